@@ -0,0 +1,156 @@
+/*
+ * @file discstat.cpp
+ *
+ * @brief Statistics of the WiFi station disconnections by the reason-code:
+ *	  lock-free counters, updated by the WIFI_EVENT handler, & the snapshot for the telemetry
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_wifi_types.h>
+#include <esp_wifi.h>
+
+#include <esp_log.h>
+
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+
+#include "net.h"
+#include "wifi.h"
+
+
+using namespace std;
+using esp::net::wifi::disconnects;
+
+
+namespace
+{
+
+    /// counters of the reason-code, updated by the event handler
+    struct slot_t
+    {
+	atomic<uint32_t> count;
+	atomic<uint32_t> last;
+	atomic<uint32_t> hist[disconnects::buckets];
+    }; /* struct slot_t */
+
+    slot_t counters[disconnects::slots];
+    atomic<uint32_t> total_count;
+    atomic<uint32_t> connect_stamp;	///< esp_timer_get_time() of the connection, ms
+    atomic<bool> connected;
+
+    mutex enroll_lock;
+    esp_event_handler_instance_t on_connected = nullptr;
+    esp_event_handler_instance_t on_disconnected = nullptr;
+
+    static_assert(atomic<uint32_t>::is_always_lock_free, "the disconnects counters are not lock-free");
+
+    /// slot of the reason-code
+    slot_t& slot(uint8_t reason)
+    {
+	return counters[esp::wifi::err::index(reason)];
+    }; /* slot() */
+
+    uint32_t now_ms()
+    {
+	return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+    }; /* now_ms() */
+
+}; /* namespace <anonymous> */
+
+
+
+//--[ class esp::net::wifi::disconnects ]------------------------------------------------------------------------------
+
+
+/// @brief register the WIFI_EVENT_STA_CONNECTED & WIFI_EVENT_STA_DISCONNECTED handlers, once
+esp_err_t disconnects::enroll()
+{
+	lock_guard<mutex> lock(enroll_lock);
+	esp_err_t err = ESP_OK;
+
+    if (!on_connected)
+	err = esp::net::wifi::evloop::listen(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, on_event, nullptr, &on_connected);
+    if (err == ESP_OK && !on_disconnected)
+	err = esp::net::wifi::evloop::listen(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, on_event, nullptr, &on_disconnected);
+    return err;
+}; /* esp::net::wifi::disconnects::enroll() */
+
+
+/// @brief count of the all disconnections
+uint32_t disconnects::total()
+{
+    return total_count.load(memory_order_relaxed);
+}; /* esp::net::wifi::disconnects::total() */
+
+
+/// @brief copy of the statistics
+void disconnects::snapshot(snapshot_t& snap)
+{
+    snap.total = total();
+    for (unsigned i = 0; i < slots; i++)
+	get(i < esp::wifi::err::codes? esp::wifi::err::code(i): 0, snap.reasons[i]);
+}; /* esp::net::wifi::disconnects::snapshot() */
+
+
+/// @brief counters of the one reason-code
+void disconnects::get(uint8_t reason, counter_t& cnt)
+{
+	const slot_t& src = slot(reason);
+
+    cnt.reason = esp::wifi::err::index(reason) < esp::wifi::err::codes? reason: 0;
+    cnt.count = src.count.load(memory_order_relaxed);
+    cnt.last = src.last.load(memory_order_relaxed);
+    for (unsigned i = 0; i < buckets; i++)
+	cnt.hist[i] = src.hist[i].load(memory_order_relaxed);
+}; /* esp::net::wifi::disconnects::get() */
+
+
+/// @brief clear of the statistics
+void disconnects::reset()
+{
+    for (auto& item: counters)
+    {
+	item.count.store(0, memory_order_relaxed);
+	item.last.store(0, memory_order_relaxed);
+	for (auto& bin: item.hist)
+	    bin.store(0, memory_order_relaxed);
+    }; /* for item */
+    total_count.store(0, memory_order_relaxed);
+}; /* esp::net::wifi::disconnects::reset() */
+
+
+/// @brief WIFI_EVENT handler: the start of the connection & the disconnection
+void disconnects::on_event(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+	uint32_t now = now_ms();
+
+    if (id == WIFI_EVENT_STA_CONNECTED)
+    {
+	connect_stamp.store(now, memory_order_relaxed);
+	connected.store(true, memory_order_relaxed);
+	return;
+    }; /* if WIFI_EVENT_STA_CONNECTED */
+
+	slot_t& cnt = slot(static_cast<wifi_event_sta_disconnected_t*>(data)->reason);
+	bool was = connected.exchange(false, memory_order_relaxed);
+
+    cnt.hist[bucket(was, now - connect_stamp.load(memory_order_relaxed))].fetch_add(1, memory_order_relaxed);
+    cnt.last.store(now, memory_order_relaxed);
+    cnt.count.fetch_add(1, memory_order_relaxed);
+    total_count.fetch_add(1, memory_order_relaxed);
+}; /* esp::net::wifi::disconnects::on_event() */
+
+
+//--[ discstat.cpp ]---------------------------------------------------------------------------------------------------
@@ -0,0 +1,223 @@
+/*
+ * @file dispatch.cpp
+ *
+ * @brief Persistent dispatcher of the WIFI_EVENT & IP_EVENT: the handlers are registered once,
+ *	  the events are fanned out to the single-producer/single-consumer queues of the subscribers
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_wifi_types.h>
+#include <esp_wifi.h>
+
+#include <esp_log.h>
+
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <asemaphore>
+
+#include "net.h"
+#include "wifi.h"
+
+
+using namespace std;
+using esp::net::wifi::dispatcher;
+
+
+/// @brief queue of the subscriber: the producer writes the slot & publishes it by the 'head',
+///	   the consumer releases the slot by the 'tail'; the indexes are free running, modulo 2^32
+struct dispatcher::queue_t
+{
+    atomic<esp_event_base_t> base{nullptr};
+    atomic<uint32_t> ids{0};	///< mask of the event ids, 0 - unsubscribed
+    atomic<uint32_t> head{0};	///< the next event of the producer
+    atomic<uint32_t> tail{0};	///< the next event of the consumer
+    atomic<uint32_t> lost{0};
+    event_t	     ring[capacity];
+    Semaphore	     ready;	///< given on the every event, taken by the waiting consumer
+
+    /// the producer side: the event loop task
+    bool push(const event_t& ev)
+    {
+	    uint32_t pos = head.load(memory_order_relaxed);
+
+	if (pos - tail.load(memory_order_acquire) >= capacity)
+	{
+	    lost.fetch_add(1, memory_order_relaxed);
+	    return false;
+	}; /* if the queue is full */
+	ring[pos & (capacity - 1)] = ev;
+	head.store(pos + 1, memory_order_release);
+	ready.Give();
+	return true;
+    }; /* push() */
+
+    /// the consumer side: the task of the subscriber
+    bool pop(event_t& ev)
+    {
+	    uint32_t pos = tail.load(memory_order_relaxed);
+
+	if (pos == head.load(memory_order_acquire))
+	    return false;
+	ev = ring[pos & (capacity - 1)];
+	tail.store(pos + 1, memory_order_release);
+	return true;
+    }; /* pop() */
+
+}; /* struct esp::net::wifi::dispatcher::queue_t */
+
+
+static_assert(atomic<uint32_t>::is_always_lock_free, "the dispatcher queue is not lock-free");
+static_assert((dispatcher::capacity & (dispatcher::capacity - 1)) == 0, "CONFIG_WIFI_DISPATCH_EVENTS must be the power of 2");
+
+
+
+//--[ class esp::net::wifi::dispatcher ]-------------------------------------------------------------------------------
+
+
+/// @brief unregister the handlers first: no event is pushed into the released queue
+dispatcher::~dispatcher()
+{
+    if (wifi_evt)
+	evloop::unlisten(WIFI_EVENT, ESP_EVENT_ANY_ID, wifi_evt);
+    if (ip_evt)
+	evloop::unlisten(IP_EVENT, ESP_EVENT_ANY_ID, ip_evt);
+    for (auto& sub: subs)
+	delete sub.exchange(nullptr);
+}; /* esp::net::wifi::dispatcher::~dispatcher() */
+
+
+/// @brief register the WIFI_EVENT & IP_EVENT handlers, once; called by the owner task only
+esp_err_t dispatcher::enroll()
+{
+	esp_err_t err = ESP_OK;
+
+    if (!wifi_evt)
+	err = evloop::listen(WIFI_EVENT, ESP_EVENT_ANY_ID, on_event, this, &wifi_evt);
+    if (err == ESP_OK && !ip_evt)
+	err = evloop::listen(IP_EVENT, ESP_EVENT_ANY_ID, on_event, this, &ip_evt);
+    return err;
+}; /* esp::net::wifi::dispatcher::enroll() */
+
+
+/// @brief the unsubscribed queue is reused, else the new one is allocated in the free slot;
+///	   the queue is published after the subscription is set: the handler sees the complete one
+dispatcher::queue_t* dispatcher::subscribe(esp_event_base_t base, uint32_t ids)
+{
+    for (auto& sub: subs)
+	if (queue_t* queue = sub.load(memory_order_acquire); queue && !queue->ids.load(memory_order_relaxed))
+	{
+	    drain(*queue);
+	    queue->base.store(base, memory_order_relaxed);
+	    queue->ids.store(ids, memory_order_release);
+	    return queue;
+	}; /* if queue is unsubscribed */
+
+    for (auto& sub: subs)
+	if (!sub.load(memory_order_relaxed))
+	{
+		queue_t* queue = new (nothrow) queue_t;
+
+	    if (!queue)
+		return nullptr;
+	    queue->base.store(base, memory_order_relaxed);
+	    queue->ids.store(ids, memory_order_relaxed);
+	    sub.store(queue, memory_order_release);
+	    return queue;
+	}; /* if !sub */
+    return nullptr;
+}; /* esp::net::wifi::dispatcher::subscribe() */
+
+
+void dispatcher::unsubscribe(queue_t* queue)
+{
+    if (queue)
+	queue->ids.store(0, memory_order_relaxed);
+}; /* esp::net::wifi::dispatcher::unsubscribe() */
+
+
+/// @brief the binary semaphore is given by the every event: the queue is checked after the every wakeup,
+///	   the wakeup by the event, already taken, is not the event
+bool dispatcher::wait(queue_t& queue, event_t& ev, TickType_t ticks)
+{
+	TickType_t start = xTaskGetTickCount();
+
+    for (;;)
+    {
+	if (queue.pop(ev))
+	    return true;
+
+	    TickType_t elapsed = xTaskGetTickCount() - start;
+
+	if (ticks != portMAX_DELAY && elapsed >= ticks)
+	    return false;
+	if (queue.ready.Take(ticks == portMAX_DELAY? portMAX_DELAY: ticks - elapsed) != pdTRUE)
+	    return queue.pop(ev);
+    }; /* for (;;) */
+}; /* esp::net::wifi::dispatcher::wait() */
+
+
+size_t dispatcher::drain(queue_t& queue)
+{
+	uint32_t pos = queue.tail.load(memory_order_relaxed);
+	uint32_t last = queue.head.load(memory_order_acquire);
+
+    queue.tail.store(last, memory_order_release);
+    queue.ready.Take(0);
+    return last - pos;
+}; /* esp::net::wifi::dispatcher::drain() */
+
+
+uint32_t dispatcher::dropped(const queue_t& queue)
+{
+    return queue.lost.load(memory_order_relaxed);
+}; /* esp::net::wifi::dispatcher::dropped() */
+
+
+/// @brief only the raw fields of the event data are copied; the ids over 31 are not dispatched
+void dispatcher::on_event(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+	dispatcher& self = *static_cast<dispatcher*>(arg);
+	event_t ev = {base, id, 0, 0, 0};
+
+    if (id < 0 || id > 31)
+	return;
+    if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP)
+	ev.aux = static_cast<ip_event_got_ip_t*>(data)->ip_info.ip.addr;
+    else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_CONNECTED)
+	ev.aux = static_cast<wifi_event_sta_connected_t*>(data)->channel;
+    else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED)
+    {
+	ev.reason = static_cast<wifi_event_sta_disconnected_t*>(data)->reason;
+	ev.rssi = static_cast<wifi_event_sta_disconnected_t*>(data)->rssi;
+    }; /* else if WIFI_EVENT_STA_DISCONNECTED */
+
+    for (auto& sub: self.subs)
+    {
+	    queue_t* queue = sub.load(memory_order_acquire);
+
+	if (!queue || !(queue->ids.load(memory_order_acquire) & 1u << id) || queue->base.load(memory_order_relaxed) != base)
+	    continue;
+	if (queue->push(ev))
+	    self.posted.fetch_add(1, memory_order_relaxed);
+	else
+	    self.lost.fetch_add(1, memory_order_relaxed);
+    }; /* for sub */
+}; /* esp::net::wifi::dispatcher::on_event() */
+
+
+//--[ dispatch.cpp ]---------------------------------------------------------------------------------------------------
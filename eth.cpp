@@ -0,0 +1,315 @@
+/*
+ * @file eth.cpp
+ *
+ * @brief C++ abstraction layer of the Ethernet ESP API procedures: the netif of the esp_eth driver
+ *	  & the Updater of it's ip configuration
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_log.h>
+
+#include <esp_netif.h>
+#include <esp_eth.h>
+#include <esp_event.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <asemaphore>
+#include <sync.hpp>
+
+#include "net.h"
+#include "eth.h"
+#include "netlog.h"
+#include "sdkconfig.h"
+
+
+using namespace std;
+
+
+#ifdef CONFIG_ETH_USE_ESP32_EMAC
+static_assert(esp::eth::dma::configured.valid(), "the DMA buffers of the EMAC are out of the ranges of the esp_eth");
+#endif
+static_assert(esp::eth::dma::low_ram.valid() && esp::eth::dma::balanced.valid() && esp::eth::dma::throughput.valid(),
+	"the DMA buffers profile is out of the ranges of the esp_eth");
+
+
+
+//--[ class esp::eth::netif_t ]----------------------------------------------------------------------------------------
+
+
+/// @brief Create exemplar of the Ethernet esp::netif
+esp::eth::netif_t::netif_t(esp_eth_handle_t driver, esp_netif_inherent_config_t &config): netif_t()
+{
+    create(driver, config);
+}; /* esp::eth::netif_t::netif_t() */
+
+
+esp::eth::netif_t::~netif_t()
+{
+    untrack();
+    if (glue)
+	esp_eth_del_netif_glue(glue);
+    glue = nullptr;
+}; /* esp::eth::netif_t::~netif_t() */
+
+
+/// @brief the handlers are registered before the netif is attached: the link of the driver,
+///	   started before the creation of the netif, is not mirrored up to it's next change
+esp_netif_t* esp::eth::netif_t::create(esp_eth_handle_t driver, esp_netif_inherent_config_t &config)
+{
+	esp_netif_config_t netif_cfg = {&config, nullptr, ESP_NETIF_NETSTACK_DEFAULT_ETH};
+
+    eth = driver;
+    instance = esp_netif_new(&netif_cfg);
+    if (!instance)
+    {
+	NET_LOGE(__func__, "Fail create the Ethernet netif");
+	err = ESP_FAIL;
+	return nullptr;
+    }; /* if !instance */
+
+    dhcp.client.sync();
+    track();
+    glue = esp_eth_new_netif_glue(driver);
+    err = glue? esp_netif_attach(instance, glue): ESP_ERR_INVALID_ARG;
+    if (err != ESP_OK)
+    {
+	NET_LOGE(__func__, "Fail attach the Ethernet driver to the netif with error code %i", err);
+	untrack();
+	if (glue)
+	    esp_eth_del_netif_glue(glue);
+	glue = nullptr;
+	destroy();
+    }; /* if err != ESP_OK */
+    return instance;
+}; /* esp::eth::netif_t::create() */
+
+
+esp_err_t esp::eth::netif_t::track()
+{
+	esp_err_t err = ESP_OK;
+
+    if (!on_eth)
+	err = esp_event_handler_instance_register(ETH_EVENT, ESP_EVENT_ANY_ID, on_event, this, &on_eth);
+    if (err == ESP_OK && !on_ip)
+	err = esp_event_handler_instance_register(IP_EVENT, ESP_EVENT_ANY_ID, on_event, this, &on_ip);
+    if (err != ESP_OK)
+	NET_LOGE(__func__, "Fail register the handlers of the Ethernet events with error code %i", err);
+    return err;
+}; /* esp::eth::netif_t::track() */
+
+
+void esp::eth::netif_t::untrack()
+{
+    if (on_eth)
+	esp_event_handler_instance_unregister(ETH_EVENT, ESP_EVENT_ANY_ID, on_eth);
+    if (on_ip)
+	esp_event_handler_instance_unregister(IP_EVENT, ESP_EVENT_ANY_ID, on_ip);
+    on_eth = on_ip = nullptr;
+}; /* esp::eth::netif_t::untrack() */
+
+
+/// @brief the events of the driver & the netif are mirrored into the link & the DHCP client w/o the esp_netif calls;
+///	   the ETH_EVENT data is the handle of the driver, the events of the other drivers are skipped
+void esp::eth::netif_t::on_event(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+	netif_t& netif = *static_cast<netif_t*>(arg);
+
+    if (base == ETH_EVENT)
+    {
+	if (!data || *static_cast<esp_eth_handle_t*>(data) != netif.eth)
+	    return;
+	if (id == ETHERNET_EVENT_CONNECTED)
+	{
+	    netif.up.store(true, memory_order_release);
+	    netif.nlinks.fetch_add(1, memory_order_relaxed);
+	    netif.dhcp.client.link(true);
+	} /* if ETHERNET_EVENT_CONNECTED */
+	else if (id == ETHERNET_EVENT_DISCONNECTED || id == ETHERNET_EVENT_STOP)
+	{
+	    netif.up.store(false, memory_order_release);
+	    netif.dhcp.client.link(false);
+	}; /* else if ETHERNET_EVENT_DISCONNECTED */
+    } /* if base == ETH_EVENT */
+    else if (base == IP_EVENT && (id == IP_EVENT_ETH_GOT_IP || id == IP_EVENT_ETH_LOST_IP) && data
+	    && static_cast<ip_event_got_ip_t*>(data)->esp_netif == netif.instance)
+    {
+	if (id == IP_EVENT_ETH_LOST_IP)
+	{
+	    netif.dhcp.client.lost();
+	    return;
+	}; /* if IP_EVENT_ETH_LOST_IP */
+
+	    const esp_netif_ip_info_t& info = static_cast<ip_event_got_ip_t*>(data)->ip_info;
+
+	netif.dhcp.client.bound(info);
+	netif.got.store(info.ip.addr, memory_order_release);
+	netif.addressed.Give();
+    }; /* else if IP_EVENT_ETH_GOT_IP */
+}; /* esp::eth::netif_t::on_event() */
+
+
+
+//--[ class esp::net::eth::Updater ]-----------------------------------------------------------------------------------
+
+
+/** @brief Save current ip configuration of the netif for backup: the DHCP client is on, unless it is stopped
+ *  @return ESP_OK	  - success */
+esp_err_t esp::net::eth::Updater::backup()
+{
+    if (ethbkp == nullptr)
+    {
+	bkpbuf = ::net::configuration_t(!its_netif.dhcp.client.stopped(), its_netif.cfg.get(), "", "");
+	bkpbuf.clr_chgst();
+	ethbkp = &bkpbuf;
+    }; /* if ethbkp == nullptr */
+
+    NET_LOGI(__func__, "Backup of the Ethernet ip cfg: DHCP is %s, IP %s, Mask %s, Gateway %s",
+	    ethbkp->dhcp? "Enabled": "Disabled", ethbkp->ip.text().c_str(), ethbkp->mask.text().c_str(),
+	    ethbkp->gate.text().c_str());
+    return (err = ESP_OK);
+}; /* esp::net::eth::Updater::backup() */
+
+
+esp_err_t esp::net::eth::Updater::revert()
+{
+    if (ethbkp == nullptr)
+	return (err = ESP_ERR_NOT_FOUND);
+    NET_LOGW(__func__, "###-- Error updating the Ethernet ip cfg, restore it's from backup --###");
+    return invoke(*ethbkp);
+}; /* esp::net::eth::Updater::revert() */
+
+
+void esp::net::eth::Updater::finalize()
+{
+    ethbkp = nullptr;
+}; /* esp::net::eth::Updater::finalize() */
+
+
+bool esp::net::eth::Updater::valid(const ::net::configuration_t& cfg)
+{
+    return cfg.dhcp || (uint32_t(cfg.ip) != 0 && uint32_t(cfg.mask) != 0);
+}; /* esp::net::eth::Updater::valid() */
+
+
+esp_err_t esp::net::eth::Updater::dhcp(bool on)
+{
+    err = ESP_OK;
+    if (on && !its_netif.dhcp.client.started())
+	err = its_netif.dhcp.client.start();
+    else if (!on && !its_netif.dhcp.client.stopped())
+	err = its_netif.dhcp.client.stop();
+    if (err == ESP_ERR_ESP_NETIF_DHCP_ALREADY_STARTED || err == ESP_ERR_ESP_NETIF_DHCP_ALREADY_STOPPED)
+	err = ESP_OK;
+    return err;
+}; /* esp::net::eth::Updater::dhcp() */
+
+
+/// @brief the IP_EVENT_ETH_GOT_IP of the other address (the static one, announced before the DHCP start)
+///	   is skipped, the waiting is continued up to the end of the timeout
+esp_err_t esp::net::eth::Updater::wait(const ::net::configuration_t& cfg)
+{
+	TickType_t ticks = secticks(CONFIG_NET_ETH_WAITING_IP);
+	TickType_t start = xTaskGetTickCount();
+	uint32_t addr = cfg.ip;
+
+    while (its_netif.addressed.Take(ticks - std::min<TickType_t>(xTaskGetTickCount() - start, ticks)) == pdTRUE)
+	if (cfg.dhcp? its_netif.dhcp.client.leased(): its_netif.got.load(memory_order_acquire) == addr)
+	{
+		esp_ip4_addr_t got = {its_netif.got.load(memory_order_acquire)};
+
+	    NET_LOGI(__func__, "Ethernet netif got ip " IPSTR ", ip cfg sucessfully changed", IP2STR(&got));
+	    return (err = ESP_OK);
+	}; /* if the address of the cfg */
+
+    NET_LOGW(__func__, "No address of the Ethernet netif during %u s", CONFIG_NET_ETH_WAITING_IP);
+    return (err = ESP_ERR_TIMEOUT);
+}; /* esp::net::eth::Updater::wait() */
+
+
+/// @brief the DHCP client, started & leased already, is kept: no new exchange, no waiting
+esp_err_t esp::net::eth::Updater::invoke(const ::net::configuration_t& cfg)
+{
+    if (!valid(cfg))
+	return (err = ESP_ERR_INVALID_ARG);
+
+	bool renew = !cfg.dhcp || !its_netif.dhcp.client.started() || !its_netif.dhcp.client.leased();
+
+    its_netif.addressed.Take(0);	// IP_EVENT_ETH_GOT_IP of the previous configuration
+    if (dhcp(cfg.dhcp) != ESP_OK)
+    {
+	NET_LOGE(__func__, "Fail %s the DHCP client with error code %i", cfg.dhcp? "start": "stop", err);
+	return err;
+    }; /* if dhcp() != ESP_OK */
+    if (!cfg.dhcp)
+    {
+	    esp::ip4::info info(cfg.ip, cfg.mask, cfg.gate);
+
+	if ((err = its_netif.set_ip(&info)) != ESP_OK)
+	{
+	    NET_LOGE(__func__, "Fail set the static ip with error code %i", err);
+	    return err;
+	}; /* if set_ip() != ESP_OK */
+    }; /* if !cfg.dhcp */
+
+    if (!its_netif.link())
+    {
+	NET_LOGI(__func__, "The link is down, the address of the Ethernet netif follows the link up");
+	return (err = ESP_OK);
+    }; /* if !its_netif.link() */
+    return renew? wait(cfg): (err = ESP_OK);
+}; /* esp::net::eth::Updater::invoke() */
+
+
+esp_err_t esp::net::eth::Updater::operator()(const ::net::configuration_t& cfg)
+{
+    err = ESP_OK;
+    if (!cfg.ip_changed())
+    {
+	NET_LOGW(__func__, "# Ethernet netif configuration was not changed - nothong to do");
+	return (err = ESP_ERR_NOT_FOUND);
+    }; /* if !cfg.ip_changed() */
+
+    if (cfg.fingerprint() == applied && cfg.same(lastcfg))
+    {
+	NET_LOGW(__func__, "# Ethernet netif configuration is changed back to the applied one - nothong to do");
+	return (err = ESP_ERR_NOT_FOUND);
+    }; /* if cfg.fingerprint() == applied && cfg.same(lastcfg) */
+
+    if (!valid(cfg))
+	return (err = ESP_ERR_INVALID_ARG);
+
+    backup();
+    invoke(cfg);
+    if (err != ESP_OK)
+    {
+	    esp_err_t savederr = err;
+
+	NET_LOGW(__func__, "Fail updating the Ethernet ip cfg with error code %i, reverted it", err);
+	revert();
+	NET_LOGW(__func__, "Revert the Ethernet ip cfg with error code %i", err);
+	if (err != ESP_OK)
+	    applied = 0;	// the current configuration is unknown
+	err = savederr;
+    } /* if err != ESP_OK */
+    else
+    {
+	applied = cfg.fingerprint();
+	lastcfg = cfg;
+    }; /* else if err != ESP_OK */
+    return err;
+}; /* esp::net::eth::Updater::operator() */
+
+
+//--[ eth.cpp ]--------------------------------------------------------------------------------------------------------
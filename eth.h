@@ -0,0 +1,222 @@
+/*
+ * @file
+ * eth.h
+ *
+ * @brief General backend definition for the wired Ethernet network:
+ * @brief C++ abstraction layer of the Ethernet ESP API procedures - the netif of the esp_eth driver & it's Updater
+ *
+ * @warning May be only inner definitions of the 'net' component
+ *
+ * This code is in the Public Domain (or CC0 licensed, at your option.)
+ *
+ * Unless required by applicable law or agreed to in writing, this
+ *  software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ *  CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * @date    Created on: 16 окт. 2026 г.
+ * @author  aso
+ */
+
+#ifndef _ETH_H_
+#define _ETH_H_
+
+#ifdef __cplusplus
+
+#include <atomic>
+
+#include <esp_eth.h>
+#include <asemaphore>
+
+#include "net.h"
+#include "sdkconfig.h"
+
+
+/// Timeout of the waiting of the IP_EVENT_ETH_GOT_IP by the esp::net::eth::Updater, s
+#ifndef CONFIG_NET_ETH_WAITING_IP
+#define CONFIG_NET_ETH_WAITING_IP 10
+#endif
+
+
+// namesopace for encapsulating of the esp system functions
+namespace esp
+{
+
+    namespace eth
+    {
+	class netif_t;
+
+
+	///@brief Profile of the DMA buffers of the EMAC: the throughput of the wired gateway against the RAM.
+	///@detail The frame of the max size (1518 bytes) takes the chain of the buffers: the more RX buffers -
+	///	   the longer burst is received w/o the drop, while the lwIP task is busy; the more TX buffers -
+	///	   the more frames are queued w/o the blocking of the sender. Every buffer takes the descriptor.
+	struct dma_profile_t
+	{
+	    static constexpr size_t descriptor = 32;	///< size of the DMA descriptor, bytes
+	    static constexpr size_t frame = 1518;	///< the max Ethernet frame w/o the VLAN tag, bytes
+
+	    uint8_t  rx;	///< count of the RX buffers, 3..30
+	    uint8_t  tx;	///< count of the TX buffers, 3..30
+	    uint16_t size;	///< size of the buffer, bytes, 256..1600, multiple of 4
+
+	    /// @brief the profile is in the ranges of the Kconfig options of the esp_eth
+	    constexpr bool valid() const {
+		return rx >= 3 && rx <= 30 && tx >= 3 && tx <= 30 && size >= 256 && size <= 1600 && size % 4 == 0; };
+
+	    /// @brief the RAM of the buffers & the descriptors, bytes
+	    constexpr size_t ram() const { return (rx + tx) * (size + descriptor); };
+
+	    /// @brief count of the max size frames, buffered by the RX ring
+	    constexpr unsigned burst() const { return rx / ((frame + size - 1) / size); };
+	}; /* struct esp::eth::dma_profile_t */
+
+	namespace dma
+	{
+	    constexpr dma_profile_t low_ram    {5, 5, 512};	///< the sensor node: 1 frame of the burst, 5.3 KiB
+	    constexpr dma_profile_t balanced   {10, 10, 512};	///< the defaults of the esp_eth: 3 frames, 10.6 KiB
+	    constexpr dma_profile_t throughput {20, 20, 512};	///< the wired gateway: 6 frames of the burst, 21.3 KiB
+
+#ifdef CONFIG_ETH_USE_ESP32_EMAC
+	    /// the profile, the esp_eth is built with: the Kconfig options of the internal EMAC,
+	    /// absent for the SPI Ethernet & the chips w/o the EMAC
+	    constexpr dma_profile_t configured {CONFIG_ETH_DMA_RX_BUFFER_NUM, CONFIG_ETH_DMA_TX_BUFFER_NUM, CONFIG_ETH_DMA_BUFFER_SIZE};
+#endif
+
+	}; /* namespace esp::eth::dma */
+
+    }; /* namespace esp::eth */
+
+
+    namespace net
+    {
+	namespace eth
+	{
+
+	    /// @brief Class for updating the ip configuration of the Ethernet netif: the static ip or the DHCP client,
+	    ///	       with the backup & the revert of the failed configuration, as the esp::net::wifi::Updater;
+	    ///	       the wired netif has no login - the login/password fields of the configuration are ignored
+	    class Updater
+	    {
+	    public:
+		Updater(esp::eth::netif_t *netif): its_netif(*netif) {};
+
+		esp_err_t status() { return err; };
+
+		/** @brief Save current ip configuration of the netif for backup
+		 *  @return ESP_OK	  - success */
+		esp_err_t backup();
+
+		/** @brief Restore previously saved ip configuration from backup
+		 *  @return ESP_OK	  - success updating configuration
+		 *	ESP_ERR_NOT_FOUND - backup is absent
+		 *	other		  - as the invoke() */
+		esp_err_t revert();
+
+		/** @brief Finalize updating procedure - clearing the backup */
+		void finalize();
+
+		/** @brief Invoke immediately the update of the ip configuration w/o the backup & the revert:
+		 *	    start/stop the DHCP client, set the static ip; wait the IP_EVENT_ETH_GOT_IP of the new
+		 *	    configuration, if the link is up, else the address follows the link up by the netif itself
+		 *  @param[in]   cfg      - new network configuration
+		 *  @return
+		 *	ESP_OK		      - the address is obtained, or the link is down
+		 *	ESP_ERR_INVALID_ARG   - the static ip or the mask is 0
+		 *	ESP_ERR_TIMEOUT	      - no address during CONFIG_NET_ETH_WAITING_IP
+		 *	other		      - error of the esp_netif */
+		esp_err_t invoke(const ::net::configuration_t& cfg);
+
+		/** @brief Full update procedure of the ip configuration of the Ethernet netif: backup, invoke,
+		 *	    revert on failure
+		 *  @return
+		 *	ESP_OK		      - Setup configuration successfully
+		 *	ESP_ERR_NOT_FOUND     - ip cfg is not changed, nothing to do
+		 *				or it is changed back to the last applied configuration
+		 *	other		      - as the invoke(), the backup is restored */
+		esp_err_t operator()(const ::net::configuration_t& cfg);
+
+	    protected:
+
+		/// @brief the static configuration has the address & the mask
+		static bool valid(const ::net::configuration_t& cfg);
+
+		/// @brief start/stop the DHCP client according the requested status
+		esp_err_t dhcp(bool on);
+
+		/// @brief wait the IP_EVENT_ETH_GOT_IP of the configuration: the leased address or the static one
+		esp_err_t wait(const ::net::configuration_t& cfg);
+
+	    private:
+		esp::eth::netif_t &its_netif;
+
+		::net::configuration_t *ethbkp = nullptr; ///<@brief backup of the ip cfg, points to the 'bkpbuf'
+		::net::configuration_t bkpbuf;	///< storage of the backup, inline - the backup does not allocate
+		esp_err_t err = ESP_OK;
+		uint32_t applied = 0;	///< fingerprint of the applied configuration, 0 - unknown
+		::net::configuration_t lastcfg;	///< the applied configuration, compared on the equal fingerprints
+
+	    }; /* class esp::net::eth::Updater */
+
+	}; /* namespace esp::net::eth */
+
+    }; /* namespace esp::net */
+
+
+    namespace eth
+    {
+
+	/// NetIf for the Ethernet Specialization: the netif of the esp_eth driver, attached by the glue
+	///@detail The link & the address are mirrored into the DHCP client by the ETH_EVENT & IP_EVENT handlers
+	///	   of the default event loop: the own event loop of the component is for the WiFi events only,
+	///	   the both bases are handled in the one task, the order of the link & the address is kept.
+	class netif_t: public esp::netif_t
+	{
+	public:
+	    /// @brief Default constructor
+	    netif_t(): esp::netif_t(), update(this) {};
+	    /// @brief Create the exemplar of esp::netif and create the Ethernet esp_netif_t object of the driver
+	    netif_t(esp_eth_handle_t driver, esp_netif_inherent_config_t &config);
+	    /// @brief the handlers are unregistered & the glue is deleted before the netif is destroyed
+	    ~netif_t();
+	    /// Main procedure for creation the Ethernet Netif & it's attaching to the driver
+	    esp_netif_t* create(esp_eth_handle_t driver, esp_netif_inherent_config_t &config);
+
+	    esp_err_t start() { return (err = esp_eth_start(eth)); };	///< start the driver: the link is up on the autonegotiation
+	    esp_err_t stop() { return (err = esp_eth_stop(eth)); };	///< stop the driver: the link is down
+
+	    bool link() const { return up.load(std::memory_order_acquire); };	///< the link is up, mirrored
+	    uint32_t links() const { return nlinks.load(std::memory_order_relaxed); };	///< count of the link ups
+	    esp_eth_handle_t driver() const { return eth; };
+
+#ifdef CONFIG_ETH_USE_ESP32_EMAC
+	    /// @brief the DMA buffers profile, the esp_eth is built with
+	    static constexpr const dma_profile_t& dma() { return dma::configured; };
+#endif
+
+	    net::eth::Updater update;
+
+	protected:
+	    friend class esp::net::eth::Updater;
+
+	    esp_err_t track();
+	    void untrack();
+	    static void on_event(void* arg, esp_event_base_t base, int32_t id, void* data);
+	    esp_event_handler_instance_t on_eth = nullptr;
+	    esp_event_handler_instance_t on_ip = nullptr;
+
+	    esp_eth_handle_t eth = nullptr;
+	    esp_eth_netif_glue_handle_t glue = nullptr;
+	    std::atomic<bool> up{false};
+	    std::atomic<uint32_t> nlinks{0};
+	    std::atomic<uint32_t> got{0};	///< the address of the last IP_EVENT_ETH_GOT_IP
+	    Semaphore addressed;		///< given by the IP_EVENT_ETH_GOT_IP
+
+	}; /* class esp::eth::netif_t */
+
+    }; /* namespace esp::eth */
+
+}; /* namespace esp */
+
+#endif /* __cplusplus */
+
+#endif /* _ETH_H_ */
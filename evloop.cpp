@@ -0,0 +1,237 @@
+/*
+ * @file evloop.cpp
+ *
+ * @brief Own esp_event loop of the 'net' component: the own task, priority & core affinity,
+ *	  the WIFI_EVENT & IP_EVENT are forwarded into it from the default event loop
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_wifi_types.h>
+#include <esp_wifi.h>
+
+#include <esp_log.h>
+
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "netlog.h"
+
+
+using namespace std;
+using esp::net::wifi::evloop;
+
+
+namespace
+{
+
+    mutex start_lock;	///< start() & stop(), the forwarder reads the 'loop' w/o the lock
+    atomic<esp_event_loop_handle_t> loop{nullptr};
+    esp_event_handler_instance_t fwd_wifi = nullptr;
+    esp_event_handler_instance_t fwd_ip = nullptr;
+
+    atomic<uint32_t> fwd_count{0};
+    atomic<uint32_t> drop_count{0};
+
+    /// handler of the component, registered in the own loop: the instance & the loop, it is registered in
+    struct listener_t
+    {
+	esp_event_handler_instance_t instance;
+	esp_event_loop_handle_t loop;
+    }; /* struct listener_t */
+
+    listener_t listeners[CONFIG_WIFI_EVLOOP_HANDLERS];	///< under the 'start_lock'
+    unsigned nlisteners = 0;
+
+}; /* namespace <anonymous> */
+
+
+
+//--[ class esp::net::wifi::evloop ]-----------------------------------------------------------------------------------
+
+
+/// @brief the forwarders are registered after the loop is published: no event is lost between
+esp_err_t evloop::start(const config_t& cfg)
+{
+	lock_guard<mutex> lock(start_lock);
+	esp_event_loop_args_t args = {};
+	esp_event_loop_handle_t handle = nullptr;
+	esp_err_t err;
+
+    if (loop.load(memory_order_relaxed))
+	return ESP_ERR_INVALID_STATE;
+    args.queue_size = cfg.queue;
+    args.task_name = cfg.name;
+    args.task_priority = cfg.priority;
+    args.task_stack_size = cfg.stack;
+    args.task_core_id = cfg.core;
+    if ((err = esp_event_loop_create(&args, &handle)) != ESP_OK)
+    {
+	NET_LOGE(__func__, "Fail create the event loop of the component with error code %i", err);
+	return err;
+    }; /* if esp_event_loop_create() != ESP_OK */
+    loop.store(handle, memory_order_release);
+
+    err = esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID, forward, nullptr, &fwd_wifi);
+    if (err == ESP_OK)
+	err = esp_event_handler_instance_register(IP_EVENT, ESP_EVENT_ANY_ID, forward, nullptr, &fwd_ip);
+    if (err != ESP_OK)
+    {
+	NET_LOGE(__func__, "Fail register the event forwarders with error code %i", err);
+	if (fwd_wifi)
+	    esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, fwd_wifi);
+	fwd_wifi = nullptr;
+	loop.store(nullptr, memory_order_release);
+	esp_event_loop_delete(handle);
+	return err;
+    }; /* if err != ESP_OK */
+    NET_LOGI(__func__, "Event loop of the component is started: task %s, priority %u", cfg.name, cfg.priority);
+    return ESP_OK;
+}; /* esp::net::wifi::evloop::start() */
+
+
+/// @brief the forwarders are unregistered first: no event is posted into the deleted loop; the loop
+///	   with the handlers of the component is kept, they would stay registered in the deleted loop
+esp_err_t evloop::stop()
+{
+	lock_guard<mutex> lock(start_lock);
+	esp_event_loop_handle_t handle = loop.load(memory_order_relaxed);
+
+    if (!handle)
+	return ESP_ERR_INVALID_STATE;
+    if (nlisteners)
+    {
+	NET_LOGE(__func__, "%u handlers of the component are registered in the event loop, it is not deleted", nlisteners);
+	return ESP_ERR_INVALID_STATE;
+    }; /* if nlisteners */
+    esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, fwd_wifi);
+    esp_event_handler_instance_unregister(IP_EVENT, ESP_EVENT_ANY_ID, fwd_ip);
+    fwd_wifi = fwd_ip = nullptr;
+    loop.store(nullptr, memory_order_release);
+    return esp_event_loop_delete(handle);
+}; /* esp::net::wifi::evloop::stop() */
+
+
+esp_event_loop_handle_t evloop::handle()
+{
+    return loop.load(memory_order_acquire);
+}; /* esp::net::wifi::evloop::handle() */
+
+
+esp_err_t evloop::listen(esp_event_base_t base, int32_t id, esp_event_handler_t fn, void* arg,
+	esp_event_handler_instance_t* instance)
+{
+	lock_guard<mutex> lock(start_lock);
+	esp_event_loop_handle_t handle = loop.load(memory_order_relaxed);
+	esp_err_t err;
+
+    if (!handle)
+	return esp_event_handler_instance_register(base, id, fn, arg, instance);
+    if (!instance)
+	return ESP_ERR_INVALID_ARG;
+    if (nlisteners == CONFIG_WIFI_EVLOOP_HANDLERS)
+    {
+	NET_LOGE(__func__, "No room for the handler of the component, CONFIG_WIFI_EVLOOP_HANDLERS are registered");
+	return ESP_ERR_NO_MEM;
+    }; /* if nlisteners == CONFIG_WIFI_EVLOOP_HANDLERS */
+    if ((err = esp_event_handler_instance_register_with(handle, base, id, fn, arg, instance)) == ESP_OK)
+	listeners[nlisteners++] = {*instance, handle};
+    return err;
+}; /* esp::net::wifi::evloop::listen() */
+
+
+/// @brief the instance, not found in the own loop, is registered in the default one
+esp_err_t evloop::unlisten(esp_event_base_t base, int32_t id, esp_event_handler_instance_t instance)
+{
+	lock_guard<mutex> lock(start_lock);
+
+    for (unsigned i = 0; i < nlisteners; i++)
+	if (listeners[i].instance == instance)
+	{
+		esp_event_loop_handle_t handle = listeners[i].loop;
+
+	    listeners[i] = listeners[--nlisteners];
+	    return esp_event_handler_instance_unregister_with(handle, base, id, instance);
+	}; /* if listeners[i].instance == instance */
+    return esp_event_handler_instance_unregister(base, id, instance);
+}; /* esp::net::wifi::evloop::unlisten() */
+
+
+esp_err_t evloop::post(esp_event_base_t base, int32_t id, const void* data, size_t size, TickType_t ticks)
+{
+	esp_event_loop_handle_t handle = loop.load(memory_order_acquire);
+
+    if (!handle)
+	return esp_event_post(base, id, data, size, ticks);
+    return esp_event_post_to(handle, base, id, data, size, ticks);
+}; /* esp::net::wifi::evloop::post() */
+
+
+/// @brief the handler gets the data w/o it's size: the size is known for the events, used by the component only
+size_t evloop::data_size(esp_event_base_t base, int32_t id)
+{
+    if (base == WIFI_EVENT)
+	switch (id)
+	{
+	case WIFI_EVENT_STA_CONNECTED:		return sizeof(wifi_event_sta_connected_t);
+	case WIFI_EVENT_STA_DISCONNECTED:	return sizeof(wifi_event_sta_disconnected_t);
+	case WIFI_EVENT_AP_STACONNECTED:	return sizeof(wifi_event_ap_staconnected_t);
+	case WIFI_EVENT_AP_STADISCONNECTED:	return sizeof(wifi_event_ap_stadisconnected_t);
+	default:				return 0;
+	}; /* switch id */
+    if (base == IP_EVENT)
+	switch (id)
+	{
+	case IP_EVENT_STA_GOT_IP:
+	case IP_EVENT_ETH_GOT_IP:
+	case IP_EVENT_PPP_GOT_IP:		return sizeof(ip_event_got_ip_t);
+	case IP_EVENT_AP_STAIPASSIGNED:		return sizeof(ip_event_ap_staipassigned_t);
+	default:				return 0;
+	}; /* switch id */
+    return 0;
+}; /* esp::net::wifi::evloop::data_size() */
+
+
+uint32_t evloop::forwarded()
+{
+    return fwd_count.load(memory_order_relaxed);
+}; /* esp::net::wifi::evloop::forwarded() */
+
+
+uint32_t evloop::dropped()
+{
+    return drop_count.load(memory_order_relaxed);
+}; /* esp::net::wifi::evloop::dropped() */
+
+
+/// @brief the default loop is never blocked: the event, not fitting the queue of the own loop, is dropped & counted
+void evloop::forward(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+	esp_event_loop_handle_t handle = loop.load(memory_order_acquire);
+	size_t size = data? data_size(base, id): 0;
+
+    if (!handle)
+	return;
+    if (esp_event_post_to(handle, base, id, size? data: nullptr, size, 0) == ESP_OK)
+	fwd_count.fetch_add(1, memory_order_relaxed);
+    else
+	drop_count.fetch_add(1, memory_order_relaxed);
+}; /* esp::net::wifi::evloop::forward() */
+
+
+//--[ evloop.cpp ]-----------------------------------------------------------------------------------------------------
@@ -0,0 +1,221 @@
+/*
+ * @file evtrace.cpp
+ *
+ * @brief Trace of the WIFI_EVENT & IP_EVENT: single producer, multiple readers lock-free ring
+ *	  of the compact binary records, filled by the event handler & decoded by the reader only
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_wifi_types.h>
+#include <esp_wifi.h>
+
+#include <esp_log.h>
+
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+
+#include "net.h"
+#include "wifi.h"
+
+
+using namespace std;
+using esp::net::wifi::trace;
+
+
+namespace
+{
+
+    /// slot of the ring: the per slot sequence lock - 'seq' is 0 while the slot is written,
+    /// the record number + 1 after; the record is packed into the 32-bit words,
+    /// the 64-bit atomics are not lock-free on the 32-bit targets
+    struct slot_t
+    {
+	atomic<uint32_t> seq;
+	atomic<uint32_t> time_lo;
+	atomic<uint32_t> time_hi;
+	atomic<uint32_t> aux;
+	atomic<uint32_t> packed;	///< source | id << 8 | reason << 16 | rssi << 24
+    }; /* struct slot_t */
+
+    slot_t ring[trace::capacity];
+    atomic<uint32_t> head;	///< number of the next record
+    atomic<uint32_t> cleared_at;	///< first record after the clear()
+
+    mutex enroll_lock;
+    esp_event_handler_instance_t on_wifi = nullptr;
+    esp_event_handler_instance_t on_ip = nullptr;
+
+    static_assert(atomic<uint32_t>::is_always_lock_free, "the trace ring is not lock-free");
+    static_assert((trace::capacity & (trace::capacity - 1)) == 0, "CONFIG_WIFI_TRACE_RECORDS must be the power of 2");
+
+    const char* const wifi_names[] = {
+	"WIFI_READY", "SCAN_DONE", "STA_START", "STA_STOP", "STA_CONNECTED", "STA_DISCONNECTED",
+	"STA_AUTHMODE_CHANGE", "STA_WPS_ER_SUCCESS", "STA_WPS_ER_FAILED", "STA_WPS_ER_TIMEOUT",
+	"STA_WPS_ER_PIN", "STA_WPS_ER_PBC_OVERLAP", "AP_START", "AP_STOP", "AP_STACONNECTED",
+	"AP_STADISCONNECTED", "AP_PROBEREQRECVED" };
+
+    const char* const ip_names[] = {
+	"STA_GOT_IP", "STA_LOST_IP", "AP_STAIPASSIGNED", "GOT_IP6", "ETH_GOT_IP", "ETH_LOST_IP",
+	"PPP_GOT_IP", "PPP_LOST_IP" };
+
+}; /* namespace <anonymous> */
+
+
+
+//--[ class esp::net::wifi::trace ]------------------------------------------------------------------------------------
+
+
+/// @brief register the WIFI_EVENT & IP_EVENT handlers, once
+esp_err_t trace::enroll()
+{
+	lock_guard<mutex> lock(enroll_lock);
+	esp_err_t err = ESP_OK;
+
+    if (!on_wifi)
+	err = evloop::listen(WIFI_EVENT, ESP_EVENT_ANY_ID, on_event, nullptr, &on_wifi);
+    if (err == ESP_OK && !on_ip)
+	err = evloop::listen(IP_EVENT, ESP_EVENT_ANY_ID, on_event, nullptr, &on_ip);
+    return err;
+}; /* esp::net::wifi::trace::enroll() */
+
+
+/// @brief record the event: the slot is marked as busy, written by the relaxed stores & published
+void trace::record(source_t source, uint8_t id, uint8_t reason, int8_t rssi, uint32_t aux)
+{
+	uint64_t now = esp_timer_get_time();
+	uint32_t n = head.load(memory_order_relaxed);
+	slot_t& slot = ring[n & (capacity - 1)];
+
+    slot.seq.store(0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot.time_lo.store(static_cast<uint32_t>(now), memory_order_relaxed);
+    slot.time_hi.store(static_cast<uint32_t>(now >> 32), memory_order_relaxed);
+    slot.aux.store(aux, memory_order_relaxed);
+    slot.packed.store(source | id << 8 | reason << 16 | static_cast<uint8_t>(rssi) << 24, memory_order_relaxed);
+    slot.seq.store(n + 1, memory_order_release);
+    head.store(n + 1, memory_order_release);
+}; /* esp::net::wifi::trace::record() */
+
+
+/// @brief count of the all records, the next record number
+uint32_t trace::recorded()
+{
+    return head.load(memory_order_acquire);
+}; /* esp::net::wifi::trace::recorded() */
+
+
+/// @brief copy of the records, the oldest first: the slot is taken, if it's sequence is the same
+///	   before & after the copy, and it is the wanted record - not overwritten by the next round
+size_t trace::read(record_t out[], size_t size, uint32_t from)
+{
+	uint32_t last = head.load(memory_order_acquire);
+	uint32_t first = last - (last < capacity? last: capacity);
+	uint32_t cleared = cleared_at.load(memory_order_relaxed);
+	size_t count = 0;
+
+    // the latest of the oldest record in the ring, the wanted one & the first after the clear(), modulo 2^32
+    if (last - from < last - first)
+	first = from;
+    if (last - cleared < last - first)
+	first = cleared;
+    for (uint32_t n = first; n != last && count < size; n++)
+    {
+	    const slot_t& slot = ring[n & (capacity - 1)];
+	    uint32_t seq = slot.seq.load(memory_order_acquire);
+	    record_t& rec = out[count];
+
+	if (seq != n + 1)
+	    continue;	// overwritten or is written now
+	    uint32_t lo = slot.time_lo.load(memory_order_relaxed);
+	    uint32_t hi = slot.time_hi.load(memory_order_relaxed);
+	    uint32_t packed = slot.packed.load(memory_order_relaxed);
+
+	rec.aux = slot.aux.load(memory_order_relaxed);
+	atomic_thread_fence(memory_order_acquire);
+	if (slot.seq.load(memory_order_relaxed) != seq)
+	    continue;	// overwritten during the copy
+	rec.time = static_cast<int64_t>(static_cast<uint64_t>(hi) << 32 | lo);
+	rec.seq = n;
+	rec.source = static_cast<source_t>(packed & 0xff);
+	rec.id = packed >> 8;
+	rec.reason = packed >> 16;
+	rec.rssi = static_cast<int8_t>(packed >> 24);
+	count++;
+    }; /* for n */
+    return count;
+}; /* esp::net::wifi::trace::read() */
+
+
+/// @brief name of the event of the record
+const char* trace::name(const record_t& rec)
+{
+    if (rec.source == WIFI)
+	return rec.id < sizeof(wifi_names) / sizeof(wifi_names[0])? wifi_names[rec.id]: "WIFI_EVENT";
+    return rec.id < sizeof(ip_names) / sizeof(ip_names[0])? ip_names[rec.id]: "IP_EVENT";
+}; /* esp::net::wifi::trace::name() */
+
+
+/// @brief log the records with the decoded event names & reasons; the records are copied in the stack
+void trace::dump(const char* tag, uint32_t from)
+{
+	record_t recs[capacity];
+	size_t count = read(recs, capacity, from);
+
+    for (size_t i = 0; i < count; i++)
+    {
+	    const record_t& rec = recs[i];
+
+	if (rec.reason)
+	    ESP_LOGI(tag, "#%u %lld us %s: %s (%u), rssi %d", static_cast<unsigned>(rec.seq), static_cast<long long>(rec.time),
+		    name(rec), esp::wifi::err::reason(rec.reason), rec.reason, rec.rssi);
+	else if (rec.source == IP && rec.aux)
+	    ESP_LOGI(tag, "#%u %lld us %s: %s", static_cast<unsigned>(rec.seq), static_cast<long long>(rec.time),
+		    name(rec), esp::ip4::format(esp_ip4_addr_t{rec.aux}).c_str());
+	else
+	    ESP_LOGI(tag, "#%u %lld us %s %u", static_cast<unsigned>(rec.seq), static_cast<long long>(rec.time),
+		    name(rec), static_cast<unsigned>(rec.aux));
+    }; /* for i */
+}; /* esp::net::wifi::trace::dump() */
+
+
+/// @brief drop the records: the readers start from the next one, the ring is not touched by the reader
+void trace::clear()
+{
+    cleared_at.store(head.load(memory_order_acquire), memory_order_relaxed);
+}; /* esp::net::wifi::trace::clear() */
+
+
+/// @brief WIFI_EVENT & IP_EVENT handler: only the raw fields of the event data are taken
+void trace::on_event(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+    if (base == IP_EVENT)
+	return record(IP, id, 0, 0, id == IP_EVENT_STA_GOT_IP? static_cast<ip_event_got_ip_t*>(data)->ip_info.ip.addr: 0);
+
+    switch (id)
+    {
+    case WIFI_EVENT_STA_CONNECTED:
+	return record(WIFI, id, 0, 0, static_cast<wifi_event_sta_connected_t*>(data)->channel);
+    case WIFI_EVENT_STA_DISCONNECTED:
+	return record(WIFI, id, static_cast<wifi_event_sta_disconnected_t*>(data)->reason,
+		static_cast<wifi_event_sta_disconnected_t*>(data)->rssi);
+    case WIFI_EVENT_AP_STADISCONNECTED:
+	return record(WIFI, id, static_cast<wifi_event_ap_stadisconnected_t*>(data)->reason);
+    default:
+	return record(WIFI, id);
+    }; /* switch id */
+}; /* esp::net::wifi::trace::on_event() */
+
+
+//--[ evtrace.cpp ]----------------------------------------------------------------------------------------------------
@@ -0,0 +1,193 @@
+/*
+ * @file evloop_bench.cpp
+ *
+ * @brief Benchmark of the own event loop of the component, esp::net::wifi::evloop, on the simulated backend:
+ *	  latency from the post of the WIFI_EVENT_STA_CONNECTED up to the wake-up of the waiting subscriber
+ *	  of the esp::net::wifi::dispatcher (as the Updater::connect() waits it), while the slow handler
+ *	  of the application is registered for the same events in the default loop:
+ *	    default - the dispatcher is registered in the default loop, after the handler of the application;
+ *	    evloop  - the component loop is started before the application registers it's handler,
+ *		      the dispatcher is registered in the component loop.
+ *	  Then the synchronous & the asynchronous updates of the Updater under the same load,
+ *	  with the component loop: the success, the wrong password, the forwarded & dropped events.
+ *
+ * Usage: evloop_bench [-n events] [-l load, ms] [-s scale] [-v loglevel]
+ *
+ * All the times are in ms of the simulated time.
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "sim.hpp"
+
+using namespace std;
+using esp::net::wifi::dispatcher;
+using esp::net::wifi::evloop;
+
+
+namespace
+{
+    uint32_t load_ms = 20;	///< cost of the handler of the application, ms of the simulated time
+
+    /// the slow handler of the application
+    void app_handler(void* arg, esp_event_base_t base, int32_t id, void* data)
+    {
+	sim::sleep(load_ms);
+    }; /* app_handler() */
+
+    struct stat_t
+    {
+	double p50, p99, max;
+    }; /* struct stat_t */
+
+    stat_t stat(vector<double>& samples)
+    {
+	sort(samples.begin(), samples.end());
+	return {samples[samples.size() / 2], samples[samples.size() * 99 / 100], samples.back()};
+    }; /* stat() */
+
+    /// latency of the wake-up of the subscriber, waiting the WIFI_EVENT_STA_CONNECTED, ms
+    stat_t wakeup(unsigned n)
+    {
+	    dispatcher events;
+	    vector<double> samples;
+
+	ESP_ERROR_CHECK(events.enroll());
+	    dispatcher::queue_t* linking = events.subscribe(WIFI_EVENT, 1u << WIFI_EVENT_STA_CONNECTED);
+
+	for (unsigned i = 0; i < n; i++)
+	{
+		wifi_event_sta_connected_t data = {};
+		dispatcher::event_t ev;
+
+	    data.channel = 6;
+		int64_t start = esp_timer_get_time();
+
+	    esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, &data, sizeof(data), portMAX_DELAY);
+	    if (dispatcher::wait(*linking, ev, portMAX_DELAY) && ev.aux == 6)
+		samples.push_back((esp_timer_get_time() - start) / 1000.0);
+	    sim::settle();	// the next event is posted to the idle loops
+	}; /* for i */
+	if (samples.empty())
+	    samples.push_back(0);
+	return stat(samples);
+    }; /* wakeup() */
+
+}; /* namespace <anonymous> */
+
+
+int main(int argc, char* argv[])
+{
+	unsigned n = 100;
+	double scale = 0.1;
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+    for (int i = 1; i < argc - 1; i += 2)
+	if (strcmp(argv[i], "-n") == 0)
+	    n = atoi(argv[i + 1]);
+	else if (strcmp(argv[i], "-l") == 0)
+	    load_ms = atoi(argv[i + 1]);
+	else if (strcmp(argv[i], "-s") == 0)
+	    scale = atof(argv[i + 1]);
+	else if (strcmp(argv[i], "-v") == 0)
+	    esp_log_level_set("*", static_cast<esp_log_level_t>(atoi(argv[i + 1])));
+
+    sim::scale(scale);
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+
+	esp_event_handler_instance_t app_wifi = nullptr, app_ip = nullptr;
+
+    // the handlers of the component & of the application share the default loop
+    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID, app_handler, nullptr, &app_wifi));
+	stat_t shared = wakeup(n);
+
+    // the component loop is started first, at the init of the component
+    ESP_ERROR_CHECK(esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, app_wifi));
+    ESP_ERROR_CHECK(evloop::start());
+    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID, app_handler, nullptr, &app_wifi));
+    ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT, ESP_EVENT_ANY_ID, app_handler, nullptr, &app_ip));
+	stat_t own = wakeup(n);
+
+    printf("WIFI_EVENT_STA_CONNECTED -> wake-up of the subscriber, application handler of %u ms, %u events, ms\n", load_ms, n);
+    printf("%-10s %10s %10s %10s\n", "loop", "p50", "p99", "max");
+    printf("%-10s %10.2f %10.2f %10.2f\n", "default", shared.p50, shared.p99, shared.max);
+    printf("%-10s %10.2f %10.2f %10.2f\n", "evloop", own.p50, own.p99, own.max);
+
+	bool ok = true;
+
+    if (own.p50 >= shared.p50 || own.p50 >= load_ms / 2.0)
+    {
+	printf("wake-up with the component loop is not faster than the application handler FAILED\n");
+	ok = false;
+    }; /* if own.p50 >= shared.p50 */
+
+    // the updates of the Updater: the events are forwarded with their data
+    sim::add_ap(sim::make_ap("home", "pass1234", 6, 1, 1));
+    sim::add_ap(sim::make_ap("office", "office-pass", 11, 2, 2));
+
+	esp_netif_inherent_config_t inherent = ESP_NETIF_INHERENT_DEFAULT_WIFI_STA();
+	esp::wifi::netif_t sta(WIFI_IF_STA, inherent);
+	wifi_init_config_t wifi_init = WIFI_INIT_CONFIG_DEFAULT();
+	::net::configuration_t cfg;
+
+    ESP_ERROR_CHECK(esp::net::wifi::stack::init(&wifi_init));
+    ESP_ERROR_CHECK(esp::net::wifi::mode::set(WIFI_MODE_STA));
+    ESP_ERROR_CHECK(esp::net::wifi::stack::start());
+    cfg.login = "home";
+    cfg.passwd = "pass1234";
+    cfg.use_pwd = true;
+	esp_err_t good = sta.update(cfg);
+
+    sta.update.finalize();
+    cfg.clr_chgst();
+    cfg.passwd = "wrong-password";
+	esp_err_t bad = sta.update(cfg);
+
+    sta.update.finalize();
+    cfg.clr_chgst();
+    cfg.login = "office";
+    cfg.passwd = "office-pass";
+	esp_err_t async = sta.update.apply(cfg).wait();
+
+    sim::settle();
+	esp::net::wifi::Updater::timing_t timing[esp::net::wifi::Updater::PHASES];
+
+    sta.update.summary(timing);
+    printf("\nupdates with the component loop: %s, wrong password: %s, asynchronous: %s\n",
+	    esp_err_to_name(good), esp_err_to_name(bad), esp_err_to_name(async));
+    printf("connect phase avg %.1f ms, max %.1f ms; %u events forwarded, %u dropped\n",
+	    timing[esp::net::wifi::Updater::PH_CONNECT].avg / 1000.0, timing[esp::net::wifi::Updater::PH_CONNECT].max / 1000.0,
+	    evloop::forwarded(), evloop::dropped());
+    if (good != ESP_OK || bad != ESP_ERR_WIFI_PASSWORD || async != ESP_OK || evloop::forwarded() < n || evloop::dropped())
+    {
+	printf("updates with the component loop FAILED\n");
+	ok = false;
+    }; /* if good != ESP_OK || bad != ESP_ERR_WIFI_PASSWORD */
+
+    esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, app_wifi);
+    esp_event_handler_instance_unregister(IP_EVENT, ESP_EVENT_ANY_ID, app_ip);
+    return ok? EXIT_SUCCESS: EXIT_FAILURE;
+}; /* main() */
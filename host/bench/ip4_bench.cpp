@@ -0,0 +1,376 @@
+/*
+ * @file ip4_bench.cpp
+ *
+ * @brief Micro-benchmark of the esp::ip4 address classes: the static (CRTP) dispatch
+ *	  of the esp::ip4::base<> against the previous virtual instance() dispatch,
+ *	  kept here as the 'legacy' reference copy.
+ *
+ * Usage: ip4_bench [-n iterations]
+ *
+ * Columns - ns per operation:
+ *	compare - operator == of the two addresses
+ *	set	- set() of the new uint32_t value, with the check of the change
+ *	copy	- construction of the address from the other address
+ *	field	- set() of the ip field of the net::configuration_t (with the change tracking)
+ *
+ * The second table - the text conversions, ns per address:
+ *	format	- esp::ip4::format() to the returned text_t against the esp_ip4addr_ntoa() to the static buffer
+ *	parse	- esp::ip4::parse() of the std::string_view against the esp_ip4addr_aton() of the std::string
+ * (the esp_ip4addr_*() here are the simulated ones, snprintf/sscanf-based),
+ * then the check of the format/parse round trip & of the rejection of the incorrect texts.
+ *
+ * The third row - the netmask check, ns per mask: esp::ip4::chkmask() (popcount/ctz)
+ * against the previous loop over the shifted pattern; esp::ip4::network is checked
+ * at the compile time by the static_assert's.
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_netif.h>
+
+#include "net.h"
+
+using namespace std;
+
+
+namespace legacy
+{
+
+    ///@brief the esp::ip4 address classes with the virtual instance(), as before the CRTP
+    class base
+    {
+    public:
+	virtual ~base() {};
+
+	template <typename iptype>
+	esp_err_t set(const iptype& ipaddr) {
+	    if (instance().addr == value(ipaddr))
+		return ESP_ERR_NOT_FINISHED;
+	    instance().addr = value(ipaddr);
+	    return ESP_OK; };
+
+	static uint32_t value(uint32_t ipvalue) { return ipvalue; };
+	static uint32_t value(const base& ipaddr) { return ipaddr.instance().addr; };
+
+	friend bool operator == (const base& left, const base& right) noexcept {
+	    return left.instance().addr == right.instance().addr; };
+
+	operator const esp_ip4_addr_t&() const noexcept { return instance(); };
+
+    protected:
+	virtual esp_ip4_addr_t& instance() = 0;
+	virtual const esp_ip4_addr_t& instance() const = 0;
+
+    }; /* class legacy::base */
+
+    class address: public base
+    {
+    public:
+	address(const base &_ip): ip{static_cast<const esp_ip4_addr_t&>(_ip)} {};
+	explicit address(uint32_t ipval = 0x0): ip{ipval} {};
+	virtual ~address() {};
+
+    protected:
+	esp_ip4_addr_t& instance() override { return ip; };
+	const esp_ip4_addr_t& instance() const override { return ip; };
+
+	esp_ip4_addr_t ip;
+
+    }; /* class legacy::address */
+
+    ///@brief check of the netmask, as before the esp::ip4::network: the loop over the shifted pattern
+    bool chkmask(uint32_t mask)
+    {
+	    uint32_t pattern = (1UL << 31) - 1 /*0x7fffffff*/;
+
+	for (int i = 1; i < (32-1); i++)
+	{
+	    pattern = pattern << 1;
+	    if (mask == pattern )
+		return true;
+	}; /* for (int i = 1; i < (32-1); i++) */
+	return false;
+    }; /* legacy::chkmask() */
+
+}; /* namespace legacy */
+
+
+
+namespace
+{
+
+    /// keep the value alive for the optimizer
+    template <typename valtype>
+    inline void keep(const valtype& val) { asm volatile("" : : "g"(&val) : "memory"); };
+
+    /// hide the dynamic type of the object from the optimizer, as for the object passed from the other unit
+    template <typename valtype>
+    inline valtype& opaque(valtype& val) { valtype* ptr = &val; asm volatile("" : "+r"(ptr)); return *ptr; };
+
+    /// the run of the operations by the base class reference, as the code of the net component does
+    template <typename addr_t, typename base_t>
+    struct runs
+    {
+	__attribute__((noinline)) static double compare(const base_t& a, const base_t& b, unsigned n)
+	{
+		unsigned eq = 0;
+		auto t0 = chrono::steady_clock::now();
+	    for (unsigned i = 0; i < n; i++)
+	    {
+		eq += (a == b);
+		keep(eq);
+	    }; /* for i */
+	    return chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+	}; /* compare() */
+
+	__attribute__((noinline)) static double set(base_t& a, unsigned n)
+	{
+		auto t0 = chrono::steady_clock::now();
+	    for (unsigned i = 0; i < n; i++)
+	    {
+		a.set(i >> 1);
+		keep(a);
+	    }; /* for i */
+	    return chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+	}; /* set() */
+
+	__attribute__((noinline)) static double copy(const base_t& a, unsigned n)
+	{
+		auto t0 = chrono::steady_clock::now();
+	    for (unsigned i = 0; i < n; i++)
+	    {
+		addr_t c(a);
+		keep(c);
+	    }; /* for i */
+	    return chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+	}; /* copy() */
+
+    }; /* struct runs */
+
+    const char* const samples[] = {
+	"192.168.1.1", "10.0.0.254", "172.16.31.7", "255.255.255.0", "0.0.0.0", "8.8.4.4", "100.64.12.200", "1.2.3.4" };
+    constexpr unsigned nsamples = sizeof(samples) / sizeof(samples[0]);
+
+    const char* const malformed[] = {
+	"", "1.2.3", "1.2.3.4.", ".1.2.3", "1..2.3", "256.1.1.1", "1.2.3.1000", "1.2.3.a", "1.2.3.4 ", "0001.2.3.4",
+	"1.2.3.4.5", "999.999.999.999", "010.1.2.3", "1.2.3.00" };
+
+    /// text conversions: the esp::ip4 against the esp_ip4addr_*() calls
+    void text(unsigned n)
+    {
+	    esp_ip4_addr_t addrs[nsamples];
+	    string strs[nsamples];
+	    string_view views[nsamples];
+	    double lfmt, cfmt, lprs, cprs;
+
+	for (unsigned i = 0; i < nsamples; i++)
+	{
+	    strs[i] = samples[i];
+	    views[i] = samples[i];
+	    addrs[i].addr = esp_ip4addr_aton(samples[i]);
+	}; /* for i */
+
+	{
+		static char buf[] = "xxx.xxx.xxx.xxx";
+		auto t0 = chrono::steady_clock::now();
+	    for (unsigned i = 0; i < n; i++)
+		keep(*esp_ip4addr_ntoa(&addrs[i % nsamples], buf, sizeof(buf)));
+	    lfmt = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+	}
+	{
+		auto t0 = chrono::steady_clock::now();
+	    for (unsigned i = 0; i < n; i++)
+	    {
+		esp::ip4::text_t txt = esp::ip4::format(addrs[i % nsamples]);
+		keep(txt);
+	    }; /* for i */
+	    cfmt = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+	}
+	{
+		auto t0 = chrono::steady_clock::now();
+	    for (unsigned i = 0; i < n; i++)
+	    {
+		uint32_t addr = esp_ip4addr_aton(strs[i % nsamples].c_str());
+		keep(addr);
+	    }; /* for i */
+	    lprs = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+	}
+	{
+		auto t0 = chrono::steady_clock::now();
+	    for (unsigned i = 0; i < n; i++)
+	    {
+		uint32_t addr = 0;
+		esp::ip4::parse(views[i % nsamples], addr);
+		keep(addr);
+	    }; /* for i */
+	    cprs = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+	}
+
+	printf("%-8s %8s %8s\n", "text", "format", "parse");
+	printf("%-8s %8.3f %8.3f\n", "esp_ip4", lfmt, lprs);
+	printf("%-8s %8.3f %8.3f\n", "ip4", cfmt, cprs);
+    }; /* text() */
+
+    /// round trip of the samples & rejection of the malformed texts
+    bool text_check()
+    {
+	    bool ok = true;
+
+	for (auto sample: samples)
+	{
+		uint32_t addr = 0;
+		esp_ip4_addr_t ip;
+
+	    ip.addr = esp_ip4addr_aton(sample);
+	    if (!esp::ip4::parse(sample, addr) || addr != ip.addr
+		    || strcmp(esp::ip4::format(ip).c_str(), sample) != 0 || esp::ip4::format(ip).size() != strlen(sample))
+	    {
+		printf("esp::ip4 text round trip of \"%s\" FAILED\n", sample);
+		ok = false;
+	    }; /* if !parse() */
+	}; /* for sample */
+
+	for (auto sample: malformed)
+	{
+		uint32_t addr = 0x5a5a5a5a;
+
+	    if (esp::ip4::parse(sample, addr) || addr != 0x5a5a5a5a)
+	    {
+		printf("esp::ip4 parse of the malformed \"%s\" is not rejected\n", sample);
+		ok = false;
+	    }; /* if parse() */
+	}; /* for sample */
+
+	if (esp::ip4::value(string("10.1.2.3")) != esp::ip4::address(string_view("10.1.2.3"))
+		|| esp::ip4::value("10.1.2") != 0xffffffffUL)
+	{
+	    printf("esp::ip4::value() of the text FAILED\n");
+	    ok = false;
+	}; /* if value() */
+	return ok;
+    }; /* text_check() */
+
+    using esp::ip4::network;
+
+    constexpr uint32_t addr(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+	return esp::ip4::hton(uint32_t(a) << 24 | uint32_t(b) << 16 | uint32_t(c) << 8 | d); };
+
+    constexpr network lan = network::prefix(addr(192, 168, 1, 77), 24);
+    constexpr network wide = network::prefix(addr(192, 168, 0, 0), 16);
+    constexpr network other = network::prefix(addr(10, 0, 0, 0), 8);
+    constexpr network p2p = network::prefix(addr(172, 16, 0, 6), 31);
+
+    static_assert(lan.valid() && lan.length() == 24, "esp::ip4::network prefix");
+    static_assert(lan.net() == addr(192, 168, 1, 0) && lan.broadcast() == addr(192, 168, 1, 255), "esp::ip4::network bounds");
+    static_assert(lan.first() == addr(192, 168, 1, 1) && lan.last() == addr(192, 168, 1, 254) && lan.hosts() == 254,
+		  "esp::ip4::network host range");
+    static_assert(p2p.first() == addr(172, 16, 0, 6) && p2p.last() == addr(172, 16, 0, 7) && p2p.hosts() == 2,
+		  "esp::ip4::network /31 host range");
+    static_assert(lan.contains(addr(192, 168, 1, 200)) && !lan.contains(addr(192, 168, 2, 1)), "esp::ip4::network contains address");
+    static_assert(wide.contains(lan) && !lan.contains(wide), "esp::ip4::network contains subnet");
+    static_assert(lan.overlaps(wide) && wide.overlaps(lan) && !lan.overlaps(other), "esp::ip4::network overlap");
+    static_assert(lan == network(addr(192, 168, 1, 0), addr(255, 255, 255, 0)), "esp::ip4::network equality");
+    static_assert(!network(addr(10, 0, 0, 1), addr(255, 0, 255, 0)).valid(), "esp::ip4::network non-contiguous mask");
+    static_assert(esp::ip4::chkmask(addr(255, 255, 255, 0)) && esp::ip4::chkmask(addr(255, 255, 255, 254))
+		  && !esp::ip4::chkmask(addr(255, 255, 255, 255)) && !esp::ip4::chkmask(0)
+		  && !esp::ip4::chkmask(addr(255, 255, 0, 255)), "esp::ip4::chkmask()");
+    static_assert(esp::ip4::info(addr(192, 168, 1, 10), addr(192, 168, 1, 1), addr(255, 255, 255, 0)).consistent()
+		  && !esp::ip4::info(addr(192, 168, 1, 10), addr(192, 168, 2, 1), addr(255, 255, 255, 0)).consistent(),
+		  "esp::ip4::info::consistent()");
+
+    /// netmask check: the esp::ip4::chkmask() against the legacy loop
+    void masks(unsigned n)
+    {
+	    uint32_t samples[33];
+	    double lchk, cchk;
+
+	for (unsigned len = 0; len <= 32; len++)
+	    samples[len] = network::prefix(0, len).mask();
+	{
+		unsigned ok = 0;
+		auto t0 = chrono::steady_clock::now();
+	    for (unsigned i = 0; i < n; i++)
+	    {
+		ok += legacy::chkmask(esp::ip4::ntoh(samples[i % 33]));
+		keep(ok);
+	    }; /* for i */
+	    lchk = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+	}
+	{
+		unsigned ok = 0;
+		auto t0 = chrono::steady_clock::now();
+	    for (unsigned i = 0; i < n; i++)
+	    {
+		ok += esp::ip4::chkmask(samples[i % 33]);
+		keep(ok);
+	    }; /* for i */
+	    cchk = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+	}
+	printf("%-8s %8s %8s\n", "netmask", "loop", "popcount");
+	printf("%-8s %8.3f %8.3f\n", "chkmask", lchk, cchk);
+    }; /* masks() */
+
+}; /* namespace <anonymous> */
+
+
+int main(int argc, char* argv[])
+{
+	unsigned n = 50000000;
+
+    for (int i = 1; i < argc - 1; i += 2)
+	if (strcmp(argv[i], "-n") == 0)
+	    n = atoi(argv[i + 1]);
+
+	legacy::address la(0x0101a8c0), lb(0x0201a8c0);
+	esp::ip4::address ca(0x0101a8c0), cb(0x0201a8c0);
+	net::configuration_t cfg(false, 0x0101a8c0, 0u, 0u, false, "", "");
+	auto& fa = cfg.ip;
+
+	typedef runs<legacy::address, legacy::base> lruns;
+	typedef runs<esp::ip4::address, esp::ip4::base<esp::ip4::address>> cruns;
+
+	double lcmp = lruns::compare(opaque(la), opaque(lb), n), ccmp = cruns::compare(opaque(ca), opaque(cb), n);
+	double lset = lruns::set(opaque(la), n), cset = cruns::set(opaque(ca), n);
+	double lcpy = lruns::copy(opaque(la), n), ccpy = cruns::copy(opaque(ca), n);
+	double fset;
+    {
+	    auto t0 = chrono::steady_clock::now();
+	for (unsigned i = 0; i < n; i++)
+	{
+	    fa.set(i >> 1);
+	    keep(fa);
+	}; /* for i */
+	fset = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+    }
+
+    printf("esp::ip4 address, %u iterations, ns/op\n", n);
+    printf("%-8s %6s %8s %8s %8s %8s\n", "dispatch", "size", "compare", "set", "copy", "field");
+    printf("%-8s %6zu %8.3f %8.3f %8.3f %8s\n", "virtual", sizeof(legacy::address), lcmp, lset, lcpy, "-");
+    printf("%-8s %6zu %8.3f %8.3f %8.3f %8.3f\n", "crtp", sizeof(esp::ip4::address), ccmp, cset, ccpy, fset);
+
+    text(n / 10);
+    masks(n / 10);
+
+	constexpr esp::ip4::address probe(0x0101a8c0);
+	static_assert(probe == 0x0101a8c0u, "esp::ip4::address is not constexpr");
+
+    if (ca.set(0x0301a8c0) != ESP_OK || ca.set(0x0301a8c0) != ESP_ERR_NOT_FINISHED || ca != esp::ip4::address(0x0301a8c0))
+    {
+	printf("esp::ip4::address set/compare check FAILED\n");
+	return EXIT_FAILURE;
+    }; /* if ca.set() */
+    if (!text_check())
+	return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}; /* main() */
@@ -0,0 +1,210 @@
+/*
+ * @file lpm_bench.cpp
+ *
+ * @brief Benchmark of the esp::ip4::lpm_table (longest-prefix-match trie) against the linear scan
+ *	  of the esp::ip4::network list: single & bulk lookup, ns per address;
+ *	  the check of the identity of the results & of the esp::ip4::acl_table decisions.
+ *
+ * Usage: lpm_bench [-n lookups] [-r networks]
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <esp_netif.h>
+
+#include "net.h"
+
+using namespace std;
+using esp::ip4::network;
+using esp::ip4::lpm_t;
+
+
+namespace
+{
+
+    constexpr size_t maxroutes = 64;
+
+    /// deterministic pseudo-random sequence
+    struct lcg_t
+    {
+	uint32_t state = 12345;
+	uint32_t operator()() { state = state * 1664525 + 1013904223; return state; };
+    }; /* struct lcg_t */
+
+    /// the network of the linear scan list
+    struct route_t
+    {
+	network		net;
+	lpm_t::value_t	value;
+    }; /* struct route_t */
+
+    /// the most specific network of the list, by the scan of the all list
+    lpm_t::value_t scan(const vector<route_t>& list, uint32_t addr)
+    {
+	    lpm_t::value_t best = lpm_t::none;
+	    int bestlen = -1;
+
+	for (const auto& route: list)
+	    if (route.net.contains(addr) && int(route.net.length()) > bestlen)
+	    {
+		best = route.value;
+		bestlen = route.net.length();
+	    }; /* if contains() */
+	return best;
+    }; /* scan() */
+
+    template <typename fn_t>
+    double time(unsigned n, fn_t fn)
+    {
+	    auto t0 = chrono::steady_clock::now();
+	fn();
+	return chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+    }; /* time() */
+
+}; /* namespace <anonymous> */
+
+
+int main(int argc, char* argv[])
+{
+	unsigned n = 2000000;
+	unsigned nroutes = 48;
+	lcg_t rnd;
+	vector<route_t> list;
+	static esp::ip4::lpm_table<maxroutes, 256> table;
+
+    for (int i = 1; i < argc - 1; i += 2)
+	if (strcmp(argv[i], "-n") == 0)
+	    n = atoi(argv[i + 1]);
+	else if (strcmp(argv[i], "-r") == 0)
+	    nroutes = atoi(argv[i + 1]);
+    if (nroutes > maxroutes)
+	nroutes = maxroutes;
+
+    // networks: the local /16 with the nested subnets, the random ones & the default route
+    list.push_back({network::prefix(esp::ip4::hton(0xc0a80000), 16), 0});
+    list.push_back({network::prefix(0, 0), 1});
+    while (list.size() < nroutes)
+    {
+	    unsigned len = 8 + rnd() % 23;
+	    uint32_t addr = rnd();
+
+	if (list.size() % 3 == 0)	// nested in the local /16
+	    addr = 0xc0a80000 | (addr & 0xffff), len = 17 + len % 14;
+	    network net = network::prefix(esp::ip4::hton(addr), len);
+	    bool dup = false;
+
+	for (const auto& route: list)
+	    dup |= route.net == net;
+	if (!dup)
+	    list.push_back({net, lpm_t::value_t(list.size())});
+    }; /* while list.size() < nroutes */
+
+    for (const auto& route: list)
+	if (table.add(route.net, route.value) != ESP_OK)
+	{
+	    printf("esp::ip4::lpm_table::add() of the network %u FAILED\n", route.value);
+	    return EXIT_FAILURE;
+	}; /* if add() != ESP_OK */
+
+	vector<uint32_t> addrs(4096);
+	vector<lpm_t::value_t> expect(addrs.size()), res(addrs.size());
+
+    for (size_t i = 0; i < addrs.size(); i++)
+    {
+	    const network& net = list[rnd() % list.size()].net;
+
+	// half of the addresses - inside of the networks of the list, the rest - random
+	addrs[i] = i & 1? rnd(): esp::ip4::hton(esp::ip4::ntoh(net.net()) | (rnd() & ~esp::ip4::ntoh(net.mask())));
+	expect[i] = scan(list, addrs[i]);
+    }; /* for i */
+
+	unsigned rounds = n / addrs.size() + 1;
+	unsigned total = rounds * addrs.size();
+	unsigned sink = 0;
+
+	unsigned scanrounds = rounds / 16 + 1;	// the scan is slow, the part of the rounds
+	double tscan = time(scanrounds * addrs.size(), [&]{
+	    for (unsigned r = 0; r < scanrounds; r++)
+		for (auto addr: addrs)
+		    sink += scan(list, addr); });
+	double tone = time(total, [&]{
+	    for (unsigned r = 0; r < rounds; r++)
+		for (auto addr: addrs)
+		    sink += table.lookup(addr); });
+	double tbulk = time(total, [&]{
+	    for (unsigned r = 0; r < rounds; r++)
+	    {
+		table.lookup(addrs.data(), res.data(), addrs.size());
+		sink += res[r % res.size()];
+	    }; /* for r */ });
+
+    printf("esp::ip4::lpm_table, %zu networks, %zu trie nodes (%zu bytes), %u lookups, ns/address\n",
+	    table.size(), table.nodes(), table.nodes() * 64, total);
+    printf("%-8s %8s %8s %8s\n", "lookup", "scan", "single", "bulk");
+    printf("%-8s %8.3f %8.3f %8.3f\n", "ns", tscan, tone, tbulk);
+    if (!sink)
+	printf("\n");
+
+	bool ok = true;
+
+    table.lookup(addrs.data(), res.data(), addrs.size());
+    for (size_t i = 0; i < addrs.size(); i++)
+	if (res[i] != expect[i] || table.lookup(addrs[i]) != expect[i])
+	{
+	    printf("esp::ip4::lpm_table lookup of %s: %u, expected %u\n",
+		    esp::ip4::format(esp_ip4_addr_t{addrs[i]}).c_str(), res[i], expect[i]);
+	    ok = false;
+	    break;
+	}; /* if res[i] != expect[i] */
+
+    // removal: the rest networks are found, as by the scan without the removed one
+    for (unsigned k = 0; k < 3 && list.size() > 2; k++)
+    {
+	    size_t victim = 2 + rnd() % (list.size() - 2);
+
+	if (table.remove(list[victim].net) != ESP_OK || table.remove(list[victim].net) != ESP_ERR_NOT_FOUND)
+	    ok = false;
+	list.erase(list.begin() + victim);
+    }; /* for k */
+    for (auto addr: addrs)
+	if (table.lookup(addr) != scan(list, addr))
+	{
+	    printf("esp::ip4::lpm_table lookup after the removal FAILED\n");
+	    ok = false;
+	    break;
+	}; /* if lookup() != scan() */
+
+	esp::ip4::acl_table<8> acl;
+	esp::ip4::lpm_table<2, 2> tiny;
+
+    acl.allow(network::prefix(esp::ip4::hton(0xc0a80100), 24));
+    acl.deny(network::prefix(esp::ip4::hton(0xc0a80180), 25));
+    if (!acl.permits(esp::ip4::hton(0xc0a80105)) || acl.permits(esp::ip4::hton(0xc0a80185))
+	    || acl.permits(esp::ip4::hton(0x08080808)) || acl.allow(network(0, esp::ip4::hton(0xff00ff00))) != ESP_ERR_INVALID_ARG)
+    {
+	printf("esp::ip4::acl_table decisions FAILED\n");
+	ok = false;
+    }; /* if !acl.permits() */
+
+    if (tiny.add(network::prefix(esp::ip4::hton(0x0a000000), 8), 1) != ESP_OK
+	    || tiny.add(network::prefix(esp::ip4::hton(0x0a010000), 16), 2) != ESP_ERR_NO_MEM
+	    || tiny.lookup(esp::ip4::hton(0x0a010203)) != 1 || tiny.size() != 1)
+    {
+	printf("esp::ip4::lpm_table out of nodes FAILED\n");
+	ok = false;
+    }; /* if tiny.add() */
+
+    return ok? EXIT_SUCCESS: EXIT_FAILURE;
+}; /* main() */
@@ -0,0 +1,228 @@
+/*
+ * @file state_bench.cpp
+ *
+ * @brief Benchmark of the esp::net::wifi::state snapshot on the simulated backend: reads per second
+ *	  of the ip/mask/gateway by the several concurrent readers, while the IP_EVENT_STA_GOT_IP
+ *	  are published continuously, against the same reads by the netif_t::Config_t ip(), mask() & gate()
+ *	  (three esp_netif_get_ip_info() round trips under the lock of the backend);
+ *	  the check, that the snapshot is never torn & never calls the backend,
+ *	  then the snapshot after the real connection, the poll() & the failed update.
+ *
+ * Usage: state_bench [-t ms of the each run] [-r max readers] [-v loglevel]
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "sim.hpp"
+
+using namespace std;
+using esp::net::wifi::state;
+
+
+namespace
+{
+    constexpr uint32_t salt = 0x5a5a5a5a;
+
+    /// the fields of the synthetic address are derived from the number: the torn snapshot is detected
+    void got_ip(uint32_t i)
+    {
+	    ip_event_got_ip_t ev = {};
+
+	ev.ip_info.ip.addr = i;
+	ev.ip_info.netmask.addr = ~i;
+	ev.ip_info.gw.addr = i ^ salt;
+	esp_event_post(IP_EVENT, IP_EVENT_STA_GOT_IP, &ev, sizeof(ev), portMAX_DELAY);
+    }; /* got_ip() */
+
+    /// count of the trace records of the backend call
+    unsigned calls(const char* what)
+    {
+	    unsigned count = 0;
+
+	for (auto& rec: sim::trace())
+	    count += strcmp(rec.what, what) == 0;
+	return count;
+    }; /* calls() */
+
+    struct run_t
+    {
+	double	 rate;		///< reads per second of the all readers
+	double	 ns;		///< ns per read of the one reader
+	unsigned torn;
+    }; /* struct run_t */
+
+    /// the readers read the ip/mask/gate during the 'ms', the writer publishes the synthetic addresses
+    run_t run(unsigned nreaders, unsigned ms, function<void(esp_netif_ip_info_t&)> read, bool checked)
+    {
+	    atomic<bool> stop(false);
+	    atomic<unsigned> torn(0);
+	    atomic<uint64_t> reads(0);
+	    vector<thread> readers;
+	    thread writer([&]{
+		    uint32_t i = 1;
+
+		while (!stop.load(memory_order_relaxed))
+		{
+		    got_ip(i++);
+		    if (i % 64 == 0)
+			sim::settle();	// the queue of the loop is not grown unbounded
+		}; /* while !stop */ });
+
+	for (unsigned r = 0; r < nreaders; r++)
+	    readers.emplace_back([&]{
+		    uint64_t count = 0;
+		    esp_netif_ip_info_t ip;
+
+		while (!stop.load(memory_order_relaxed))
+		{
+		    read(ip);
+		    torn += checked && ip.ip.addr && (ip.netmask.addr != ~ip.ip.addr || ip.gw.addr != (ip.ip.addr ^ salt));
+		    count++;
+		}; /* while !stop */
+		reads += count; });
+
+	this_thread::sleep_for(chrono::milliseconds(ms));
+	stop = true;
+	writer.join();
+	for (auto& th: readers)
+	    th.join();
+	sim::settle();
+
+	    double rate = reads.load() * 1000.0 / ms;
+
+	return {rate, nreaders * 1e9 / rate, torn.load()};
+    }; /* run() */
+
+}; /* namespace <anonymous> */
+
+
+int main(int argc, char* argv[])
+{
+	unsigned ms = 200;
+	unsigned maxreaders = 4;
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+    for (int i = 1; i < argc - 1; i += 2)
+	if (strcmp(argv[i], "-t") == 0)
+	    ms = atoi(argv[i + 1]);
+	else if (strcmp(argv[i], "-r") == 0)
+	    maxreaders = atoi(argv[i + 1]);
+	else if (strcmp(argv[i], "-v") == 0)
+	    esp_log_level_set("*", static_cast<esp_log_level_t>(atoi(argv[i + 1])));
+
+    sim::scale(0.01);
+    sim::add_ap(sim::make_ap("home", "pass1234", 6, 1, 1));
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+
+	esp_netif_inherent_config_t inherent = ESP_NETIF_INHERENT_DEFAULT_WIFI_STA();
+	esp::wifi::netif_t sta(WIFI_IF_STA, inherent);
+	bool ok = true;
+	state::snapshot_t seed;
+
+    state::get(seed);
+    if (state::version() == 0 || seed.dhcp != sta.dhcp.client.status())
+    {
+	printf("the snapshot is not seeded by the creation of the station netif FAILED\n");
+	ok = false;
+    }; /* if state::version() == 0 */
+
+    printf("ip/mask/gateway reads with the IP_EVENT_STA_GOT_IP published continuously, %u ms per run\n", ms);
+    printf("%-8s %14s %10s %14s %10s %8s\n", "readers", "snapshot/s", "ns/read", "Config_t/s", "ns/read", "torn");
+    for (unsigned nreaders = 1; nreaders <= maxreaders; nreaders *= 2)
+    {
+	sim::trace_clear();
+	    run_t snap = run(nreaders, ms, [](esp_netif_ip_info_t& ip){ ip = state::info(); }, true);
+	    unsigned backend = calls("esp_netif_get_ip_info");
+
+	sim::trace_clear();
+	    run_t netif = run(nreaders, ms, [&sta](esp_netif_ip_info_t& ip){
+		ip.ip = sta.cfg.ip(); ip.netmask = sta.cfg.mask(); ip.gw = sta.cfg.gate(); }, false);
+
+	sim::trace_clear();
+	printf("%-8u %14.0f %10.1f %14.0f %10.1f %8u\n", nreaders, snap.rate, snap.ns, netif.rate, netif.ns, snap.torn);
+	if (snap.torn || backend)
+	{
+	    printf("the snapshot is torn or calls the backend (%u calls) FAILED\n", backend);
+	    ok = false;
+	}; /* if snap.torn || backend */
+	if (snap.rate <= netif.rate)
+	{
+	    printf("the snapshot is not faster than the netif FAILED\n");
+	    ok = false;
+	}; /* if snap.rate <= netif.rate */
+    }; /* for nreaders */
+    printf("retries of the readers: %u, publications: %u\n", state::retries(), state::version());
+
+    // the snapshot of the real connection
+	wifi_init_config_t wifi_init = WIFI_INIT_CONFIG_DEFAULT();
+	::net::configuration_t cfg;
+	state::snapshot_t st;
+
+    ESP_ERROR_CHECK(esp::net::wifi::stack::init(&wifi_init));
+    ESP_ERROR_CHECK(esp::net::wifi::mode::set(WIFI_MODE_STA));
+    ESP_ERROR_CHECK(esp::net::wifi::stack::start());
+    cfg.login = "home";
+    cfg.passwd = "pass1234";
+    cfg.use_pwd = true;
+	esp_err_t good = sta.update(cfg);
+
+    sta.update.finalize();
+    cfg.clr_chgst();
+    sim::settle();
+    state::poll();
+    state::get(st);
+
+	esp::ip4::info actual = sta.cfg.get();
+
+    printf("\nconnected: %s, link %d, got_ip %d, ip %s, dhcp %d, bssid ..:%02x, channel %u, rssi %d\n",
+	    esp_err_to_name(good), st.link, st.got_ip, esp::ip4::format(st.ip.ip).c_str(), st.dhcp,
+	    st.bssid[5], st.channel, st.rssi);
+    if (good != ESP_OK || !st.link || !st.got_ip || st.ip.ip.addr != actual.ip.addr || st.ip.gw.addr != actual.gw.addr
+	    || st.dhcp != ESP_NETIF_DHCP_STARTED || st.bssid[5] != 1 || st.channel != 6 || st.rssi != -50)
+    {
+	printf("the snapshot of the connection FAILED\n");
+	ok = false;
+    }; /* if !st.link */
+
+	uint32_t before = state::version();
+
+    cfg.passwd = "wrong-password";
+	esp_err_t bad = sta.update(cfg);
+
+    sta.update.finalize();
+    sim::settle();
+    state::get(st);
+    printf("wrong password: %s, %u publications, link %d, got_ip %d\n",
+	    esp_err_to_name(bad), state::version() - before, st.link, st.got_ip);
+    if (bad == ESP_OK || state::version() == before || !st.link || !st.got_ip || st.ip.ip.addr != sta.cfg.get().ip.addr)
+    {
+	printf("the snapshot after the rollback FAILED\n");
+	ok = false;
+    }; /* if bad == ESP_OK */
+
+    return ok? EXIT_SUCCESS: EXIT_FAILURE;
+}; /* main() */
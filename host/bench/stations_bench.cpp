@@ -0,0 +1,252 @@
+/*
+ * @file stations_bench.cpp
+ *
+ * @brief Benchmark of the esp::net::wifi::stations registry on the simulated backend with the soft-AP
+ *	  at the max connections: ns per lookup of the station by the MAC in the hash against the lookup
+ *	  by the esp_wifi_ap_get_sta_list() & the scan of the list, at the connected stations only
+ *	  & at the registry full of the disconnected ones; then the AID, the assigned address,
+ *	  the disconnection reason, the RSSI EWMA of the poll(), the silent leave & the eviction.
+ *
+ * Usage: stations_bench [-n lookups] [-v loglevel]
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "sim.hpp"
+
+using namespace std;
+using esp::net::wifi::stations;
+
+
+namespace
+{
+    constexpr size_t maxconn = ESP_WIFI_MAX_CONN_NUM;
+
+    void make_mac(uint32_t id, uint8_t mac[6])
+    {
+	    uint8_t oui[3] = {0xa4, 0xcf, 0x12};
+
+	memcpy(mac, oui, sizeof(oui));
+	mac[3] = id >> 16;
+	mac[4] = id >> 8;
+	mac[5] = id;
+    }; /* make_mac() */
+
+    /// the lookup as by the station list of the driver: esp_wifi_ap_get_sta_list() & the scan of it
+    bool scan(const uint8_t mac[6], int8_t& rssi)
+    {
+	    wifi_sta_list_t list;
+
+	if (esp_wifi_ap_get_sta_list(&list) != ESP_OK)
+	    return false;
+	for (int i = 0; i < list.num; i++)
+	    if (memcmp(list.sta[i].mac, mac, 6) == 0)
+	    {
+		rssi = list.sta[i].rssi;
+		return true;
+	    }; /* if list.sta[i].mac == mac */
+	return false;
+    }; /* scan() */
+
+    struct run_t
+    {
+	double	 hash;		///< ns per lookup by the stations::find()
+	double	 list;		///< ns per lookup by the esp_wifi_ap_get_sta_list()
+	unsigned missed;	///< the connected stations, not found by the hash
+    }; /* struct run_t */
+
+    /// the lookups of the random connected stations
+    run_t lookups(const uint32_t ids[], size_t nids, unsigned n, mt19937& rng)
+    {
+	    run_t run{0, 0, 0};
+	    uint8_t mac[6];
+	    stations::station_t st;
+	    int8_t rssi;
+	    uint64_t sink = 0;
+
+	    auto start = chrono::steady_clock::now();
+
+	for (unsigned i = 0; i < n; i++)
+	{
+	    make_mac(ids[rng() % nids], mac);
+	    run.missed += !stations::find(mac, st) || !st.connected;
+	    sink += st.aid;
+	}; /* for i */
+	run.hash = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / n;
+
+	start = chrono::steady_clock::now();
+	for (unsigned i = 0; i < n; i++)
+	{
+	    make_mac(ids[rng() % nids], mac);
+	    sink += scan(mac, rssi);
+	}; /* for i */
+	run.list = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / n;
+	sim::trace_clear();
+	if (!sink)
+	    run.missed++;
+	return run;
+    }; /* lookups() */
+
+}; /* namespace <anonymous> */
+
+
+int main(int argc, char* argv[])
+{
+	unsigned n = 200000;
+	mt19937 rng(2026);
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+    for (int i = 1; i < argc - 1; i += 2)
+	if (strcmp(argv[i], "-n") == 0)
+	    n = atoi(argv[i + 1]);
+	else if (strcmp(argv[i], "-v") == 0)
+	    esp_log_level_set("*", static_cast<esp_log_level_t>(atoi(argv[i + 1])));
+
+    sim::scale(0.01);
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+    ESP_ERROR_CHECK(stations::enroll());
+
+	esp_netif_inherent_config_t inherent = ESP_NETIF_INHERENT_DEFAULT_WIFI_AP();
+	esp::wifi::netif_t ap(WIFI_IF_AP, inherent);
+	wifi_init_config_t wifi_init = WIFI_INIT_CONFIG_DEFAULT();
+	uint32_t ids[maxconn];
+	uint8_t mac[6];
+	stations::station_t st;
+	bool ok = true;
+
+    ESP_ERROR_CHECK(esp::net::wifi::stack::init(&wifi_init));
+    ESP_ERROR_CHECK(esp::net::wifi::mode::set(WIFI_MODE_AP));
+    ESP_ERROR_CHECK(esp::net::wifi::stack::start());
+    ESP_ERROR_CHECK(ap.dhcp.server.pool(ESP_IP4TOADDR(192, 168, 4, 100), ESP_IP4TOADDR(192, 168, 4, 199)));
+
+    // the soft-AP at the max connections
+	unsigned joined = 0;
+
+    for (size_t i = 0; i < maxconn; i++)
+    {
+	ids[i] = 0x1000 + i * 0x35;
+	make_mac(ids[i], mac);
+	joined += sim::ap_join(mac, -40 - i);
+    }; /* for i */
+    make_mac(0xffff, mac);
+	bool over = sim::ap_join(mac);
+
+    sim::settle();
+
+	unsigned assigned = 0, aids = 0;
+
+    for (size_t i = 0; i < maxconn; i++)
+    {
+	make_mac(ids[i], mac);
+	if (stations::find(mac, st))
+	{
+	    aids += st.aid == i + 1;
+	    assigned += st.ip == ESP_IP4TOADDR(192, 168, 4, 100 + i) && st.connected;
+	}; /* if stations::find() */
+    }; /* for i */
+    printf("soft-AP at the max connections: %u joined (%s over the max), %zu connected, %u AID, %u assigned addresses\n",
+	    joined, over? "joined": "refused", stations::connected(), aids, assigned);
+    if (joined != maxconn || over || stations::connected() != maxconn || aids != maxconn || assigned != maxconn)
+    {
+	printf("the stations of the events FAILED\n");
+	ok = false;
+    }; /* if joined != maxconn */
+
+	run_t conn = lookups(ids, maxconn, n, rng);
+
+    // the registry is filled by the disconnected stations: the lookups probe the longer chains,
+    // the oldest disconnected stations are replaced
+	unsigned churn = stations::capacity * 4;
+	uint32_t last = 0x20000 + churn - 1;
+
+    make_mac(ids[maxconn - 1], mac);
+    sim::ap_leave(mac, WIFI_REASON_ASSOC_LEAVE);
+    for (uint32_t id = 0x20000; id <= last; id++)
+    {
+	make_mac(id, mac);
+	sim::ap_join(mac);
+	sim::settle();
+	if (id != last)
+	    sim::ap_leave(mac, WIFI_REASON_ASSOC_LEAVE);
+	sim::settle();
+    }; /* for id */
+    make_mac(last, mac);
+
+	bool latest = stations::find(mac, st) && st.connected;
+	bool oldest;
+
+    make_mac(0x20000, mac);
+    oldest = stations::find(mac, st);
+
+	run_t full = lookups(ids, maxconn - 1, n, rng);
+
+    printf("\nlookups of the station by the MAC, %u lookups, ns per lookup\n", n);
+    printf("%-28s %10s %16s %8s\n", "registry", "hash", "get_sta_list", "missed");
+    printf("%-28s %10.1f %16.1f %8u\n", "connected only", conn.hash, conn.list, conn.missed);
+    printf("%-28s %10.1f %16.1f %8u\n", "full of the disconnected", full.hash, full.list, full.missed);
+    printf("evicted: %u, dropped: %u\n", stations::evicted(), stations::dropped());
+    if (conn.missed || full.missed || conn.hash >= conn.list || full.hash >= full.list)
+    {
+	printf("the lookup by the hash is not faster or misses the stations FAILED\n");
+	ok = false;
+    }; /* if conn.missed */
+    if (!latest || oldest || stations::evicted() != maxconn + churn - stations::capacity || stations::dropped())
+    {
+	printf("the oldest disconnected station is not replaced FAILED\n");
+	ok = false;
+    }; /* if !latest */
+
+    // the disconnection reason, the RSSI EWMA & the silent leave
+    make_mac(ids[0], mac);
+    sim::ap_leave(mac, WIFI_REASON_AUTH_EXPIRE);
+    sim::settle();
+
+	bool reason = stations::find(mac, st) && !st.connected && st.reason == WIFI_REASON_AUTH_EXPIRE && st.left
+		&& stations::connected() == maxconn - 1;
+
+    make_mac(ids[1], mac);
+    sim::ap_rssi(mac, -80);
+    for (int i = 0; i < 12; i++)
+	stations::poll();
+
+	int8_t rssi = stations::find(mac, st)? st.rssi: 0;
+
+    make_mac(ids[2], mac);
+    sim::ap_leave(mac, WIFI_REASON_ASSOC_LEAVE, false);
+    stations::poll();
+
+	bool silent = stations::find(mac, st) && !st.connected && st.reason == 0;
+
+    printf("\ndisconnection reason %s, RSSI EWMA -41 -> -80: %d after 12 polls, silent leave %s by the poll\n",
+	    reason? "kept": "lost", rssi, silent? "found": "missed");
+    if (!reason || rssi > -78 || rssi < -80 || !silent)
+    {
+	printf("the reason, the RSSI or the poll FAILED\n");
+	ok = false;
+    }; /* if !reason */
+
+    return ok? EXIT_SUCCESS: EXIT_FAILURE;
+}; /* main() */
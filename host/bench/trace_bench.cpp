@@ -0,0 +1,198 @@
+/*
+ * @file trace_bench.cpp
+ *
+ * @brief Benchmark of the esp::net::wifi::trace event ring: ns per record of the producer,
+ *	  the check of the consistency of the records, read concurrently by the several readers,
+ *	  and the trace of the real connection & failed connection on the simulated backend.
+ *
+ * Usage: trace_bench [-n records] [-r readers] [-v loglevel]
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "sim.hpp"
+
+using namespace std;
+using esp::net::wifi::trace;
+
+
+namespace
+{
+
+    /// the fields of the synthetic record are derived from it's number: the torn record is detected
+    void synthetic(uint32_t i)
+    {
+	trace::record(trace::WIFI, i & 0xff, (i >> 8) & 0xff, static_cast<int8_t>(i >> 16), ~i);
+    }; /* synthetic() */
+
+    bool consistent(const trace::record_t& rec, uint32_t base)
+    {
+	    uint32_t i = rec.seq - base;
+
+	return rec.aux == ~i && rec.id == (i & 0xff) && rec.reason == ((i >> 8) & 0xff)
+		&& rec.rssi == static_cast<int8_t>(i >> 16) && rec.source == trace::WIFI;
+    }; /* consistent() */
+
+}; /* namespace <anonymous> */
+
+
+int main(int argc, char* argv[])
+{
+	unsigned n = 1000000;
+	unsigned nreaders = 2;
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+    for (int i = 1; i < argc - 1; i += 2)
+	if (strcmp(argv[i], "-n") == 0)
+	    n = atoi(argv[i + 1]);
+	else if (strcmp(argv[i], "-r") == 0)
+	    nreaders = atoi(argv[i + 1]);
+	else if (strcmp(argv[i], "-v") == 0)
+	    esp_log_level_set("*", static_cast<esp_log_level_t>(atoi(argv[i + 1])));
+
+    // the producer alone
+	uint32_t base = trace::recorded();
+	auto t0 = chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < n; i++)
+	synthetic(i);
+
+	double alone = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+
+    // the producer & the concurrent readers: every record read must be intact
+	atomic<bool> stop(false);
+	atomic<unsigned> torn(0), gaps(0);
+	atomic<uint64_t> reads(0);
+	vector<thread> readers;
+
+    base = trace::recorded();
+    for (unsigned r = 0; r < nreaders; r++)
+	readers.emplace_back([&]{
+		trace::record_t recs[trace::capacity];
+		uint32_t next = base;
+
+	    while (!stop.load(memory_order_relaxed))
+	    {
+		    size_t count = trace::read(recs, trace::capacity, next);
+
+		for (size_t i = 0; i < count; i++)
+		{
+		    torn += !consistent(recs[i], base);
+		    gaps += recs[i].seq != next;
+		    next = recs[i].seq + 1;
+		}; /* for i */
+		reads += count;
+	    }; /* while !stop */ });
+
+    t0 = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++)
+	synthetic(i);
+
+	double loaded = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / n;
+
+    stop = true;
+    for (auto& th: readers)
+	th.join();
+
+    printf("esp::net::wifi::trace, %zu records ring, %u records, ns/record\n", trace::capacity, n);
+    printf("%-10s %10s %10s\n", "producer", "alone", "readers");
+    printf("%-10s %10.1f %10.1f\n", "ns", alone, loaded);
+    printf("%u readers: %llu records read, %u gaps (overwritten before the read), %u torn\n",
+	    nreaders, static_cast<unsigned long long>(reads.load()), gaps.load(), torn.load());
+
+	bool ok = true;
+
+    if (torn || alone >= 1000)
+    {
+	printf("esp::net::wifi::trace record is torn or slower than 1 us FAILED\n");
+	ok = false;
+    }; /* if torn || alone >= 1000 */
+
+    // the events of the simulated backend: connection, the failed connection, the clear()
+    sim::scale(0.01);
+    sim::add_ap(sim::make_ap("home", "pass1234", 6, 1, 1));
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+    ESP_ERROR_CHECK(trace::enroll());
+    trace::clear();
+
+	esp_netif_inherent_config_t inherent = ESP_NETIF_INHERENT_DEFAULT_WIFI_STA();
+	esp::wifi::netif_t sta(WIFI_IF_STA, inherent);
+	wifi_init_config_t wifi_init = WIFI_INIT_CONFIG_DEFAULT();
+	::net::configuration_t cfg;
+
+    ESP_ERROR_CHECK(esp::net::wifi::stack::init(&wifi_init));
+    ESP_ERROR_CHECK(esp::net::wifi::mode::set(WIFI_MODE_STA));
+    ESP_ERROR_CHECK(esp::net::wifi::stack::start());
+    cfg.login = "home";
+    cfg.passwd = "pass1234";
+    cfg.use_pwd = true;
+	esp_err_t good = sta.update(cfg);
+
+    sta.update.finalize();
+    cfg.clr_chgst();
+    cfg.passwd = "wrong-password";
+	esp_err_t bad = sta.update(cfg);
+
+    sta.update.finalize();
+    sim::settle();
+
+	trace::record_t recs[trace::capacity];
+	size_t count = trace::read(recs, trace::capacity);
+	bool connected = false, got_ip = false, rejected = false;
+
+    printf("\nupdate: %s, wrong password: %s, %zu events traced\n", esp_err_to_name(good), esp_err_to_name(bad), count);
+    for (size_t i = 0; i < count; i++)
+    {
+	    const trace::record_t& rec = recs[i];
+
+	printf("#%-4u %10.1f ms  %-18s", static_cast<unsigned>(rec.seq - recs[0].seq), rec.time / 1000.0, trace::name(rec));
+	if (rec.reason)
+	    printf(" %s (%u), rssi %d", esp::wifi::err::reason(rec.reason), rec.reason, rec.rssi);
+	else if (rec.source == trace::IP && rec.aux)
+	    printf(" %s", esp::ip4::format(esp_ip4_addr_t{rec.aux}).c_str());
+	printf("\n");
+	connected |= rec.source == trace::WIFI && rec.id == WIFI_EVENT_STA_CONNECTED && rec.aux == 6;
+	got_ip |= rec.source == trace::IP && rec.id == IP_EVENT_STA_GOT_IP && rec.aux;
+	rejected |= rec.source == trace::WIFI && rec.id == WIFI_EVENT_STA_DISCONNECTED
+		&& esp::wifi::err::kind(rec.reason) == esp::wifi::err::CREDENTIAL;
+    }; /* for i */
+    trace::dump();
+    if (good != ESP_OK || !connected || !got_ip || !rejected || count == 0 || recs[0].seq < base + n)
+    {
+	printf("esp::net::wifi::trace of the simulated events FAILED\n");
+	ok = false;
+    }; /* if !connected || !got_ip || !rejected */
+
+    trace::clear();
+    if (trace::read(recs, trace::capacity) != 0)
+    {
+	printf("esp::net::wifi::trace::clear() FAILED\n");
+	ok = false;
+    }; /* if read() != 0 */
+
+    return ok? EXIT_SUCCESS: EXIT_FAILURE;
+}; /* main() */
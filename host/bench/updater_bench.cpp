@@ -0,0 +1,367 @@
+/*
+ * @file updater_bench.cpp
+ *
+ * @brief Latency benchmark of the esp::net::wifi::Updater::operator() on the simulated backend:
+ *	  p50/p99 of the end-to-end apply time & the time per phase
+ *	  for the set of the net::configuration_t change scenarios.
+ *
+ * Usage: updater_bench [-n iterations] [-s scale] [-v loglevel]
+ *
+ * The second table - the same scenarios with the asynchronous Updater::apply():
+ * time of the caller blocking & the time up to the completion of the request;
+ * then the check of the superseding of the request in flight by the next one
+ * and of the fallback to the full scan, when the known AP is moved to the other channel;
+ * at the end - the esp::net::wifi::disconnects statistics of the all runs.
+ *
+ * "fail" column - count of the failed applies, expected for the "bad-passwd" & "unknown-ssid"
+ *
+ * Phases are the timing spans, recorded by the Updater itself (Updater::spans()):
+ *	backup	   - backup of the current configuration & the deferring of the storage
+ *	disconnect - esp_wifi_disconnect()
+ *	login	   - PSK derivation (on the PSK cache miss) & esp_wifi_set_config()
+ *	connect	   - esp_wifi_connect() up to the wake of the Updater
+ *	dhcp	   - DHCP client start/stop & status polling
+ *	ip	   - setting of the static ip
+ *	got_ip	   - waiting of the IP_EVENT_STA_GOT_IP
+ *	revert	   - rollback to the backup configuration after the failure, with it's own phases
+ * the gaps between the phases (logging, event handlers) are not counted in any column;
+ * then the Updater::summary() of the last recorded spans: min/avg/max/p95 of the each phase.
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+#include <freertos/FreeRTOS.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "netlog.h"
+#include "sim.hpp"
+
+using namespace std;
+
+
+namespace
+{
+
+    using Updater = esp::net::wifi::Updater;
+
+    /// phase columns of the table: the whole PH_APPLY is the end-to-end time
+    constexpr int PHASES = Updater::PH_APPLY;
+
+    /// scenario of the configuration change
+    struct scenario_t
+    {
+	const char* name;
+	function<void(::net::configuration_t&)> change;
+	bool	    persist;	///< the changed configuration become the current, if applied
+    }; /* struct scenario_t */
+
+    /// samples of the one scenario
+    struct samples_t
+    {
+	vector<double>	total;
+	vector<double>	phase[PHASES];
+	unsigned	fails = 0;
+	sim::counters_t	counters;
+    }; /* struct samples_t */
+
+
+    double percentile(vector<double> v, double p)
+    {
+	if (v.empty())
+	    return 0;
+	sort(v.begin(), v.end());
+	return v[min(v.size() - 1, static_cast<size_t>(p * v.size()))];
+    }; /* percentile() */
+
+    /// sum the spans of the last update by phases, ms; the phases of the rollback are the part of the revert
+    void phases(const Updater& update, uint16_t& last, double out[PHASES])
+    {
+	    static Updater::span_t spans[CONFIG_WIFI_UPDATER_SPANS];
+	    size_t count = update.spans(spans, CONFIG_WIFI_UPDATER_SPANS);
+
+	fill(out, out + PHASES, 0.0);
+	if (!count || spans[count - 1].apply == last)
+	    return;	// nothing is applied
+	last = spans[count - 1].apply;
+	for (size_t i = 0; i < count; i++)
+	    if (spans[i].apply == last && !spans[i].rollback && spans[i].phase < PHASES)
+		out[spans[i].phase] += spans[i].duration / 1000.0;
+    }; /* phases() */
+
+}; /* namespace <anonymous> */
+
+
+
+int main(int argc, char* argv[])
+{
+	unsigned iterations = 20;
+	double scale = 0.01;
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+    for (int i = 1; i < argc - 1; i += 2)
+    {
+	if (strcmp(argv[i], "-n") == 0)
+	    iterations = atoi(argv[i + 1]);
+	else if (strcmp(argv[i], "-s") == 0)
+	    scale = atof(argv[i + 1]);
+	else if (strcmp(argv[i], "-v") == 0)
+	{
+	    esp_log_level_set("*", static_cast<esp_log_level_t>(atoi(argv[i + 1])));
+	    esp::net::log::start();	// the deferred records of the component are written by the task
+	}; /* else if "-v" */
+    }; /* for i */
+
+    sim::scale(scale);
+    sim::add_ap(sim::make_ap("home",   "pass1234", 6, 1, 1));
+    sim::add_ap(sim::make_ap("office", "secret99", 11, 2, 2));
+
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+
+	esp_netif_inherent_config_t base = ESP_NETIF_INHERENT_DEFAULT_WIFI_STA();
+	esp::wifi::netif_t sta(WIFI_IF_STA, base);
+	wifi_init_config_t wifi_init = WIFI_INIT_CONFIG_DEFAULT();
+
+    ESP_ERROR_CHECK(esp::net::wifi::stack::init(&wifi_init));
+    ESP_ERROR_CHECK(esp::net::wifi::mode::set(WIFI_MODE_STA));
+    ESP_ERROR_CHECK(esp::net::wifi::stack::start());
+    ESP_ERROR_CHECK(esp::net::wifi::disconnects::enroll());
+
+	::net::configuration_t current;
+
+    current.login = "home";
+    current.passwd = "pass1234";
+    current.use_pwd = true;
+    if (sta.update(current) != ESP_OK)
+    {
+	fprintf(stderr, "Initial connection failed with error %i\n", sta.update.status());
+	return 1;
+    }; /* if sta.update(current) != ESP_OK */
+    sta.update.finalize();
+    current.clr_chgst();
+
+	const vector<scenario_t> scenarios = {
+	    { "ip-static",   [](::net::configuration_t& cfg) {
+				cfg.dhcp = false;
+				cfg.ip = esp_ip4addr_aton("192.168.1.50");
+				cfg.mask = esp_ip4addr_aton("255.255.255.0");
+				cfg.gate = esp_ip4addr_aton("192.168.1.1"); }, true },
+	    { "ip-dhcp",     [](::net::configuration_t& cfg) { cfg.dhcp = true; }, true },
+	    { "switch-ap",   [](::net::configuration_t& cfg) { cfg.login = "office"; cfg.passwd = "secret99"; }, true },
+	    { "switch-back", [](::net::configuration_t& cfg) { cfg.login = "home"; cfg.passwd = "pass1234"; }, true },
+	    { "no-change",   [](::net::configuration_t& cfg) {}, false },
+	    { "change-back", [](::net::configuration_t& cfg) {
+				::net::configuration_t orig(cfg);
+				cfg.login = "nowhere";
+				cfg.dhcp = !cfg.dhcp;
+				cfg = orig; }, false },
+	    { "bad-passwd",  [](::net::configuration_t& cfg) { cfg.passwd = "wrong-password"; }, false },
+	    { "unknown-ssid",[](::net::configuration_t& cfg) { cfg.login = "nowhere"; }, false },
+	};
+	vector<samples_t> results(scenarios.size());
+	uint16_t last = 0;
+
+    for (unsigned n = 0; n < iterations; n++)
+	for (size_t i = 0; i < scenarios.size(); i++)
+	{
+		::net::configuration_t cfg(current);
+		double ph[PHASES];
+
+	    cfg.clr_chgst();
+	    scenarios[i].change(cfg);
+
+	    sim::settle();
+		sim::counters_t before = sim::counters();
+		uint64_t begin = sim::now();
+		esp_err_t err = sta.update(cfg);
+		uint64_t end = sim::now();
+		sim::counters_t after = sim::counters();
+
+	    sta.update.finalize();
+	    phases(sta.update, last, ph);
+
+		samples_t& res = results[i];
+
+	    res.total.push_back((end - begin) / 1000.0);
+	    for (int p = 0; p < PHASES; p++)
+		res.phase[p].push_back(ph[p]);
+	    if (err != ESP_OK && err != ESP_ERR_NOT_FOUND)	// ESP_ERR_NOT_FOUND - nothing to do
+		res.fails++;
+	    res.counters.nvs_writes += after.nvs_writes - before.nvs_writes;
+	    res.counters.pbkdf2     += after.pbkdf2 - before.pbkdf2;
+	    res.counters.full_scans += after.full_scans - before.full_scans;
+
+	    if (err == ESP_OK && scenarios[i].persist)
+	    {
+		current = cfg;
+		current.clr_chgst();
+	    }; /* if err == ESP_OK */
+	}; /* for i */
+
+    printf("Updater::operator() latency, %u iterations, simulated ms\n\n", iterations);
+    printf("%-13s %5s %9s %9s", "scenario", "fail", "p50", "p99");
+    for (int p = 0; p < PHASES; p++)
+	printf(" %10s", Updater::phase_name(static_cast<Updater::phase_t>(p)));
+    printf(" %6s %6s %6s\n", "nvs", "pbkdf2", "scans");
+
+    for (size_t i = 0; i < scenarios.size(); i++)
+    {
+	    const samples_t& res = results[i];
+
+	printf("%-13s %5u %9.1f %9.1f", scenarios[i].name, res.fails,
+		percentile(res.total, 0.50), percentile(res.total, 0.99));
+	for (int p = 0; p < PHASES; p++)
+	    printf(" %10.1f", percentile(res.phase[p], 0.50));
+	printf(" %6.1f %6.1f %6.1f\n",
+		static_cast<double>(res.counters.nvs_writes) / iterations,
+		static_cast<double>(res.counters.pbkdf2) / iterations,
+		static_cast<double>(res.counters.full_scans) / iterations);
+    }; /* for i */
+    printf("\n(phase columns are p50 of the each phase; nvs/pbkdf2/scans - mean per apply)\n");
+    printf("flash writes of the WiFi configuration, avoided by the deferred storage: %u\n", sta.update.writes_avoided());
+
+    // the built-in summary of the last spans: the update & the rollback
+	Updater::timing_t forward[Updater::PHASES], rollback[Updater::PHASES];
+
+    sta.update.summary(forward);
+    sta.update.summary(rollback, true);
+    printf("\nUpdater::summary() of the last %u spans, simulated us\n\n", CONFIG_WIFI_UPDATER_SPANS);
+    printf("%-11s %5s %9s %9s %9s %9s %9s\n", "phase", "count", "min", "avg", "max", "p95", "rollback");
+    for (int p = 0; p < Updater::PHASES; p++)
+	printf("%-11s %5u %9u %9u %9u %9u %9u\n", Updater::phase_name(static_cast<Updater::phase_t>(p)),
+		forward[p].count, forward[p].min, forward[p].avg, forward[p].max, forward[p].p95, rollback[p].avg);
+    if (!forward[Updater::PH_APPLY].count || !forward[Updater::PH_REVERT].count || !rollback[Updater::PH_CONNECT].count)
+    {
+	fprintf(stderr, "The phases of the update or of the rollback are not recorded\n");
+	return 1;
+    }; /* if !forward[PH_APPLY].count */
+
+    // asynchronous update: the caller is blocked only for the posting of the request
+	vector<double> blocked[scenarios.size()], completed[scenarios.size()];
+	unsigned async_fails[scenarios.size()] = {};
+
+    for (unsigned n = 0; n < iterations; n++)
+	for (size_t i = 0; i < scenarios.size(); i++)
+	{
+		::net::configuration_t cfg(current);
+
+	    cfg.clr_chgst();
+	    scenarios[i].change(cfg);
+	    sim::settle();
+
+		uint64_t begin = sim::now();
+		auto handle = sta.update.apply(cfg);
+		uint64_t posted = sim::now();
+		esp_err_t err = handle.wait();
+		uint64_t end = sim::now();
+
+	    blocked[i].push_back((posted - begin) / 1000.0);
+	    completed[i].push_back((end - begin) / 1000.0);
+	    if (err != ESP_OK && err != ESP_ERR_NOT_FOUND)
+		async_fails[i]++;
+	    if (err == ESP_OK && scenarios[i].persist)
+	    {
+		current = cfg;
+		current.clr_chgst();
+	    }; /* if err == ESP_OK */
+	}; /* for i */
+
+    printf("\nUpdater::apply() asynchronous, %u iterations, simulated ms\n\n", iterations);
+    printf("%-13s %5s %12s %12s\n", "scenario", "fail", "caller p50", "done p50");
+    for (size_t i = 0; i < scenarios.size(); i++)
+	printf("%-13s %5u %12.2f %12.1f\n", scenarios[i].name, async_fails[i],
+		percentile(blocked[i], 0.50), percentile(completed[i], 0.50));
+
+    // the request in flight is superseded by the next one
+	::net::configuration_t wrong(current), right(current);
+
+    wrong.clr_chgst();
+    wrong.passwd = "wrong-password";
+    right.clr_chgst();
+    right.login = (current.login == "home")? "office": "home";
+    right.passwd = (current.login == "home")? "secret99": "pass1234";
+    sim::settle();
+
+	auto first = sta.update.apply(wrong);
+    sim::sleep(50);
+	auto second = sta.update.apply(right);
+	esp_err_t first_err = first.wait(), second_err = second.wait();
+
+    printf("\nsupersede: first request %s, second request %s\n", esp_err_to_name(first_err), esp_err_to_name(second_err));
+    if (first_err != ESP_ERR_INVALID_STATE || second_err != ESP_OK)
+    {
+	fprintf(stderr, "The superseded request is not cancelled or the next one is failed\n");
+	return 1;
+    }; /* if first_err != ESP_ERR_INVALID_STATE || second_err != ESP_OK */
+    current = right;
+    current.clr_chgst();
+
+    // the known AP is moved to the other channel & BSSID: the targeted connection fails, the full scan finds it
+	::net::configuration_t moved(current);
+	const bool home = current.login == "home";
+
+    sim::move_ap(home? sim::make_ap("office", "secret99", 3, 2, 12): sim::make_ap("home", "pass1234", 9, 1, 11));
+    moved.clr_chgst();
+    moved.login = home? "office": "home";
+    moved.passwd = home? "secret99": "pass1234";
+    sim::settle();
+
+	sim::counters_t before = sim::counters();
+	uint64_t begin = sim::now();
+	esp_err_t moved_err = sta.update(moved);
+	uint64_t end = sim::now();
+
+    sta.update.finalize();
+    printf("moved AP: %s, %.1f ms, %u full scans\n", esp_err_to_name(moved_err), (end - begin) / 1000.0,
+	    sim::counters().full_scans - before.full_scans);
+    if (moved_err != ESP_OK)
+    {
+	fprintf(stderr, "The moved known AP is not found by the full scan\n");
+	return 1;
+    }; /* if moved_err != ESP_OK */
+
+    // the disconnections of the all runs by the reason-code
+	static esp::net::wifi::disconnects::snapshot_t snap;
+	unsigned credential = 0, absent = 0;
+
+    sim::settle();
+    esp::net::wifi::disconnects::snapshot(snap);
+    printf("\ndisconnects: %u\n%-24s %6s  %s\n", snap.total, "reason", "count", "connection time: none <1s <4s <16s <64s ...");
+    for (const auto& cnt: snap.reasons)
+    {
+	if (!cnt.count)
+	    continue;
+	printf("%-24s %6u ", esp::wifi::err::reason(cnt.reason), cnt.count);
+	for (auto bin: cnt.hist)
+	    printf(" %4u", bin);
+	printf("\n");
+	credential += esp::wifi::err::kind(cnt.reason) == esp::wifi::err::CREDENTIAL? cnt.count: 0;
+	absent += esp::wifi::err::kind(cnt.reason) == esp::wifi::err::ABSENT? cnt.count: 0;
+    }; /* for cnt */
+    if (!credential || !absent || snap.total != esp::net::wifi::disconnects::total())
+    {
+	fprintf(stderr, "The disconnections of the failed applies are not counted\n");
+	return 1;
+    }; /* if !credential || !absent */
+
+    return 0;
+}; /* main() */
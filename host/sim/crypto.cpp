@@ -0,0 +1,234 @@
+/*
+ * @file crypto.cpp
+ *
+ * @brief Host stand-in of the mbedTLS PBKDF2-HMAC-SHA1 (the WPA2 passphrase to the PMK derivation) & HMAC-SHA1
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <cstring>
+
+#include <mbedtls/md.h>
+#include <mbedtls/pkcs5.h>
+
+#include "sim_internal.hpp"
+
+using namespace std;
+
+
+namespace
+{
+    /// plain SHA-1 (FIPS 180-4)
+    class sha1
+    {
+    public:
+	sha1() { reset(); };
+
+	void reset()
+	{
+	    static const uint32_t init[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+	    memcpy(h, init, sizeof(h));
+	    total = 0;
+	    used = 0;
+	}; /* reset() */
+
+	void update(const uint8_t* data, size_t len)
+	{
+	    total += len;
+	    while (len)
+	    {
+		    size_t chunk = min(len, sizeof(block) - used);
+
+		memcpy(block + used, data, chunk);
+		used += chunk;
+		data += chunk;
+		len -= chunk;
+		if (used == sizeof(block))
+		{
+		    compress();
+		    used = 0;
+		}; /* if used == sizeof(block) */
+	    }; /* while len */
+	}; /* update() */
+
+	void final(uint8_t out[20])
+	{
+		uint64_t bits = total * 8;
+		uint8_t pad = 0x80;
+
+	    update(&pad, 1);
+	    pad = 0;
+	    while (used != 56)
+		update(&pad, 1);
+	    for (int i = 7; i >= 0; i--)
+		block[56 + 7 - i] = static_cast<uint8_t>(bits >> (i * 8));
+	    compress();
+	    for (int i = 0; i < 5; i++)
+		for (int j = 0; j < 4; j++)
+		    out[i * 4 + j] = static_cast<uint8_t>(h[i] >> (24 - j * 8));
+	}; /* final() */
+
+    private:
+	static uint32_t rol(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); };
+
+	void compress()
+	{
+		uint32_t w[80];
+
+	    for (int i = 0; i < 16; i++)
+		w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16)
+			| (uint32_t(block[i * 4 + 2]) << 8) | block[i * 4 + 3];
+	    for (int i = 16; i < 80; i++)
+		w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+		uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+
+	    for (int i = 0; i < 80; i++)
+	    {
+		    uint32_t f, k;
+
+		if (i < 20)	 { f = (b & c) | (~b & d);	    k = 0x5a827999; }
+		else if (i < 40) { f = b ^ c ^ d;		    k = 0x6ed9eba1; }
+		else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8f1bbcdc; }
+		else		 { f = b ^ c ^ d;		    k = 0xca62c1d6; }
+
+		    uint32_t t = rol(a, 5) + f + e + k + w[i];
+
+		e = d; d = c; c = rol(b, 30); b = a; a = t;
+	    }; /* for i */
+	    h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+	}; /* compress() */
+
+	uint32_t h[5];
+	uint8_t	 block[64];
+	size_t	 used;
+	uint64_t total;
+    }; /* class sha1 */
+
+
+    /// HMAC-SHA1 with the precomputed inner & outer pads
+    class hmac_sha1
+    {
+    public:
+	hmac_sha1(const uint8_t* key, size_t len)
+	{
+		uint8_t k[64] = {}, pad[64];
+
+	    if (len > sizeof(k))
+	    {
+		sha1 kh;
+		kh.update(key, len);
+		kh.final(k);
+	    } /* if len > sizeof(k) */
+	    else
+		memcpy(k, key, len);
+	    for (int i = 0; i < 64; i++)
+		pad[i] = k[i] ^ 0x36;
+	    inner.update(pad, sizeof(pad));
+	    for (int i = 0; i < 64; i++)
+		pad[i] = k[i] ^ 0x5c;
+	    outer.update(pad, sizeof(pad));
+	}; /* hmac_sha1() */
+
+	void mac(const uint8_t* data, size_t len, uint8_t out[20]) const
+	{
+		sha1 in(inner), out_h(outer);
+		uint8_t digest[20];
+
+	    in.update(data, len);
+	    in.final(digest);
+	    out_h.update(digest, sizeof(digest));
+	    out_h.final(out);
+	}; /* mac() */
+
+    private:
+	sha1 inner, outer;
+    }; /* class hmac_sha1 */
+
+}; /* namespace <anonymous> */
+
+
+namespace sim
+{
+    namespace detail
+    {
+	void pbkdf2_sha1(const uint8_t* pwd, size_t plen, const uint8_t* salt, size_t slen,
+		unsigned iterations, uint8_t* out, size_t olen)
+	{
+		hmac_sha1 prf(pwd, plen);
+		uint8_t buf[64 + 4];
+
+	    slen = min(slen, sizeof(buf) - 4);
+	    for (uint32_t blk = 1; olen; blk++)
+	    {
+		    uint8_t u[20], t[20];
+
+		memcpy(buf, salt, slen);
+		buf[slen] = blk >> 24; buf[slen + 1] = blk >> 16; buf[slen + 2] = blk >> 8; buf[slen + 3] = blk;
+		prf.mac(buf, slen + 4, u);
+		memcpy(t, u, sizeof(t));
+		for (unsigned i = 1; i < iterations; i++)
+		{
+		    prf.mac(u, sizeof(u), u);
+		    for (int j = 0; j < 20; j++)
+			t[j] ^= u[j];
+		}; /* for i */
+
+		    size_t chunk = min(olen, sizeof(t));
+
+		memcpy(out, t, chunk);
+		out += chunk;
+		olen -= chunk;
+	    }; /* for blk */
+	}; /* sim::detail::pbkdf2_sha1() */
+
+    }; /* namespace sim::detail */
+
+}; /* namespace sim */
+
+
+int mbedtls_pkcs5_pbkdf2_hmac_ext(mbedtls_md_type_t md_type,
+				  const unsigned char *password, size_t plen,
+				  const unsigned char *salt, size_t slen,
+				  unsigned int iteration_count,
+				  uint32_t key_length, unsigned char *output)
+{
+    if (md_type != MBEDTLS_MD_SHA1)
+	return MBEDTLS_ERR_MD_FEATURE_UNAVAILABLE;
+	uint64_t deadline = sim::now() + sim::delays().pbkdf2 * 1000ULL;
+
+    sim::mark("mbedtls_pkcs5_pbkdf2_hmac_ext");
+    {
+	std::lock_guard<std::recursive_mutex> lk(sim::detail::lock());
+	sim::detail::count().pbkdf2++;
+    }
+    sim::detail::pbkdf2_sha1(password, plen, salt, slen, iteration_count, output, key_length);
+    sim::sleep_until(deadline);	// the host computation is the part of the simulated cost
+    return 0;
+}; /* mbedtls_pkcs5_pbkdf2_hmac_ext() */
+
+
+/// the SHA-1 is the only digest of the stand-in
+struct mbedtls_md_info_t
+{
+    mbedtls_md_type_t type;
+}; /* struct mbedtls_md_info_t */
+
+static const mbedtls_md_info_t sha1_info = {MBEDTLS_MD_SHA1};
+
+const mbedtls_md_info_t *mbedtls_md_info_from_type(mbedtls_md_type_t md_type)
+{
+    return md_type == MBEDTLS_MD_SHA1? &sha1_info: nullptr;
+}; /* mbedtls_md_info_from_type() */
+
+int mbedtls_md_hmac(const mbedtls_md_info_t *md_info,
+		    const unsigned char *key, size_t keylen,
+		    const unsigned char *input, size_t ilen,
+		    unsigned char *output)
+{
+    if (md_info != &sha1_info)
+	return MBEDTLS_ERR_MD_BAD_INPUT_DATA;
+    hmac_sha1(key, keylen).mac(input, ilen, output);
+    return 0;
+}; /* mbedtls_md_hmac() */
@@ -0,0 +1,283 @@
+/*
+ * @file esp_eth.cpp
+ *
+ * @brief Host simulation of the ESP-IDF Ethernet driver w/o the MAC & PHY: the link of the started driver
+ *	  is up after the autonegotiation (the job of the simulated driver task) while the cable is plugged;
+ *	  the glue links the netif up/down with the link of the driver
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <esp_eth.h>
+#include <esp_netif.h>
+
+#include "sim_internal.hpp"
+
+using namespace std;
+
+ESP_EVENT_DEFINE_BASE(ETH_EVENT);
+
+
+/// simulated Ethernet driver
+struct eth_driver_t
+{
+    esp_eth_handle_t self;		///< the handle, posted as the data of the ETH_EVENT
+    bool	     started = false;
+    bool	     up = false;	///< the link is up
+    uint32_t	     gen = 0;		///< generation of the autonegotiation
+    esp_netif_t*     netif = nullptr;	///< the attached netif
+    uint8_t	     mac[6];
+}; /* struct eth_driver_t */
+
+/// the glue of the driver to the netif
+struct esp_eth_netif_glue_t
+{
+    eth_driver_t*    driver;
+}; /* struct esp_eth_netif_glue_t */
+
+
+namespace
+{
+    vector<eth_driver_t*> drivers;
+    bool cable = true;
+    uint32_t subnet_val = ESP_IP4TOADDR(192, 168, 10, 0);
+    uint8_t next_mac = 0;
+
+    eth_driver_t* driver(esp_eth_handle_t hdl)
+    {
+	    auto it = find(drivers.begin(), drivers.end(), static_cast<eth_driver_t*>(hdl));
+
+	return it != drivers.end()? *it: nullptr;
+    }; /* driver() */
+
+    /// post the ETH_EVENT of the driver
+    void post(eth_driver_t* drv, int32_t id, const char* what)
+    {
+	sim::mark(what);
+	sim::detail::post(ETH_EVENT, id, &drv->self, sizeof(drv->self));
+    }; /* post() */
+
+    /// the link of the started driver is up after the autonegotiation, if the cable is still plugged; call under the lock
+    void negotiate(eth_driver_t* drv)
+    {
+	    sim::backend_scope inside;
+	    uint32_t gen = ++drv->gen;
+
+	sim::detail::job([drv, gen]{
+	    sim::sleep(sim::delays().eth_link);
+
+	    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	    if (!driver(drv) || drv->gen != gen || !drv->started || !cable || drv->up)
+		return;
+	    drv->up = true;
+	    post(drv, ETHERNET_EVENT_CONNECTED, "ETHERNET_EVENT_CONNECTED");
+	    if (drv->netif)
+		sim::detail::link_up(drv->netif);
+	});
+    }; /* negotiate() */
+
+    /// the link of the driver is down; call under the lock
+    void link_down(eth_driver_t* drv)
+    {
+	drv->gen++;
+	if (!drv->up)
+	    return;
+	drv->up = false;
+	if (drv->netif)
+	    sim::detail::link_down(drv->netif);
+	post(drv, ETHERNET_EVENT_DISCONNECTED, "ETHERNET_EVENT_DISCONNECTED");
+    }; /* link_down() */
+
+}; /* namespace <anonymous> */
+
+
+namespace sim
+{
+    void eth_cable(bool plugged)
+    {
+	lock_guard<recursive_mutex> lk(detail::lock());
+	if (cable == plugged)
+	    return;
+	cable = plugged;
+	for (auto drv: drivers)
+	    if (!plugged)
+		link_down(drv);
+	    else if (drv->started)
+		negotiate(drv);
+    }; /* sim::eth_cable() */
+
+    void eth_network(uint32_t subnet)
+    {
+	lock_guard<recursive_mutex> lk(detail::lock());
+	subnet_val = subnet;
+    }; /* sim::eth_network() */
+
+    namespace detail
+    {
+	uint32_t& eth_subnet() { return subnet_val; };
+
+	void reset_eth()
+	{
+	    lock_guard<recursive_mutex> lk(lock());
+	    for (auto drv: drivers)
+		delete drv;
+	    drivers.clear();
+	    cable = true;
+	    subnet_val = ESP_IP4TOADDR(192, 168, 10, 0);
+	}; /* sim::detail::reset_eth() */
+
+    }; /* namespace sim::detail */
+
+}; /* namespace sim */
+
+
+
+esp_err_t esp_eth_driver_install(const esp_eth_config_t *config, esp_eth_handle_t *out_hdl)
+{
+    sim::mark("esp_eth_driver_install");
+    if (!config || !out_hdl)
+	return ESP_ERR_INVALID_ARG;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	eth_driver_t* drv = new eth_driver_t;
+	uint8_t mac[6] = {0x02, 0xe5, 0x70, 0x00, 0x00, ++next_mac};
+
+    drv->self = drv;
+    memcpy(drv->mac, mac, sizeof(mac));
+    drivers.push_back(drv);
+    *out_hdl = drv;
+    return ESP_OK;
+}; /* esp_eth_driver_install() */
+
+esp_err_t esp_eth_driver_uninstall(esp_eth_handle_t hdl)
+{
+    sim::mark("esp_eth_driver_uninstall");
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	eth_driver_t* drv = driver(hdl);
+
+    if (!drv)
+	return ESP_ERR_INVALID_ARG;
+    if (drv->started || drv->netif)
+	return ESP_ERR_INVALID_STATE;
+    drivers.erase(find(drivers.begin(), drivers.end(), drv));
+    delete drv;
+    return ESP_OK;
+}; /* esp_eth_driver_uninstall() */
+
+esp_err_t esp_eth_start(esp_eth_handle_t hdl)
+{
+    sim::mark("esp_eth_start");
+    sim::detail::api_delay();
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	eth_driver_t* drv = driver(hdl);
+
+    if (!drv)
+	return ESP_ERR_INVALID_ARG;
+    if (drv->started)
+	return ESP_ERR_INVALID_STATE;
+    drv->started = true;
+    post(drv, ETHERNET_EVENT_START, "ETHERNET_EVENT_START");
+    if (cable)
+	negotiate(drv);
+    return ESP_OK;
+}; /* esp_eth_start() */
+
+esp_err_t esp_eth_stop(esp_eth_handle_t hdl)
+{
+    sim::mark("esp_eth_stop");
+    sim::detail::api_delay();
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	eth_driver_t* drv = driver(hdl);
+
+    if (!drv)
+	return ESP_ERR_INVALID_ARG;
+    if (!drv->started)
+	return ESP_ERR_INVALID_STATE;
+    link_down(drv);
+    drv->started = false;
+    post(drv, ETHERNET_EVENT_STOP, "ETHERNET_EVENT_STOP");
+    return ESP_OK;
+}; /* esp_eth_stop() */
+
+esp_err_t esp_eth_ioctl(esp_eth_handle_t hdl, esp_eth_io_cmd_t cmd, void *data)
+{
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	eth_driver_t* drv = driver(hdl);
+
+    if (!drv || !data)
+	return ESP_ERR_INVALID_ARG;
+    switch (cmd)
+    {
+    case ETH_CMD_G_MAC_ADDR:
+	memcpy(data, drv->mac, sizeof(drv->mac));
+	return ESP_OK;
+
+    case ETH_CMD_S_MAC_ADDR:
+	memcpy(drv->mac, data, sizeof(drv->mac));
+	return ESP_OK;
+
+    case ETH_CMD_G_SPEED:
+	*static_cast<eth_speed_t*>(data) = ETH_SPEED_100M;
+	return ESP_OK;
+
+    case ETH_CMD_G_DUPLEX_MODE:
+	*static_cast<eth_duplex_t*>(data) = ETH_DUPLEX_FULL;
+	return ESP_OK;
+
+    default:
+	return ESP_ERR_NOT_SUPPORTED;
+    }; /* switch cmd */
+}; /* esp_eth_ioctl() */
+
+
+esp_eth_netif_glue_handle_t esp_eth_new_netif_glue(esp_eth_handle_t eth_hdl)
+{
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	eth_driver_t* drv = driver(eth_hdl);
+
+    return drv? new esp_eth_netif_glue_t{drv}: nullptr;
+}; /* esp_eth_new_netif_glue() */
+
+esp_err_t esp_eth_del_netif_glue(esp_eth_netif_glue_handle_t glue)
+{
+    if (!glue)
+	return ESP_ERR_INVALID_ARG;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	eth_driver_t* drv = driver(glue->driver);
+
+    if (drv && drv->netif)
+    {
+	drv->netif->eth = nullptr;
+	drv->netif = nullptr;
+    }; /* if drv->netif */
+    delete glue;
+    return ESP_OK;
+}; /* esp_eth_del_netif_glue() */
+
+/// @brief the netif is linked up at once, if the link of the driver is up already
+esp_err_t esp_netif_attach(esp_netif_t *netif, esp_netif_iodriver_handle driver_handle)
+{
+    sim::mark("esp_netif_attach");
+    if (!netif || !driver_handle)
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	eth_driver_t* drv = driver(static_cast<esp_eth_netif_glue_t*>(driver_handle)->driver);
+
+    if (!drv)
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+    drv->netif = netif;
+    netif->eth = drv;
+    if (drv->up)
+	sim::detail::link_up(netif);
+    return ESP_OK;
+}; /* esp_netif_attach() */
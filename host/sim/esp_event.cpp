@@ -0,0 +1,288 @@
+/*
+ * @file esp_event.cpp
+ *
+ * @brief Host simulation of the ESP-IDF default & user event loops: own dispatching thread of the each loop
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <esp_event.h>
+
+#include "sim_internal.hpp"
+
+using namespace std;
+
+
+namespace
+{
+    struct handler_t
+    {
+	esp_event_base_t    base;
+	int32_t		    id;
+	esp_event_handler_t fn;
+	void*		    arg;
+	unsigned	    instance;
+    }; /* struct handler_t */
+
+    struct event_t
+    {
+	esp_event_base_t base;
+	int32_t		 id;
+	vector<uint8_t>	 data;
+    }; /* struct event_t */
+
+    /// state of the event loop; never destroyed - the detached loop thread waits on it up to the process exit,
+    /// the thread of the deleted user loop exits, but the loop object is kept
+    struct loop_t
+    {
+	mutex		  lock;
+	condition_variable cond;
+	deque<event_t>	  queue;
+	vector<handler_t> handlers;
+	size_t		  limit = 0;	///< capacity of the queue, 0 - unbounded
+	bool		  busy = false;
+	bool		  created = false;
+	bool		  deleted = false;
+    }; /* struct loop_t */
+
+    loop_t& loop = *new loop_t;		///< the default event loop
+
+    mutex loops_lock;
+    vector<loop_t*>& loops = *new vector<loop_t*>{&loop};	///< the all loops, for the settle
+    atomic<unsigned> instances{0};	///< numbers of the handler instances, unique over the all loops
+
+    void loop_task(loop_t* self)
+    {
+	for (;;)
+	{
+		event_t ev;
+		vector<handler_t> snapshot;
+	    {
+		unique_lock<mutex> lk(self->lock);
+		self->busy = false;
+		self->cond.notify_all();
+		self->cond.wait(lk, [self]{ return !self->queue.empty() || self->deleted; });
+		if (self->deleted)
+		    return;
+		ev = std::move(self->queue.front());
+		self->queue.pop_front();
+		snapshot = self->handlers;
+		self->busy = true;
+	    }
+	    for (auto& h: snapshot)
+		if ((h.base == ESP_EVENT_ANY_BASE || h.base == ev.base || strcmp(h.base, ev.base) == 0)
+			&& (h.id == ESP_EVENT_ANY_ID || h.id == ev.id))
+		    h.fn(h.arg, ev.base, ev.id, ev.data.empty()? nullptr: ev.data.data());
+	}; /* for (;;) */
+    }; /* loop_task() */
+
+    loop_t* which(esp_event_loop_handle_t handle)
+    {
+	return handle? static_cast<loop_t*>(handle): &loop;
+    }; /* which() */
+
+}; /* namespace <anonymous> */
+
+
+esp_err_t esp_event_loop_create_default(void)
+{
+	static bool running = (thread(loop_task, &loop).detach(), true);
+    lock_guard<mutex> lk(loop.lock);
+    if (loop.created)
+	return ESP_ERR_INVALID_STATE;
+    loop.created = true;
+    return ESP_OK;
+}; /* esp_event_loop_create_default() */
+
+esp_err_t esp_event_loop_delete_default(void)
+{
+    lock_guard<mutex> lk(loop.lock);
+    loop.created = false;
+    loop.handlers.clear();
+    return ESP_OK;
+}; /* esp_event_loop_delete_default() */
+
+
+esp_err_t esp_event_loop_create(const esp_event_loop_args_t* args, esp_event_loop_handle_t* handle)
+{
+	sim::backend_scope inside;
+
+    if (!args || !handle || !args->task_name || args->queue_size <= 0)
+	return ESP_ERR_INVALID_ARG;
+	loop_t* user = new loop_t;
+
+    user->limit = args->queue_size;
+    user->created = true;
+    {
+	lock_guard<mutex> lk(loops_lock);
+	loops.push_back(user);
+    }
+    thread(loop_task, user).detach();
+    *handle = user;
+    return ESP_OK;
+}; /* esp_event_loop_create() */
+
+esp_err_t esp_event_loop_delete(esp_event_loop_handle_t handle)
+{
+	loop_t* user = static_cast<loop_t*>(handle);
+
+    if (!user || user == &loop)
+	return ESP_ERR_INVALID_ARG;
+    {
+	lock_guard<mutex> lk(loops_lock);
+	loops.erase(remove(loops.begin(), loops.end(), user), loops.end());
+    }
+    lock_guard<mutex> lk(user->lock);
+    user->created = false;
+    user->deleted = true;
+    user->queue.clear();
+    user->handlers.clear();
+    user->cond.notify_all();
+    return ESP_OK;
+}; /* esp_event_loop_delete() */
+
+
+esp_err_t esp_event_handler_instance_register_with(esp_event_loop_handle_t handle, esp_event_base_t base, int32_t id,
+		esp_event_handler_t fn, void* arg, esp_event_handler_instance_t* instance)
+{
+	sim::backend_scope inside;
+	loop_t& lp = *which(handle);
+
+    sim::mark("esp_event_handler_register");
+    lock_guard<mutex> lk(lp.lock);
+    if (!lp.created)
+	return ESP_ERR_INVALID_STATE;
+	unsigned number = ++instances;
+
+    lp.handlers.push_back({base, id, fn, arg, number});
+    if (instance)
+	*instance = reinterpret_cast<esp_event_handler_instance_t>(static_cast<uintptr_t>(number));
+    return ESP_OK;
+}; /* esp_event_handler_instance_register_with() */
+
+esp_err_t esp_event_handler_instance_register(esp_event_base_t base, int32_t id,
+		esp_event_handler_t fn, void* arg, esp_event_handler_instance_t* instance)
+{
+    return esp_event_handler_instance_register_with(nullptr, base, id, fn, arg, instance);
+}; /* esp_event_handler_instance_register() */
+
+esp_err_t esp_event_handler_register(esp_event_base_t base, int32_t id, esp_event_handler_t fn, void* arg)
+{
+    return esp_event_handler_instance_register(base, id, fn, arg, nullptr);
+}; /* esp_event_handler_register() */
+
+esp_err_t esp_event_handler_instance_unregister_with(esp_event_loop_handle_t handle, esp_event_base_t base, int32_t id,
+		esp_event_handler_instance_t instance)
+{
+	loop_t& lp = *which(handle);
+
+    sim::mark("esp_event_handler_unregister");
+    lock_guard<mutex> lk(lp.lock);
+    for (auto h = lp.handlers.begin(); h != lp.handlers.end(); h++)
+	if (h->base == base && h->id == id && h->instance == reinterpret_cast<uintptr_t>(instance))
+	{
+	    lp.handlers.erase(h);
+	    return ESP_OK;
+	}; /* if h == instance */
+    return ESP_ERR_NOT_FOUND;
+}; /* esp_event_handler_instance_unregister_with() */
+
+esp_err_t esp_event_handler_instance_unregister(esp_event_base_t base, int32_t id, esp_event_handler_instance_t instance)
+{
+    return esp_event_handler_instance_unregister_with(nullptr, base, id, instance);
+}; /* esp_event_handler_instance_unregister() */
+
+esp_err_t esp_event_handler_unregister(esp_event_base_t base, int32_t id, esp_event_handler_t fn)
+{
+    sim::mark("esp_event_handler_unregister");
+    lock_guard<mutex> lk(loop.lock);
+    for (auto h = loop.handlers.begin(); h != loop.handlers.end(); h++)
+	if (h->base == base && h->id == id && h->fn == fn)
+	{
+	    loop.handlers.erase(h);
+	    return ESP_OK;
+	}; /* if h == fn */
+    return ESP_ERR_NOT_FOUND;
+}; /* esp_event_handler_unregister() */
+
+
+/// the full queue of the bounded loop is waited up to the 'ticks' of the simulated time
+esp_err_t esp_event_post_to(esp_event_loop_handle_t handle, esp_event_base_t base, int32_t id,
+		const void* data, size_t size, TickType_t ticks)
+{
+	sim::backend_scope inside;
+	loop_t& lp = *which(handle);
+	event_t ev{base, id, {}};
+
+    if (data && size)
+	ev.data.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+    unique_lock<mutex> lk(lp.lock);
+    if (!lp.created)
+	return ESP_ERR_INVALID_STATE;
+    if (lp.limit && lp.queue.size() >= lp.limit)
+    {
+	    auto room = [&lp]{ return lp.queue.size() < lp.limit || lp.deleted; };
+
+	if (ticks == portMAX_DELAY)
+	    lp.cond.wait(lk, room);
+	else if (!lp.cond.wait_for(lk, chrono::duration<double, milli>(sim::host_ms(ticks * portTICK_PERIOD_MS)), room))
+	    return ESP_ERR_TIMEOUT;
+	if (lp.deleted)
+	    return ESP_ERR_INVALID_STATE;
+    }; /* if the queue is full */
+    lp.queue.push_back(std::move(ev));
+    lp.cond.notify_all();
+    return ESP_OK;
+}; /* esp_event_post_to() */
+
+esp_err_t esp_event_post(esp_event_base_t base, int32_t id, const void* data, size_t size, TickType_t ticks)
+{
+    return esp_event_post_to(nullptr, base, id, data, size, ticks);
+}; /* esp_event_post() */
+
+
+namespace sim
+{
+    namespace detail
+    {
+	void post(esp_event_base_t base, int32_t id, const void* data, size_t size)
+	{
+	    esp_event_post(base, id, data, size, 0);
+	}; /* sim::detail::post() */
+
+	/// the default loop first: it's handlers may forward the events to the user loops
+	void settle_events()
+	{
+		vector<loop_t*> all;
+	    {
+		lock_guard<mutex> lk(loops_lock);
+		all = loops;
+	    }
+	    for (auto lp: all)
+	    {
+		unique_lock<mutex> lk(lp->lock);
+		lp->cond.wait(lk, [lp]{ return (lp->queue.empty() && !lp->busy) || lp->deleted; });
+	    }; /* for lp */
+	}; /* sim::detail::settle_events() */
+
+	void reset_events()
+	{
+	    lock_guard<mutex> lk(loop.lock);
+	    loop.queue.clear();
+	    loop.handlers.clear();
+	}; /* sim::detail::reset_events() */
+
+    }; /* namespace sim::detail */
+
+}; /* namespace sim */
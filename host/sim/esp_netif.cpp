@@ -0,0 +1,442 @@
+/*
+ * @file esp_netif.cpp
+ *
+ * @brief Host simulation of the ESP-IDF esp_netif: ip information, DHCP client & server status;
+ *	  the DHCP exchange & the static ip announcing are the jobs of the simulated driver task
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <nvs.h>
+
+#include "sdkconfig.h"
+#include "sim_internal.hpp"
+
+using namespace std;
+
+ESP_EVENT_DEFINE_BASE(IP_EVENT);
+
+
+namespace
+{
+    vector<esp_netif_t*> netifs;
+
+    /// post the IP_EVENT_STA_GOT_IP (the got ip event of the netif) with the current ip of the netif
+    void got_ip(esp_netif_t* netif, bool changed)
+    {
+	    ip_event_got_ip_t evt{};
+
+	evt.esp_netif = netif;
+	evt.ip_info = netif->ip;
+	evt.ip_changed = changed;
+	sim::mark(netif->got_ip_event == IP_EVENT_ETH_GOT_IP? "IP_EVENT_ETH_GOT_IP": "IP_EVENT_STA_GOT_IP");
+	sim::detail::post(IP_EVENT, netif->got_ip_event, &evt, sizeof(evt));
+    }; /* got_ip() */
+
+    /// the subnet of the DHCP server of the netif: the wired network or the connected AP
+    uint32_t subnet(esp_netif_t* netif)
+    {
+	return netif->eth? sim::detail::eth_subnet(): sim::detail::sta_subnet();
+    }; /* subnet() */
+
+    /// the address of the netif in the NVS of the lwIP dhcp_state.c (CONFIG_LWIP_DHCP_RESTORE_LAST_IP):
+    /// read at the start of the client, written on the bind, erased on the NAK
+    uint32_t dhcp_state(esp_netif_t* netif, bool write = false, uint32_t ip = 0)
+    {
+	    char key[6];
+	    nvs_handle_t nvs;
+	    uint32_t stored = 0;
+
+	if (esp_netif_get_netif_impl_name(netif, key) != ESP_OK
+		|| nvs_open("dhcp_state", write? NVS_READWRITE: NVS_READONLY, &nvs) != ESP_OK)
+	    return 0;
+	if (!write)
+	    nvs_get_u32(nvs, key, &stored);
+	else if ((ip? nvs_set_u32(nvs, key, ip): nvs_erase_key(nvs, key)) == ESP_OK)
+	    nvs_commit(nvs);
+	nvs_close(nvs);
+	return stored;
+    }; /* dhcp_state() */
+
+    /// start the simulated DHCP exchange on the netif with the link up: the address, restored by the lwIP,
+    /// is requested by the INIT-REBOOT, the full exchange follows the NAK of the address of the other subnet
+    void dhcp_run(esp_netif_t* netif)
+    {
+	    sim::backend_scope inside;
+	    uint32_t link = netif->link;
+
+	sim::detail::job([netif, link]{
+	    if (!subnet(netif))
+		return;		// no DHCP server: the DISCOVER is not answered
+
+		uint32_t requested = 0;
+		bool acked = false;
+
+#ifdef CONFIG_LWIP_DHCP_RESTORE_LAST_IP
+	    requested = dhcp_state(netif);
+#endif
+	    if (requested)
+	    {
+		sim::sleep(sim::delays().dhcp_reboot);
+		acked = (requested & 0x00ffffff) == subnet(netif);
+		if (!acked)
+		    dhcp_state(netif, true);
+	    }; /* if requested */
+	    if (!acked)
+		sim::sleep(sim::delays().dhcp);
+	    {
+		lock_guard<recursive_mutex> lk(sim::detail::lock());
+		if (netif->link != link || !netif->up || netif->dhcpc != ESP_NETIF_DHCP_STARTED)
+		    return;
+		(acked? sim::detail::count().dhcp_reboots: sim::detail::count().dhcp)++;
+		sim::detail::count().dhcp_naks += requested && !acked;
+		netif->old_ip = netif->ip;
+		netif->ip.ip.addr = acked? requested: subnet(netif) | (netif->lease << 24);
+		netif->ip.netmask.addr = ESP_IP4TOADDR(255, 255, 255, 0);
+		netif->ip.gw.addr = subnet(netif) | (1 << 24);
+		got_ip(netif, netif->old_ip.ip.addr != netif->ip.ip.addr);
+	    }
+#ifdef CONFIG_LWIP_DHCP_RESTORE_LAST_IP
+	    dhcp_state(netif, true, netif->ip.ip.addr);
+#endif
+	});
+    }; /* dhcp_run() */
+
+    /// announce the static ip on the netif with the link up
+    void static_run(esp_netif_t* netif)
+    {
+	    sim::backend_scope inside;
+	    uint32_t link = netif->link;
+
+	sim::detail::job([netif, link]{
+	    sim::sleep(sim::delays().static_ip);
+
+	    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	    if (netif->link != link || !netif->up || netif->ip.ip.addr == 0)
+		return;
+	    got_ip(netif, true);
+	});
+    }; /* static_run() */
+
+}; /* namespace <anonymous> */
+
+
+namespace sim
+{
+    namespace detail
+    {
+
+	void link_up(esp_netif_t* netif)
+	{
+	    lock_guard<recursive_mutex> lk(lock());
+	    netif->up = true;
+	    netif->link++;
+	    if ((netif->flags & ESP_NETIF_DHCP_CLIENT) && netif->dhcpc != ESP_NETIF_DHCP_STOPPED)
+	    {
+		netif->dhcpc = ESP_NETIF_DHCP_STARTED;
+		dhcp_run(netif);
+	    } /* if dhcp client is not stopped */
+	    else if (netif->ip.ip.addr != 0)
+		static_run(netif);
+	}; /* sim::detail::link_up() */
+
+	void link_down(esp_netif_t* netif)
+	{
+	    lock_guard<recursive_mutex> lk(lock());
+	    netif->up = false;
+	    netif->link++;
+	}; /* sim::detail::link_down() */
+
+	void reset_netif()
+	{
+	    lock_guard<recursive_mutex> lk(lock());
+	    for (auto netif: netifs)
+		delete netif;
+	    netifs.clear();
+	    sta_netif() = nullptr;
+	}; /* sim::detail::reset_netif() */
+
+    }; /* namespace sim::detail */
+
+}; /* namespace sim */
+
+
+
+esp_err_t esp_netif_init(void)
+{
+    return ESP_OK;
+}; /* esp_netif_init() */
+
+esp_netif_t *esp_netif_new(const esp_netif_config_t *config)
+{
+    if (!config || !config->base)
+	return nullptr;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    esp_netif_t* netif = new esp_netif_obj;
+    netif->flags = config->base->flags;
+    netif->got_ip_event = config->base->get_ip_event;
+    if (config->base->ip_info)
+	netif->ip = *config->base->ip_info;
+    netifs.push_back(netif);
+    return netif;
+}; /* esp_netif_new() */
+
+void esp_netif_destroy(esp_netif_t *netif)
+{
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    for (auto it = netifs.begin(); it != netifs.end(); it++)
+	if (*it == netif)
+	{
+	    if (sim::detail::sta_netif() == netif)
+		sim::detail::sta_netif() = nullptr;
+	    if (sim::detail::ap_netif() == netif)
+		sim::detail::ap_netif() = nullptr;
+	    netifs.erase(it);
+	    delete netif;
+	    return;
+	}; /* if *it == netif */
+}; /* esp_netif_destroy() */
+
+esp_netif_flags_t esp_netif_get_flags(esp_netif_t *netif)
+{
+    sim::mark("esp_netif_get_flags");
+    sim::detail::api_delay();
+    return netif? netif->flags: static_cast<esp_netif_flags_t>(0);
+}; /* esp_netif_get_flags() */
+
+bool esp_netif_is_netif_up(esp_netif_t *netif)
+{
+    sim::detail::api_delay();
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    return netif && netif->up;
+}; /* esp_netif_is_netif_up() */
+
+
+esp_err_t esp_netif_set_ip_info(esp_netif_t *netif, const esp_netif_ip_info_t *ip_info)
+{
+    sim::mark("esp_netif_set_ip_info");
+    sim::detail::api_delay();
+    if (!netif || !ip_info)
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if ((netif->flags & ESP_NETIF_DHCP_CLIENT) && netif->dhcpc != ESP_NETIF_DHCP_STOPPED)
+	return ESP_ERR_ESP_NETIF_DHCP_NOT_STOPPED;
+    netif->old_ip = netif->ip;
+    netif->ip = *ip_info;
+    if (netif->up && netif->ip.ip.addr != 0)
+	static_run(netif);
+    return ESP_OK;
+}; /* esp_netif_set_ip_info() */
+
+/// the name of the lwIP netif: "st", "ap" or "en" & the number of the netif, the loopback is the 0
+esp_err_t esp_netif_get_netif_impl_name(esp_netif_t *netif, char* name)
+{
+    if (!netif || !name)
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    for (size_t i = 0; i < netifs.size(); i++)
+	if (netifs[i] == netif)
+	{
+	    snprintf(name, 6, "%s%u", netif->wifi_if == WIFI_IF_STA? "st": netif->wifi_if == WIFI_IF_AP? "ap": "en",
+		    unsigned(i + 1) % 10);
+	    return ESP_OK;
+	}; /* if netifs[i] == netif */
+    return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+}; /* esp_netif_get_netif_impl_name() */
+
+esp_err_t esp_netif_get_ip_info(esp_netif_t *netif, esp_netif_ip_info_t *ip_info)
+{
+    sim::mark("esp_netif_get_ip_info");
+    sim::detail::api_delay();
+    if (!netif || !ip_info)
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    *ip_info = netif->ip;
+    return ESP_OK;
+}; /* esp_netif_get_ip_info() */
+
+esp_err_t esp_netif_set_old_ip_info(esp_netif_t *netif, const esp_netif_ip_info_t *ip_info)
+{
+    sim::detail::api_delay();
+    if (!netif || !ip_info)
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    netif->old_ip = *ip_info;
+    return ESP_OK;
+}; /* esp_netif_set_old_ip_info() */
+
+esp_err_t esp_netif_get_old_ip_info(esp_netif_t *netif, esp_netif_ip_info_t *ip_info)
+{
+    sim::detail::api_delay();
+    if (!netif || !ip_info)
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    *ip_info = netif->old_ip;
+    return ESP_OK;
+}; /* esp_netif_get_old_ip_info() */
+
+
+esp_err_t esp_netif_dhcpc_start(esp_netif_t *netif)
+{
+    sim::mark("esp_netif_dhcpc_start");
+    sim::detail::api_delay();
+    if (!netif || !(netif->flags & ESP_NETIF_DHCP_CLIENT))
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (netif->dhcpc == ESP_NETIF_DHCP_STARTED)
+	return ESP_ERR_ESP_NETIF_DHCP_ALREADY_STARTED;
+    netif->dhcpc = ESP_NETIF_DHCP_STARTED;
+    if (netif->up)
+	dhcp_run(netif);
+    return ESP_OK;
+}; /* esp_netif_dhcpc_start() */
+
+esp_err_t esp_netif_dhcpc_stop(esp_netif_t *netif)
+{
+    sim::mark("esp_netif_dhcpc_stop");
+    sim::detail::api_delay();
+    if (!netif || !(netif->flags & ESP_NETIF_DHCP_CLIENT))
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (netif->dhcpc == ESP_NETIF_DHCP_STOPPED)
+	return ESP_ERR_ESP_NETIF_DHCP_ALREADY_STOPPED;
+    netif->dhcpc = ESP_NETIF_DHCP_STOPPED;
+    netif->ip = esp_netif_ip_info_t{};
+    return ESP_OK;
+}; /* esp_netif_dhcpc_stop() */
+
+esp_err_t esp_netif_dhcpc_get_status(esp_netif_t *netif, esp_netif_dhcp_status_t *status)
+{
+    sim::mark("esp_netif_dhcpc_get_status");
+    sim::detail::api_delay();
+    if (!netif || !status)
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    *status = netif->dhcpc;
+    return ESP_OK;
+}; /* esp_netif_dhcpc_get_status() */
+
+esp_err_t esp_netif_dhcpc_option(esp_netif_t *netif, esp_netif_dhcp_option_mode_t opt_op,
+		esp_netif_dhcp_option_id_t opt_id, void *opt_val, uint32_t opt_len)
+{
+    sim::mark("esp_netif_dhcpc_option");
+    sim::detail::api_delay();
+    if (!netif)
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+    if (opt_op == ESP_NETIF_OP_GET && opt_id == ESP_NETIF_IP_ADDRESS_LEASE_TIME && opt_val && opt_len >= sizeof(uint32_t))
+    {
+	lock_guard<recursive_mutex> lk(sim::detail::lock());
+	*static_cast<uint32_t*>(opt_val) = netif->ip.ip.addr? sim::delays().lease_s: 0;
+    }; /* if ESP_NETIF_IP_ADDRESS_LEASE_TIME */
+    return ESP_OK;
+}; /* esp_netif_dhcpc_option() */
+
+
+esp_err_t esp_netif_dhcps_start(esp_netif_t *netif)
+{
+    sim::mark("esp_netif_dhcps_start");
+    sim::detail::api_delay();
+    if (!netif || !(netif->flags & ESP_NETIF_DHCP_SERVER))
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (netif->dhcps == ESP_NETIF_DHCP_STARTED)
+	return ESP_ERR_ESP_NETIF_DHCP_ALREADY_STARTED;
+    netif->dhcps = ESP_NETIF_DHCP_STARTED;
+    return ESP_OK;
+}; /* esp_netif_dhcps_start() */
+
+esp_err_t esp_netif_dhcps_stop(esp_netif_t *netif)
+{
+    sim::mark("esp_netif_dhcps_stop");
+    sim::detail::api_delay();
+    if (!netif || !(netif->flags & ESP_NETIF_DHCP_SERVER))
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (netif->dhcps == ESP_NETIF_DHCP_STOPPED)
+	return ESP_ERR_ESP_NETIF_DHCP_ALREADY_STOPPED;
+    netif->dhcps = ESP_NETIF_DHCP_STOPPED;
+    return ESP_OK;
+}; /* esp_netif_dhcps_stop() */
+
+esp_err_t esp_netif_dhcps_get_status(esp_netif_t *netif, esp_netif_dhcp_status_t *status)
+{
+    sim::mark("esp_netif_dhcps_get_status");
+    sim::detail::api_delay();
+    if (!netif || !status)
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    *status = netif->dhcps;
+    return ESP_OK;
+}; /* esp_netif_dhcps_get_status() */
+
+esp_err_t esp_netif_dhcps_option(esp_netif_t *netif, esp_netif_dhcp_option_mode_t opt_op,
+		esp_netif_dhcp_option_id_t opt_id, void *opt_val, uint32_t opt_len)
+{
+    sim::mark("esp_netif_dhcps_option");
+    sim::detail::api_delay();
+    if (!netif || !opt_val)
+	return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (opt_op == ESP_NETIF_OP_SET && netif->dhcps == ESP_NETIF_DHCP_STARTED)
+	return ESP_ERR_ESP_NETIF_DHCP_ALREADY_STARTED;	// as the esp_netif: the options of the stopped server only
+    switch (opt_id)
+    {
+    case ESP_NETIF_REQUESTED_IP_ADDRESS:
+	if (opt_len < sizeof(dhcps_lease_t))
+	    return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+	if (opt_op == ESP_NETIF_OP_SET)
+	    netif->pool = *static_cast<dhcps_lease_t*>(opt_val);
+	else
+	    *static_cast<dhcps_lease_t*>(opt_val) = netif->pool;
+	return ESP_OK;
+
+    case ESP_NETIF_IP_ADDRESS_LEASE_TIME:
+	if (opt_len < sizeof(uint32_t))
+	    return ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+	if (opt_op == ESP_NETIF_OP_SET)
+	    netif->lease_min = *static_cast<uint32_t*>(opt_val);
+	else
+	    *static_cast<uint32_t*>(opt_val) = netif->lease_min;
+	return ESP_OK;
+
+    default:
+	return ESP_OK;
+    }; /* switch opt_id */
+}; /* esp_netif_dhcps_option() */
+
+
+esp_err_t esp_netif_create_ip6_linklocal(esp_netif_t *netif)
+{
+    return netif? ESP_OK: ESP_ERR_ESP_NETIF_INVALID_PARAMS;
+}; /* esp_netif_create_ip6_linklocal() */
+
+
+char *esp_ip4addr_ntoa(const esp_ip4_addr_t *addr, char *buf, int buflen)
+{
+    if (!addr || !buf)
+	return nullptr;
+    snprintf(buf, buflen, IPSTR, IP2STR(addr));
+    return buf;
+}; /* esp_ip4addr_ntoa() */
+
+uint32_t esp_ip4addr_aton(const char *addr)
+{
+	unsigned a, b, c, d;
+
+    if (!addr || sscanf(addr, "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 || b > 255 || c > 255 || d > 255)
+	return 0xffffffffUL;	// IPADDR_NONE, as in lwIP ipaddr_addr()
+    return ESP_IP4TOADDR(a, b, c, d);
+}; /* esp_ip4addr_aton() */
@@ -0,0 +1,600 @@
+/*
+ * @file esp_wifi.cpp
+ *
+ * @brief Host simulation of the ESP-IDF WiFi driver: station of the simulated access points.
+ *	  Connection (scan, PMK derivation, association) runs as the job of the simulated driver task.
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <strings.h>
+#include <string>
+#include <vector>
+
+#include <esp_wifi.h>
+#include <esp_netif.h>
+
+#include "sim_internal.hpp"
+
+using namespace std;
+
+ESP_EVENT_DEFINE_BASE(WIFI_EVENT);
+
+
+namespace
+{
+    constexpr int channels = 13;
+
+    struct
+    {
+	bool		inited  = false;
+	bool		started = false;
+	bool		connected = false;
+	wifi_mode_t	mode	= WIFI_MODE_NULL;
+	wifi_storage_t	storage	= WIFI_STORAGE_FLASH;
+	wifi_config_t	sta {};
+	wifi_config_t	ap {};
+	wifi_config_t	flashed {};	///< STA configuration, stored to the flash
+	uint32_t	attempt = 0;	///< generation of the connection attempt
+	int		ap_idx	= -1;	///< index of the connected AP
+	string		pmk;		///< key of the last derived PMK: ssid + passphrase
+	vector<sim::ap_t> aps;
+	vector<string>	psk;		///< PSK of the each AP
+	vector<wifi_sta_info_t> peers;	///< stations of the soft-AP
+	vector<uint8_t>	aids;		///< AID of the each station of the soft-AP
+    } state;
+
+    esp_netif_t* sta_netif_ptr = nullptr;
+    esp_netif_t* ap_netif_ptr = nullptr;
+    uint32_t sta_subnet_val = 0;
+
+    string cstr(const uint8_t buf[], size_t maxlen)
+    {
+	return string(reinterpret_cast<const char*>(buf), strnlen(reinterpret_cast<const char*>(buf), maxlen));
+    }; /* cstr() */
+
+    /// post the WIFI_EVENT_STA_DISCONNECTED with the reason
+    void disconnected(const wifi_sta_config_t& cfg, uint8_t reason)
+    {
+	    wifi_event_sta_disconnected_t evt{};
+
+	memcpy(evt.ssid, cfg.ssid, sizeof(evt.ssid));
+	evt.ssid_len = strnlen(reinterpret_cast<const char*>(cfg.ssid), sizeof(cfg.ssid));
+	memcpy(evt.bssid, cfg.bssid, sizeof(evt.bssid));
+	evt.reason = reason;
+	evt.rssi = -100;
+	sim::mark("WIFI_EVENT_STA_DISCONNECTED");
+	sim::detail::post(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, &evt, sizeof(evt));
+    }; /* disconnected() */
+
+    /// the channel is scanned: find the AP with the ssid (and bssid, if set)
+    int find(const wifi_sta_config_t& cfg, int channel)
+    {
+	    string ssid = cstr(cfg.ssid, sizeof(cfg.ssid));
+
+	for (size_t i = 0; i < state.aps.size(); i++)
+	    if (state.aps[i].channel == channel && state.aps[i].ssid == ssid
+		    && (!cfg.bssid_set || memcmp(state.aps[i].bssid, cfg.bssid, sizeof(cfg.bssid)) == 0))
+		return i;
+	return -1;
+    }; /* find() */
+
+    /// the scan phase of the connection: fast scan stops on the first found AP
+    int scan(const wifi_sta_config_t& cfg, uint32_t attempt)
+    {
+	    int idx = -1;
+	    bool full = cfg.channel == 0 || cfg.scan_method == WIFI_ALL_CHANNEL_SCAN;
+
+	if (cfg.channel > 0 && cfg.channel <= channels)
+	{
+	    sim::sleep(sim::delays().scan_chan);
+	    idx = find(cfg, cfg.channel);
+	    if (idx >= 0 && cfg.scan_method == WIFI_FAST_SCAN)
+		return idx;
+	    full = true;
+	}; /* if cfg.channel */
+
+	if (full)
+	{
+	    {
+		lock_guard<recursive_mutex> lk(sim::detail::lock());
+		sim::detail::count().full_scans++;
+	    }
+	    for (int ch = 1; ch <= channels; ch++)
+	    {
+		if (ch == cfg.channel)
+		    continue;
+		if (state.attempt != attempt)
+		    return -1;
+		sim::sleep(sim::delays().scan_chan);
+		if (idx < 0)
+		    idx = find(cfg, ch);
+		if (idx >= 0 && cfg.scan_method == WIFI_FAST_SCAN)
+		    break;
+	    }; /* for ch */
+	}; /* if full */
+	return idx;
+    }; /* scan() */
+
+    /// the password is the PSK: 64 hex digits
+    bool is_psk(const string& pwd)
+    {
+	return pwd.size() == 64 && pwd.find_first_not_of("0123456789abcdefABCDEF") == string::npos;
+    }; /* is_psk() */
+
+    /// the PSK of the AP, 64 hex digits; derived once, on the adding of the AP
+    string derive_psk(const sim::ap_t& ap)
+    {
+	    uint8_t pmk[32];
+	    char hex[65];
+
+	sim::detail::pbkdf2_sha1(reinterpret_cast<const uint8_t*>(ap.passphrase.data()), ap.passphrase.size(),
+		reinterpret_cast<const uint8_t*>(ap.ssid.data()), ap.ssid.size(), 4096, pmk, sizeof(pmk));
+	for (size_t i = 0; i < sizeof(pmk); i++)
+	    snprintf(hex + i * 2, 3, "%02x", pmk[i]);
+	return hex;
+    }; /* derive_psk() */
+
+    /// the credentials are valid for the AP; the PMK derivation from the passphrase costs time,
+    /// the PSK (64 hex digits) is used as is
+    bool authenticate(const wifi_sta_config_t& cfg, const sim::ap_t& ap)
+    {
+	    string pwd = cstr(cfg.password, sizeof(cfg.password));
+	    string key = ap.ssid + '\0' + pwd;
+
+	if (is_psk(pwd))
+	    return strcasecmp(pwd.c_str(), state.psk[&ap - state.aps.data()].c_str()) == 0;
+	if (state.pmk != key)
+	{
+	    sim::sleep(sim::delays().pbkdf2);
+	    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	    sim::detail::count().pbkdf2++;
+	    state.pmk = key;
+	}; /* if state.pmk != key */
+	return pwd == ap.passphrase;
+    }; /* authenticate() */
+
+    /// the connection job of the simulated driver task
+    void connection(wifi_sta_config_t cfg, uint32_t attempt)
+    {
+	{
+	    lock_guard<recursive_mutex> lk(sim::detail::lock());
+	    sim::detail::count().connects++;
+	}
+	int idx = scan(cfg, attempt);
+
+	if (state.attempt != attempt)
+	    return;
+	if (idx < 0)
+	{
+	    disconnected(cfg, WIFI_REASON_NO_AP_FOUND);
+	    return;
+	}; /* if idx < 0 */
+
+	if (!authenticate(cfg, state.aps[idx]))
+	{
+	    sim::sleep(sim::delays().auth_fail);
+	    if (state.attempt == attempt)
+		disconnected(cfg, WIFI_REASON_HANDSHAKE_TIMEOUT);
+	    return;
+	}; /* if !authenticate() */
+
+	sim::sleep(sim::delays().assoc);
+
+	lock_guard<recursive_mutex> lk(sim::detail::lock());
+	if (state.attempt != attempt)
+	    return;
+
+	    const sim::ap_t& ap = state.aps[idx];
+	    wifi_event_sta_connected_t evt{};
+
+	state.connected = true;
+	state.ap_idx = idx;
+	memcpy(evt.ssid, ap.ssid.c_str(), min(ap.ssid.size(), sizeof(evt.ssid)));
+	evt.ssid_len = min(ap.ssid.size(), sizeof(evt.ssid));
+	memcpy(evt.bssid, ap.bssid, sizeof(evt.bssid));
+	evt.channel = ap.channel;
+	evt.authmode = ap.passphrase.empty()? WIFI_AUTH_OPEN: WIFI_AUTH_WPA2_PSK;
+	evt.aid = 1;
+	sim::mark("WIFI_EVENT_STA_CONNECTED");
+	sim::detail::post(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, &evt, sizeof(evt));
+
+	sim::detail::sta_subnet() = ap.subnet;
+	if (sim::detail::sta_netif())
+	    sim::detail::link_up(sim::detail::sta_netif());
+    }; /* connection() */
+
+    /// index of the station of the soft-AP, -1 - not joined; call under the lock
+    int peer(const uint8_t mac[6])
+    {
+	for (size_t i = 0; i < state.peers.size(); i++)
+	    if (memcmp(state.peers[i].mac, mac, sizeof(state.peers[i].mac)) == 0)
+		return i;
+	return -1;
+    }; /* peer() */
+
+}; /* namespace <anonymous> */
+
+
+namespace sim
+{
+    ap_t make_ap(const char* ssid, const char* passphrase, uint8_t channel, uint8_t net, uint8_t id)
+    {
+	    ap_t ap;
+	    uint8_t bssid[6] = {0x24, 0x0a, 0xc4, 0x00, 0x00, id};
+
+	ap.ssid = ssid;
+	ap.passphrase = passphrase;
+	ap.channel = channel;
+	memcpy(ap.bssid, bssid, sizeof(bssid));
+	ap.subnet = ESP_IP4TOADDR(192, 168, net, 0);
+	return ap;
+    }; /* sim::make_ap() */
+
+    wifi_config_t flashed_sta()
+    {
+	lock_guard<recursive_mutex> lk(detail::lock());
+	return state.flashed;
+    }; /* sim::flashed_sta() */
+
+    void add_ap(const ap_t& ap)
+    {
+	lock_guard<recursive_mutex> lk(detail::lock());
+	state.aps.push_back(ap);
+	state.psk.push_back(derive_psk(ap));
+    }; /* sim::add_ap() */
+
+    void move_ap(const ap_t& ap)
+    {
+	lock_guard<recursive_mutex> lk(detail::lock());
+	for (size_t i = 0; i < state.aps.size(); i++)
+	    if (state.aps[i].ssid == ap.ssid)
+	    {
+		state.aps[i] = ap;
+		state.psk[i] = derive_psk(ap);
+	    }; /* if state.aps[i].ssid == ap.ssid */
+    }; /* sim::move_ap() */
+
+    bool ap_join(const uint8_t mac[6], int8_t rssi)
+    {
+	    wifi_event_ap_staconnected_t conn{};
+	    ip_event_ap_staipassigned_t assigned{};
+	{
+	    lock_guard<recursive_mutex> lk(detail::lock());
+		size_t limit = state.ap.ap.max_connection? min<size_t>(state.ap.ap.max_connection, ESP_WIFI_MAX_CONN_NUM):
+			ESP_WIFI_MAX_CONN_NUM;
+
+	    if (!state.started || (state.mode != WIFI_MODE_AP && state.mode != WIFI_MODE_APSTA)
+		    || peer(mac) >= 0 || state.peers.size() >= limit)
+		return false;
+
+		wifi_sta_info_t info{};
+		uint8_t aid = 1;
+
+	    while (find(state.aids.begin(), state.aids.end(), aid) != state.aids.end())
+		aid++;
+	    memcpy(info.mac, mac, sizeof(info.mac));
+	    info.rssi = rssi;
+	    info.phy_11n = 1;
+	    state.peers.push_back(info);
+	    state.aids.push_back(aid);
+
+	    memcpy(conn.mac, mac, sizeof(conn.mac));
+	    conn.aid = aid;
+	    memcpy(assigned.mac, mac, sizeof(assigned.mac));
+	    assigned.esp_netif = ap_netif_ptr;
+	    assigned.ip.addr = (ap_netif_ptr && ap_netif_ptr->pool.enable)?
+		    esp_netif_htonl(esp_netif_htonl(ap_netif_ptr->pool.start_ip.addr) + aid - 1):
+		    ESP_IP4TOADDR(192, 168, 4, 1 + aid);
+	}
+	sim::mark("WIFI_EVENT_AP_STACONNECTED");
+	detail::post(WIFI_EVENT, WIFI_EVENT_AP_STACONNECTED, &conn, sizeof(conn));
+	sim::mark("IP_EVENT_AP_STAIPASSIGNED");
+	detail::post(IP_EVENT, IP_EVENT_AP_STAIPASSIGNED, &assigned, sizeof(assigned));
+	return true;
+    }; /* sim::ap_join() */
+
+    void ap_leave(const uint8_t mac[6], uint8_t reason, bool notify)
+    {
+	    wifi_event_ap_stadisconnected_t evt{};
+	{
+	    lock_guard<recursive_mutex> lk(detail::lock());
+		int i = peer(mac);
+
+	    if (i < 0)
+		return;
+	    memcpy(evt.mac, mac, sizeof(evt.mac));
+	    evt.aid = state.aids[i];
+	    evt.reason = reason;
+	    state.peers.erase(state.peers.begin() + i);
+	    state.aids.erase(state.aids.begin() + i);
+	}
+	if (!notify)
+	    return;
+	sim::mark("WIFI_EVENT_AP_STADISCONNECTED");
+	detail::post(WIFI_EVENT, WIFI_EVENT_AP_STADISCONNECTED, &evt, sizeof(evt));
+    }; /* sim::ap_leave() */
+
+    void ap_rssi(const uint8_t mac[6], int8_t rssi)
+    {
+	lock_guard<recursive_mutex> lk(detail::lock());
+	    int i = peer(mac);
+
+	if (i >= 0)
+	    state.peers[i].rssi = rssi;
+    }; /* sim::ap_rssi() */
+
+    namespace detail
+    {
+	esp_netif_t*& sta_netif() { return sta_netif_ptr; };
+
+	esp_netif_t*& ap_netif() { return ap_netif_ptr; };
+
+	uint32_t& sta_subnet() { return sta_subnet_val; };
+
+	void reset_wifi()
+	{
+	    lock_guard<recursive_mutex> lk(lock());
+	    state.attempt++;
+	    state.inited = state.started = state.connected = false;
+	    state.mode = WIFI_MODE_NULL;
+	    state.storage = WIFI_STORAGE_FLASH;
+	    state.sta = state.ap = state.flashed = wifi_config_t{};
+	    state.ap_idx = -1;
+	    state.pmk.clear();
+	    state.aps.clear();
+	    state.psk.clear();
+	    state.peers.clear();
+	    state.aids.clear();
+	    ap_netif_ptr = nullptr;
+	}; /* sim::detail::reset_wifi() */
+
+    }; /* namespace sim::detail */
+
+}; /* namespace sim */
+
+
+
+esp_err_t esp_wifi_init(const wifi_init_config_t *config)
+{
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    state.inited = true;
+    return ESP_OK;
+}; /* esp_wifi_init() */
+
+esp_err_t esp_wifi_deinit(void)
+{
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (state.started)
+	return ESP_ERR_WIFI_NOT_STOPPED;
+    state.inited = false;
+    return ESP_OK;
+}; /* esp_wifi_deinit() */
+
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode)
+{
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (!state.inited)
+	return ESP_ERR_WIFI_NOT_INIT;
+    state.mode = mode;
+    return ESP_OK;
+}; /* esp_wifi_set_mode() */
+
+esp_err_t esp_wifi_get_mode(wifi_mode_t *mode)
+{
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (!state.inited)
+	return ESP_ERR_WIFI_NOT_INIT;
+    *mode = state.mode;
+    return ESP_OK;
+}; /* esp_wifi_get_mode() */
+
+esp_err_t esp_wifi_start(void)
+{
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (!state.inited)
+	return ESP_ERR_WIFI_NOT_INIT;
+    state.started = true;
+    if (state.mode == WIFI_MODE_STA || state.mode == WIFI_MODE_APSTA)
+	sim::detail::post(WIFI_EVENT, WIFI_EVENT_STA_START);
+    if (state.mode == WIFI_MODE_AP || state.mode == WIFI_MODE_APSTA)
+	sim::detail::post(WIFI_EVENT, WIFI_EVENT_AP_START);
+    return ESP_OK;
+}; /* esp_wifi_start() */
+
+esp_err_t esp_wifi_stop(void)
+{
+    esp_wifi_disconnect();
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    state.started = false;
+    sim::detail::post(WIFI_EVENT, WIFI_EVENT_STA_STOP);
+    if (state.mode == WIFI_MODE_AP || state.mode == WIFI_MODE_APSTA)
+	sim::detail::post(WIFI_EVENT, WIFI_EVENT_AP_STOP);
+    state.peers.clear();
+    state.aids.clear();
+    return ESP_OK;
+}; /* esp_wifi_stop() */
+
+esp_err_t esp_wifi_restore(void)
+{
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    state.sta = state.ap = wifi_config_t{};
+    return ESP_OK;
+}; /* esp_wifi_restore() */
+
+esp_err_t esp_wifi_connect(void)
+{
+    sim::mark("esp_wifi_connect");
+    sim::detail::api_delay();
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (!state.inited)
+	return ESP_ERR_WIFI_NOT_INIT;
+    if (!state.started)
+	return ESP_ERR_WIFI_NOT_STARTED;
+    if (state.mode != WIFI_MODE_STA && state.mode != WIFI_MODE_APSTA)
+	return ESP_ERR_WIFI_MODE;
+
+    uint32_t attempt = ++state.attempt;
+    wifi_sta_config_t cfg = state.sta.sta;
+    sim::backend_scope inside;
+    sim::detail::job([cfg, attempt]{ connection(cfg, attempt); });
+    return ESP_OK;
+}; /* esp_wifi_connect() */
+
+esp_err_t esp_wifi_disconnect(void)
+{
+    sim::mark("esp_wifi_disconnect");
+    sim::detail::api_delay();
+
+	bool connected;
+    {
+	lock_guard<recursive_mutex> lk(sim::detail::lock());
+	if (!state.inited)
+	    return ESP_ERR_WIFI_NOT_INIT;
+	if (!state.started)
+	    return ESP_ERR_WIFI_NOT_STARTED;
+	state.attempt++;
+	connected = state.connected;
+	state.connected = false;
+	state.ap_idx = -1;
+	if (connected && sim::detail::sta_netif())
+	    sim::detail::link_down(sim::detail::sta_netif());
+    }
+
+    if (connected)
+    {
+	sim::sleep(sim::delays().disconnect);
+	disconnected(state.sta.sta, WIFI_REASON_ASSOC_LEAVE);
+    }; /* if connected */
+    return ESP_OK;
+}; /* esp_wifi_disconnect() */
+
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t *conf)
+{
+    sim::mark("esp_wifi_set_config");
+    sim::detail::api_delay();
+    if (!conf)
+	return ESP_ERR_INVALID_ARG;
+
+	bool flash;
+    {
+	lock_guard<recursive_mutex> lk(sim::detail::lock());
+	if (!state.inited)
+	    return ESP_ERR_WIFI_NOT_INIT;
+	if (interface == WIFI_IF_STA)
+	    state.sta = *conf;
+	else if (interface == WIFI_IF_AP)
+	    state.ap = *conf;
+	else
+	    return ESP_ERR_WIFI_IF;
+	flash = (state.storage == WIFI_STORAGE_FLASH);
+	if (flash)
+	    sim::detail::count().nvs_writes++;
+	if (flash && interface == WIFI_IF_STA)
+	    state.flashed = *conf;
+    }
+    sim::sleep(sim::delays().set_config + (flash? sim::delays().nvs_write: 0));
+    return ESP_OK;
+}; /* esp_wifi_set_config() */
+
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t *conf)
+{
+    sim::mark("esp_wifi_get_config");
+    sim::detail::api_delay();
+    if (!conf)
+	return ESP_ERR_INVALID_ARG;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (!state.inited)
+	return ESP_ERR_WIFI_NOT_INIT;
+    if (interface == WIFI_IF_STA)
+	*conf = state.sta;
+    else if (interface == WIFI_IF_AP)
+	*conf = state.ap;
+    else
+	return ESP_ERR_WIFI_IF;
+    return ESP_OK;
+}; /* esp_wifi_get_config() */
+
+esp_err_t esp_wifi_set_storage(wifi_storage_t storage)
+{
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (!state.inited)
+	return ESP_ERR_WIFI_NOT_INIT;
+    state.storage = storage;
+    return ESP_OK;
+}; /* esp_wifi_set_storage() */
+
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t *ap_info)
+{
+    sim::detail::api_delay();
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (!state.connected || state.ap_idx < 0)
+	return ESP_ERR_WIFI_NOT_CONNECT;
+
+	const sim::ap_t& ap = state.aps[state.ap_idx];
+
+    *ap_info = wifi_ap_record_t{};
+    memcpy(ap_info->bssid, ap.bssid, sizeof(ap_info->bssid));
+    memcpy(ap_info->ssid, ap.ssid.c_str(), min(ap.ssid.size(), sizeof(ap_info->ssid) - 1));
+    ap_info->primary = ap.channel;
+    ap_info->rssi = ap.rssi;
+    ap_info->authmode = ap.passphrase.empty()? WIFI_AUTH_OPEN: WIFI_AUTH_WPA2_PSK;
+    return ESP_OK;
+}; /* esp_wifi_sta_get_ap_info() */
+
+esp_err_t esp_wifi_ap_get_sta_list(wifi_sta_list_t *sta)
+{
+    sim::mark("esp_wifi_ap_get_sta_list");
+    sim::detail::api_delay();
+    if (!sta)
+	return ESP_ERR_INVALID_ARG;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    if (!state.inited)
+	return ESP_ERR_WIFI_NOT_INIT;
+    if (state.mode != WIFI_MODE_AP && state.mode != WIFI_MODE_APSTA)
+	return ESP_ERR_WIFI_MODE;
+    *sta = wifi_sta_list_t{};
+    for (auto& info: state.peers)
+	sta->sta[sta->num++] = info;
+    return ESP_OK;
+}; /* esp_wifi_ap_get_sta_list() */
+
+
+esp_netif_t* esp_netif_create_wifi(wifi_interface_t wifi_if, const esp_netif_inherent_config_t *config)
+{
+	esp_netif_config_t cfg{config, nullptr, nullptr};
+	esp_netif_t* netif = esp_netif_new(&cfg);
+
+    if (netif)
+    {
+	lock_guard<recursive_mutex> lk(sim::detail::lock());
+	netif->wifi_if = wifi_if;
+	if (wifi_if == WIFI_IF_STA)
+	    sim::detail::sta_netif() = netif;
+	else if (wifi_if == WIFI_IF_AP)
+	    ap_netif_ptr = netif;
+    }; /* if netif */
+    return netif;
+}; /* esp_netif_create_wifi() */
+
+esp_err_t esp_wifi_set_default_wifi_sta_handlers(void)
+{
+    return ESP_OK;
+}; /* esp_wifi_set_default_wifi_sta_handlers() */
+
+esp_err_t esp_wifi_set_default_wifi_ap_handlers(void)
+{
+    return ESP_OK;
+}; /* esp_wifi_set_default_wifi_ap_handlers() */
+
+esp_err_t esp_wifi_clear_default_wifi_driver_and_handlers(void *esp_netif)
+{
+    return ESP_OK;
+}; /* esp_wifi_clear_default_wifi_driver_and_handlers() */
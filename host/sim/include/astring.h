@@ -0,0 +1,22 @@
+/*
+ * @file astring.h
+ *
+ * @brief Host stand-in of the 'utils' component string helpers
+ */
+
+#ifndef _SIM_ASTRING_H_
+#define _SIM_ASTRING_H_
+
+#include <string>
+
+namespace astr
+{
+    /// @brief the string is confirmation: "yes", "on", "true", "1"...
+    bool confirm(const std::string& str);
+
+    /// @brief the string is declination: "no", "off", "false", "0"...
+    bool decline(const std::string& str);
+
+}; /* namespace astr */
+
+#endif /* _SIM_ASTRING_H_ */
@@ -0,0 +1,90 @@
+/*
+ * @file esp_eth.h
+ *
+ * @brief Host simulation of the ESP-IDF Ethernet driver API (subset, used by the 'net' component):
+ *	  the driver, it's events & the glue to the esp_netif. The simulated driver has no MAC & PHY:
+ *	  the link is up after the autonegotiation delay while the simulated cable is plugged, see sim::eth_cable()
+ */
+
+#ifndef _SIM_ESP_ETH_H_
+#define _SIM_ESP_ETH_H_
+
+#include "esp_err.h"
+#include "esp_types.h"
+#include "esp_event.h"
+#include "esp_netif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void* esp_eth_handle_t;
+
+typedef struct esp_eth_mac_s esp_eth_mac_t;
+typedef struct esp_eth_phy_s esp_eth_phy_t;
+
+typedef struct {
+    esp_eth_mac_t *mac;			///< not used by the simulated driver, may be NULL
+    esp_eth_phy_t *phy;			///< not used by the simulated driver, may be NULL
+    uint32_t check_link_period_ms;
+} esp_eth_config_t;
+
+#define ETH_DEFAULT_CONFIG(emac, ephy)	\
+    {					\
+	.mac = emac,			\
+	.phy = ephy,			\
+	.check_link_period_ms = 2000,	\
+    }
+
+typedef enum {
+    ETHERNET_EVENT_START,
+    ETHERNET_EVENT_STOP,
+    ETHERNET_EVENT_CONNECTED,
+    ETHERNET_EVENT_DISCONNECTED,
+} eth_event_t;
+
+ESP_EVENT_DECLARE_BASE(ETH_EVENT);
+
+typedef enum {
+    ETH_CMD_G_MAC_ADDR,
+    ETH_CMD_S_MAC_ADDR,
+    ETH_CMD_G_PHY_ADDR,
+    ETH_CMD_S_PHY_ADDR,
+    ETH_CMD_G_AUTONEGO,
+    ETH_CMD_S_AUTONEGO,
+    ETH_CMD_G_SPEED,
+    ETH_CMD_S_SPEED,
+    ETH_CMD_S_PROMISCUOUS,
+    ETH_CMD_S_FLOW_CTRL,
+    ETH_CMD_G_DUPLEX_MODE,
+    ETH_CMD_S_DUPLEX_MODE,
+    ETH_CMD_S_PHY_LOOPBACK,
+} esp_eth_io_cmd_t;
+
+typedef enum {
+    ETH_SPEED_10M,
+    ETH_SPEED_100M,
+    ETH_SPEED_MAX
+} eth_speed_t;
+
+typedef enum {
+    ETH_DUPLEX_HALF,
+    ETH_DUPLEX_FULL,
+} eth_duplex_t;
+
+esp_err_t esp_eth_driver_install(const esp_eth_config_t *config, esp_eth_handle_t *out_hdl);
+esp_err_t esp_eth_driver_uninstall(esp_eth_handle_t hdl);
+esp_err_t esp_eth_start(esp_eth_handle_t hdl);
+esp_err_t esp_eth_stop(esp_eth_handle_t hdl);
+esp_err_t esp_eth_ioctl(esp_eth_handle_t hdl, esp_eth_io_cmd_t cmd, void *data);
+
+typedef struct esp_eth_netif_glue_t* esp_eth_netif_glue_handle_t;
+
+esp_eth_netif_glue_handle_t esp_eth_new_netif_glue(esp_eth_handle_t eth_hdl);
+esp_err_t esp_eth_del_netif_glue(esp_eth_netif_glue_handle_t eth_netif_glue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_ESP_ETH_H_ */
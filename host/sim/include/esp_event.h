@@ -0,0 +1,74 @@
+/*
+ * @file esp_event.h
+ *
+ * @brief Host simulation of the ESP-IDF event loop library:
+ *	  the default & the user event loops are served by the own host threads
+ */
+
+#ifndef _SIM_ESP_EVENT_H_
+#define _SIM_ESP_EVENT_H_
+
+#include "esp_err.h"
+#include "esp_types.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"		// as the freertos/queue.h of the ESP-IDF
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef const char*  esp_event_base_t;
+typedef void*        esp_event_loop_handle_t;
+typedef void         (*esp_event_handler_t)(void* event_handler_arg,
+					    esp_event_base_t event_base,
+					    int32_t event_id,
+					    void* event_data);
+typedef void*        esp_event_handler_instance_t;
+
+#define ESP_EVENT_DECLARE_BASE(id) extern esp_event_base_t const id
+#define ESP_EVENT_DEFINE_BASE(id) esp_event_base_t const id = #id
+
+#define ESP_EVENT_ANY_BASE     NULL
+#define ESP_EVENT_ANY_ID       -1
+
+/// arguments of the user event loop; the priority & the core of the task are ignored by the host
+typedef struct {
+    int32_t	 queue_size;
+    const char*	 task_name;	///< NULL - the loop w/o the task, not supported by the host
+    UBaseType_t	 task_priority;
+    uint32_t	 task_stack_size;
+    BaseType_t	 task_core_id;
+} esp_event_loop_args_t;
+
+esp_err_t esp_event_loop_create(const esp_event_loop_args_t* event_loop_args, esp_event_loop_handle_t* event_loop);
+esp_err_t esp_event_loop_delete(esp_event_loop_handle_t event_loop);
+
+esp_err_t esp_event_loop_create_default(void);
+esp_err_t esp_event_loop_delete_default(void);
+
+esp_err_t esp_event_handler_register(esp_event_base_t event_base, int32_t event_id,
+				     esp_event_handler_t event_handler, void* event_handler_arg);
+esp_err_t esp_event_handler_unregister(esp_event_base_t event_base, int32_t event_id,
+				       esp_event_handler_t event_handler);
+esp_err_t esp_event_handler_instance_register(esp_event_base_t event_base, int32_t event_id,
+					      esp_event_handler_t event_handler, void* event_handler_arg,
+					      esp_event_handler_instance_t* instance);
+esp_err_t esp_event_handler_instance_unregister(esp_event_base_t event_base, int32_t event_id,
+						esp_event_handler_instance_t instance);
+
+esp_err_t esp_event_handler_instance_register_with(esp_event_loop_handle_t event_loop, esp_event_base_t event_base,
+						   int32_t event_id, esp_event_handler_t event_handler,
+						   void* event_handler_arg, esp_event_handler_instance_t* instance);
+esp_err_t esp_event_handler_instance_unregister_with(esp_event_loop_handle_t event_loop, esp_event_base_t event_base,
+						     int32_t event_id, esp_event_handler_instance_t instance);
+
+esp_err_t esp_event_post(esp_event_base_t event_base, int32_t event_id,
+			 const void* event_data, size_t event_data_size, TickType_t ticks_to_wait);
+esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t event_base, int32_t event_id,
+			    const void* event_data, size_t event_data_size, TickType_t ticks_to_wait);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_ESP_EVENT_H_ */
@@ -0,0 +1,224 @@
+/*
+ * @file esp_netif.h
+ *
+ * @brief Host simulation of the ESP-IDF network interface API (subset, used by the 'net' component)
+ */
+
+#ifndef _SIM_ESP_NETIF_H_
+#define _SIM_ESP_NETIF_H_
+
+#include "esp_err.h"
+#include "esp_types.h"
+#include "esp_event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_ERR_ESP_NETIF_BASE			0x5000
+#define ESP_ERR_ESP_NETIF_INVALID_PARAMS	ESP_ERR_ESP_NETIF_BASE + 0x01
+#define ESP_ERR_ESP_NETIF_IF_NOT_READY		ESP_ERR_ESP_NETIF_BASE + 0x02
+#define ESP_ERR_ESP_NETIF_DHCPC_START_FAILED	ESP_ERR_ESP_NETIF_BASE + 0x03
+#define ESP_ERR_ESP_NETIF_DHCP_ALREADY_STARTED	ESP_ERR_ESP_NETIF_BASE + 0x04
+#define ESP_ERR_ESP_NETIF_DHCP_ALREADY_STOPPED	ESP_ERR_ESP_NETIF_BASE + 0x05
+#define ESP_ERR_ESP_NETIF_NO_MEM		ESP_ERR_ESP_NETIF_BASE + 0x06
+#define ESP_ERR_ESP_NETIF_DHCP_NOT_STOPPED	ESP_ERR_ESP_NETIF_BASE + 0x07
+
+typedef struct esp_ip4_addr {
+    uint32_t addr;	///< IPv4 address, network byte order
+} esp_ip4_addr_t;
+
+typedef struct {
+    esp_ip4_addr_t ip;
+    esp_ip4_addr_t netmask;
+    esp_ip4_addr_t gw;
+} esp_netif_ip_info_t;
+
+#define esp_netif_ip4_makeu32(a,b,c,d) (((uint32_t)((a) & 0xff) << 24) | \
+					((uint32_t)((b) & 0xff) << 16) | \
+					((uint32_t)((c) & 0xff) << 8)  | \
+					 (uint32_t)((d) & 0xff))
+#define ESP_IP4TOADDR(a,b,c,d)	esp_netif_htonl(esp_netif_ip4_makeu32(a,b,c,d))
+#define esp_netif_htonl(x)	__builtin_bswap32(x)
+
+#define esp_ip4_addr_get_byte(ipaddr, idx) (((const uint8_t*)(&(ipaddr)->addr))[idx])
+#define esp_ip4_addr1(ipaddr) esp_ip4_addr_get_byte(ipaddr, 0)
+#define esp_ip4_addr2(ipaddr) esp_ip4_addr_get_byte(ipaddr, 1)
+#define esp_ip4_addr3(ipaddr) esp_ip4_addr_get_byte(ipaddr, 2)
+#define esp_ip4_addr4(ipaddr) esp_ip4_addr_get_byte(ipaddr, 3)
+
+#define IPSTR "%d.%d.%d.%d"
+#define IP2STR(ipaddr) esp_ip4_addr1(ipaddr), esp_ip4_addr2(ipaddr), esp_ip4_addr3(ipaddr), esp_ip4_addr4(ipaddr)
+
+typedef struct esp_netif_obj esp_netif_t;
+
+typedef enum esp_netif_flags {
+    ESP_NETIF_DHCP_CLIENT = 1 << 0,
+    ESP_NETIF_DHCP_SERVER = 1 << 1,
+    ESP_NETIF_FLAG_AUTOUP = 1 << 2,
+    ESP_NETIF_FLAG_GARP   = 1 << 3,
+    ESP_NETIF_FLAG_EVENT_IP_MODIFIED = 1 << 4,
+    ESP_NETIF_FLAG_IS_PPP = 1 << 5,
+    ESP_NETIF_FLAG_IS_SLIP = 1 << 6,
+} esp_netif_flags_t;
+
+typedef enum {
+    ESP_NETIF_DHCP_INIT = 0,
+    ESP_NETIF_DHCP_STARTED,
+    ESP_NETIF_DHCP_STOPPED,
+    ESP_NETIF_DHCP_STATUS_MAX
+} esp_netif_dhcp_status_t;
+
+typedef enum {
+    ESP_NETIF_OP_START = 0,
+    ESP_NETIF_OP_SET,
+    ESP_NETIF_OP_GET,
+    ESP_NETIF_OP_MAX
+} esp_netif_dhcp_option_mode_t;
+
+typedef enum {
+    ESP_NETIF_SUBNET_MASK			= 1,
+    ESP_NETIF_DOMAIN_NAME_SERVER		= 6,
+    ESP_NETIF_ROUTER_SOLICITATION_ADDRESS	= 32,
+    ESP_NETIF_REQUESTED_IP_ADDRESS		= 50,
+    ESP_NETIF_IP_ADDRESS_LEASE_TIME		= 51,
+    ESP_NETIF_IP_REQUEST_RETRY_TIME		= 52,
+    ESP_NETIF_VENDOR_CLASS_IDENTIFIER		= 60,
+    ESP_NETIF_VENDOR_SPECIFIC_INFO		= 43,
+} esp_netif_dhcp_option_id_t;
+
+/// @brief DHCP server address pool (ESP_NETIF_REQUESTED_IP_ADDRESS option of the server)
+typedef struct {
+    bool enable;
+    esp_ip4_addr_t start_ip;
+    esp_ip4_addr_t end_ip;
+} dhcps_lease_t;
+
+typedef struct esp_netif_inherent_config {
+    esp_netif_flags_t flags;
+    uint8_t mac[6];
+    const esp_netif_ip_info_t* ip_info;
+    uint32_t get_ip_event;
+    uint32_t lost_ip_event;
+    const char * if_key;
+    const char * if_desc;
+    int route_prio;
+} esp_netif_inherent_config_t;
+
+typedef struct esp_netif_driver_ifconfig esp_netif_driver_ifconfig_t;
+typedef struct esp_netif_netstack_config esp_netif_netstack_config_t;
+
+typedef struct esp_netif_config {
+    const esp_netif_inherent_config_t *base;
+    const esp_netif_driver_ifconfig_t *driver;
+    const esp_netif_netstack_config_t *stack;
+} esp_netif_config_t;
+
+/// IP event declarations
+typedef enum {
+    IP_EVENT_STA_GOT_IP,
+    IP_EVENT_STA_LOST_IP,
+    IP_EVENT_AP_STAIPASSIGNED,
+    IP_EVENT_GOT_IP6,
+    IP_EVENT_ETH_GOT_IP,
+    IP_EVENT_ETH_LOST_IP,
+    IP_EVENT_PPP_GOT_IP,
+    IP_EVENT_PPP_LOST_IP,
+} ip_event_t;
+
+ESP_EVENT_DECLARE_BASE(IP_EVENT);
+
+typedef struct {
+    int if_index;
+    esp_netif_t *esp_netif;
+    esp_netif_ip_info_t ip_info;
+    bool ip_changed;
+} ip_event_got_ip_t;
+
+typedef struct {
+    esp_netif_t *esp_netif;
+    esp_ip4_addr_t ip;
+    uint8_t mac[6];
+} ip_event_ap_staipassigned_t;
+
+#define ESP_NETIF_INHERENT_DEFAULT_WIFI_STA()				\
+    {									\
+	.flags = (esp_netif_flags_t)(ESP_NETIF_DHCP_CLIENT | ESP_NETIF_FLAG_GARP | ESP_NETIF_FLAG_EVENT_IP_MODIFIED), \
+	.mac = { 0 },							\
+	.ip_info = NULL,						\
+	.get_ip_event = IP_EVENT_STA_GOT_IP,				\
+	.lost_ip_event = IP_EVENT_STA_LOST_IP,				\
+	.if_key = "WIFI_STA_DEF",					\
+	.if_desc = "sta",						\
+	.route_prio = 100						\
+    }
+
+#define ESP_NETIF_INHERENT_DEFAULT_WIFI_AP()				\
+    {									\
+	.flags = (esp_netif_flags_t)(ESP_NETIF_DHCP_SERVER | ESP_NETIF_FLAG_AUTOUP), \
+	.mac = { 0 },							\
+	.ip_info = NULL,						\
+	.get_ip_event = 0,						\
+	.lost_ip_event = 0,						\
+	.if_key = "WIFI_AP_DEF",					\
+	.if_desc = "ap",						\
+	.route_prio = 10						\
+    }
+
+#define ESP_NETIF_INHERENT_DEFAULT_ETH()				\
+    {									\
+	.flags = (esp_netif_flags_t)(ESP_NETIF_DHCP_CLIENT | ESP_NETIF_FLAG_GARP | ESP_NETIF_FLAG_EVENT_IP_MODIFIED), \
+	.mac = { 0 },							\
+	.ip_info = NULL,						\
+	.get_ip_event = IP_EVENT_ETH_GOT_IP,				\
+	.lost_ip_event = IP_EVENT_ETH_LOST_IP,				\
+	.if_key = "ETH_DEF",						\
+	.if_desc = "eth",						\
+	.route_prio = 50						\
+    }
+
+/// the network stack of the simulated netif is not configurable
+#define ESP_NETIF_NETSTACK_DEFAULT_ETH	NULL
+
+/// handle of the driver (the glue of the driver), attached to the netif
+typedef void* esp_netif_iodriver_handle;
+
+esp_err_t esp_netif_init(void);
+
+esp_netif_t *esp_netif_new(const esp_netif_config_t *esp_netif_config);
+void esp_netif_destroy(esp_netif_t *esp_netif);
+
+esp_netif_flags_t esp_netif_get_flags(esp_netif_t *esp_netif);
+
+esp_err_t esp_netif_set_ip_info(esp_netif_t *esp_netif, const esp_netif_ip_info_t *ip_info);
+esp_err_t esp_netif_get_ip_info(esp_netif_t *esp_netif, esp_netif_ip_info_t *ip_info);
+esp_err_t esp_netif_get_netif_impl_name(esp_netif_t *esp_netif, char* name);
+esp_err_t esp_netif_set_old_ip_info(esp_netif_t *esp_netif, const esp_netif_ip_info_t *ip_info);
+esp_err_t esp_netif_get_old_ip_info(esp_netif_t *esp_netif, esp_netif_ip_info_t *ip_info);
+
+esp_err_t esp_netif_dhcpc_start(esp_netif_t *esp_netif);
+esp_err_t esp_netif_dhcpc_stop(esp_netif_t *esp_netif);
+esp_err_t esp_netif_dhcpc_get_status(esp_netif_t *esp_netif, esp_netif_dhcp_status_t *status);
+esp_err_t esp_netif_dhcpc_option(esp_netif_t *esp_netif, esp_netif_dhcp_option_mode_t opt_op,
+				 esp_netif_dhcp_option_id_t opt_id, void *opt_val, uint32_t opt_len);
+
+esp_err_t esp_netif_dhcps_start(esp_netif_t *esp_netif);
+esp_err_t esp_netif_dhcps_stop(esp_netif_t *esp_netif);
+esp_err_t esp_netif_dhcps_get_status(esp_netif_t *esp_netif, esp_netif_dhcp_status_t *status);
+esp_err_t esp_netif_dhcps_option(esp_netif_t *esp_netif, esp_netif_dhcp_option_mode_t opt_op,
+				 esp_netif_dhcp_option_id_t opt_id, void *opt_val, uint32_t opt_len);
+
+bool esp_netif_is_netif_up(esp_netif_t *esp_netif);
+
+esp_err_t esp_netif_attach(esp_netif_t *esp_netif, esp_netif_iodriver_handle driver_handle);
+
+esp_err_t esp_netif_create_ip6_linklocal(esp_netif_t *esp_netif);
+
+char *esp_ip4addr_ntoa(const esp_ip4_addr_t *addr, char *buf, int buflen);
+uint32_t esp_ip4addr_aton(const char *addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_ESP_NETIF_H_ */
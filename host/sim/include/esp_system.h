@@ -0,0 +1,13 @@
+/*
+ * @file esp_system.h
+ *
+ * @brief Host simulation of the ESP-IDF system header
+ */
+
+#ifndef _SIM_ESP_SYSTEM_H_
+#define _SIM_ESP_SYSTEM_H_
+
+#include "esp_err.h"
+#include "esp_types.h"
+
+#endif /* _SIM_ESP_SYSTEM_H_ */
@@ -0,0 +1,48 @@
+/*
+ * @file esp_timer.h
+ *
+ * @brief Host simulation of the ESP-IDF high resolution timer: simulated time, microseconds
+ */
+
+#ifndef _SIM_ESP_TIMER_H_
+#define _SIM_ESP_TIMER_H_
+
+#include "esp_err.h"
+#include "esp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct esp_timer* esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void* arg);
+
+typedef enum {
+    ESP_TIMER_TASK,
+    ESP_TIMER_ISR,
+    ESP_TIMER_MAX,
+} esp_timer_dispatch_t;
+
+typedef struct {
+    esp_timer_cb_t	 callback;
+    void*		 arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char*		 name;
+    bool		 skip_unhandled_events;
+} esp_timer_create_args_t;
+
+/// @brief simulated time since start, in microseconds
+int64_t esp_timer_get_time(void);
+
+/// @brief one-shot timers of the simulated time; callbacks are called from the own host thread
+esp_err_t esp_timer_create(const esp_timer_create_args_t* create_args, esp_timer_handle_t* out_handle);
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us);
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+esp_err_t esp_timer_delete(esp_timer_handle_t timer);
+bool esp_timer_is_active(esp_timer_handle_t timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_ESP_TIMER_H_ */
@@ -0,0 +1,14 @@
+/*
+ * @file esp_types.h
+ *
+ * @brief Host simulation of the ESP-IDF common types header
+ */
+
+#ifndef _SIM_ESP_TYPES_H_
+#define _SIM_ESP_TYPES_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#endif /* _SIM_ESP_TYPES_H_ */
@@ -0,0 +1,91 @@
+/*
+ * @file esp_wifi.h
+ *
+ * @brief Host simulation of the ESP-IDF WiFi driver API (subset, used by the 'net' component)
+ */
+
+#ifndef _SIM_ESP_WIFI_H_
+#define _SIM_ESP_WIFI_H_
+
+#include "esp_err.h"
+#include "esp_wifi_types.h"
+#include "esp_netif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_ERR_WIFI_NOT_INIT    (ESP_ERR_WIFI_BASE + 1)
+#define ESP_ERR_WIFI_NOT_STARTED (ESP_ERR_WIFI_BASE + 2)
+#define ESP_ERR_WIFI_NOT_STOPPED (ESP_ERR_WIFI_BASE + 3)
+#define ESP_ERR_WIFI_IF          (ESP_ERR_WIFI_BASE + 4)
+#define ESP_ERR_WIFI_MODE        (ESP_ERR_WIFI_BASE + 5)
+#define ESP_ERR_WIFI_STATE       (ESP_ERR_WIFI_BASE + 6)
+#define ESP_ERR_WIFI_CONN        (ESP_ERR_WIFI_BASE + 7)
+#define ESP_ERR_WIFI_NVS         (ESP_ERR_WIFI_BASE + 8)
+#define ESP_ERR_WIFI_MAC         (ESP_ERR_WIFI_BASE + 9)
+#define ESP_ERR_WIFI_SSID        (ESP_ERR_WIFI_BASE + 10)
+#define ESP_ERR_WIFI_PASSWORD    (ESP_ERR_WIFI_BASE + 11)
+#define ESP_ERR_WIFI_TIMEOUT     (ESP_ERR_WIFI_BASE + 12)
+#define ESP_ERR_WIFI_WAKE_FAIL   (ESP_ERR_WIFI_BASE + 13)
+#define ESP_ERR_WIFI_WOULD_BLOCK (ESP_ERR_WIFI_BASE + 14)
+#define ESP_ERR_WIFI_NOT_CONNECT (ESP_ERR_WIFI_BASE + 15)
+#define ESP_ERR_WIFI_POST        (ESP_ERR_WIFI_BASE + 18)
+#define ESP_ERR_WIFI_INIT_STATE  (ESP_ERR_WIFI_BASE + 19)
+#define ESP_ERR_WIFI_STOP_STATE  (ESP_ERR_WIFI_BASE + 20)
+#define ESP_ERR_WIFI_NOT_ASSOC   (ESP_ERR_WIFI_BASE + 21)
+#define ESP_ERR_WIFI_TX_DISALLOW (ESP_ERR_WIFI_BASE + 22)
+
+typedef struct {
+    int static_rx_buf_num;
+    int dynamic_rx_buf_num;
+    int tx_buf_type;
+    int static_tx_buf_num;
+    int dynamic_tx_buf_num;
+    int magic;
+} wifi_init_config_t;
+
+#define WIFI_INIT_CONFIG_MAGIC	0x1F2F3F4F
+#define WIFI_INIT_CONFIG_DEFAULT() { \
+    .static_rx_buf_num = 10,	    \
+    .dynamic_rx_buf_num = 32,	    \
+    .tx_buf_type = 1,		    \
+    .static_tx_buf_num = 0,	    \
+    .dynamic_tx_buf_num = 32,	    \
+    .magic = WIFI_INIT_CONFIG_MAGIC \
+}
+
+typedef struct {
+    uint8_t bssid[6];
+    uint8_t ssid[33];
+    uint8_t primary;
+    int8_t  rssi;
+    wifi_auth_mode_t authmode;
+} wifi_ap_record_t;
+
+esp_err_t esp_wifi_init(const wifi_init_config_t *config);
+esp_err_t esp_wifi_deinit(void);
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode);
+esp_err_t esp_wifi_get_mode(wifi_mode_t *mode);
+esp_err_t esp_wifi_start(void);
+esp_err_t esp_wifi_stop(void);
+esp_err_t esp_wifi_restore(void);
+esp_err_t esp_wifi_connect(void);
+esp_err_t esp_wifi_disconnect(void);
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t *conf);
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t *conf);
+esp_err_t esp_wifi_set_storage(wifi_storage_t storage);
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t *ap_info);
+esp_err_t esp_wifi_ap_get_sta_list(wifi_sta_list_t *sta);
+
+/// esp_wifi_default.h
+esp_netif_t* esp_netif_create_wifi(wifi_interface_t wifi_if, const esp_netif_inherent_config_t *esp_netif_config);
+esp_err_t esp_wifi_set_default_wifi_sta_handlers(void);
+esp_err_t esp_wifi_set_default_wifi_ap_handlers(void);
+esp_err_t esp_wifi_clear_default_wifi_driver_and_handlers(void *esp_netif);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_ESP_WIFI_H_ */
@@ -0,0 +1,270 @@
+/*
+ * @file esp_wifi_types.h
+ *
+ * @brief Host simulation of the ESP-IDF WiFi types (subset, used by the 'net' component)
+ */
+
+#ifndef _SIM_ESP_WIFI_TYPES_H_
+#define _SIM_ESP_WIFI_TYPES_H_
+
+#include "esp_types.h"
+#include "esp_event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    WIFI_MODE_NULL = 0,
+    WIFI_MODE_STA,
+    WIFI_MODE_AP,
+    WIFI_MODE_APSTA,
+    WIFI_MODE_MAX
+} wifi_mode_t;
+
+typedef enum {
+    WIFI_IF_STA = 0,
+    WIFI_IF_AP  = 1,
+} wifi_interface_t;
+
+typedef enum {
+    WIFI_AUTH_OPEN = 0,
+    WIFI_AUTH_WEP,
+    WIFI_AUTH_WPA_PSK,
+    WIFI_AUTH_WPA2_PSK,
+    WIFI_AUTH_WPA_WPA2_PSK,
+    WIFI_AUTH_WPA2_ENTERPRISE,
+    WIFI_AUTH_WPA3_PSK,
+    WIFI_AUTH_WPA2_WPA3_PSK,
+    WIFI_AUTH_WAPI_PSK,
+    WIFI_AUTH_OWE,
+    WIFI_AUTH_MAX
+} wifi_auth_mode_t;
+
+typedef enum {
+    WIFI_REASON_UNSPECIFIED                        = 1,
+    WIFI_REASON_AUTH_EXPIRE                        = 2,
+    WIFI_REASON_AUTH_LEAVE                         = 3,
+    WIFI_REASON_ASSOC_EXPIRE                       = 4,
+    WIFI_REASON_ASSOC_TOOMANY                      = 5,
+    WIFI_REASON_NOT_AUTHED                         = 6,
+    WIFI_REASON_NOT_ASSOCED                        = 7,
+    WIFI_REASON_ASSOC_LEAVE                        = 8,
+    WIFI_REASON_ASSOC_NOT_AUTHED                   = 9,
+    WIFI_REASON_DISASSOC_PWRCAP_BAD                = 10,
+    WIFI_REASON_DISASSOC_SUPCHAN_BAD               = 11,
+    WIFI_REASON_BSS_TRANSITION_DISASSOC            = 12,
+    WIFI_REASON_IE_INVALID                         = 13,
+    WIFI_REASON_MIC_FAILURE                        = 14,
+    WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT             = 15,
+    WIFI_REASON_GROUP_KEY_UPDATE_TIMEOUT           = 16,
+    WIFI_REASON_IE_IN_4WAY_DIFFERS                 = 17,
+    WIFI_REASON_GROUP_CIPHER_INVALID               = 18,
+    WIFI_REASON_PAIRWISE_CIPHER_INVALID            = 19,
+    WIFI_REASON_AKMP_INVALID                       = 20,
+    WIFI_REASON_UNSUPP_RSN_IE_VERSION              = 21,
+    WIFI_REASON_INVALID_RSN_IE_CAP                 = 22,
+    WIFI_REASON_802_1X_AUTH_FAILED                 = 23,
+    WIFI_REASON_CIPHER_SUITE_REJECTED              = 24,
+    WIFI_REASON_TDLS_PEER_UNREACHABLE              = 25,
+    WIFI_REASON_TDLS_UNSPECIFIED                   = 26,
+    WIFI_REASON_SSP_REQUESTED_DISASSOC             = 27,
+    WIFI_REASON_NO_SSP_ROAMING_AGREEMENT           = 28,
+    WIFI_REASON_BAD_CIPHER_OR_AKM                  = 29,
+    WIFI_REASON_NOT_AUTHORIZED_THIS_LOCATION       = 30,
+    WIFI_REASON_SERVICE_CHANGE_PERCLUDES_TS        = 31,
+    WIFI_REASON_UNSPECIFIED_QOS                    = 32,
+    WIFI_REASON_NOT_ENOUGH_BANDWIDTH               = 33,
+    WIFI_REASON_MISSING_ACKS                       = 34,
+    WIFI_REASON_EXCEEDED_TXOP                      = 35,
+    WIFI_REASON_STA_LEAVING                        = 36,
+    WIFI_REASON_END_BA                             = 37,
+    WIFI_REASON_UNKNOWN_BA                         = 38,
+    WIFI_REASON_TIMEOUT                            = 39,
+    WIFI_REASON_PEER_INITIATED                     = 46,
+    WIFI_REASON_AP_INITIATED                       = 47,
+    WIFI_REASON_INVALID_FT_ACTION_FRAME_COUNT      = 48,
+    WIFI_REASON_INVALID_PMKID                      = 49,
+    WIFI_REASON_INVALID_MDE                        = 50,
+    WIFI_REASON_INVALID_FTE                        = 51,
+    WIFI_REASON_TRANSMISSION_LINK_ESTABLISH_FAILED = 67,
+    WIFI_REASON_ALTERATIVE_CHANNEL_OCCUPIED        = 68,
+
+    WIFI_REASON_BEACON_TIMEOUT                     = 200,
+    WIFI_REASON_NO_AP_FOUND                        = 201,
+    WIFI_REASON_AUTH_FAIL                          = 202,
+    WIFI_REASON_ASSOC_FAIL                         = 203,
+    WIFI_REASON_HANDSHAKE_TIMEOUT                  = 204,
+    WIFI_REASON_CONNECTION_FAIL                    = 205,
+    WIFI_REASON_AP_TSF_RESET                       = 206,
+    WIFI_REASON_ROAMING                            = 207,
+    WIFI_REASON_ASSOC_COMEBACK_TIME_TOO_LONG       = 208,
+    WIFI_REASON_SA_QUERY_TIMEOUT                   = 209,
+} wifi_err_reason_t;
+
+typedef enum {
+    WIFI_CIPHER_TYPE_NONE = 0,
+    WIFI_CIPHER_TYPE_WEP40,
+    WIFI_CIPHER_TYPE_WEP104,
+    WIFI_CIPHER_TYPE_TKIP,
+    WIFI_CIPHER_TYPE_CCMP,
+    WIFI_CIPHER_TYPE_TKIP_CCMP,
+    WIFI_CIPHER_TYPE_AES_CMAC128,
+    WIFI_CIPHER_TYPE_SMS4,
+    WIFI_CIPHER_TYPE_GCMP,
+    WIFI_CIPHER_TYPE_GCMP256,
+    WIFI_CIPHER_TYPE_AES_GMAC128,
+    WIFI_CIPHER_TYPE_AES_GMAC256,
+    WIFI_CIPHER_TYPE_UNKNOWN,
+} wifi_cipher_type_t;
+
+typedef enum {
+    WIFI_FAST_SCAN = 0,
+    WIFI_ALL_CHANNEL_SCAN,
+} wifi_scan_method_t;
+
+typedef enum {
+    WIFI_CONNECT_AP_BY_SIGNAL = 0,
+    WIFI_CONNECT_AP_BY_SECURITY,
+} wifi_sort_method_t;
+
+typedef struct {
+    int8_t              rssi;
+    wifi_auth_mode_t    authmode;
+} wifi_scan_threshold_t;
+
+typedef struct {
+    bool capable;
+    bool required;
+} wifi_pmf_config_t;
+
+typedef enum {
+    WPA3_SAE_PWE_UNSPECIFIED,
+    WPA3_SAE_PWE_HUNT_AND_PECK,
+    WPA3_SAE_PWE_HASH_TO_ELEMENT,
+    WPA3_SAE_PWE_BOTH,
+} wifi_sae_pwe_method_t;
+
+typedef struct {
+    uint8_t ssid[32];
+    uint8_t password[64];
+    uint8_t ssid_len;
+    uint8_t channel;
+    wifi_auth_mode_t authmode;
+    uint8_t ssid_hidden;
+    uint8_t max_connection;
+    uint16_t beacon_interval;
+    wifi_cipher_type_t pairwise_cipher;
+    bool ftm_responder;
+    wifi_pmf_config_t pmf_cfg;
+    wifi_sae_pwe_method_t sae_pwe_h2e;
+} wifi_ap_config_t;
+
+typedef struct {
+    uint8_t ssid[32];
+    uint8_t password[64];
+    wifi_scan_method_t scan_method;
+    bool bssid_set;
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint16_t listen_interval;
+    wifi_sort_method_t sort_method;
+    wifi_scan_threshold_t  threshold;
+    wifi_pmf_config_t pmf_cfg;
+    uint32_t rm_enabled:1;
+    uint32_t btm_enabled:1;
+    uint32_t mbo_enabled:1;
+    uint32_t ft_enabled:1;
+    uint32_t owe_enabled:1;
+    uint32_t transition_disable:1;
+    uint32_t reserved:26;
+    wifi_sae_pwe_method_t sae_pwe_h2e;
+    uint8_t failure_retry_cnt;
+} wifi_sta_config_t;
+
+typedef union {
+    wifi_ap_config_t  ap;
+    wifi_sta_config_t sta;
+} wifi_config_t;
+
+typedef struct {
+    uint8_t mac[6];
+    int8_t  rssi;
+    uint32_t phy_11b:1;
+    uint32_t phy_11g:1;
+    uint32_t phy_11n:1;
+    uint32_t phy_lr:1;
+    uint32_t is_mesh_child:1;
+    uint32_t reserved:27;
+} wifi_sta_info_t;
+
+#define ESP_WIFI_MAX_CONN_NUM  (15)
+
+typedef struct {
+    wifi_sta_info_t sta[ESP_WIFI_MAX_CONN_NUM];
+    int       num;
+} wifi_sta_list_t;
+
+typedef enum {
+    WIFI_STORAGE_FLASH,
+    WIFI_STORAGE_RAM,
+} wifi_storage_t;
+
+typedef enum {
+    WIFI_EVENT_WIFI_READY = 0,
+    WIFI_EVENT_SCAN_DONE,
+    WIFI_EVENT_STA_START,
+    WIFI_EVENT_STA_STOP,
+    WIFI_EVENT_STA_CONNECTED,
+    WIFI_EVENT_STA_DISCONNECTED,
+    WIFI_EVENT_STA_AUTHMODE_CHANGE,
+    WIFI_EVENT_STA_WPS_ER_SUCCESS,
+    WIFI_EVENT_STA_WPS_ER_FAILED,
+    WIFI_EVENT_STA_WPS_ER_TIMEOUT,
+    WIFI_EVENT_STA_WPS_ER_PIN,
+    WIFI_EVENT_STA_WPS_ER_PBC_OVERLAP,
+    WIFI_EVENT_AP_START,
+    WIFI_EVENT_AP_STOP,
+    WIFI_EVENT_AP_STACONNECTED,
+    WIFI_EVENT_AP_STADISCONNECTED,
+    WIFI_EVENT_AP_PROBEREQRECVED,
+    WIFI_EVENT_MAX,
+} wifi_event_t;
+
+ESP_EVENT_DECLARE_BASE(WIFI_EVENT);
+
+typedef struct {
+    uint8_t ssid[32];
+    uint8_t ssid_len;
+    uint8_t bssid[6];
+    uint8_t channel;
+    wifi_auth_mode_t authmode;
+    uint16_t aid;
+} wifi_event_sta_connected_t;
+
+typedef struct {
+    uint8_t ssid[32];
+    uint8_t ssid_len;
+    uint8_t bssid[6];
+    uint8_t reason;
+    int8_t  rssi;
+} wifi_event_sta_disconnected_t;
+
+typedef struct {
+    uint8_t mac[6];
+    uint8_t aid;
+    bool is_mesh_child;
+} wifi_event_ap_staconnected_t;
+
+typedef struct {
+    uint8_t mac[6];
+    uint8_t aid;
+    bool is_mesh_child;
+    uint8_t reason;
+} wifi_event_ap_stadisconnected_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_ESP_WIFI_TYPES_H_ */
@@ -0,0 +1,67 @@
+/*
+ * @file event_ctrl.hpp
+ *
+ * @brief Host stand-in of the 'utils' component event control helpers:
+ *	  waiting the esp_event with the semaphore & automatic (un)registering of the handler
+ */
+
+#ifndef _SIM_EVENT_CTRL_HPP_
+#define _SIM_EVENT_CTRL_HPP_
+
+#include <esp_event.h>
+
+#include <asemaphore>
+#include <sync.hpp>
+
+
+namespace event
+{
+    namespace sync
+    {
+	/// @brief static event waiter: the handler give the 'wait' semaphore on the event
+	class stat
+	{
+	public:
+	    stat(esp_event_base_t evbase, int32_t evid): base(evbase), id(evid) {};
+
+	    static void handler(void* arg, esp_event_base_t evbase, int32_t evid, void* data) {
+		static_cast<stat*>(arg)->wait.Give(); };
+
+	    const esp_event_base_t base;
+	    const int32_t id;
+	    Semaphore wait;
+	}; /* class event::sync::stat */
+
+    }; /* namespace event::sync */
+
+
+    /// @brief register/unregister the event handler of the waiter object
+    template <sync::stat& waiter>
+    class ctrl
+    {
+    public:
+	static esp_err_t enroll() {
+	    waiter.wait.Take(0);	// drop the stale event, if any
+	    return esp_event_handler_register(waiter.base, waiter.id, sync::stat::handler, &waiter); };
+
+	static esp_err_t unreg() {
+	    return esp_event_handler_unregister(waiter.base, waiter.id, sync::stat::handler); };
+
+	/// @brief unregister the handler automatically on leaving the scope
+	class automatic
+	{
+	public:
+	    ~automatic() { if (enrolled) unreg(); };
+	    esp_err_t enroll() {
+		esp_err_t err = ctrl::enroll();
+		enrolled = (err == ESP_OK);
+		return err; };
+	private:
+	    bool enrolled = false;
+	}; /* class event::ctrl::automatic */
+
+    }; /* class event::ctrl */
+
+}; /* namespace event */
+
+#endif /* _SIM_EVENT_CTRL_HPP_ */
@@ -0,0 +1,35 @@
+/*
+ * @file FreeRTOS.h
+ *
+ * @brief Host simulation of the FreeRTOS basic definitions;
+ *	  one tick is one millisecond of the simulated time
+ */
+
+#ifndef _SIM_FREERTOS_H_
+#define _SIM_FREERTOS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdFALSE			0
+#define pdTRUE			1
+#define pdPASS			pdTRUE
+#define pdFAIL			pdFALSE
+
+#define configTICK_RATE_HZ	1000
+#define portTICK_PERIOD_MS	((TickType_t) 1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY		((TickType_t) 0xffffffffUL)
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t) (((TickType_t) (xTimeInMs) * (TickType_t) configTICK_RATE_HZ) / (TickType_t) 1000U))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_FREERTOS_H_ */
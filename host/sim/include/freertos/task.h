@@ -0,0 +1,35 @@
+/*
+ * @file task.h
+ *
+ * @brief Host simulation of the FreeRTOS task API (subset)
+ */
+
+#ifndef _SIM_FREERTOS_TASK_H_
+#define _SIM_FREERTOS_TASK_H_
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void* TaskHandle_t;
+
+#define tskNO_AFFINITY		0x7FFFFFFF
+typedef void (*TaskFunction_t)(void*);
+
+/// @brief create the task as the detached host thread; the stack depth & the priority are ignored
+BaseType_t xTaskCreate(TaskFunction_t pvTaskCode, const char* const pcName, const uint32_t usStackDepth,
+	void* const pvParameters, UBaseType_t uxPriority, TaskHandle_t* const pxCreatedTask);
+
+/// @brief current tick count of the simulated time
+TickType_t xTaskGetTickCount(void);
+
+/// @brief delay the calling thread for the simulated number of ticks
+void vTaskDelay(const TickType_t xTicksToDelay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_FREERTOS_TASK_H_ */
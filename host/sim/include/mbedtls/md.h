@@ -0,0 +1,41 @@
+/*
+ * @file mbedtls/md.h
+ *
+ * @brief Host stand-in of the mbedTLS message digest types & HMAC-SHA1: only the part, used by the 'net' component
+ */
+
+#ifndef _SIM_MBEDTLS_MD_H_
+#define _SIM_MBEDTLS_MD_H_
+
+typedef enum {
+    MBEDTLS_MD_NONE = 0,
+    MBEDTLS_MD_MD5,
+    MBEDTLS_MD_SHA1,
+    MBEDTLS_MD_SHA224,
+    MBEDTLS_MD_SHA256,
+} mbedtls_md_type_t;
+
+#define MBEDTLS_ERR_MD_FEATURE_UNAVAILABLE -0x5080
+#define MBEDTLS_ERR_MD_BAD_INPUT_DATA      -0x5100
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mbedtls_md_info_t mbedtls_md_info_t;
+
+/// the info of the MBEDTLS_MD_SHA1 only, nullptr for the others
+const mbedtls_md_info_t *mbedtls_md_info_from_type(mbedtls_md_type_t md_type);
+
+int mbedtls_md_hmac(const mbedtls_md_info_t *md_info,
+		    const unsigned char *key, size_t keylen,
+		    const unsigned char *input, size_t ilen,
+		    unsigned char *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_MBEDTLS_MD_H_ */
@@ -0,0 +1,30 @@
+/*
+ * @file mbedtls/pkcs5.h
+ *
+ * @brief Host stand-in of the mbedTLS PKCS#5 PBKDF2: HMAC-SHA1 only.
+ *	  Each call costs the sim::delays_t::pbkdf2 of the simulated time, as on the ESP32.
+ */
+
+#ifndef _SIM_MBEDTLS_PKCS5_H_
+#define _SIM_MBEDTLS_PKCS5_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "md.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int mbedtls_pkcs5_pbkdf2_hmac_ext(mbedtls_md_type_t md_type,
+				  const unsigned char *password, size_t plen,
+				  const unsigned char *salt, size_t slen,
+				  unsigned int iteration_count,
+				  uint32_t key_length, unsigned char *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_MBEDTLS_PKCS5_H_ */
@@ -0,0 +1,46 @@
+/*
+ * @file nvs.h
+ *
+ * @brief Host simulation of the ESP-IDF NVS: blobs in the RAM of the host process,
+ *	  survive the sim::reset() as the NVS survives the reboot.
+ *	  Each nvs_commit() of the changed data costs the sim::delays_t::nvs_write;
+ *	  the nvs_set_u32() of the stored value changes nothing, as the NVS skips it.
+ */
+
+#ifndef _SIM_NVS_H_
+#define _SIM_NVS_H_
+
+#include "esp_err.h"
+#include "esp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_ERR_NVS_BASE		0x1100
+#define ESP_ERR_NVS_NOT_INITIALIZED	(ESP_ERR_NVS_BASE + 0x01)
+#define ESP_ERR_NVS_NOT_FOUND		(ESP_ERR_NVS_BASE + 0x02)
+#define ESP_ERR_NVS_INVALID_HANDLE	(ESP_ERR_NVS_BASE + 0x07)
+#define ESP_ERR_NVS_INVALID_LENGTH	(ESP_ERR_NVS_BASE + 0x0c)
+
+typedef uint32_t nvs_handle_t;
+
+typedef enum {
+    NVS_READONLY,
+    NVS_READWRITE
+} nvs_open_mode_t;
+
+esp_err_t nvs_open(const char* name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle);
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out_value, size_t* length);
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length);
+esp_err_t nvs_get_u32(nvs_handle_t handle, const char* key, uint32_t* out_value);
+esp_err_t nvs_set_u32(nvs_handle_t handle, const char* key, uint32_t value);
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char* key);
+esp_err_t nvs_commit(nvs_handle_t handle);
+void nvs_close(nvs_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_NVS_H_ */
@@ -0,0 +1,23 @@
+/*
+ * @file sdkconfig.h
+ *
+ * @brief Host simulation of the project configuration, used by the 'net' component.
+ *	  The timeouts are in seconds of the simulated time.
+ */
+
+#ifndef _SIM_SDKCONFIG_H_
+#define _SIM_SDKCONFIG_H_
+
+#define CONFIG_WIFI_STA_MAXIMUM_RETRY	    5
+#define CONFIG_WIFI_STA_WAITING_CONNECT	    10
+#define CONFIG_WIFI_STA_WAITING_IP	    10
+#define CONFIG_LWIP_DHCP_RESTORE_LAST_IP    1
+
+#define CONFIG_LOG_DEFAULT_LEVEL	    1
+
+#define CONFIG_ETH_USE_ESP32_EMAC	    1
+#define CONFIG_ETH_DMA_RX_BUFFER_NUM	    10
+#define CONFIG_ETH_DMA_TX_BUFFER_NUM	    10
+#define CONFIG_ETH_DMA_BUFFER_SIZE	    512
+
+#endif /* _SIM_SDKCONFIG_H_ */
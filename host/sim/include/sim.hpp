@@ -0,0 +1,157 @@
+/*
+ * @file sim.hpp
+ *
+ * @brief Control interface of the simulated esp_netif/esp_wifi/esp_eth backend for the host build:
+ *	  simulated clock, configurable delays of the backend operations,
+ *	  simulated access points, the wired network and the trace of the backend calls.
+ *
+ * All the delays are in milliseconds of the simulated time (except the 'api_us');
+ * one ms of the simulated time takes 'scale' ms of the host time.
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#ifndef _SIM_HPP_
+#define _SIM_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <esp_wifi_types.h>
+
+
+namespace sim
+{
+
+    /// @brief delays of the simulated backend operations, ms of the simulated time
+    struct delays_t
+    {
+	uint32_t api_us	    = 0;	///< any call to the esp_netif/esp_wifi API (lwIP core lock & IPC round trip), us
+	uint32_t disconnect = 20;	///< esp_wifi_disconnect() of the connected station
+	uint32_t set_config = 5;	///< esp_wifi_set_config() processing
+	uint32_t nvs_write  = 40;	///< flash write & erase in the esp_wifi_set_config() with WIFI_STORAGE_FLASH
+	uint32_t pbkdf2	    = 600;	///< PBKDF2-SHA1 derivation of the PMK from the passphrase
+	uint32_t scan_chan  = 120;	///< active scan of the one channel
+	uint32_t assoc	    = 150;	///< authentication, association & 4-way handshake
+	uint32_t auth_fail  = 900;	///< 4-way handshake failed with a wrong password
+	uint32_t dhcp	    = 700;	///< full DHCP DISCOVER/OFFER/REQUEST/ACK exchange
+	uint32_t dhcp_reboot = 150;	///< INIT-REBOOT REQUEST/ACK (or NAK) of the address, restored by the lwIP
+	uint32_t static_ip  = 5;	///< static ip set up (ARP probe) up to the IP_EVENT_STA_GOT_IP
+	uint32_t lease_s    = 7200;	///< lease time, granted by the DHCP server, s (not a delay)
+	uint32_t eth_link   = 300;	///< autonegotiation of the Ethernet link up to the ETHERNET_EVENT_CONNECTED
+    }; /* struct sim::delays_t */
+
+    /// @brief simulated access point
+    struct ap_t
+    {
+	std::string ssid;
+	std::string passphrase;
+	uint8_t	    bssid[6];
+	uint8_t	    channel = 1;	///< 1..13
+	int8_t	    rssi = -50;
+	uint32_t    subnet  = 0;	///< network address of the AP subnet /24, network byte order
+    }; /* struct sim::ap_t */
+
+    /// @brief record of the backend calls & events trace
+    struct trace_t
+    {
+	uint64_t    time;	///< simulated time, us
+	const char* what;	///< name of the API or event
+    }; /* struct sim::trace_t */
+
+    /// @brief counters of the simulated backend
+    struct counters_t
+    {
+	uint32_t nvs_writes = 0;	///< flash writes of the WiFi configuration
+	uint32_t pbkdf2	    = 0;	///< passphrase derivations
+	uint32_t full_scans = 0;	///< all-channel scans
+	uint32_t connects   = 0;	///< connection attempts
+	uint32_t dhcp	    = 0;	///< DHCP exchanges: the full ones
+	uint32_t dhcp_reboots = 0;	///< INIT-REBOOT of the restored address, ACKed
+	uint32_t dhcp_naks  = 0;	///< INIT-REBOOT of the restored address, NAKed: the full exchange follows
+    }; /* struct sim::counters_t */
+
+
+    /// @brief reset the simulated world: APs, netifs, driver state, counters & trace
+    void reset();
+
+    /// @brief access to the delays of the backend operations
+    delays_t& delays();
+
+    /// @brief set ratio of the host time to the simulated time (0.01 - 100 times faster)
+    void scale(double ratio);
+
+    /// @brief the access point of the SSID on the channel: the BSSID 24:0a:c4:00:00:<id>, the subnet 192.168.<net>.0/24
+    ap_t make_ap(const char* ssid, const char* passphrase, uint8_t channel, uint8_t net, uint8_t id);
+
+    /// @brief the STA configuration of the flash: the last esp_wifi_set_config() with the WIFI_STORAGE_FLASH
+    wifi_config_t flashed_sta();
+
+    /// @brief add the simulated access point
+    void add_ap(const ap_t& ap);
+
+    /// @brief replace the simulated access point with the same SSID: the AP is moved to the other channel/BSSID
+    void move_ap(const ap_t& ap);
+
+    /// @brief the station joins the started soft-AP: WIFI_EVENT_AP_STACONNECTED with the lowest free AID,
+    ///	   then the IP_EVENT_AP_STAIPASSIGNED of the address of the pool of the soft-AP netif
+    /// @return false - the soft-AP is not started or is full (the max_connection of it's config)
+    bool ap_join(const uint8_t mac[6], int8_t rssi = -60);
+
+    /// @brief the station leaves the soft-AP; the WIFI_EVENT_AP_STADISCONNECTED is posted, if 'notify'
+    void ap_leave(const uint8_t mac[6], uint8_t reason, bool notify = true);
+
+    /// @brief RSSI of the station of the soft-AP, as listed by the esp_wifi_ap_get_sta_list()
+    void ap_rssi(const uint8_t mac[6], int8_t rssi);
+
+    /// @brief the cable of the simulated Ethernet drivers is plugged/unplugged: the started drivers link up
+    ///	   after the autonegotiation or link down at once (plugged by default)
+    void eth_cable(bool plugged);
+
+    /// @brief the wired network of the simulated Ethernet drivers: the network address /24
+    ///	   of the DHCP server of it, 0 - no DHCP server (192.168.10.0 by default)
+    void eth_network(uint32_t subnet);
+
+    /// @brief simulated time, us
+    uint64_t now();
+
+    /// @brief sleep the calling thread, ms of the simulated time
+    void sleep(uint32_t ms);
+
+    /// @brief sleep the calling thread up to the deadline, us of the simulated time
+    void sleep_until(uint64_t deadline);
+
+    /// @brief host duration of the simulated ms
+    double host_ms(uint32_t ms);
+
+    /// @brief add the record to the trace of the backend calls
+    void mark(const char* what);
+
+    /// @brief the trace of the backend calls & events
+    std::vector<trace_t> trace();
+
+    /// @brief clear the trace of the backend calls & events
+    void trace_clear();
+
+    /// @brief counters of the simulated backend
+    counters_t counters();
+
+    /// @brief drain the queued events & driver jobs
+    void settle();
+
+    /// @brief the calling thread is inside the simulated backend while the object exists:
+    ///	   the allocations of the backend itself are excluded by the allocation tests of the component
+    class backend_scope
+    {
+    public:
+	backend_scope();
+	~backend_scope();
+	static bool active();	///< the calling thread is inside the backend
+    }; /* class sim::backend_scope */
+
+}; /* namespace sim */
+
+
+#endif /* _SIM_HPP_ */
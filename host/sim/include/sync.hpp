@@ -0,0 +1,16 @@
+/*
+ * @file sync.hpp
+ *
+ * @brief Host stand-in of the 'utils' component synchronisation helpers
+ */
+
+#ifndef _SIM_SYNC_HPP_
+#define _SIM_SYNC_HPP_
+
+#include "freertos/FreeRTOS.h"
+
+/// @brief convert seconds to the ticks
+constexpr TickType_t secticks(unsigned seconds) {
+    return pdMS_TO_TICKS(seconds * 1000U); };
+
+#endif /* _SIM_SYNC_HPP_ */
@@ -0,0 +1,146 @@
+/*
+ * @file nvs.cpp
+ *
+ * @brief Host simulation of the ESP-IDF NVS: named namespaces of the blobs in the host RAM
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <nvs.h>
+
+#include "sim_internal.hpp"
+
+using namespace std;
+
+
+namespace
+{
+    typedef map<string, vector<uint8_t>> space_t;
+
+    struct handle_data_t
+    {
+	string	name;
+	bool	writable;
+	bool	dirty = false;
+    }; /* struct handle_data_t */
+
+    map<string, space_t> flash;
+    map<nvs_handle_t, handle_data_t> handles;
+    nvs_handle_t last = 0;
+
+}; /* namespace <anonymous> */
+
+
+esp_err_t nvs_open(const char* name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle)
+{
+	sim::backend_scope inside;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    handles[++last] = {name, open_mode == NVS_READWRITE};
+    *out_handle = last;
+    return ESP_OK;
+}; /* nvs_open() */
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out_value, size_t* length)
+{
+	sim::backend_scope inside;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    auto h = handles.find(handle);
+    if (h == handles.end())
+	return ESP_ERR_NVS_INVALID_HANDLE;
+
+    auto& space = flash[h->second.name];
+    auto item = space.find(key);
+    if (item == space.end())
+	return ESP_ERR_NVS_NOT_FOUND;
+    if (!out_value)
+    {
+	*length = item->second.size();
+	return ESP_OK;
+    }; /* if !out_value */
+    if (*length < item->second.size())
+	return ESP_ERR_NVS_INVALID_LENGTH;
+    memcpy(out_value, item->second.data(), item->second.size());
+    *length = item->second.size();
+    return ESP_OK;
+}; /* nvs_get_blob() */
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length)
+{
+	sim::backend_scope inside;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    auto h = handles.find(handle);
+    if (h == handles.end() || !h->second.writable)
+	return ESP_ERR_NVS_INVALID_HANDLE;
+    flash[h->second.name][key].assign(static_cast<const uint8_t*>(value), static_cast<const uint8_t*>(value) + length);
+    h->second.dirty = true;
+    return ESP_OK;
+}; /* nvs_set_blob() */
+
+esp_err_t nvs_get_u32(nvs_handle_t handle, const char* key, uint32_t* out_value)
+{
+	size_t length = sizeof(*out_value);
+	esp_err_t err = nvs_get_blob(handle, key, out_value, &length);
+
+    return (err == ESP_OK && length != sizeof(*out_value))? ESP_ERR_NVS_NOT_FOUND: err;
+}; /* nvs_get_u32() */
+
+esp_err_t nvs_set_u32(nvs_handle_t handle, const char* key, uint32_t value)
+{
+	uint32_t stored;
+
+    if (nvs_get_u32(handle, key, &stored) == ESP_OK && stored == value)
+	return ESP_OK;
+    return nvs_set_blob(handle, key, &value, sizeof(value));
+}; /* nvs_set_u32() */
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char* key)
+{
+	sim::backend_scope inside;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    auto h = handles.find(handle);
+    if (h == handles.end() || !h->second.writable)
+	return ESP_ERR_NVS_INVALID_HANDLE;
+    if (flash[h->second.name].erase(key) == 0)
+	return ESP_ERR_NVS_NOT_FOUND;
+    h->second.dirty = true;
+    return ESP_OK;
+}; /* nvs_erase_key() */
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+	bool dirty;
+    {
+	lock_guard<recursive_mutex> lk(sim::detail::lock());
+	auto h = handles.find(handle);
+	if (h == handles.end())
+	    return ESP_ERR_NVS_INVALID_HANDLE;
+	dirty = h->second.dirty;
+	h->second.dirty = false;
+	if (dirty)
+	    sim::detail::count().nvs_writes++;
+    }
+    if (dirty)
+    {
+	sim::mark("nvs_commit");
+	sim::sleep(sim::delays().nvs_write);
+    }; /* if dirty */
+    return ESP_OK;
+}; /* nvs_commit() */
+
+void nvs_close(nvs_handle_t handle)
+{
+	sim::backend_scope inside;
+
+    lock_guard<recursive_mutex> lk(sim::detail::lock());
+    handles.erase(handle);
+}; /* nvs_close() */
@@ -0,0 +1,453 @@
+/*
+ * @file sim.cpp
+ *
+ * @brief Simulated clock, trace & driver task of the host backend;
+ *	  host stand-ins of the FreeRTOS, logging and 'utils' component API
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <thread>
+
+#include <esp_err.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/task.h>
+
+#include <asemaphore>
+#include <astring.h>
+#include <sdkconfig.h>
+
+#include "sim_internal.hpp"
+
+using namespace std;
+using host_clock = chrono::steady_clock;
+
+
+namespace sim
+{
+
+    namespace
+    {
+	mutex clock_lock;
+	host_clock::time_point host_base = host_clock::now();
+	uint64_t sim_base = 0;
+	double ratio = 0.01;
+
+	mutex trace_lock;
+	vector<trace_t> tracebuf;
+
+	delays_t delaytab;
+	counters_t countab;
+
+	/// queue of the simulated driver task; never destroyed - the detached driver thread waits on it up to the exit
+	struct driver_t
+	{
+	    mutex		    lock;
+	    condition_variable	    cond;
+	    deque<function<void()>> jobs;
+	    bool		    busy = false;
+	}; /* struct driver_t */
+
+	driver_t& driver = *new driver_t;
+
+	/// one-shot timers of the simulated time, served by the own thread; never destroyed, as the driver_t
+	struct timers_t
+	{
+	    mutex		lock;
+	    condition_variable	cond;
+	    vector<esp_timer*>	list;
+	}; /* struct timers_t */
+
+	timers_t& timers = *new timers_t;
+
+	void driver_task()
+	{
+	    for (;;)
+	    {
+		function<void()> fn;
+		{
+		    unique_lock<mutex> lk(driver.lock);
+		    driver.busy = false;
+		    driver.cond.notify_all();
+		    driver.cond.wait(lk, []{ return !driver.jobs.empty(); });
+		    fn = std::move(driver.jobs.front());
+		    driver.jobs.pop_front();
+		    driver.busy = true;
+		}
+		fn();
+	    }; /* for (;;) */
+	}; /* driver_task() */
+
+    }; /* namespace sim::<anonymous> */
+
+}; /* namespace sim */
+
+
+/// simulated timer object
+struct esp_timer
+{
+    esp_timer_cb_t  callback;
+    void*	    arg;
+    uint64_t	    deadline = 0;	///< simulated time, us
+    bool	    armed = false;
+}; /* struct esp_timer */
+
+
+namespace sim
+{
+    namespace
+    {
+	void timer_task()
+	{
+	    unique_lock<mutex> lk(timers.lock);
+
+	    for (;;)
+	    {
+		    esp_timer* first = nullptr;
+
+		for (auto t: timers.list)
+		    if (t->armed && (!first || t->deadline < first->deadline))
+			first = t;
+		if (!first)
+		{
+		    timers.cond.wait(lk);
+		    continue;
+		}; /* if !first */
+
+		    uint64_t curr = now();
+
+		if (first->deadline > curr)
+		{
+		    timers.cond.wait_for(lk, chrono::duration<double, milli>(host_ms(1) * (first->deadline - curr) / 1000));
+		    continue;
+		}; /* if first->deadline > curr */
+
+		first->armed = false;
+		    esp_timer_cb_t cb = first->callback;
+		    void* arg = first->arg;
+		lk.unlock();
+		cb(arg);
+		lk.lock();
+	    }; /* for (;;) */
+	}; /* timer_task() */
+
+    }; /* namespace sim::<anonymous> */
+
+
+    uint64_t now()
+    {
+	lock_guard<mutex> lk(clock_lock);
+	return sim_base + static_cast<uint64_t>(chrono::duration<double, micro>(host_clock::now() - host_base).count() / ratio);
+    }; /* sim::now() */
+
+    void scale(double r)
+    {
+	uint64_t base = now();
+	lock_guard<mutex> lk(clock_lock);
+	sim_base = base;
+	host_base = host_clock::now();
+	ratio = r;
+    }; /* sim::scale() */
+
+    double host_ms(uint32_t ms)
+    {
+	lock_guard<mutex> lk(clock_lock);
+	return ms * ratio;
+    }; /* sim::host_ms() */
+
+    void sleep(uint32_t ms)
+    {
+	if (ms)
+	    this_thread::sleep_for(chrono::duration<double, milli>(host_ms(ms)));
+    }; /* sim::sleep() */
+
+    void sleep_until(uint64_t deadline)
+    {
+	    uint64_t curr = now();
+
+	if (deadline > curr)
+	    this_thread::sleep_for(chrono::duration<double, milli>(host_ms(1) * (deadline - curr) / 1000));
+    }; /* sim::sleep_until() */
+
+    delays_t& delays() { return delaytab; };
+
+    namespace
+    {
+	thread_local unsigned backend_depth = 0;
+    }; /* namespace sim::<anonymous> */
+
+    backend_scope::backend_scope() { backend_depth++; };
+
+    backend_scope::~backend_scope() { backend_depth--; };
+
+    bool backend_scope::active() { return backend_depth > 0; };
+
+    void mark(const char* what)
+    {
+	backend_scope inside;
+	uint64_t t = now();
+	lock_guard<mutex> lk(trace_lock);
+	tracebuf.push_back({t, what});
+    }; /* sim::mark() */
+
+    vector<trace_t> trace()
+    {
+	lock_guard<mutex> lk(trace_lock);
+	return tracebuf;
+    }; /* sim::trace() */
+
+    void trace_clear()
+    {
+	lock_guard<mutex> lk(trace_lock);
+	tracebuf.clear();
+    }; /* sim::trace_clear() */
+
+    counters_t counters()
+    {
+	lock_guard<recursive_mutex> lk(detail::lock());
+	return countab;
+    }; /* sim::counters() */
+
+    void settle()
+    {
+	for (int i = 0; i < 3; i++)
+	{
+	    detail::settle_jobs();
+	    detail::settle_events();
+	}; /* for i */
+    }; /* sim::settle() */
+
+    void reset()
+    {
+	settle();
+	detail::reset_wifi();
+	detail::reset_eth();
+	detail::reset_netif();
+	detail::reset_events();
+	{
+	    lock_guard<recursive_mutex> lk(detail::lock());
+	    countab = counters_t();
+	}
+	delaytab = delays_t();
+	trace_clear();
+    }; /* sim::reset() */
+
+
+    namespace detail
+    {
+	recursive_mutex& lock()
+	{
+		static recursive_mutex mtx;
+	    return mtx;
+	}; /* sim::detail::lock() */
+
+	counters_t& count() { return countab; };
+
+	void api_delay()
+	{
+	    if (delaytab.api_us)
+		sleep_until(now() + delaytab.api_us);
+	}; /* sim::detail::api_delay() */
+
+	void job(function<void()> fn)
+	{
+		static bool running = (thread(driver_task).detach(), true);
+	    lock_guard<mutex> lk(driver.lock);
+	    driver.jobs.push_back(std::move(fn));
+	    driver.cond.notify_all();
+	}; /* sim::detail::job() */
+
+	void settle_jobs()
+	{
+	    unique_lock<mutex> lk(driver.lock);
+	    driver.cond.wait(lk, []{ return driver.jobs.empty() && !driver.busy; });
+	}; /* sim::detail::settle_jobs() */
+
+    }; /* namespace sim::detail */
+
+}; /* namespace sim */
+
+
+
+//--[ esp_timer, FreeRTOS ]--------------------------------------------------------------------------------------------
+
+int64_t esp_timer_get_time(void)
+{
+    return sim::now();
+}; /* esp_timer_get_time() */
+
+TickType_t xTaskGetTickCount(void)
+{
+    return static_cast<TickType_t>(sim::now() / 1000);
+}; /* xTaskGetTickCount() */
+
+void vTaskDelay(const TickType_t ticks)
+{
+    sim::sleep(ticks * portTICK_PERIOD_MS);
+}; /* vTaskDelay() */
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char* const name, const uint32_t depth,
+	void* const param, UBaseType_t priority, TaskHandle_t* const created)
+{
+	thread task(code, param);
+
+    if (created)
+	*created = nullptr;
+    task.detach();
+    return pdPASS;
+}; /* xTaskCreate() */
+
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* create_args, esp_timer_handle_t* out_handle)
+{
+	static bool running = (thread(sim::timer_task).detach(), true);
+	sim::backend_scope inside;
+
+    if (!create_args || !create_args->callback || !out_handle)
+	return ESP_ERR_INVALID_ARG;
+    *out_handle = new esp_timer{create_args->callback, create_args->arg};
+    lock_guard<mutex> lk(sim::timers.lock);
+    sim::timers.list.push_back(*out_handle);
+    return ESP_OK;
+}; /* esp_timer_create() */
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    lock_guard<mutex> lk(sim::timers.lock);
+    if (timer->armed)
+	return ESP_ERR_INVALID_STATE;
+    timer->deadline = sim::now() + timeout_us;
+    timer->armed = true;
+    sim::timers.cond.notify_all();
+    return ESP_OK;
+}; /* esp_timer_start_once() */
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    lock_guard<mutex> lk(sim::timers.lock);
+    if (!timer->armed)
+	return ESP_ERR_INVALID_STATE;
+    timer->armed = false;
+    sim::timers.cond.notify_all();
+    return ESP_OK;
+}; /* esp_timer_stop() */
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    lock_guard<mutex> lk(sim::timers.lock);
+    if (timer->armed)
+	return ESP_ERR_INVALID_STATE;
+    sim::timers.list.erase(remove(sim::timers.list.begin(), sim::timers.list.end(), timer), sim::timers.list.end());
+    delete timer;
+    return ESP_OK;
+}; /* esp_timer_delete() */
+
+bool esp_timer_is_active(esp_timer_handle_t timer)
+{
+    lock_guard<mutex> lk(sim::timers.lock);
+    return timer->armed;
+}; /* esp_timer_is_active() */
+
+
+//--[ class Semaphore ]------------------------------------------------------------------------------------------------
+
+BaseType_t Semaphore::Take(TickType_t ticks)
+{
+    if (ticks > 0)
+	sim::mark("wait");
+
+    unique_lock<mutex> lk(lock);
+
+    if (ticks == portMAX_DELAY)
+	cond.wait(lk, [this]{ return state; });
+    else if (ticks > 0)
+	cond.wait_for(lk, chrono::duration<double, milli>(sim::host_ms(ticks * portTICK_PERIOD_MS)), [this]{ return state; });
+
+    if (!state)
+	return pdFALSE;
+    state = false;
+    return pdTRUE;
+}; /* Semaphore::Take() */
+
+BaseType_t Semaphore::Give()
+{
+    lock_guard<mutex> lk(lock);
+    state = true;
+    cond.notify_all();
+    return pdTRUE;
+}; /* Semaphore::Give() */
+
+
+//--[ logging ]--------------------------------------------------------------------------------------------------------
+
+static esp_log_level_t log_level = []{
+	const char* env = getenv("NET_SIM_LOG");
+    return static_cast<esp_log_level_t>(env? atoi(env): CONFIG_LOG_DEFAULT_LEVEL); }();
+
+void esp_log_level_set(const char* tag, esp_log_level_t level)
+{
+    log_level = level;
+}; /* esp_log_level_set() */
+
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...)
+{
+	static const char letter[] = "NEWIDV";
+	va_list args;
+
+    if (level > log_level)
+	return;
+    fprintf(stderr, "%c (%llu) %s: ", letter[level], static_cast<unsigned long long>(sim::now() / 1000), tag);
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+}; /* esp_log_write() */
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code)
+    {
+    case ESP_OK:		return "ESP_OK";
+    case ESP_FAIL:		return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:	return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:	return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:	return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_NOT_FOUND:	return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_TIMEOUT:	return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_NOT_FINISHED:	return "ESP_ERR_NOT_FINISHED";
+    default:			return "UNKNOWN ERROR";
+    }; /* switch code */
+}; /* esp_err_to_name() */
+
+
+//--[ namespace astr ]-------------------------------------------------------------------------------------------------
+
+static string lowercase(const string& str)
+{
+	string res(str);
+    transform(res.begin(), res.end(), res.begin(), [](unsigned char c){ return tolower(c); });
+    return res;
+}; /* lowercase() */
+
+bool astr::confirm(const string& str)
+{
+	string s = lowercase(str);
+    return s == "1" || s == "y" || s == "yes" || s == "on" || s == "true" || s == "enable";
+}; /* astr::confirm() */
+
+bool astr::decline(const string& str)
+{
+	string s = lowercase(str);
+    return s == "0" || s == "n" || s == "no" || s == "off" || s == "false" || s == "disable";
+}; /* astr::decline() */
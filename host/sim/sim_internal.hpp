@@ -0,0 +1,95 @@
+/*
+ * @file sim_internal.hpp
+ *
+ * @brief Inner definitions of the simulated esp_netif/esp_wifi backend,
+ *	  shared between the modules of the simulation
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#ifndef _SIM_INTERNAL_HPP_
+#define _SIM_INTERNAL_HPP_
+
+#include <functional>
+#include <mutex>
+
+#include <esp_netif.h>
+#include <esp_wifi_types.h>
+
+#include "sim.hpp"
+
+
+/// simulated network interface object
+struct esp_netif_obj
+{
+    esp_netif_flags_t	    flags;
+    int			    wifi_if = -1;	///< WIFI_IF_STA/WIFI_IF_AP, -1 - not the WiFi netif
+    esp_netif_ip_info_t	    ip {};
+    esp_netif_ip_info_t	    old_ip {};
+    esp_netif_dhcp_status_t dhcpc = ESP_NETIF_DHCP_INIT;
+    esp_netif_dhcp_status_t dhcps = ESP_NETIF_DHCP_INIT;
+    bool		    up = false;	///< link is up
+    uint32_t		    link = 0;	///< generation of the link, incremented on every link up/down
+    uint32_t		    lease = 100;///< next host number of the simulated DHCP lease
+    dhcps_lease_t	    pool {};	///< address pool of the DHCP server
+    uint32_t		    lease_min = 120;///< lease time of the DHCP server, minutes
+    int32_t		    got_ip_event = IP_EVENT_STA_GOT_IP;	///< of the inherent config
+    void*		    eth = nullptr;	///< the attached Ethernet driver, nullptr - not the Ethernet netif
+}; /* struct esp_netif_obj */
+
+
+namespace sim
+{
+    namespace detail
+    {
+	/// common lock of the simulated backend state
+	std::recursive_mutex& lock();
+
+	/// the backend counters, access under the lock()
+	counters_t& count();
+
+	/// delay of the generic API call, us of the simulated time
+	void api_delay();
+
+	/// @brief enqueue the job into the simulated driver task
+	void job(std::function<void()> fn);
+
+	/// @brief post the event to the default event loop from the backend
+	void post(esp_event_base_t base, int32_t id, const void* data = nullptr, size_t size = 0);
+
+	/// @brief link of the netif is up/down: start DHCP or announce the static ip
+	void link_up(esp_netif_t* netif);
+	void link_down(esp_netif_t* netif);
+
+	/// @brief the station netif, created by the esp_netif_create_wifi()
+	esp_netif_t*& sta_netif();
+
+	/// @brief the soft-AP netif, created by the esp_netif_create_wifi()
+	esp_netif_t*& ap_netif();
+
+	/// @brief address pool subnet of the currently connected AP
+	uint32_t& sta_subnet();
+
+	/// @brief network address of the wired network /24, 0 - no DHCP server in it
+	uint32_t& eth_subnet();
+
+	/// @brief reset the simulated netif/wifi/eth/event modules
+	void reset_netif();
+	void reset_wifi();
+	void reset_eth();
+	void reset_events();
+
+	/// @brief PBKDF2-HMAC-SHA1 without the simulated cost - for the inner use of the simulated driver
+	void pbkdf2_sha1(const uint8_t* pwd, size_t plen, const uint8_t* salt, size_t slen,
+		unsigned iterations, uint8_t* out, size_t olen);
+
+	/// @brief wait while the event loop & the driver task are idle
+	void settle_events();
+	void settle_jobs();
+
+    }; /* namespace sim::detail */
+
+}; /* namespace sim */
+
+#endif /* _SIM_INTERNAL_HPP_ */
@@ -0,0 +1,45 @@
+/*
+ * @file check.hpp
+ *
+ * @brief The checks of the host tests: the count of the failed checks, the check of the condition
+ *	  and the exit status of the test by the count.
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#ifndef _CHECK_HPP_
+#define _CHECK_HPP_
+
+#include <cstdio>
+#include <cstdlib>
+
+
+namespace test
+{
+    /// count of the failed checks of the test
+    inline unsigned failed = 0;
+
+    /// the check of the condition: the failed one is printed & counted
+    inline void expect(bool cond, const char* what)
+    {
+	if (cond)
+	    return;
+	printf("%s FAILED\n", what);
+	failed++;
+    }; /* test::expect() */
+
+    /// the exit status of the test: the count of the failed checks of the 'what' is printed, if any
+    inline int report(const char* what)
+    {
+	if (failed)
+	{
+	    fprintf(stderr, "%u checks of the %s FAILED\n", failed, what);
+	    return EXIT_FAILURE;
+	}; /* if failed */
+	return EXIT_SUCCESS;
+    }; /* test::report() */
+
+}; /* namespace test */
+
+#endif /* _CHECK_HPP_ */
@@ -0,0 +1,185 @@
+/*
+ * @file config_alloc_test.cpp
+ *
+ * @brief Allocation test of the net::configuration_t & the esp::net::wifi::Updater on the simulated backend:
+ *	  the copy of the configuration & the full apply cycle (backup, login, connect, ip, finalize
+ *	  or revert) does not allocate the heap, with the inline string fields (CONFIG_NET_CFG_INLINE_STRINGS).
+ *
+ * The allocations of the calling thread are counted by the replaced global operator new,
+ * except the allocations of the simulated backend itself (sim::backend_scope).
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "sim.hpp"
+
+using namespace std;
+
+
+static_assert(CONFIG_NET_CFG_INLINE_STRINGS, "the test is for the inline string fields of the configuration");
+static_assert(is_nothrow_copy_constructible<::net::configuration_t>::value, "copy of the configuration may throw");
+static_assert(is_nothrow_move_constructible<::net::configuration_t>::value, "move of the configuration may throw");
+static_assert(is_nothrow_copy_assignable<decltype(::net::configuration_t::login)>::value, "assignment of the login may throw");
+static_assert(is_nothrow_copy_assignable<decltype(::net::configuration_t::passwd)>::value, "assignment of the password may throw");
+static_assert(sizeof(::net::configuration_t::dhcp) == sizeof(bool), "the field carries the change state");
+static_assert(sizeof(::net::configuration_t::ip) == sizeof(esp::ip4::address), "the field carries the change state");
+
+
+namespace
+{
+    thread_local bool counting = false;	///< count the allocations of the calling thread
+    atomic<unsigned> allocations{0};
+
+    void* allocate(size_t size)
+    {
+	if (counting && !sim::backend_scope::active())
+	    allocations++;
+	if (void* ptr = malloc(size? size: 1))
+	    return ptr;
+	throw bad_alloc();
+    }; /* allocate() */
+
+    /// count the allocations of the calling thread in the scope
+    struct counter_t
+    {
+	counter_t(): start(allocations) { counting = true; };
+	~counter_t() { counting = false; };
+	unsigned count() const { return allocations - start; };
+	unsigned start;
+    }; /* struct counter_t */
+
+}; /* namespace <anonymous> */
+
+
+void* operator new(size_t size) { return allocate(size); };
+void* operator new[](size_t size) { return allocate(size); };
+void operator delete(void* ptr) noexcept { free(ptr); };
+void operator delete[](void* ptr) noexcept { free(ptr); };
+void operator delete(void* ptr, size_t) noexcept { free(ptr); };
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); };
+
+
+
+int main(int argc, char* argv[])
+{
+	unsigned failed = 0;
+
+    // the counter itself: the long std::string is allocated
+    {
+	    counter_t counter;
+	    string probe(sizeof(wifi_sta_config_t::password), 'x');
+
+	if (!counter.count())
+	{
+	    fprintf(stderr, "The allocation counter is broken\n");
+	    return 1;
+	}; /* if !counter.count() */
+    }
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+    sim::scale(0.002);
+    sim::add_ap(sim::make_ap("home",   "pass1234", 6, 1, 1));
+    sim::add_ap(sim::make_ap("office-with-the-long-ssid-name32", "the long passphrase of the office access point", 11, 2, 2));
+
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+
+	esp_netif_inherent_config_t base = ESP_NETIF_INHERENT_DEFAULT_WIFI_STA();
+	esp::wifi::netif_t sta(WIFI_IF_STA, base);
+	wifi_init_config_t wifi_init = WIFI_INIT_CONFIG_DEFAULT();
+
+    ESP_ERROR_CHECK(esp::net::wifi::stack::init(&wifi_init));
+    ESP_ERROR_CHECK(esp::net::wifi::mode::set(WIFI_MODE_STA));
+    ESP_ERROR_CHECK(esp::net::wifi::stack::start());
+
+	::net::configuration_t current;
+
+    current.login = "home";
+    current.passwd = "pass1234";
+    current.use_pwd = true;
+    if (sta.update(current) != ESP_OK)
+    {
+	fprintf(stderr, "Initial connection failed with error %i\n", sta.update.status());
+	return 1;
+    }; /* if sta.update(current) != ESP_OK */
+    sta.update.finalize();
+    current.clr_chgst();
+
+	const struct
+	{
+	    const char* name;
+	    function<void(::net::configuration_t&)> change;
+	    bool	persist;
+	} scenarios[] = {
+	    { "switch-ap",   [](::net::configuration_t& cfg) {
+				cfg.login = "office-with-the-long-ssid-name32";
+				cfg.passwd = "the long passphrase of the office access point"; }, true },
+	    { "switch-back", [](::net::configuration_t& cfg) { cfg.login = "home"; cfg.passwd = "pass1234"; }, true },
+	    { "ip-static",   [](::net::configuration_t& cfg) {
+				cfg.dhcp = false;
+				cfg.ip = ESP_IP4TOADDR(192, 168, 1, 50);
+				cfg.mask = ESP_IP4TOADDR(255, 255, 255, 0);
+				cfg.gate = ESP_IP4TOADDR(192, 168, 1, 1); }, true },
+	    { "ip-dhcp",     [](::net::configuration_t& cfg) { cfg.dhcp = true; }, true },
+	    { "bad-passwd",  [](::net::configuration_t& cfg) { cfg.passwd = "wrong-password"; }, false },
+	};
+
+    // the first pass - the one-time initialization (handlers, caches) is allowed to allocate
+    for (int pass = 0; pass < 2; pass++)
+	for (auto& scenario: scenarios)
+	{
+		unsigned count;
+		esp_err_t err;
+
+	    sim::settle();
+	    {
+		    counter_t counter;
+		    ::net::configuration_t cfg(current);
+
+		cfg.clr_chgst();
+		scenario.change(cfg);
+		err = sta.update(cfg);
+		sta.update.finalize();
+		if (err == ESP_OK && scenario.persist)
+		{
+		    current = cfg;
+		    current.clr_chgst();
+		}; /* if err == ESP_OK && scenario.persist */
+		count = counter.count();
+	    }
+	    if (pass == 0)
+		continue;
+
+	    printf("%-12s %-6i %u allocations\n", scenario.name, err, count);
+	    if (count || (err == ESP_OK) != scenario.persist)
+		failed++;
+	}; /* for scenario */
+
+    if (failed)
+    {
+	fprintf(stderr, "%u apply cycles are allocated the heap or failed unexpectedly\n", failed);
+	return 1;
+    }; /* if failed */
+    return 0;
+}; /* main() */
@@ -0,0 +1,206 @@
+/*
+ * @file dhcp_client_test.cpp
+ *
+ * @brief Test of the mirrored state of the esp::dhcp_client_t on the simulated backend:
+ *	  the status, the enable flag & the lease follow the connection, the static ip & the DHCP updates
+ *	  of the Updater and the link down, while the updates make no esp_netif_dhcpc_get_status()
+ *	  & esp_netif_get_flags() calls, and the DHCP client is started/stopped for the change only;
+ *	  the time to the address on the reconnection to the known network by the INIT-REBOOT of the address,
+ *	  obtained on it last time, against the full exchange on the unknown one & the NAK of the other's address.
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "sim.hpp"
+#include "check.hpp"
+
+using namespace std;
+using namespace test;
+
+
+namespace
+{
+    /// count of the trace records of the backend call
+    unsigned calls(const char* what)
+    {
+	    unsigned count = 0;
+
+	for (auto& rec: sim::trace())
+	    count += strcmp(rec.what, what) == 0;
+	return count;
+    }; /* calls() */
+
+    /// the status queries of the backend during the trace
+    unsigned queries()
+    {
+	return calls("esp_netif_dhcpc_get_status") + calls("esp_netif_get_flags");
+    }; /* queries() */
+
+    /// time from the last WIFI_EVENT_STA_CONNECTED to the IP_EVENT_STA_GOT_IP of the trace, ms; 0 - no address
+    uint64_t time_to_ip()
+    {
+	    uint64_t connected = 0, got_ip = 0;
+
+	for (auto& rec: sim::trace())
+	    if (strcmp(rec.what, "WIFI_EVENT_STA_CONNECTED") == 0)
+		connected = rec.time, got_ip = 0;
+	    else if (strcmp(rec.what, "IP_EVENT_STA_GOT_IP") == 0 && connected && !got_ip)
+		got_ip = rec.time;
+	return got_ip? (got_ip - connected) / 1000: 0;
+    }; /* time_to_ip() */
+
+    esp_err_t update(esp::wifi::netif_t& sta, ::net::configuration_t& cfg)
+    {
+	    esp_err_t err = sta.update(cfg);
+
+	sta.update.finalize();
+	cfg.clr_chgst();
+	sim::settle();
+	return err;
+    }; /* update() */
+
+}; /* namespace <anonymous> */
+
+
+int main(int argc, char* argv[])
+{
+    esp_log_level_set("*", ESP_LOG_NONE);
+    sim::scale(0.01);
+    sim::add_ap(sim::make_ap("home", "pass1234", 6, 1, 1));
+    sim::add_ap(sim::make_ap("office", "office-pass", 11, 2, 2));
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+
+	esp_netif_inherent_config_t inherent = ESP_NETIF_INHERENT_DEFAULT_WIFI_STA();
+	esp::wifi::netif_t sta(WIFI_IF_STA, inherent);
+	esp::dhcp_client_t& client = sta.dhcp.client;
+	wifi_init_config_t wifi_init = WIFI_INIT_CONFIG_DEFAULT();
+	::net::configuration_t cfg;
+
+    expect(client.enabled() && client.initialized() && !client.leased(), "the state, read at the creation of the netif");
+
+    ESP_ERROR_CHECK(esp::net::wifi::stack::init(&wifi_init));
+    ESP_ERROR_CHECK(esp::net::wifi::mode::set(WIFI_MODE_STA));
+    ESP_ERROR_CHECK(esp::net::wifi::stack::start());
+
+    // the connection: the netif starts the client itself on the link up
+    sim::trace_clear();
+    cfg.login = "home";
+    cfg.passwd = "pass1234";
+    cfg.use_pwd = true;
+    expect(update(sta, cfg) == ESP_OK, "connection");
+    printf("connection: %u status queries, %u starts, lease of %s for %u s, renew in %u ms\n", queries(),
+	    calls("esp_netif_dhcpc_start"), esp::ip4::format(esp_ip4_addr_t{client.address()}).c_str(), client.lease_time(),
+	    client.renew() - client.obtained());
+    expect(queries() == 0, "no status queries of the connection");
+    expect(client.started() && client.leased() && client.address() == sta.cfg.get().ip.addr, "lease of the connection");
+    expect(client.lease_time() == sim::delays().lease_s && client.renew() - client.obtained() == client.lease_time() * 500
+	    && client.rebind() - client.obtained() == client.lease_time() * 875
+	    && client.expire() - client.obtained() == client.lease_time() * 1000, "renew, rebind & expire deadlines");
+
+    // the static ip: the client is stopped once, the static address is not a lease
+    sim::trace_clear();
+    cfg.dhcp = false;
+    cfg.ip = ESP_IP4TOADDR(192, 168, 1, 50);
+    cfg.mask = ESP_IP4TOADDR(255, 255, 255, 0);
+    cfg.gate = ESP_IP4TOADDR(192, 168, 1, 1);
+    expect(update(sta, cfg) == ESP_OK, "static ip");
+    expect(queries() == 0 && calls("esp_netif_dhcpc_stop") == 1, "the client is stopped w/o the status queries");
+    expect(client.stopped() && !client.leased() && client.renew() == 0, "state of the static ip");
+
+    // the other AP with the static ip: the stopped client is not started by the link up
+    sim::trace_clear();
+    cfg.login = "office";
+    cfg.passwd = "office-pass";
+    expect(update(sta, cfg) == ESP_OK, "switch of the AP with the static ip");
+    expect(queries() == 0 && calls("esp_netif_dhcpc_start") == 0 && calls("esp_netif_dhcpc_stop") == 0,
+	    "no calls of the client for the AP switch");
+    expect(client.stopped() && !client.leased(), "state of the static ip after the AP switch");
+
+    // back to the DHCP: the client is started once
+    sim::trace_clear();
+    cfg.dhcp = true;
+    expect(update(sta, cfg) == ESP_OK, "dhcp");
+    expect(queries() == 0 && calls("esp_netif_dhcpc_start") == 1, "the client is started w/o the status queries");
+    expect(client.started() && client.leased() && client.address() == sta.cfg.get().ip.addr, "lease of the dhcp");
+
+    // the other AP with the DHCP: the started client is not restarted
+    sim::trace_clear();
+    cfg.login = "home";
+    cfg.passwd = "pass1234";
+    expect(update(sta, cfg) == ESP_OK, "switch of the AP with the dhcp");
+    printf("AP switch: %u status queries, %u starts, %u stops\n", queries(), calls("esp_netif_dhcpc_start"),
+	    calls("esp_netif_dhcpc_stop"));
+    expect(queries() == 0 && calls("esp_netif_dhcpc_start") == 0 && calls("esp_netif_dhcpc_stop") == 0,
+	    "no calls of the client for the AP switch");
+    expect(client.started() && client.leased() && client.address() == sta.cfg.get().ip.addr, "lease after the AP switch");
+
+    // the known network: the address, obtained on it last time, is requested by the INIT-REBOOT
+	uint32_t office_ip = 0;
+	sim::counters_t before = sim::counters();
+	uint64_t reboot_ms, full_ms;
+
+    sim::trace_clear();
+    cfg.login = "office";
+    cfg.passwd = "office-pass";
+    expect(update(sta, cfg) == ESP_OK, "reconnection to the known network");
+    reboot_ms = time_to_ip();
+    office_ip = client.address();
+    expect(sim::counters().dhcp_reboots == before.dhcp_reboots + 1 && sim::counters().dhcp == before.dhcp,
+	    "INIT-REBOOT on the known network, no full exchange");
+    expect(client.leased() && office_ip == sta.cfg.get().ip.addr, "lease of the INIT-REBOOT");
+
+    // the unknown network: no address is requested, the full exchange w/o the NAK
+    before = sim::counters();
+    esp::net::wifi::known_ap::clear();
+    sim::trace_clear();
+    cfg.login = "home";
+    cfg.passwd = "pass1234";
+    expect(update(sta, cfg) == ESP_OK, "connection to the unknown network");
+    full_ms = time_to_ip();
+    expect(sim::counters().dhcp == before.dhcp + 1 && sim::counters().dhcp_reboots == before.dhcp_reboots
+	    && sim::counters().dhcp_naks == before.dhcp_naks, "full exchange on the unknown network, no NAK");
+    printf("time to IP: %llu ms by the INIT-REBOOT, %llu ms by the full exchange, %llu ms gain\n",
+	    (unsigned long long)reboot_ms, (unsigned long long)full_ms, (unsigned long long)(full_ms - reboot_ms));
+    expect(reboot_ms && full_ms && full_ms - reboot_ms >= sim::delays().dhcp - sim::delays().dhcp_reboot,
+	    "time to IP of the INIT-REBOOT");
+
+    // the address of the other network is NAKed & erased: the full exchange follows
+    before = sim::counters();
+    esp_wifi_disconnect();
+    sim::settle();
+    expect(client.restore(office_ip) == ESP_OK, "the address of the other network is restored");
+    esp_wifi_connect();
+    sim::settle();
+    expect(sim::counters().dhcp_naks == before.dhcp_naks + 1 && sim::counters().dhcp == before.dhcp + 1,
+	    "NAK of the other network's address & the full exchange");
+    expect(client.leased() && client.address() != office_ip, "lease after the NAK");
+
+    // the link down: the lease is released
+    esp_wifi_disconnect();
+    sim::settle();
+    expect(!client.leased() && client.expire() == 0, "the lease is released by the link down");
+    expect(client.enabled(), "the enable flag is kept");
+
+    return report("DHCP client state");
+}; /* main() */
@@ -0,0 +1,288 @@
+/*
+ * @file dhcp_server_test.cpp
+ *
+ * @brief Test of the esp::dhcp_server_t & of it's bitmap allocator esp::ip4::pool_t on the simulated backend:
+ *	  the cost of the allocation at the growing fill of the pool, while the thousands of the clients
+ *	  are churned (released & allocated again), stays flat; no address is allocated twice;
+ *	  the start/stop, the pool & the lease time of the server of the soft-AP netif,
+ *	  the sorted table of the reservations & the churn of the clients with the reservations,
+ *	  the table of the soft-AP server follows the leases of the joined & left stations;
+ *	  the option() of the DHCP client goes to the client API.
+ *
+ * Usage: dhcp_server_test [-n churns per fill level] [-v loglevel]
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "sim.hpp"
+#include "check.hpp"
+
+using namespace std;
+using namespace test;
+using esp::ip4::ntoh;
+using esp::ip4::hton;
+
+
+namespace
+{
+    /// count of the trace records of the backend call
+    unsigned calls(const char* what)
+    {
+	    unsigned count = 0;
+
+	for (auto& rec: sim::trace())
+	    count += strcmp(rec.what, what) == 0;
+	return count;
+    }; /* calls() */
+
+    void make_mac(uint32_t id, uint8_t mac[6])
+    {
+	mac[0] = 0x02;	// locally administered
+	mac[1] = 0x00;
+	mac[2] = id >> 24;
+	mac[3] = id >> 16;
+	mac[4] = id >> 8;
+	mac[5] = id;
+    }; /* make_mac() */
+
+    constexpr size_t big = 4096;
+    esp::ip4::pool_table<big> pool;
+
+    /// the pool is filled up to the 'fill' of it's size, then the 'n' random used addresses are released
+    /// & allocated again; ns per allocation of the churn
+    double churn(double fill, unsigned n, mt19937& rng)
+    {
+	    vector<uint32_t> used;
+	    vector<bool> taken(pool.size());
+	    bool ok = true;
+
+	pool.clear();
+	while (used.size() < pool.size() * fill)
+	    used.push_back(pool.alloc());
+	for (auto addr: used)
+	    taken[ntoh(addr) - ntoh(pool.first())] = true;
+
+	    uint64_t ns = 0;
+
+	for (unsigned i = 0; i < n; i++)
+	{
+		size_t victim = rng() % used.size();
+
+	    ok &= pool.release(used[victim]) == ESP_OK;
+	    taken[ntoh(used[victim]) - ntoh(pool.first())] = false;
+
+		auto start = chrono::steady_clock::now();
+		uint32_t addr = pool.alloc();
+
+	    ns += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	    ok &= addr && !taken[ntoh(addr) - ntoh(pool.first())];
+	    taken[ntoh(addr) - ntoh(pool.first())] = true;
+	    used[victim] = addr;
+	}; /* for i */
+	expect(ok && pool.available() == pool.size() - used.size(), "no address is allocated twice");
+	return double(ns) / n;
+    }; /* churn() */
+
+}; /* namespace <anonymous> */
+
+
+int main(int argc, char* argv[])
+{
+	unsigned n = 100000;
+	mt19937 rng(2026);
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+    for (int i = 1; i < argc - 1; i += 2)
+	if (strcmp(argv[i], "-n") == 0)
+	    n = atoi(argv[i + 1]);
+	else if (strcmp(argv[i], "-v") == 0)
+	    esp_log_level_set("*", static_cast<esp_log_level_t>(atoi(argv[i + 1])));
+
+    // the allocator: the range, the exhaustion & the flat cost of the churn
+    expect(pool.range(ESP_IP4TOADDR(10, 0, 0, 1), ESP_IP4TOADDR(10, 0, 16, 1)) == ESP_ERR_NO_MEM,
+	    "the range over the storage is refused");
+    expect(pool.range(ESP_IP4TOADDR(10, 0, 0, 9), ESP_IP4TOADDR(10, 0, 0, 1)) == ESP_ERR_INVALID_ARG,
+	    "the reversed range is refused");
+    expect(pool.range(ESP_IP4TOADDR(10, 0, 0, 1), ESP_IP4TOADDR(10, 0, 15, 255)) == ESP_OK
+	    && pool.size() == big - 1 && pool.available() == big - 1, "the range of the pool");
+    for (size_t i = 0; i < big - 1; i++)
+	pool.alloc();
+    expect(pool.available() == 0 && pool.alloc() == 0, "the exhausted pool");
+    expect(pool.release(ESP_IP4TOADDR(10, 0, 7, 7)) == ESP_OK && pool.alloc() == ESP_IP4TOADDR(10, 0, 7, 7),
+	    "the released address is allocated again");
+    expect(pool.release(ESP_IP4TOADDR(10, 0, 16, 0)) == ESP_ERR_NOT_FOUND, "the address out of the pool");
+
+	const double fills[] = {0.25, 0.5, 0.75, 0.9, 0.99};
+	double cost[sizeof(fills) / sizeof(fills[0])];
+
+    printf("churn of %u clients per fill level of the pool of %zu addresses\n", n, pool.size());
+    printf("%-8s %12s\n", "fill", "ns/alloc");
+    for (size_t i = 0; i < sizeof(fills) / sizeof(fills[0]); i++)
+    {
+	cost[i] = churn(fills[i], n, rng);
+	printf("%-8.2f %12.1f\n", fills[i], cost[i]);
+    }; /* for i */
+    expect(*max_element(begin(cost), end(cost)) < 8 * max(cost[0], 5.0), "the cost of the allocation is flat");
+
+    // the server of the soft-AP netif
+    sim::scale(0.01);
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+
+	esp_netif_inherent_config_t inherent = ESP_NETIF_INHERENT_DEFAULT_WIFI_AP();
+	esp::wifi::netif_t ap(WIFI_IF_AP, inherent);
+	esp::dhcp_server_t& server = ap.dhcp.server;
+	dhcps_lease_t range = {};
+	uint32_t minutes = 0;
+
+    expect(server.enabled() && !ap.dhcp.client.enabled(), "the enable flags of the soft-AP netif");
+    expect(server.start() == ESP_OK && server.started(), "start of the server");
+    sim::trace_clear();
+    expect(server.pool(ESP_IP4TOADDR(192, 168, 4, 2), ESP_IP4TOADDR(192, 168, 4, 250)) == ESP_OK, "pool of the server");
+    expect(server.started() && calls("esp_netif_dhcps_stop") == 1 && calls("esp_netif_dhcps_start") == 1,
+	    "the started server is restarted for the pool");
+    expect(server.option(ESP_NETIF_OP_GET, ESP_NETIF_REQUESTED_IP_ADDRESS, &range, sizeof(range)) == ESP_OK
+	    && range.enable && range.start_ip.addr == ESP_IP4TOADDR(192, 168, 4, 2)
+	    && range.end_ip.addr == ESP_IP4TOADDR(192, 168, 4, 250), "the pool of the esp_netif server");
+    expect(server.pool().size() == 249 && server.pool().available() == 249, "the pool of the allocator");
+    expect(server.lease_time(3601) == ESP_OK && server.lease_time() == 3660
+	    && server.option(ESP_NETIF_OP_GET, ESP_NETIF_IP_ADDRESS_LEASE_TIME, &minutes, sizeof(minutes)) == ESP_OK
+	    && minutes == 61, "the lease time in the minutes");
+    expect(server.stop() == ESP_OK && server.stopped() && server.stop() == ESP_ERR_ESP_NETIF_DHCP_ALREADY_STOPPED
+	    && server.stopped(), "stop of the server");
+
+    // the reservations: the table is sorted by the MAC
+	uint8_t mac[6];
+
+    for (unsigned i = 0; i < esp::dhcp_server_t::reservations; i++)
+    {
+	make_mac(1000 - i * 7, mac);
+	expect(server.reserve(mac, ESP_IP4TOADDR(192, 168, 4, 10 + i)) == ESP_OK, "reservation");
+    }; /* for i */
+    make_mac(5, mac);
+    expect(server.reserve(mac, ESP_IP4TOADDR(192, 168, 4, 100)) == ESP_ERR_NO_MEM, "the full table of the reservations");
+    make_mac(1000, mac);
+    expect(server.reserved(mac) == ESP_IP4TOADDR(192, 168, 4, 10), "lookup of the reservation");
+    expect(server.reserve(mac, ESP_IP4TOADDR(192, 168, 4, 11)) == ESP_ERR_INVALID_STATE,
+	    "the address of the other reservation is refused");
+    expect(server.reserve(mac, ESP_IP4TOADDR(192, 168, 4, 200)) == ESP_OK && server.reserved(mac) == ESP_IP4TOADDR(192, 168, 4, 200)
+	    && !server.pool().used(ESP_IP4TOADDR(192, 168, 4, 10)) && server.pool().used(ESP_IP4TOADDR(192, 168, 4, 200)),
+	    "the reservation of the MAC is replaced");
+    expect(server.pool().available() == 249 - esp::dhcp_server_t::reservations, "the reserved addresses are taken from the pool");
+
+    // the churn of the clients: the reserved MAC gets it's address, the dynamic clients never get the reserved one
+	vector<pair<uint32_t, uint32_t>> clients;	// id, address
+	unsigned conflicts = 0, wrong = 0, exhausted = 0;
+	uint32_t next = 100000;
+	constexpr unsigned churns = 5000;
+
+    for (unsigned i = 0; i < churns; i++)
+    {
+	if (clients.size() > 200 || (clients.size() && rng() % 2))
+	{
+		size_t victim = rng() % clients.size();
+
+	    make_mac(clients[victim].first, mac);
+	    expect(server.release(mac, clients[victim].second) == ESP_OK, "release of the client");
+	    clients.erase(clients.begin() + victim);
+	}; /* if clients.size() > 200 */
+
+	    uint32_t id = (rng() % 10 == 0)? 1000 - (rng() % esp::dhcp_server_t::reservations) * 7: next++;
+	    bool present = false;
+
+	for (auto& client: clients)
+	    present |= client.first == id;
+	if (present)
+	    continue;
+	make_mac(id, mac);
+	    uint32_t addr = server.assign(mac);
+	    uint32_t reserved = server.reserved(mac);
+
+	if (!addr)
+	{
+	    exhausted++;
+	    continue;
+	}; /* if !addr */
+	wrong += reserved && addr != reserved;
+	for (unsigned r = 0; r < esp::dhcp_server_t::reservations && !reserved; r++)
+	{
+		uint8_t other[6];
+
+	    make_mac(1000 - r * 7, other);
+	    conflicts += server.reserved(other) == addr;
+	}; /* for r */
+	clients.emplace_back(id, addr);
+    }; /* for i */
+    printf("\n%u clients churned: %zu connected, %u reserved addresses to the other, %u wrong reserved, %u exhausted\n",
+	    churns, clients.size(), conflicts, wrong, exhausted);
+    expect(!conflicts && !wrong && !exhausted, "the reservations under the churn");
+
+    make_mac(1000 - 7, mac);
+    expect(server.unreserve(mac) == ESP_OK && server.reserved(mac) == 0 && server.reserved() == esp::dhcp_server_t::reservations - 1
+	    && !server.pool().used(ESP_IP4TOADDR(192, 168, 4, 11)), "drop of the reservation");
+    expect(server.bind(mac, ESP_IP4TOADDR(192, 168, 4, 11)) == ESP_OK && server.pool().used(ESP_IP4TOADDR(192, 168, 4, 11)),
+	    "the address, assigned by the esp_netif server, is booked");
+
+    // the table of the server of the soft-AP mirrors the real leases of the stations
+	wifi_init_config_t wifi_init = WIFI_INIT_CONFIG_DEFAULT();
+	uint8_t peers[3][6];
+
+    ESP_ERROR_CHECK(esp::net::wifi::stack::init(&wifi_init));
+    ESP_ERROR_CHECK(esp::net::wifi::mode::set(WIFI_MODE_AP));
+    ESP_ERROR_CHECK(esp::net::wifi::stack::start());
+    expect(server.pool(ESP_IP4TOADDR(192, 168, 4, 2), ESP_IP4TOADDR(192, 168, 4, 9)) == ESP_OK && server.start() == ESP_OK,
+	    "the server of the soft-AP is started");
+    for (unsigned i = 0; i < 3; i++)
+    {
+	make_mac(200000 + i, peers[i]);
+	expect(sim::ap_join(peers[i]), "the station joins the soft-AP");
+    }; /* for i */
+    sim::settle();
+    expect(server.pool().available() == 5 && server.pool().used(ESP_IP4TOADDR(192, 168, 4, 2))
+	    && server.pool().used(ESP_IP4TOADDR(192, 168, 4, 4)), "the assigned addresses are bound");
+    sim::ap_leave(peers[1], WIFI_REASON_ASSOC_LEAVE);
+    sim::settle();
+    expect(server.pool().available() == 6 && !server.pool().used(ESP_IP4TOADDR(192, 168, 4, 3)),
+	    "the address of the disconnected station is released");
+    expect(sim::ap_join(peers[1]), "the station joins the soft-AP again");
+    sim::settle();
+    expect(server.pool().available() == 5 && server.pool().used(ESP_IP4TOADDR(192, 168, 4, 3)), "the address is bound again");
+    ESP_ERROR_CHECK(esp::net::wifi::stack::stop());
+    sim::settle();
+    expect(server.pool().available() == 8, "the addresses of the stopped soft-AP are released");
+
+    // the option of the client goes to the client API
+	esp_netif_inherent_config_t sta_inherent = ESP_NETIF_INHERENT_DEFAULT_WIFI_STA();
+	esp::wifi::netif_t sta(WIFI_IF_STA, sta_inherent);
+	uint32_t lease = 0;
+
+    sim::trace_clear();
+    sta.dhcp.client.option(ESP_NETIF_OP_GET, ESP_NETIF_IP_ADDRESS_LEASE_TIME, &lease, sizeof(lease));
+    expect(calls("esp_netif_dhcpc_option") == 1 && calls("esp_netif_dhcps_option") == 0, "option() of the client");
+
+    return report("DHCP server");
+}; /* main() */
@@ -0,0 +1,241 @@
+/*
+ * @file dispatch_test.cpp
+ *
+ * @brief Test of the esp::net::wifi::dispatcher on the simulated backend: the events are fanned out
+ *	  to the every matching subscriber, the events, posted between the waitings, are kept,
+ *	  the full queue drops & counts the new events, the synchronous updates of the Updater
+ *	  register the esp_event handlers on the first update only, and the handlers of the component
+ *	  are unregistered in the loop, they are registered in.
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "sdkconfig.h"
+#include "sim.hpp"
+#include "check.hpp"
+
+using namespace std;
+using namespace test;
+using esp::net::wifi::dispatcher;
+using esp::net::wifi::evloop;
+
+
+namespace
+{
+    void disconnected(uint8_t reason)
+    {
+	    wifi_event_sta_disconnected_t data = {};
+
+	data.reason = reason;
+	data.rssi = -70;
+	esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, &data, sizeof(data), 0);
+    }; /* disconnected() */
+
+    void on_nothing(void* arg, esp_event_base_t base, int32_t id, void* data) {};
+
+    /// count of the trace records of the backend call
+    unsigned calls(const char* what)
+    {
+	    unsigned count = 0;
+
+	for (auto& rec: sim::trace())
+	    count += strcmp(rec.what, what) == 0;
+	return count;
+    }; /* calls() */
+
+}; /* namespace <anonymous> */
+
+
+int main(int argc, char* argv[])
+{
+    esp_log_level_set("*", ESP_LOG_NONE);
+    sim::scale(0.01);
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+
+    // fan out & the events between the waitings
+    {
+	    dispatcher events;
+	    dispatcher::event_t ev;
+
+	expect(events.enroll() == ESP_OK && events.enroll() == ESP_OK, "enroll of the dispatcher");
+	    dispatcher::queue_t* link = events.subscribe(WIFI_EVENT, 1u << WIFI_EVENT_STA_DISCONNECTED);
+	    dispatcher::queue_t* link2 = events.subscribe(WIFI_EVENT, 1u << WIFI_EVENT_STA_DISCONNECTED | 1u << WIFI_EVENT_STA_START);
+	    dispatcher::queue_t* addr = events.subscribe(IP_EVENT, 1u << IP_EVENT_STA_GOT_IP);
+
+	expect(link && link2 && addr, "subscription");
+	if (!link || !link2 || !addr)
+	    return EXIT_FAILURE;
+
+	disconnected(WIFI_REASON_AUTH_FAIL);
+	esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_START, nullptr, 0, 0);
+	disconnected(WIFI_REASON_NO_AP_FOUND);
+	sim::settle();
+	expect(dispatcher::wait(*link, ev, 0) && ev.reason == WIFI_REASON_AUTH_FAIL && ev.rssi == -70
+		&& dispatcher::wait(*link, ev, 0) && ev.reason == WIFI_REASON_NO_AP_FOUND
+		&& !dispatcher::wait(*link, ev, 0), "events posted before the wait, in order");
+	expect(dispatcher::drain(*link2) == 3, "fan out to the every matching subscriber");
+	expect(!dispatcher::wait(*addr, ev, 0), "no events of the other base");
+	expect(events.delivered() == 5 && events.dropped() == 0, "count of the delivered events");
+
+	// the full queue drops the new events
+	for (unsigned i = 0; i < dispatcher::capacity + 3; i++)
+	    disconnected(i + 1);
+	sim::settle();
+	expect(dispatcher::dropped(*link) == 3 && events.dropped() == 6, "drop of the events of the full queue");
+	expect(dispatcher::wait(*link, ev, 0) && ev.reason == 1, "the oldest events are kept");
+	expect(dispatcher::drain(*link) == dispatcher::capacity - 1, "drain of the queue");
+
+	// the unsubscribed queue gets no events & is reused
+	events.unsubscribe(link2);
+	dispatcher::drain(*link2);
+	disconnected(WIFI_REASON_AUTH_FAIL);
+	sim::settle();
+	expect(!dispatcher::wait(*link2, ev, 0), "no events of the unsubscribed queue");
+	expect(events.subscribe(WIFI_EVENT, 1u << WIFI_EVENT_STA_CONNECTED) == link2, "reuse of the unsubscribed queue");
+	dispatcher::drain(*link);
+    }
+
+    // the synchronous updates: the handlers are registered by the first update only
+    sim::add_ap(sim::make_ap("home", "pass1234", 6, 1, 1));
+    sim::add_ap(sim::make_ap("office", "office-pass", 11, 2, 2));
+
+	esp_netif_inherent_config_t inherent = ESP_NETIF_INHERENT_DEFAULT_WIFI_STA();
+	esp::wifi::netif_t sta(WIFI_IF_STA, inherent);
+	wifi_init_config_t wifi_init = WIFI_INIT_CONFIG_DEFAULT();
+	::net::configuration_t cfg;
+	const char* const logins[][2] = { {"office", "office-pass"}, {"home", "pass1234"} };
+
+    ESP_ERROR_CHECK(esp::net::wifi::stack::init(&wifi_init));
+    ESP_ERROR_CHECK(esp::net::wifi::mode::set(WIFI_MODE_STA));
+    ESP_ERROR_CHECK(esp::net::wifi::stack::start());
+    cfg.login = "home";
+    cfg.passwd = "pass1234";
+    cfg.use_pwd = true;
+    expect(sta.update(cfg) == ESP_OK, "first update");
+    sta.update.finalize();
+    cfg.clr_chgst();
+
+    sim::trace_clear();
+	constexpr unsigned updates = 6;
+
+    for (unsigned i = 0; i < updates; i++)
+    {
+	cfg.login = logins[i % 2][0];
+	cfg.passwd = logins[i % 2][1];
+	expect(sta.update(cfg) == ESP_OK, "update");
+	sta.update.finalize();
+	cfg.clr_chgst();
+    }; /* for i */
+
+    // the pin of the known AP is set for the connection only: the driver & the flash keep the caller's target
+	wifi_config_t driver = {};
+	wifi_config_t flashed = sim::flashed_sta();
+	uint32_t scans = sim::counters().full_scans;
+
+    ESP_ERROR_CHECK(esp_wifi_get_config(WIFI_IF_STA, &driver));
+    expect(!driver.sta.bssid_set && !flashed.sta.bssid_set && flashed.sta.scan_method == driver.sta.scan_method,
+	    "no pin of the known AP in the driver & in the flash");
+    driver.sta.bssid_set = true;
+    memcpy(driver.sta.bssid, sim::make_ap("home", "pass1234", 6, 1, 1).bssid, sizeof(driver.sta.bssid));
+    driver.sta.scan_method = WIFI_ALL_CHANNEL_SCAN;
+    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &driver));
+    cfg.login = "office";
+    cfg.passwd = "office-pass";
+    expect(sta.update(cfg) == ESP_OK && sim::counters().full_scans == scans, "update to the known AP w/o the full scan");
+    sta.update.finalize();
+    cfg.clr_chgst();
+    esp::net::wifi::known_ap::clear();
+    cfg.login = "home";
+    cfg.passwd = "pass1234";
+    expect(sta.update(cfg) == ESP_OK, "update to the locked BSSID");
+    sta.update.finalize();
+    cfg.clr_chgst();
+    flashed = sim::flashed_sta();
+    ESP_ERROR_CHECK(esp_wifi_get_config(WIFI_IF_STA, &driver));
+    expect(driver.sta.bssid_set && flashed.sta.bssid_set && driver.sta.scan_method == WIFI_ALL_CHANNEL_SCAN
+	    && flashed.sta.scan_method == WIFI_ALL_CHANNEL_SCAN, "the BSSID lock of the caller is kept w/o the known AP");
+    driver.sta.bssid_set = false;
+    driver.sta.scan_method = WIFI_FAST_SCAN;
+    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &driver));
+
+    cfg.passwd = "wrong-password";
+    expect(sta.update(cfg) == ESP_ERR_WIFI_PASSWORD, "update with the wrong password is reverted");
+    sta.update.finalize();
+
+	unsigned registered = calls("esp_event_handler_register");
+	unsigned unregistered = calls("esp_event_handler_unregister");
+
+    printf("%u updates & the failed one: %u handlers registered, %u unregistered\n", updates, registered, unregistered);
+    expect(registered == 0 && unregistered == 0, "no handler register/unregister churn of the updates");
+
+    // the ip stage of the asynchronous update is failed by the timeout or by the disconnection, not by the credentials
+	sim::ap_t lab = sim::make_ap("lab", "lab-pass", 1, 3, 3);
+
+    lab.subnet = 0;	// no DHCP server
+    sim::add_ap(lab);
+    cfg.login = "lab";
+    cfg.passwd = "lab-pass";
+    expect(sta.update.apply(cfg).wait() == ESP_ERR_TIMEOUT, "no address of the asynchronous update is the timeout");
+    sim::settle();
+    sim::trace_clear();
+
+	uint64_t start = sim::now();
+	auto lost = sta.update.apply(cfg);
+
+    while (!calls("WIFI_EVENT_STA_CONNECTED"))
+	sim::sleep(1);
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    expect(lost.wait() == ESP_ERR_WIFI_SSID && sim::now() - start < CONFIG_WIFI_STA_WAITING_IP * 1000000ULL,
+	    "the disconnection in the ip stage fails the asynchronous update at once");
+    sim::settle();
+
+    // the PSK cache: the entry is of the SSID & the passphrase both
+	char hex[65], other[65];
+	using esp::net::wifi::pmk_cache;
+
+    ESP_ERROR_CHECK(pmk_cache::clear());
+	unsigned misses = pmk_cache::misses();
+
+    expect(pmk_cache::psk("cafe", "passphrase-1", hex) == ESP_OK && pmk_cache::psk("cafe", "passphrase-1", other, false) == ESP_OK
+	    && strcmp(hex, other) == 0 && pmk_cache::misses() == misses + 1, "the cached PSK");
+    expect(pmk_cache::psk("cafe", "passphrase-2", other, false) == ESP_ERR_NOT_FOUND
+	    && pmk_cache::psk("cafe-2", "passphrase-1", other, false) == ESP_ERR_NOT_FOUND, "no PSK of the other passphrase or SSID");
+    expect(pmk_cache::psk("cafe", "passphrase-2", other) == ESP_OK && strcmp(hex, other) != 0, "the PSK of the other passphrase");
+
+    // the handlers are unregistered in the loop, they are registered in; the own loop with the handlers is kept
+	esp_event_handler_instance_t in_default = nullptr;
+	esp_event_handler_instance_t in_own = nullptr;
+
+    expect(evloop::listen(WIFI_EVENT, WIFI_EVENT_STA_START, on_nothing, nullptr, &in_default) == ESP_OK, "listen in the default loop");
+    ESP_ERROR_CHECK(evloop::start());
+    expect(evloop::listen(WIFI_EVENT, WIFI_EVENT_STA_START, on_nothing, nullptr, &in_own) == ESP_OK, "listen in the own loop");
+    expect(evloop::listen(WIFI_EVENT, WIFI_EVENT_STA_START, on_nothing, nullptr, nullptr) == ESP_ERR_INVALID_ARG,
+	    "no handler w/o the instance in the own loop");
+    expect(evloop::stop() == ESP_ERR_INVALID_STATE && evloop::handle(), "the own loop with the handlers is not deleted");
+    expect(evloop::unlisten(WIFI_EVENT, WIFI_EVENT_STA_START, in_default) == ESP_OK, "unlisten in the default loop");
+    expect(evloop::unlisten(WIFI_EVENT, WIFI_EVENT_STA_START, in_own) == ESP_OK, "unlisten in the own loop");
+    expect(evloop::stop() == ESP_OK && !evloop::handle(), "the own loop w/o the handlers is deleted");
+
+    return report("event dispatcher");
+}; /* main() */
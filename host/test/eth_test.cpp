@@ -0,0 +1,190 @@
+/*
+ * @file eth_test.cpp
+ *
+ * @brief Test of the esp::eth::netif_t & it's Updater on the simulated esp_eth driver w/o the PHY:
+ *	  the DHCP & the static apply with the link up, the revert of the DHCP w/o the server in the wired network,
+ *	  the invalid static configuration, the apply with the cable unplugged & the address at the link up,
+ *	  the link down/up mirrored into the DHCP client, and the DMA buffers profiles.
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_eth.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+
+#include "net.h"
+#include "eth.h"
+#include "sim.hpp"
+#include "check.hpp"
+
+using namespace std;
+using namespace test;
+namespace dma = esp::eth::dma;
+
+
+namespace
+{
+    /// count of the trace records of the backend call
+    unsigned calls(const char* what)
+    {
+	    unsigned count = 0;
+
+	for (auto& rec: sim::trace())
+	    count += strcmp(rec.what, what) == 0;
+	return count;
+    }; /* calls() */
+
+    /// the update, ms of the simulated time in the 'ms'
+    esp_err_t update(esp::eth::netif_t& eth, ::net::configuration_t& cfg, double& ms)
+    {
+	    int64_t start = esp_timer_get_time();
+	    esp_err_t err = eth.update(cfg);
+
+	ms = (esp_timer_get_time() - start) / 1000.0;
+	eth.update.finalize();
+	cfg.clr_chgst();
+	sim::settle();
+	return err;
+    }; /* update() */
+
+    void set_static(::net::configuration_t& cfg, uint8_t host)
+    {
+	cfg.dhcp = false;
+	cfg.ip = ESP_IP4TOADDR(192, 168, 10, host);
+	cfg.mask = ESP_IP4TOADDR(255, 255, 255, 0);
+	cfg.gate = ESP_IP4TOADDR(192, 168, 10, 1);
+    }; /* set_static() */
+
+}; /* namespace <anonymous> */
+
+
+int main(int argc, char* argv[])
+{
+    esp_log_level_set("*", ESP_LOG_NONE);
+    sim::scale(0.01);
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+
+	esp_eth_config_t eth_cfg = ETH_DEFAULT_CONFIG(nullptr, nullptr);
+	esp_eth_handle_t driver = nullptr;
+
+    ESP_ERROR_CHECK(esp_eth_driver_install(&eth_cfg, &driver));
+
+	esp_netif_inherent_config_t inherent = ESP_NETIF_INHERENT_DEFAULT_ETH();
+	esp::eth::netif_t eth(driver, inherent);
+	esp::dhcp_client_t& client = eth.dhcp.client;
+	::net::configuration_t cfg;
+	double ms;
+
+    expect(eth.get() && eth.status() == ESP_OK && eth.driver() == driver, "creation of the netif of the driver");
+    expect(client.enabled() && client.initialized() && !eth.link(), "the state, read at the creation of the netif");
+
+    // the DMA buffers profiles
+    printf("DMA buffers: %-10s %4s %4s %6s %8s %6s\n", "profile", "rx", "tx", "size", "RAM", "burst");
+    for (auto& [name, prof]: {pair{"low_ram", dma::low_ram}, pair{"balanced", dma::balanced},
+	    pair{"throughput", dma::throughput}, pair{"configured", eth.dma()}})
+	printf("             %-10s %4u %4u %6u %8zu %6u\n", name, prof.rx, prof.tx, prof.size, prof.ram(), prof.burst());
+    expect(eth.dma().rx == CONFIG_ETH_DMA_RX_BUFFER_NUM && eth.dma().tx == CONFIG_ETH_DMA_TX_BUFFER_NUM
+	    && eth.dma().size == CONFIG_ETH_DMA_BUFFER_SIZE, "the configured profile");
+    expect(dma::low_ram.ram() < dma::balanced.ram() && dma::balanced.ram() < dma::throughput.ram()
+	    && dma::low_ram.burst() < dma::balanced.burst() && dma::balanced.burst() < dma::throughput.burst(),
+	    "the profiles trade the RAM for the burst");
+    expect(dma::balanced.ram() == 20 * (512 + esp::eth::dma_profile_t::descriptor) && dma::throughput.burst() == 6,
+	    "RAM & burst of the profile");
+    expect(!esp::eth::dma_profile_t{2, 10, 512}.valid() && !esp::eth::dma_profile_t{10, 10, 1700}.valid()
+	    && !esp::eth::dma_profile_t{10, 10, 510}.valid(), "the profile out of the ranges of the esp_eth");
+
+    // the start of the driver: the netif starts the client itself on the link up
+    ESP_ERROR_CHECK(eth.start());
+    sim::settle();
+    expect(eth.link() && eth.links() == 1, "the link is up by the autonegotiation");
+    expect(client.started() && client.leased() && client.address() == ESP_IP4TOADDR(192, 168, 10, 100),
+	    "lease of the link up");
+
+    // the static ip with the link up: the client is stopped, the IP_EVENT_ETH_GOT_IP is waited
+    sim::trace_clear();
+    set_static(cfg, 50);
+    expect(update(eth, cfg, ms) == ESP_OK, "static ip");
+    printf("static ip: %.1f ms, %u stops\n", ms, calls("esp_netif_dhcpc_stop"));
+    expect(calls("esp_netif_dhcpc_stop") == 1 && client.stopped() && !client.leased()
+	    && eth.cfg.get().ip.addr == ESP_IP4TOADDR(192, 168, 10, 50), "state of the static ip");
+    expect(update(eth, cfg, ms) == ESP_ERR_NOT_FOUND, "the unchanged configuration");
+    cfg.login = "not-used";
+    expect(update(eth, cfg, ms) == ESP_ERR_NOT_FOUND, "the login is not the configuration of the wired netif");
+
+    // the DHCP w/o the server: no address, the static ip is reverted
+    sim::eth_network(0);
+    cfg.dhcp = true;
+    expect(update(eth, cfg, ms) == ESP_ERR_TIMEOUT, "the DHCP w/o the server is timed out");
+    printf("DHCP w/o the server: reverted after %.1f ms\n", ms);
+    expect(ms >= CONFIG_NET_ETH_WAITING_IP * 1000 && client.stopped()
+	    && eth.cfg.get().ip.addr == ESP_IP4TOADDR(192, 168, 10, 50), "the static ip is reverted");
+    sim::eth_network(ESP_IP4TOADDR(192, 168, 10, 0));
+
+    // the invalid static ip: refused before any change
+    sim::trace_clear();
+    set_static(cfg, 50);
+    cfg.ip = ESP_IP4TOADDR(0, 0, 0, 0);
+    expect(update(eth, cfg, ms) == ESP_ERR_INVALID_ARG, "the static ip 0 is refused");
+    expect(calls("esp_netif_set_ip_info") == 0 && calls("esp_netif_dhcpc_start") == 0
+	    && eth.cfg.get().ip.addr == ESP_IP4TOADDR(192, 168, 10, 50), "no change by the refused configuration");
+
+    // the cable is unplugged: the DHCP is applied w/o the waiting, the address follows the link up
+    sim::eth_cable(false);
+    sim::settle();
+    expect(!eth.link(), "the link is down by the unplugged cable");
+    cfg.dhcp = true;
+    expect(update(eth, cfg, ms) == ESP_OK, "the DHCP with the link down");
+    printf("DHCP with the link down: %.1f ms\n", ms);
+    expect(ms < sim::delays().dhcp && client.started() && !client.leased(), "no waiting of the address with the link down");
+    sim::eth_cable(true);
+    sim::settle();
+    expect(eth.link() && eth.links() == 2 && client.leased() && client.address() == eth.cfg.get().ip.addr,
+	    "the address is obtained at the link up");
+
+    // the link down/up is mirrored into the client: the started client is not restarted by the updates
+    sim::eth_cable(false);
+    sim::settle();
+    expect(!client.leased() && client.initialized() && client.enabled(), "the lease is released by the link down");
+    sim::eth_cable(true);
+    sim::settle();
+    expect(eth.links() == 3 && client.started() && client.leased(), "the lease of the link up again");
+    sim::trace_clear();
+    cfg.dhcp = false;
+    cfg.dhcp = true;
+    expect(update(eth, cfg, ms) == ESP_ERR_NOT_FOUND, "the DHCP, changed back to the applied one");
+    expect(calls("esp_netif_dhcpc_start") == 0, "no restart of the leased client");
+
+    // the events of the other driver are not of this netif
+	esp_eth_handle_t other = nullptr;
+
+    ESP_ERROR_CHECK(esp_eth_driver_install(&eth_cfg, &other));
+    ESP_ERROR_CHECK(esp_eth_start(other));
+    sim::settle();
+    ESP_ERROR_CHECK(esp_eth_stop(other));
+    sim::settle();
+    expect(eth.link() && eth.links() == 3 && client.leased(), "the other driver is skipped");
+
+    // the stop of the driver
+    ESP_ERROR_CHECK(eth.stop());
+    sim::settle();
+    expect(!eth.link() && !client.leased(), "the link is down by the stop");
+    expect(esp_eth_driver_uninstall(driver) == ESP_ERR_INVALID_STATE, "the driver of the netif is not uninstalled");
+
+    return report("Ethernet netif");
+}; /* main() */
@@ -0,0 +1,163 @@
+/*
+ * @file netlog_test.cpp
+ *
+ * @brief Test of the deferred-format logging of the 'net' component (netlog.h):
+ *	  the text of the deferred record is the same as of the printf() with the same arguments,
+ *	  the compile-time & the runtime level gating, the full ring drops & counts the records,
+ *	  the concurrent producers & the flushing task lose no records.
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <esp_err.h>
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "netlog.h"
+#include "sim.hpp"
+#include "check.hpp"
+
+using namespace std;
+using namespace test;
+namespace netlog = esp::net::log;
+
+
+namespace
+{
+    /// the deferred record is formatted as the snprintf() with the same format & arguments
+    template <typename... args_t>
+    void check(const char* fmt, const args_t&... args)
+    {
+	    netlog::record_t rec{};
+	    char text[160], expect[160];
+
+	rec.format = fmt;
+	(rec.add(args), ...);
+	netlog::format(rec, text, sizeof(text));
+	snprintf(expect, sizeof(expect), fmt, args...);
+	if (strcmp(text, expect) != 0)
+	{
+	    printf("format \"%s\": \"%s\", expected \"%s\"\n", fmt, text, expect);
+	    failed++;
+	}; /* if strcmp(text, expect) != 0 */
+    }; /* check() */
+
+}; /* namespace <anonymous> */
+
+
+int main(int argc, char* argv[])
+{
+	int dummy = 0;
+
+    esp_log_level_set("*", ESP_LOG_NONE);
+
+    // formatting of the deferred records
+    check("plain text, no arguments");
+    check("%d|%i|%u", -5, ESP_ERR_NOT_FOUND, 42u);
+    check("%5u|%-4x|%08X|%#o", 42u, 255u, 0xabcdu, 8u);
+    check("%s=%s", "key", "value");
+    check("[%10s|%-6s|%.3s]", "right", "left", "truncated");
+    check("%lu %lld %hhu", 1ul << 40, -(1ll << 50), static_cast<unsigned char>(200));
+    check("%" PRIu32 " %" PRIx32 " %zu", static_cast<uint32_t>(4000000000u), static_cast<uint32_t>(0xdeadbeef), sizeof(netlog::record_t));
+    check("%.2f %e %g", 3.14159, 1e-3, 2.5f);
+    check("%c%c 100%% %i", 'o', 'k', 7);
+    check("%p", static_cast<const void*>(&dummy));
+    check("%s (%u), %s", "ASSOC_LEAVE", 8u, ::string("temporary").c_str());
+
+    // the strings over the text buffer are truncated, the rest arguments are kept
+    {
+	    netlog::record_t rec{};
+	    char text[160];
+	    string longstr(100, 'x');
+
+	rec.format = "%s|%s|%d";
+	rec.add(longstr.c_str());
+	rec.add("tail");
+	rec.add(-1);
+	netlog::format(rec, text, sizeof(text));
+	expect(strlen(text) < longstr.size() && strncmp(text, "xxxx", 4) == 0 && strcmp(text + strlen(text) - 3, "|-1") == 0,
+		"truncation of the long string argument");
+    }
+
+    // the levels above the CONFIG_NET_LOG_LEVEL are compiled out, the arguments are not evaluated
+	int evaluated = 0;
+
+    NET_LOGV("netlog_test", "verbose %d", ++evaluated);
+    expect(CONFIG_NET_LOG_LEVEL >= ESP_LOG_VERBOSE || evaluated == 0, "compile-time gating of the level");
+
+    // the runtime level: the records above it are not taken
+	uint32_t before = netlog::pending();
+
+    netlog::level(ESP_LOG_WARN);
+    NET_LOGI("netlog_test", "info %d", 1);
+    expect(netlog::pending() == before, "runtime gating of the level");
+    NET_LOGW("netlog_test", "warn %d", 2);
+    expect(netlog::pending() == before + 1, "record of the enabled level");
+    netlog::level(static_cast<esp_log_level_t>(CONFIG_NET_LOG_LEVEL));
+    netlog::flush();
+
+    // the full ring drops the new records & counts them
+	uint32_t lost = netlog::dropped();
+
+    for (unsigned i = 0; i < netlog::capacity + 5; i++)
+	NET_LOGW("netlog_test", "record %u of %s", i, "the ring");
+    expect(netlog::pending() == netlog::capacity && netlog::dropped() - lost == 5, "drop of the records of the full ring");
+    expect(netlog::flush() == netlog::capacity && netlog::pending() == 0, "flush of the full ring");
+
+    // the concurrent producers & the flushing task: every record is written or counted as dropped
+	constexpr unsigned producers = 4, records = 20000;
+	vector<thread> threads;
+	atomic<unsigned> flushed(0);
+	atomic<bool> stop(false);
+
+    lost = netlog::dropped();
+	thread consumer([&]{
+	    while (!stop)
+		flushed += netlog::flush(); });
+
+    for (unsigned t = 0; t < producers; t++)
+	threads.emplace_back([t]{
+	    for (unsigned i = 0; i < records; i++)
+	    {
+		NET_LOGI("netlog_test", "producer %u record %u: %s", t, i, "concurrent");
+		if (i % 16 == 0)	// the pace of the events, not the flood
+		    this_thread::sleep_for(chrono::microseconds(20));
+	    }; /* for i */ });
+
+    for (auto& th: threads)
+	th.join();
+    stop = true;
+    consumer.join();
+    flushed += netlog::flush();
+    printf("%u producers, %u records: %u flushed, %u dropped\n", producers, producers * records,
+	    flushed.load(), netlog::dropped() - lost);
+    expect(flushed + netlog::dropped() - lost == producers * records && flushed > netlog::capacity,
+	    "concurrent producers & consumer");
+
+    // the low-priority task flushes the ring
+    expect(netlog::start(1) == ESP_OK && netlog::start(1) == ESP_ERR_INVALID_STATE, "start of the flushing task");
+    sim::scale(1);
+    for (unsigned i = 0; i < netlog::capacity / 2; i++)
+	NET_LOGW("netlog_test", "record %u for the task", i);
+    for (unsigned i = 0; i < 1000 && netlog::pending(); i++)
+	vTaskDelay(1);
+    expect(netlog::pending() == 0, "flush by the task");
+
+    return report("deferred logging");
+}; /* main() */
@@ -0,0 +1,156 @@
+/*
+ * @file knownap.cpp
+ *
+ * @brief Table of the known AP: BSSID & channel of the last successful connection to the SSID,
+ *	  for the targeted reconnection without the full channel scan, & the address, obtained by the DHCP on it
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_wifi_types.h>
+#include <esp_wifi.h>
+
+#include <esp_log.h>
+
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "netlog.h"
+
+
+using namespace std;
+
+
+static mutex ap_lock;
+static esp::net::wifi::known_ap::entry_t ap_table[esp::net::wifi::known_ap::size];
+static esp_event_handler_instance_t ap_handler = nullptr;
+static char ap_connected[sizeof(esp::net::wifi::known_ap::entry_t::ssid)] = {};	///< SSID of the connected AP
+
+
+/// entry of the SSID, nullptr - unknown; call under the ap_lock
+static esp::net::wifi::known_ap::entry_t* ap_lookup(const char ssid[])
+{
+    if (!*ssid)
+	return nullptr;
+    for (auto& entry: ap_table)
+	if (strncmp(entry.ssid, ssid, sizeof(entry.ssid) - 1) == 0)
+	    return &entry;
+    return nullptr;
+}; /* ap_lookup() */
+
+
+
+//--[ class esp::net::wifi::known_ap ]---------------------------------------------------------------------------------
+
+
+/// @brief register the WIFI_EVENT_STA_CONNECTED handler, once
+esp_err_t esp::net::wifi::known_ap::enroll()
+{
+	lock_guard<mutex> lock(ap_lock);
+
+    if (ap_handler)
+	return ESP_OK;
+    return esp::net::wifi::evloop::listen(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, on_connected, nullptr, &ap_handler);
+}; /* esp::net::wifi::known_ap::enroll() */
+
+
+/** @brief find the known AP with the SSID
+ *  @param[in]  ssid  - SSID of the AP
+ *  @param[out] entry - the found entry
+ *  @return true - the AP is known */
+bool esp::net::wifi::known_ap::find(const char ssid[], entry_t& entry)
+{
+	lock_guard<mutex> lock(ap_lock);
+	entry_t* item = ap_lookup(ssid);
+
+    if (item)
+	entry = *item;
+    return item != nullptr;
+}; /* esp::net::wifi::known_ap::find() */
+
+
+/// @brief drop the AP with the SSID: the targeted connection to it is failed
+void esp::net::wifi::known_ap::forget(const char ssid[])
+{
+	lock_guard<mutex> lock(ap_lock);
+	entry_t* item = ap_lookup(ssid);
+
+    if (item)
+	memset(item, 0, sizeof(*item));
+}; /* esp::net::wifi::known_ap::forget() */
+
+
+/// @brief drop the all known AP
+void esp::net::wifi::known_ap::clear()
+{
+	lock_guard<mutex> lock(ap_lock);
+
+    memset(ap_table, 0, sizeof(ap_table));
+}; /* esp::net::wifi::known_ap::clear() */
+
+
+/// @brief WIFI_EVENT_STA_CONNECTED handler: store the AP to the table,
+///	   replace the free or the least recently connected entry
+void esp::net::wifi::known_ap::on_connected(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+	const wifi_event_sta_connected_t& evt = *static_cast<wifi_event_sta_connected_t*>(data);
+	char ssid[sizeof(entry_t::ssid)] = {};
+	wifi_ap_record_t info;
+	int8_t rssi = (esp_wifi_sta_get_ap_info(&info) == ESP_OK)? info.rssi: 0;
+
+    memcpy(ssid, evt.ssid, min<size_t>(evt.ssid_len, sizeof(ssid) - 1));
+
+	lock_guard<mutex> lock(ap_lock);
+	entry_t* entry = ap_lookup(ssid);
+
+    memcpy(ap_connected, ssid, sizeof(ap_connected));
+
+    if (!entry)
+    {
+	entry = &ap_table[0];
+	for (auto& item: ap_table)
+	    if (!*item.ssid || item.stamp < entry->stamp)
+	    {
+		entry = &item;
+		if (!*item.ssid)
+		    break;
+	    }; /* if !*item.ssid || item.stamp < entry->stamp */
+	memset(entry, 0, sizeof(*entry));
+	memcpy(entry->ssid, ssid, sizeof(entry->ssid));
+    }; /* if !entry */
+
+    memcpy(entry->bssid, evt.bssid, sizeof(entry->bssid));
+    entry->channel = evt.channel;
+    entry->rssi = rssi;
+    entry->stamp = esp_timer_get_time();
+    NET_LOGI(__func__, "AP \"%s\" is known: channel %u, rssi %i", entry->ssid, entry->channel, entry->rssi);
+}; /* esp::net::wifi::known_ap::on_connected() */
+
+
+/// @brief the address, obtained by the DHCP on the connected AP, is stored to it's entry
+void esp::net::wifi::known_ap::bound(uint32_t ip)
+{
+	lock_guard<mutex> lock(ap_lock);
+	entry_t* entry = ap_lookup(ap_connected);
+
+    if (!entry)
+	return;
+    entry->ip = ip;
+    NET_LOGI(__func__, "AP \"%s\": address %s", entry->ssid, esp::ip4::format(esp_ip4_addr_t{ip}).c_str());
+}; /* esp::net::wifi::known_ap::bound() */
+
+
+//--[ knownap.cpp ]----------------------------------------------------------------------------------------------------
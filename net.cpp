@@ -8,9 +8,12 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <cctype>
 #include <utility>
 
@@ -18,14 +21,17 @@
 #include <esp_log.h>
 
 #include <esp_netif.h>
+#include <nvs.h>
 
 #include <esp_system.h>
 #include <esp_types.h>
 #include <esp_event.h>
+#include <esp_timer.h>
 
 #include "astring.h"
 
 #include "net.h"
+#include "netlog.h"
 #include "sdkconfig.h"
 
 using namespace std;
@@ -49,6 +55,11 @@ esp::netif_t::netif_t(const esp_netif_config_t &config):
 esp_netif_t *esp::netif_t::create(const esp_netif_config_t &config)
 {
     instance = esp_netif_new(&config);
+    if (instance)
+    {
+	dhcp.client.sync();
+	dhcp.server.sync();
+    }; /* if instance */
     return instance;
 }; /* esp::netif_t::create(const esp_netif_config_t &esp_netif_config) */
 
@@ -56,28 +67,254 @@ esp_netif_t *esp::netif_t::create(const esp_netif_config_t &config)
 
 //--[ class esp::ip4::address ]----------------------------------------------------------------------------------------
 
-esp::ip4::base::operator const char*() const
+/// text of the ip address; reentrant, w/o snprintf
+esp::ip4::text_t esp::ip4::format(const esp_ip4_addr_t& ipaddr) noexcept
 {
-    static char buf[] = "xxx.xxx.xxx.xxx";
-    return esp_ip4addr_ntoa(/*this*/&instance(), buf, sizeof(buf));
-}; /* esp::ip4::address::operator const char*() */
+	text_t res;
+	char* pos = res.buf;
+	uint32_t addr = ipaddr.addr;
 
+    for (int i = 0; i < 4; i++, addr >>= 8)
+    {
+	    unsigned octet = addr & 0xff;
+	    unsigned hundreds = octet / 100, tens = octet / 10 % 10;
+
+	*pos = '0' + hundreds;
+	pos += hundreds != 0;
+	*pos = '0' + tens;
+	pos += (hundreds | tens) != 0;
+	*pos++ = '0' + octet % 10;
+	*pos++ = '.';
+    }; /* for i */
+    *--pos = '\0';
+    res.len = pos - res.buf;
+    return res;
+}; /* esp::ip4::format() */
+
+
+/// parse of the dotted-quad ip address text; one pass, w/o sscanf & the copy to the zero-terminated string
+bool esp::ip4::parse(std::string_view text, uint32_t& ipaddr) noexcept
+{
+	uint32_t addr = 0, octet = 0;
+	unsigned digits = 0, dots = 0;
+	bool bad = text.size() < sizeof("0.0.0.0") - 1 || text.size() >= text_t::capacity;
 
-//--[ class esp::ip4::info ]-------------------------------------------------------------------------------------------
+    for (size_t i = 0; i < text.size() && !bad; i++)
+    {
+	    unsigned digit = static_cast<unsigned char>(text[i]) - '0';
 
-///@brief check, if the mask is correct ip4 network mask
-bool esp::ip4::info::chkmask()
+	if (digit < 10)
+	{
+	    bad = ++digits > 3 || (digits > 1 && octet == 0);	// the leading zero - the octal for the inet_aton()
+	    octet = octet * 10 + digit;
+	    continue;
+	}; /* if digit < 10 */
+	bad = text[i] != '.' || !digits || octet > 255 || dots == 3;
+	addr |= octet << (8 * (dots++ & 3));
+	octet = digits = 0;
+    }; /* for i */
+
+    if (bad || dots != 3 || !digits || octet > 255)
+	return false;
+    ipaddr = addr | octet << 24;
+    return true;
+}; /* esp::ip4::parse() */
+
+
+//--[ class esp::ip4::lpm_t ]------------------------------------------------------------------------------------------
+
+esp::ip4::lpm_t::lpm_t(route_t routes[], size_t maxroutes, node_t trienodes[], size_t maxnodes) noexcept:
+	routes(routes),
+	trie(trienodes),
+	maxroutes(maxroutes),
+	maxnodes(maxnodes)
 {
-	uint32_t pattern = (1UL << 31) - 1 /*0x7fffffff*/;
+    memset(trie[0], 0, sizeof(node_t));
+}; /* esp::ip4::lpm_t::lpm_t() */
+
 
-    for (int i = 1; i < (32-1); i++)
+/// add the network or change the value of the network already present
+esp_err_t esp::ip4::lpm_t::add(const network& net, value_t value)
+{
+    if (!net.valid() || value == none)
+	return ESP_ERR_INVALID_ARG;
+
+	route_t* route = find_if(routes, routes + count, [&net](const route_t& r){ return r.net == net; });
+
+    if (route == routes + count)
     {
-	pattern = pattern << 1;
-	if (netmask.addr == pattern )
-	    return true;
-    }; /* for (int i = 1; i < (32-1); i++) */
-    return false;
-}; /* esp::ip4::info::chkmask() */
+	if (count == maxroutes)
+	    return ESP_ERR_NO_MEM;
+	*route = {network(net.net(), net.mask()), value};
+	count++;
+    }
+    else
+	route->value = value;
+
+    if (insert(*route) != ESP_OK)
+    {
+	// out of the nodes: revert the new network, drop the nodes already allocated for it
+	*route = routes[--count];
+	rebuild();
+	return ESP_ERR_NO_MEM;
+    }; /* if insert() != ESP_OK */
+    return ESP_OK;
+}; /* esp::ip4::lpm_t::add() */
+
+
+/// remove the network
+esp_err_t esp::ip4::lpm_t::remove(const network& net)
+{
+	route_t* route = find_if(routes, routes + count, [&net](const route_t& r){ return r.net == net; });
+
+    if (route == routes + count)
+	return ESP_ERR_NOT_FOUND;
+    *route = routes[--count];
+    rebuild();
+    return ESP_OK;
+}; /* esp::ip4::lpm_t::remove() */
+
+
+void esp::ip4::lpm_t::clear()
+{
+    count = 0;
+    rebuild();
+}; /* esp::ip4::lpm_t::clear() */
+
+
+/// lookup of the each address of the array
+void esp::ip4::lpm_t::lookup(const uint32_t ipaddrs[], value_t values[], size_t n) const noexcept
+{
+    for (size_t i = 0; i < n; i++)
+	values[i] = lookup(ipaddrs[i]);
+}; /* esp::ip4::lpm_t::lookup() */
+
+
+/// expand the network to the slots of the node of the last level of the prefix
+esp_err_t esp::ip4::lpm_t::insert(const route_t& route)
+{
+	uint32_t addr = ntoh(route.net.net());
+	unsigned len = route.net.length();
+	uint16_t node = 0;
+
+    for (unsigned bits = 4; ; bits += 4)
+    {
+	    unsigned idx = (addr >> (32 - bits)) & 0xf;
+
+	if (len <= bits)
+	{
+		unsigned span = 1u << (bits - len);
+
+	    for (slot_t* slot = trie[node] + (idx & ~(span - 1)); span--; slot++)
+		if (slot->len <= len + 1)	// the more specific network is kept
+		{
+		    slot->len = len + 1;
+		    slot->value = route.value;
+		}; /* if slot->len <= len + 1 */
+	    return ESP_OK;
+	}; /* if len <= bits */
+
+	if (!trie[node][idx].child)
+	{
+	    if (used == maxnodes)
+		return ESP_ERR_NO_MEM;
+	    memset(trie[used], 0, sizeof(node_t));
+	    trie[node][idx].child = used++;
+	}; /* if !child */
+	node = trie[node][idx].child;
+    }; /* for bits */
+}; /* esp::ip4::lpm_t::insert() */
+
+
+/// rebuild of the trie from the networks list, after the removal
+void esp::ip4::lpm_t::rebuild()
+{
+    used = 1;
+    memset(trie[0], 0, sizeof(node_t));
+    for (size_t i = 0; i < count; i++)
+	insert(routes[i]);
+}; /* esp::ip4::lpm_t::rebuild() */
+
+
+//--[ class esp::ip4::pool_t ]-----------------------------------------------------------------------------------------
+
+
+/// the bits of the last word over the range are set: they are never allocated
+esp_err_t esp::ip4::pool_t::range(uint32_t first, uint32_t last)
+{
+	uint32_t lo = ntoh(first), hi = ntoh(last);
+
+    if (lo > hi)
+	return ESP_ERR_INVALID_ARG;
+    if (hi - lo >= capacity())
+	return ESP_ERR_NO_MEM;
+    base = lo;
+    count = hi - lo + 1;
+    clear();
+    return ESP_OK;
+}; /* esp::ip4::pool_t::range() */
+
+
+void esp::ip4::pool_t::clear()
+{
+	size_t nwords = (count + 31) / 32;
+
+    memset(words, 0, maxwords * sizeof(*words));
+    if (count % 32)
+	words[nwords - 1] = ~0u << (count % 32);
+    nfree = count;
+    cursor = 0;
+}; /* esp::ip4::pool_t::clear() */
+
+
+/// @brief next fit: the words before the cursor are searched after the wrap only
+uint32_t esp::ip4::pool_t::alloc()
+{
+	size_t nwords = (count + 31) / 32;
+
+    if (!nfree)
+	return 0;
+    for (size_t i = 0, w = cursor; i < nwords; i++, w = (w + 1 == nwords)? 0: w + 1)
+	if (words[w] != ~0u)
+	{
+		unsigned bit = __builtin_ctz(~words[w]);
+
+	    words[w] |= 1u << bit;
+	    nfree--;
+	    cursor = w;
+	    return hton(base + w * 32 + bit);
+	}; /* if words[w] != ~0u */
+    return 0;
+}; /* esp::ip4::pool_t::alloc() */
+
+
+esp_err_t esp::ip4::pool_t::take(uint32_t ipaddr)
+{
+	uint32_t index = ntoh(ipaddr) - base;
+
+    if (!contains(ipaddr))
+	return ESP_ERR_NOT_FOUND;
+    if (used(ipaddr))
+	return ESP_ERR_INVALID_STATE;
+    words[index / 32] |= 1u << (index % 32);
+    nfree--;
+    return ESP_OK;
+}; /* esp::ip4::pool_t::take() */
+
+
+esp_err_t esp::ip4::pool_t::release(uint32_t ipaddr)
+{
+	uint32_t index = ntoh(ipaddr) - base;
+
+    if (!contains(ipaddr))
+	return ESP_ERR_NOT_FOUND;
+    if (!used(ipaddr))
+	return ESP_ERR_INVALID_STATE;
+    words[index / 32] &= ~(1u << (index % 32));
+    nfree++;
+    return ESP_OK;
+}; /* esp::ip4::pool_t::release() */
+
 
 
 //--[ class esp::dhcp_client_t ]---------------------------------------------------------------------------------------
@@ -85,36 +322,318 @@ bool esp::ip4::info::chkmask()
 /// Get/set DHCP option of the DHCP client
 esp_err_t esp::dhcp_client_t::option(esp_netif_dhcp_option_mode_t opt_op, esp_netif_dhcp_option_id_t opt_id, void *opt_val, uint32_t opt_len)
 {
-//    esp_err_t esp_netif_dhcps_option(esp_netif_t *esp_netif, esp_netif_dhcp_option_mode_t opt_op, esp_netif_dhcp_option_id_t opt_id, void *opt_val, uint32_t opt_len);
-    err = esp_netif_dhcps_option(netif->get(), opt_op, opt_id, opt_val, opt_len);
+    err = esp_netif_dhcpc_option(netif->get(), opt_op, opt_id, opt_val, opt_len);
     return err;
 }; /* esp::dhcp_client_t::option */
 
-///@brief start DHCP client
+///@brief start DHCP client; the client, started already, is mirrored as started too
 esp_err_t esp::dhcp_client_t::start()
 {
     err = esp_netif_dhcpc_start(netif->get());
+    if (err == ESP_OK || err == ESP_ERR_ESP_NETIF_DHCP_ALREADY_STARTED)
+	stat.store(ESP_NETIF_DHCP_STARTED, memory_order_release);
     return err;
 }; /* esp::dhcp_client_t::start */
 
-///@brief stop DHCP client
+///@brief stop DHCP client; the address of the stopped client is released by the netif
 esp_err_t esp::dhcp_client_t::stop()
 {
     err = esp_netif_dhcpc_stop(netif->get());
+    if (err == ESP_OK || err == ESP_ERR_ESP_NETIF_DHCP_ALREADY_STOPPED)
+    {
+	stat.store(ESP_NETIF_DHCP_STOPPED, memory_order_release);
+	lost();
+    }; /* if err == ESP_OK */
     return err;
 }; /* esp::dhcp_client_t::stop */
 
+///@brief the entry of the lwIP dhcp_state.c: the namespace "dhcp_state", the key is the name of the lwIP netif;
+///	  the same address is not rewritten, the 0 erases the entry; the NAKed one is erased by the lwIP itself
+esp_err_t esp::dhcp_client_t::restore(uint32_t ip)
+{
+#ifdef CONFIG_LWIP_DHCP_RESTORE_LAST_IP
+	char key[6];
+	nvs_handle_t nvs;
+	uint32_t stored = 0;
+
+    if ((err = esp_netif_get_netif_impl_name(netif->get(), key)) != ESP_OK
+	    || (err = nvs_open("dhcp_state", NVS_READWRITE, &nvs)) != ESP_OK)
+	return err;
+    if (nvs_get_u32(nvs, key, &stored) == ESP_OK? stored != ip: ip != 0)
+	if ((err = ip? nvs_set_u32(nvs, key, ip): nvs_erase_key(nvs, key)) == ESP_OK)
+	    err = nvs_commit(nvs);
+    nvs_close(nvs);
+    return err;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}; /* esp::dhcp_client_t::restore */
+
 
 
 ///@brief status of the DHCP client
 esp_netif_dhcp_status_t esp::dhcp_client_t::status() const
 {
-	esp_netif_dhcp_status_t status;
-    err = esp_netif_dhcpc_get_status(netif->get(), &status);
-    return status;
+    return static_cast<esp_netif_dhcp_status_t>(stat.load(memory_order_acquire));
 }; /* esp::dhcp_client_t::status */
 
 
+esp_err_t esp::dhcp_client_t::sync()
+{
+	esp_netif_dhcp_status_t status = ESP_NETIF_DHCP_INIT;
+
+    enable.store(netif->flags() & ESP_NETIF_DHCP_CLIENT, memory_order_relaxed);
+    if ((err = esp_netif_dhcpc_get_status(netif->get(), &status)) == ESP_OK)
+	stat.store(status, memory_order_release);
+    return err;
+}; /* esp::dhcp_client_t::sync */
+
+
+///@brief as the esp_netif does on the esp_netif_up()/esp_netif_down()
+void esp::dhcp_client_t::link(bool up)
+{
+	uint8_t expected = up? ESP_NETIF_DHCP_INIT: ESP_NETIF_DHCP_STARTED;
+
+    if (!enabled())
+	return;
+    stat.compare_exchange_strong(expected, up? ESP_NETIF_DHCP_STARTED: ESP_NETIF_DHCP_INIT, memory_order_acq_rel);
+    if (!up)
+	lost();
+}; /* esp::dhcp_client_t::link */
+
+
+///@brief the static address is not a lease; the lease time isn't reported by the every backend:
+///	  it is 0 (unknown) then, the deadlines too
+void esp::dhcp_client_t::bound(const esp_netif_ip_info_t& info)
+{
+	uint32_t lease = 0;
+
+    if (!started())
+	return;
+    if (esp_netif_dhcpc_option(netif->get(), ESP_NETIF_OP_GET, ESP_NETIF_IP_ADDRESS_LEASE_TIME, &lease, sizeof(lease)) != ESP_OK)
+	lease = 0;
+    lease_s.store(lease, memory_order_relaxed);
+    since.store(esp_timer_get_time() / 1000, memory_order_relaxed);
+    lease_addr.store(info.ip.addr, memory_order_release);
+}; /* esp::dhcp_client_t::bound */
+
+
+void esp::dhcp_client_t::lost()
+{
+    lease_addr.store(0, memory_order_release);
+    lease_s.store(0, memory_order_relaxed);
+}; /* esp::dhcp_client_t::lost */
+
+
+///@brief the part num/den of the lease time after the obtaining, RFC 2131 4.4.5
+uint32_t esp::dhcp_client_t::deadline(uint32_t num, uint32_t den) const
+{
+	uint32_t lease = lease_s.load(memory_order_relaxed);
+
+    if (!lease || !leased())
+	return 0;
+    return since.load(memory_order_relaxed) + static_cast<uint32_t>(uint64_t(lease) * 1000 * num / den);
+}; /* esp::dhcp_client_t::deadline */
+
+
+
+
+//--[ class esp::dhcp_server_t ]---------------------------------------------------------------------------------------
+
+/// Get/set DHCP option of the DHCP server
+esp_err_t esp::dhcp_server_t::option(esp_netif_dhcp_option_mode_t opt_op, esp_netif_dhcp_option_id_t opt_id, void *opt_val, uint32_t opt_len)
+{
+    err = esp_netif_dhcps_option(netif->get(), opt_op, opt_id, opt_val, opt_len);
+    return err;
+}; /* esp::dhcp_server_t::option */
+
+
+///@brief start DHCP server; the server, started already, is mirrored as started too
+esp_err_t esp::dhcp_server_t::start()
+{
+    err = esp_netif_dhcps_start(netif->get());
+    if (err == ESP_OK || err == ESP_ERR_ESP_NETIF_DHCP_ALREADY_STARTED)
+	stat = ESP_NETIF_DHCP_STARTED;
+    return err;
+}; /* esp::dhcp_server_t::start */
+
+
+esp_err_t esp::dhcp_server_t::stop()
+{
+    err = esp_netif_dhcps_stop(netif->get());
+    if (err == ESP_OK || err == ESP_ERR_ESP_NETIF_DHCP_ALREADY_STOPPED)
+	stat = ESP_NETIF_DHCP_STOPPED;
+    return err;
+}; /* esp::dhcp_server_t::stop */
+
+
+esp_err_t esp::dhcp_server_t::sync()
+{
+	esp_netif_dhcp_status_t status = ESP_NETIF_DHCP_INIT;
+
+    enable = netif->flags() & ESP_NETIF_DHCP_SERVER;
+    if ((err = esp_netif_dhcps_get_status(netif->get(), &status)) == ESP_OK)
+	stat = status;
+    return err;
+}; /* esp::dhcp_server_t::sync */
+
+
+///@brief the esp_netif server accepts the options stopped only: the started one is restarted
+esp_err_t esp::dhcp_server_t::pool(uint32_t first, uint32_t last)
+{
+	dhcps_lease_t lease = {};
+	bool restart = started();
+
+    if (ip4::ntoh(first) > ip4::ntoh(last))
+	return (err = ESP_ERR_INVALID_ARG);
+    if (ip4::ntoh(last) - ip4::ntoh(first) >= addrs.capacity())
+	return (err = ESP_ERR_NO_MEM);
+    lease.enable = true;
+    lease.start_ip.addr = first;
+    lease.end_ip.addr = last;
+    if (restart && stop() != ESP_OK)
+	return err;
+    option(ESP_NETIF_OP_SET, ESP_NETIF_REQUESTED_IP_ADDRESS, &lease, sizeof(lease));
+    if (err == ESP_OK)
+    {
+	addrs.range(first, last);
+	for (size_t i = 0; i < nreserved; i++)
+	    addrs.take(table[i].ip);
+    }; /* if err == ESP_OK */
+    if (restart)
+    {
+	    esp_err_t result = err;
+
+	if (start() == ESP_OK)
+	    err = result;
+    }; /* if restart */
+    return err;
+}; /* esp::dhcp_server_t::pool */
+
+
+esp_err_t esp::dhcp_server_t::lease_time(uint32_t seconds)
+{
+	uint32_t minutes = (seconds + 59) / 60;
+	bool restart = started();
+
+    if (restart && stop() != ESP_OK)
+	return err;
+    if (option(ESP_NETIF_OP_SET, ESP_NETIF_IP_ADDRESS_LEASE_TIME, &minutes, sizeof(minutes)) == ESP_OK)
+	lease_s = minutes * 60;
+    if (restart)
+    {
+	    esp_err_t result = err;
+
+	if (start() == ESP_OK)
+	    err = result;
+    }; /* if restart */
+    return err;
+}; /* esp::dhcp_server_t::lease_time */
+
+
+size_t esp::dhcp_server_t::lower(const uint8_t mac[6]) const
+{
+	size_t lo = 0, hi = nreserved;
+
+    while (lo < hi)
+    {
+	    size_t mid = (lo + hi) / 2;
+
+	if (memcmp(table[mid].mac, mac, sizeof(table[mid].mac)) < 0)
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }; /* while lo < hi */
+    return lo;
+}; /* esp::dhcp_server_t::lower */
+
+
+bool esp::dhcp_server_t::reserved_ip(uint32_t ip) const
+{
+    for (size_t i = 0; i < nreserved; i++)
+	if (table[i].ip == ip)
+	    return true;
+    return false;
+}; /* esp::dhcp_server_t::reserved_ip */
+
+
+///@brief the table is kept sorted by the MAC: the insertion moves the tail;
+///	  the esp_netif server hands out the addresses of it's pool by itself - the reservation is warned
+esp_err_t esp::dhcp_server_t::reserve(const uint8_t mac[6], uint32_t ip)
+{
+	size_t pos = lower(mac);
+	bool found = pos < nreserved && memcmp(table[pos].mac, mac, sizeof(table[pos].mac)) == 0;
+
+    if (found && table[pos].ip == ip)
+	return ESP_OK;
+    if (!found && nreserved == reservations)
+	return ESP_ERR_NO_MEM;
+    if (reserved_ip(ip) || addrs.used(ip))
+	return ESP_ERR_INVALID_STATE;
+    if (enable)
+	NET_LOGW(__func__, "The esp_netif DHCP server doesn't honour the reservation of %s:"
+		" the client gets it by the assign() only, the server %s", esp::ip4::format(esp_ip4_addr_t{ip}).c_str(),
+		addrs.contains(ip)? "may hand it out to the other client": "never hands it out");
+    if (found)
+	addrs.release(table[pos].ip);
+    else
+    {
+	memmove(&table[pos + 1], &table[pos], (nreserved - pos) * sizeof(table[0]));
+	memcpy(table[pos].mac, mac, sizeof(table[pos].mac));
+	nreserved++;
+    }; /* else !found */
+    table[pos].ip = ip;
+    addrs.take(ip);
+    return ESP_OK;
+}; /* esp::dhcp_server_t::reserve */
+
+
+esp_err_t esp::dhcp_server_t::unreserve(const uint8_t mac[6])
+{
+	size_t pos = lower(mac);
+
+    if (pos == nreserved || memcmp(table[pos].mac, mac, sizeof(table[pos].mac)) != 0)
+	return ESP_ERR_NOT_FOUND;
+    addrs.release(table[pos].ip);
+    memmove(&table[pos], &table[pos + 1], (nreserved - pos - 1) * sizeof(table[0]));
+    nreserved--;
+    return ESP_OK;
+}; /* esp::dhcp_server_t::unreserve */
+
+
+uint32_t esp::dhcp_server_t::reserved(const uint8_t mac[6]) const
+{
+	size_t pos = lower(mac);
+
+    if (pos == nreserved || memcmp(table[pos].mac, mac, sizeof(table[pos].mac)) != 0)
+	return 0;
+    return table[pos].ip;
+}; /* esp::dhcp_server_t::reserved */
+
+
+uint32_t esp::dhcp_server_t::assign(const uint8_t mac[6])
+{
+	uint32_t ip = reserved(mac);
+
+    return ip? ip: addrs.alloc();
+}; /* esp::dhcp_server_t::assign */
+
+
+esp_err_t esp::dhcp_server_t::release(const uint8_t mac[6], uint32_t ip)
+{
+    if (reserved(mac) == ip)
+	return ESP_OK;
+    return addrs.release(ip);
+}; /* esp::dhcp_server_t::release */
+
+
+esp_err_t esp::dhcp_server_t::bind(const uint8_t mac[6], uint32_t ip)
+{
+    if (reserved(mac) == ip)
+	return ESP_OK;
+    return addrs.take(ip);
+}; /* esp::dhcp_server_t::bind */
+
 
 
 namespace net
@@ -123,28 +642,67 @@ namespace net
     //--[ class net::configuration_t ]---------------------------------------------------------------------------------
 
 
-    configuration_t::configuration_t(const configuration_t& cfg):
-	ip(cfg.ip),
-	mask(cfg.mask),
-	gate(cfg.gate),
-	dhcp(cfg.dhcp),
-	use_pwd(cfg.use_pwd),
-	login(cfg.login),
-	passwd(cfg.passwd)
-    { };
+    configuration_t::configuration_t(const configuration_t& cfg) noexcept:
+	fields_t(cfg)
+    {};
 
 
     configuration_t::configuration_t(bool dhcp_st, const esp::ip4::info& info,
 		const std::string& log_in, const std::string& passw):
-	ip(info.ip.addr),
-	mask(info.netmask.addr),
-	gate(info.gw.addr),
-	dhcp(dhcp_st),
-	use_pwd(log_in.length() > 0? true: false),
-	login(log_in),
-	passwd(passw)
+	fields_t(dhcp_st, info.ip.addr, info.netmask.addr, info.gw.addr,
+		log_in.length() > 0? true: false, log_in, passw)
+    {};
+
+
+    configuration_t::configuration_t(bool dhcp_st, const esp::ip4::info& info, const char log_in[], const char passw[]):
+	fields_t(dhcp_st, info.ip.addr, info.netmask.addr, info.gw.addr,
+		*log_in? true: false, log_in, passw)
     {};
 
+
+    configuration_t& configuration_t::operator =(const configuration_t& cfg) noexcept
+    {
+	ip = cfg.ip;
+	mask = cfg.mask;
+	gate = cfg.gate;
+	dhcp = cfg.dhcp;
+	use_pwd = cfg.use_pwd;
+	login = cfg.login;
+	passwd = cfg.passwd;
+	return *this;
+    }; /* net::configuration_t::operator =() */
+
+
+    /// FNV-1a 32-bit of the data block
+    static uint32_t fnv1a(uint32_t hash, const void* data, size_t size)
+    {
+	for (size_t i = 0; i < size; i++)
+	    hash = (hash ^ static_cast<const uint8_t*>(data)[i]) * 16777619U;
+	return hash;
+    }; /* fnv1a() */
+
+    /// 32-bit fingerprint (FNV-1a) of the configuration values, never 0
+    uint32_t configuration_t::fingerprint() const
+    {
+	    uint32_t hash = 2166136261U;
+	    const uint32_t addr[] = {ip, mask, gate};
+	    const uint8_t flags[] = {dhcp, use_pwd};
+
+	hash = fnv1a(hash, addr, sizeof(addr));
+	hash = fnv1a(hash, flags, sizeof(flags));
+	hash = fnv1a(hash, login.c_str(), strlen(login.c_str()) + 1);	// with the terminating zero - separator
+	hash = fnv1a(hash, passwd.c_str(), strlen(passwd.c_str()));
+	return hash? hash: 1;
+    }; /* net::configuration_t::fingerprint() */
+
+    bool configuration_t::same(const configuration_t& other) const
+    {
+	return uint32_t(ip) == uint32_t(other.ip) && uint32_t(mask) == uint32_t(other.mask)
+		&& uint32_t(gate) == uint32_t(other.gate) && bool(dhcp) == bool(other.dhcp)
+		&& bool(use_pwd) == bool(other.use_pwd) && strcmp(login.c_str(), other.login.c_str()) == 0
+		&& strcmp(passwd.c_str(), other.passwd.c_str()) == 0;
+    }; /* net::configuration_t::same() */
+
     const esp_netif_ip_info_t *configuration_t::ipdata() const
     {
 	    static esp_netif_ip_info_t ipcfg;
@@ -155,60 +713,30 @@ namespace net
 	return &ipcfg;
     }; /* net::configuration::ipdata() */
 
-    /// Clear status of the changing the 'cfg' object
-    void configuration_t::clr_chgst()
-    {
-	ESP_LOGW(__func__, " ###--- clear change status of the DHCP state");
-	dhcp.clr_chgstat();
-
-	ESP_LOGW(__func__, " ###--- clear change status of the ip-address");
-	ip.clr_chgstat();
-
-	ESP_LOGW(__func__, " ###--- clear change status of the net mask");
-	mask.clr_chgstat();
-
-	ESP_LOGW(__func__, " ###--- clear change status of the gateway address");
-	gate.clr_chgstat();
-
-	ESP_LOGW(__func__, " ###--- clear change status of the Using Password state");
-	use_pwd.clr_chgstat();
-
-	ESP_LOGW(__func__, " ###--- clear change status of the WiFi Login/SSID");
-	login.clr_chgstat();
-
-	ESP_LOGW(__func__, " ###--- clear change status of the WiFi password");
-	passwd.clr_chgstat();
-    }; /* net::configuration::clr_chgst() */
-
 
 
 
     namespace cfg
     {
 
-	/// @brief set the DHCP status from the string
-	const flag_field& flag_field::operator =(const std::string& str)
+	/// @brief the flag of the string: 1 - confirmed, 0 - declined, -1 - neither
+	int flag_value(const std::string& str)
 	{
 	    if (astr::confirm(str))
-	    {
-		set_chgstat();
-		state = true;
-	    }; /* if configuration::yes_str(str) */
+		return 1;
 	    if (astr::decline(str))
-	    {
-		set_chgstat();
-		state = false;
-	    }; /* if configuration::no_str(str) */
-	    return *this;
-	}; /* net::cfg::flag_field::operator= (const string&) */
-
-	string_field::operator const char*()
+		return 0;
+	    return -1;
+	}; /* net::cfg::flag_value() */
+
+	/// @brief the copy of the string in the static buffer, valid up to the next call
+	const char* string_buffer(const std::string& str)
 	{
 		static std::string strbuf;
 
-	    strbuf = val;
+	    strbuf = str;
 	    return strbuf.c_str();
-	}; /* net::cfg::info::string_field::operator const char*() */
+	}; /* net::cfg::string_buffer() */
 
     }; /* namespace net::cfg */
 
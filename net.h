@@ -31,6 +31,24 @@ extern "C" {
 } /* extern "C" */
 
 
+/// Login/password fields of the net::configuration_t are stored inline, in the fixed buffers
+/// of the wifi_sta_config_t sizes: the copy of the configuration is never allocate the heap.
+/// 0 - the fields are std::string, unlimited length.
+#ifndef CONFIG_NET_CFG_INLINE_STRINGS
+#define CONFIG_NET_CFG_INLINE_STRINGS 1
+#endif
+
+/// Addresses of the pool of the DHCP server, at most: the bitmap of the allocator is inline, a bit per address
+#ifndef CONFIG_NET_DHCPS_POOL_MAX
+#define CONFIG_NET_DHCPS_POOL_MAX 256
+#endif
+
+/// Static MAC -> IP reservations in the address book of the DHCP server (not seen by the esp_netif server)
+#ifndef CONFIG_NET_DHCPS_RESERVATIONS
+#define CONFIG_NET_DHCPS_RESERVATIONS 8
+#endif
+
+
 namespace net
 {
   /// forward declaration
@@ -45,16 +63,66 @@ namespace esp
     namespace ip4
     {
 
-	///@brief check, if the mask is correct ip4 network mask
-	bool chkmask(uint32_t mask);
+	/// @brief tag of the ip address classes: esp::ip4::base<> & the derived
+	struct ip4_tag {};
 
-	///@brief Base of ip address class: interface for manipulating with esp_ip4_addr_t
-	class base
+	/// @brief the type is the ip address class
+	template <typename iptype>
+	struct is_address: std::is_base_of<ip4_tag, iptype> {};
+
+
+	///@brief conversion any types, mappable to ip address
+	///@parameter   any type value, represented the ip-address
+	///@return	    ip-address uint32_t value, according the passed parameter
+	constexpr uint32_t value(uint32_t ipvalue) noexcept { return ipvalue; };
+	constexpr uint32_t value(const esp_ip4_addr_t& ipaddr) noexcept { return ipaddr.addr; };
+	uint32_t value(std::string_view ipaddr) noexcept;
+	template <typename iptype, typename std::enable_if<is_address<iptype>::value, int>::type = 0>
+	constexpr uint32_t value(const iptype& ipaddr) noexcept { return static_cast<const esp_ip4_addr_t&>(ipaddr).addr; };
+
+
+	/// @brief text of the ip address "ddd.ddd.ddd.ddd", returned by value -
+	///	   own storage of the each caller, w/o static buffer & heap; no implicit conversion
+	///	   to the const char*: the pointer of the temporary text is dangling after the full expression
+	class text_t
 	{
 	public:
+	    static constexpr size_t capacity = sizeof("255.255.255.255");
+
+	    const char* c_str() const noexcept { return buf; };
+	    size_t size() const noexcept { return len; };
 
-	    virtual ~base() {};
+	private:
+	    friend text_t format(const esp_ip4_addr_t& ipaddr) noexcept;
+
+	    char    buf[capacity];
+	    uint8_t len;
+	}; /* class esp::ip4::text_t */
 
+	/// @brief text of the ip address; reentrant
+	text_t format(const esp_ip4_addr_t& ipaddr) noexcept;
+
+	/// @brief parse of the dotted-quad ip address text: strict decimal "a.b.c.d", each octet 1..3 digits, <= 255,
+	///	   w/o the leading zeros: "010" is the octal 8 for the esp_ip4addr_aton(), it is rejected, not read as 10
+	/// @return
+	///  - true  - the text is correct ip address, stored to the 'ipaddr'
+	///  - false - the text is not an ip address, 'ipaddr' is not changed
+	bool parse(std::string_view text, uint32_t& ipaddr) noexcept;
+
+	/// @brief the text to ip address; IPADDR_NONE (0xffffffff, as the esp_ip4addr_aton()) for the incorrect text
+	inline uint32_t value(std::string_view ipaddr) noexcept {
+		uint32_t res = 0xffffffffUL;
+	    parse(ipaddr, res);
+	    return res; };
+
+
+	///@brief Base of ip address class: interface for manipulating with esp_ip4_addr_t;
+	///	  static polymorphism (CRTP) - the 'derived' class provides the storage by the data() methods,
+	///	  all the calls are resolved & inlined at the compile time, without the vtable
+	template <class derived>
+	class base: public ip4_tag
+	{
+	public:
 
 	    /// @brief Set new value of the ip
 	    ///
@@ -63,105 +131,98 @@ namespace esp
 	    ///  - ESP_ERR_NOT_FINISHED - ip adress was not changed by new ip is rq the old ip
 	    ///  - ESP_FAIL - ip address was not changed by the error in the new ip
 	    template <typename iptype>
-	    esp_err_t set(const iptype& ipaddr);
+	    constexpr esp_err_t set(const iptype& ipaddr) {
+		if (instance().addr == value(ipaddr))	///< if new ip is eq the old ip - not any changed
+		    return ESP_ERR_NOT_FINISHED;
+		instance().addr = value(ipaddr);
+		return ESP_OK; /*ESP_FAIL*/ };
 
 	    ///@brief conversion any types, mappable to ip address
-	    ///@parameter   any type value, represented the ip-address
-	    ///@return	    ip-address uint32_t value, according the passed parameter
 	    template <typename iptype>
-	    static uint32_t value(const iptype& ipaddr);
+	    static constexpr uint32_t value(const iptype& ipaddr) { return esp::ip4::value(ipaddr); };
 
-	    template <typename iptype>
-	    const base& operator =(const iptype& ip) noexcept
-				{ set(ip); return *this;};
-
-	    operator uint32_t() const { return instance().addr;};
-	    operator uint32_t&() { return instance().addr;};
-	    operator const esp_ip4_addr_t&() const noexcept { return instance(); };
-	    operator const char*() const;
-	    operator std::string() const {return static_cast<const char*>(*this);};
-
-
-	    friend bool operator == (const base& left, const base& right) noexcept {
-		return left.instance().addr == right.instance().addr; };
-
-	    template <typename iptype>
-	    friend bool operator == (const base& left, const iptype& right) noexcept;
+	    constexpr operator uint32_t() const { return instance().addr;};
+	    constexpr operator uint32_t&() { return instance().addr;};
+	    constexpr operator const esp_ip4_addr_t&() const noexcept { return instance(); };
+	    /// text of the address: text().c_str() instead of the former operator const char*() - the text
+	    /// in the static buffer of the ntoa() is removed, the static_cast<const char*>(addr) is not compiled
+	    text_t text() const noexcept { return format(instance()); };
+	    operator text_t() const noexcept { return text(); };
+	    operator std::string() const {return text().c_str();};
 
-	    template <typename iptype>
-	    friend bool operator == (const iptype& left, const base& right) noexcept {
-		return operator ==(right, left); }
+	protected:
 
-	    template <typename iptype>
-	    friend bool operator != (const base& left, const iptype& right) noexcept {
-		return !(operator==(left, right)); };
+	    constexpr esp_ip4_addr_t& instance() { return static_cast<derived&>(*this).data(); };
+	    constexpr const esp_ip4_addr_t& instance() const { return static_cast<const derived&>(*this).data(); };
 
-	    template <typename iptype>
-	    friend bool operator != (const iptype& left, const base& right) noexcept {
-		return !(operator ==(left, right)); }
+	}; /* class esp::ip4::base */
 
-	protected:
 
-	    virtual esp_ip4_addr_t& instance() = 0;
-	    virtual const esp_ip4_addr_t& instance() const = 0;
+	template <class left_t, class right_t>
+	constexpr bool operator == (const base<left_t>& left, const base<right_t>& right) noexcept {
+	    return value(left) == value(right); };
 
-	}; /* class esp::ip4::base */
+	template <class left_t, typename iptype, typename std::enable_if<!is_address<iptype>::value, int>::type = 0>
+	constexpr bool operator == (const base<left_t>& left, const iptype& right) noexcept {
+	    return value(left) == value(right); };
 
+	template <typename iptype, class right_t, typename std::enable_if<!is_address<iptype>::value, int>::type = 0>
+	constexpr bool operator == (const iptype& left, const base<right_t>& right) noexcept {
+	    return right == left; };
 
-	template <>
-	uint32_t inline base::value<uint32_t>(const uint32_t& ipvalue) {
-	    return ipvalue; };
+	template <class left_t, typename iptype>
+	constexpr bool operator != (const base<left_t>& left, const iptype& right) noexcept {
+	    return !(left == right); };
 
-//	template <>
-//	uint32_t inline base::value<const char *>(const char* const & ipaddr) {
-//	    return esp_ip4addr_aton(ipaddr); };
+	template <typename iptype, class right_t, typename std::enable_if<!is_address<iptype>::value, int>::type = 0>
+	constexpr bool operator != (const iptype& left, const base<right_t>& right) noexcept {
+	    return !(right == left); };
 
-	template <>
-	uint32_t inline base::value<std::string>(const std::string& ipaddr) {
-	    return esp_ip4addr_aton(ipaddr.c_str()); };
 
-	template <>
-	uint32_t inline base::value<esp_ip4_addr>(const esp_ip4_addr& ipaddr) {
-	    return ipaddr.addr; };
+	///@brief Implementation of the C++ wrapper on the esp_ip4_addr_t type, 4 bytes
+	class address: public base<address>
+	{
+	public:
+	    template <class other>
+	    constexpr address(const base<other> &_ip): ip{value(_ip)} {};
+	    constexpr address(const esp_ip4_addr_t &_ip): ip{_ip.addr} {};
 
-	template <>
-	uint32_t inline base::value<base>(const base& ipaddr) {
-	    return ipaddr.instance().addr; };
+	    constexpr explicit address(uint32_t ipval = 0x0): ip{ipval} {};
+	    explicit address(std::string_view ipstr): ip{value(ipstr)} {};
 
+	    /// @brief Set new value of the ip
+	    ///
+	    /// @return
+	    ///  - ESP_OK   - ip address was changed sucefully
+	    ///  - ESP_ERR_NOT_FINISHED - ip adress was not changed by new ip is rq the old ip
+	    ///  - ESP_FAIL - ip address was not changed by the error in the new ip
+	    template <typename iptype>
+	    constexpr esp_err_t set(const iptype& ipaddr) { return base::set(ipaddr); };
 
-	template <typename iptype>
-	inline bool operator == (const base& left, const iptype& right) {
-	    return left.instance().addr == /*address*/base::value(right); };
+	    template <typename iptype>
+	    constexpr const address& operator =(const iptype& ip) noexcept
+				{ set(ip); return *this;};
 
+	    constexpr esp_ip4_addr_t& data() { return ip; };
+	    constexpr const esp_ip4_addr_t& data() const { return ip; };
 
-	/// @brief Set new value of the ip
-	///
-	/// @return
-	///  - ESP_OK   - ip address was changed sucefully
-	///  - ESP_ERR_NOT_FINISHED - ip adress was not changed by new ip is rq the old ip
-	///  - ESP_FAIL - ip address was not changed by the error in the new ip
-	template <typename iptype>
-	esp_err_t inline base::set(const iptype& ipaddr)
-	{
-	    if(instance().addr == value(ipaddr))	///< if new ip is eq the old ip - not any changed
-		return ESP_ERR_NOT_FINISHED;
+	protected:
+	    esp_ip4_addr_t ip;	///< inner ip-addres storage
 
-	    instance().addr = value(ipaddr);
-	    return ESP_OK; /*ESP_FAIL*/
-	}; /* esp::ip4::address::set() */
+	}; /* class esp::ip4::address */
 
 
-	///@brief Implementation of the C++ wrapper on the esp_ip4_addr_t type
-	class address: public base
+	///@brief Reference to the esp_ip4_addr_t, stored outside: interface for manipulating with it
+	class addrref: public base<addrref>
 	{
 	public:
-	    address(const base &_ip): ip{static_cast<const esp_ip4_addr_t&>(_ip)} {};
-	    address(const esp_ip4_addr_t &_ip): ip{_ip.addr} {};
+	    constexpr addrref(esp_ip4_addr_t& ref): ipref(ref) {};
+	    template <class other>
+	    constexpr addrref(esp_ip4_addr_t& ref, const base<other> &_ip): addrref(ref) {ipref.addr = value(_ip);};
+	    constexpr addrref(esp_ip4_addr_t& ref, const esp_ip4_addr_t &_ip): addrref(ref) { ipref.addr = _ip.addr; };
 
-	    explicit address(uint32_t ipval = 0x0): ip{ipval} {};
-	    explicit address(const std::string &ipstr);
-
-	    virtual ~address() {};
+	    constexpr explicit addrref(esp_ip4_addr_t& ref, uint32_t ipval /*= 0x0*/): addrref(ref) { ipref.addr = ipval;};
+	    explicit addrref(esp_ip4_addr_t& ref, std::string_view ipstr): addrref(ref) { ipref.addr = value(ipstr); };
 
 	    /// @brief Set new value of the ip
 	    ///
@@ -170,68 +231,289 @@ namespace esp
 	    ///  - ESP_ERR_NOT_FINISHED - ip adress was not changed by new ip is rq the old ip
 	    ///  - ESP_FAIL - ip address was not changed by the error in the new ip
 	    template <typename iptype>
-	    esp_err_t set(const iptype& ipaddr) { return base::set(ipaddr); };
+	    constexpr esp_err_t set(const iptype& ipaddr) { return base::set(ipaddr); };
 
 	    template <typename iptype>
-	    const address& operator =(const iptype& ip) noexcept
+	    constexpr const addrref& operator =(const iptype& ip) noexcept
 				{ set(ip); return *this;};
 
+	    constexpr esp_ip4_addr_t& data() { return ipref; };
+	    constexpr const esp_ip4_addr_t& data() const { return ipref; };
+
 	protected:
 
-	    esp_ip4_addr_t& instance() override { return ip; };
-	    const esp_ip4_addr_t& instance() const override { return ip; };
+	    esp_ip4_addr_t& ipref;
 
-	    esp_ip4_addr_t ip;	///< inner ip-addres storage
+	}; /* class esp::ip4::adrref */
 
-	}; /* class esp::ip4::address */
+	static_assert(sizeof(address) == sizeof(esp_ip4_addr_t), "esp::ip4::address is not the bare esp_ip4_addr_t");
+
+
+	///@brief byte order of the esp_ip4_addr_t::addr (network order) to the host order & back
+	constexpr uint32_t ntoh(uint32_t val) noexcept {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	    return __builtin_bswap32(val);
+#else
+	    return val;
+#endif
+	}; /* esp::ip4::ntoh() */
+	constexpr uint32_t hton(uint32_t val) noexcept { return ntoh(val); };
+
+
+	///@brief ip4 network (CIDR prefix): the base address & the mask;
+	///	  the addresses are in the network order, as the esp_ip4_addr_t::addr;
+	///	  all the checks are O(1) & usable at the compile time
+	class network
+	{
+	public:
+	    constexpr network(): base(0), bits(0) {};
+	    constexpr network(uint32_t addr, uint32_t mask) noexcept: base(ntoh(addr)), bits(ntoh(mask)) {};
+	    constexpr network(const esp_netif_ip_info_t& inf) noexcept: network(inf.ip.addr, inf.netmask.addr) {};
 
+	    ///@brief the network by the address & the prefix length, "a.b.c.d/len"
+	    static constexpr network prefix(uint32_t addr, unsigned len) noexcept {
+		return network(addr, hton(len? ~0u << (32 - (len > 32? 32: len)): 0)); };
 
-//	/*inline*/ address::address(const base &_ip): ip{_ip.instance().addr} {};
+	    ///@brief check, if the mask (host order) is contiguous, /0../32
+	    static constexpr bool contiguous(uint32_t hostmask) noexcept {
+		return !hostmask || __builtin_popcount(hostmask) + __builtin_ctz(hostmask) == 32; };
 
+	    ///@brief check, if the mask is correct ip4 network mask
+	    constexpr bool valid() const noexcept { return contiguous(bits); };
+	    ///@brief prefix length, the mask is valid
+	    constexpr unsigned length() const noexcept { return __builtin_popcount(bits); };
+
+	    constexpr uint32_t addr() const noexcept { return hton(base); };
+	    constexpr uint32_t mask() const noexcept { return hton(bits); };
+	    constexpr uint32_t net() const noexcept { return hton(base & bits); };
+	    constexpr uint32_t broadcast() const noexcept { return hton(base | ~bits); };
+	    ///@brief the first & the last host address of the network; for /31 & /32 - all the addresses (RFC 3021)
+	    constexpr uint32_t first() const noexcept { return hton((base & bits) + (length() < 31)); };
+	    constexpr uint32_t last() const noexcept { return hton((base | ~bits) - (length() < 31)); };
+	    ///@brief count of the host addresses of the network
+	    constexpr uint32_t hosts() const noexcept { return length() < 31? ~bits - 1: ~bits + 1; };
+
+	    ///@brief the address is in the network
+	    constexpr bool contains(uint32_t ipaddr) const noexcept { return ((ntoh(ipaddr) ^ base) & bits) == 0; };
+	    ///@brief the other network is the subnet of the network
+	    constexpr bool contains(const network& other) const noexcept {
+		return (other.bits & bits) == bits && contains(other.addr()); };
+	    ///@brief the networks have the common addresses
+	    constexpr bool overlaps(const network& other) const noexcept {
+		return ((base ^ other.base) & bits & other.bits) == 0; };
+
+	    constexpr bool operator ==(const network& other) const noexcept {
+		return bits == other.bits && ((base ^ other.base) & bits) == 0; };
+	    constexpr bool operator !=(const network& other) const noexcept { return !(*this == other); };
+
+	private:
+	    uint32_t base;	///< address, host order
+	    uint32_t bits;	///< mask, host order
+
+	}; /* class esp::ip4::network */
 
-	inline address::address(const std::string& ipstr) {
-	    ip.addr = base::value(ipstr); };
 
+	///@brief check, if the mask is correct ip4 network mask of the interface, /1../31
+	constexpr bool chkmask(uint32_t mask) noexcept {
+	    return network::contiguous(ntoh(mask)) && ntoh(mask) != 0 && ~ntoh(mask) != 0; };
 
 
-	///@brief Base of ip address class: interface for manipulating with esp_ip4_addr_t
-	class addrref: public base
+	///@brief longest-prefix-match table of the ip4 networks: multibit trie, 4 bits per level,
+	///	  the prefixes are expanded to the level boundary; 64 bytes per node (one cache line),
+	///	  at most 8 nodes per lookup. The storage is provided by the derived class (lpm_table<>),
+	///	  no heap. Lookups are read-only & may run concurrently; the changes are serialized by the caller.
+	class lpm_t
 	{
 	public:
-	    addrref(esp_ip4_addr_t& ref): ipref(ref) {};
-	    addrref(esp_ip4_addr_t& ref, const base &_ip): addrref(ref) {ipref.addr = static_cast<const esp_ip4_addr_t&>(_ip).addr;};
-	    addrref(esp_ip4_addr_t& ref, const esp_ip4_addr_t &_ip): addrref(ref) { ipref.addr = _ip.addr; };
+	    typedef uint8_t value_t;			///< the value of the network: route/rule number etc.
+	    static constexpr value_t none = 0xff;	///< lookup result: the address is not in any network
 
-	    explicit addrref(esp_ip4_addr_t& ref, uint32_t ipval /*= 0x0*/): addrref(ref) { ipref.addr = ipval;};
-	    explicit addrref(esp_ip4_addr_t& ref, const std::string &ipstr);
+	    /// @brief add the network or change the value of the network already present
+	    /// @return
+	    ///  - ESP_OK
+	    ///  - ESP_ERR_INVALID_ARG - the network mask is not contiguous or the value is 'none'
+	    ///  - ESP_ERR_NO_MEM	  - the routes or the nodes storage is exhausted, the table is not changed
+	    esp_err_t add(const network& net, value_t value);
+
+	    /// @brief remove the network
+	    /// @return ESP_OK or ESP_ERR_NOT_FOUND
+	    esp_err_t remove(const network& net);
+
+	    void clear();
+
+	    size_t size() const { return count; };
+	    size_t nodes() const { return used; };
+
+	    /// @brief value of the most specific network of the address (network order), or 'none'
+	    value_t lookup(uint32_t ipaddr) const noexcept
+	    {
+		    uint32_t addr = ntoh(ipaddr);
+		    value_t best = none;
+		    uint16_t node = 0;
+
+		for (int shift = 28; shift >= 0; shift -= 4)
+		{
+			const slot_t& slot = trie[node][(addr >> shift) & 0xf];
+
+		    if (slot.len)
+			best = slot.value;
+		    if (!(node = slot.child))
+			break;
+		}; /* for shift */
+		return best;
+	    }; /* lookup() */
+
+	    /// @brief lookup of the each address of the array
+	    void lookup(const uint32_t ipaddrs[], value_t values[], size_t n) const noexcept;
 
-	    virtual ~addrref() {};
+	protected:
 
-	    /// @brief Set new value of the ip
-	    ///
+	    /// the slot of the trie node: the expanded prefix & the next level node
+	    struct slot_t
+	    {
+		uint16_t child;	///< index of the next level node, 0 - none (root is never the child)
+		uint8_t	 len;	///< length of the prefix, stored in the slot, + 1; 0 - empty
+		value_t	 value;
+	    }; /* struct slot_t */
+
+	    typedef slot_t node_t[16];
+	    static_assert(sizeof(node_t) == 64, "esp::ip4::lpm_t trie node is not the cache line");
+
+	    /// the network of the table
+	    struct route_t
+	    {
+		network net;
+		value_t value;
+	    }; /* struct route_t */
+
+	    lpm_t(route_t routes[], size_t maxroutes, node_t trienodes[], size_t maxnodes) noexcept;
+
+	private:
+
+	    esp_err_t insert(const route_t& route);
+	    void rebuild();
+
+	    route_t* const routes;
+	    node_t* const  trie;
+	    const size_t   maxroutes;
+	    const size_t   maxnodes;
+	    size_t	   count = 0;
+	    size_t	   used = 1;
+
+	}; /* class esp::ip4::lpm_t */
+
+
+	///@brief longest-prefix-match table with the inline storage: up to 'nroutes' networks & 'nnodes' trie nodes
+	template <size_t nroutes, size_t nnodes = 64>
+	class lpm_table: public lpm_t
+	{
+	public:
+	    lpm_table() noexcept: lpm_t(routebuf, nroutes, nodebuf, nnodes) {};
+	    lpm_table(const lpm_table&) = delete;
+
+	private:
+	    route_t routebuf[nroutes];
+	    node_t  nodebuf[nnodes];
+
+	}; /* class esp::ip4::lpm_table */
+
+
+	///@brief access list: allow/deny of the address by the most specific network, 'allowed' - the policy for the rest addresses
+	template <size_t nrules, size_t nnodes = 64>
+	class acl_table
+	{
+	public:
+	    acl_table(bool allowed = false) noexcept: policy(allowed) {};
+
+	    esp_err_t allow(const network& net) { return table.add(net, 1); };
+	    esp_err_t deny(const network& net) { return table.add(net, 0); };
+	    esp_err_t remove(const network& net) { return table.remove(net); };
+
+	    /// @brief the address (network order) is allowed
+	    bool permits(uint32_t ipaddr) const noexcept {
+		    lpm_t::value_t rule = table.lookup(ipaddr);
+		return rule == lpm_t::none? policy: rule; };
+
+	    /// @brief check of the each address of the array
+	    void permits(const uint32_t ipaddrs[], bool res[], size_t n) const noexcept {
+		for (size_t i = 0; i < n; i++)
+		    res[i] = permits(ipaddrs[i]); };
+
+	    const lpm_t& rules_table() const { return table; };
+
+	private:
+	    lpm_table<nrules, nnodes> table;
+	    bool policy;
+
+	}; /* class esp::ip4::acl_table */
+
+
+	///@brief allocator of the addresses of the range, the bitmap: a bit per address, set - the address is used.
+	///	  The search continues from the word of the last allocation (next fit): O(1) amortized,
+	///	  the full words are skipped by 32 addresses. The storage is provided by the derived class (pool_table<>),
+	///	  no heap. The changes are serialized by the caller.
+	class pool_t
+	{
+	public:
+	    /// @brief set the range of the addresses (network order), the all are free
 	    /// @return
-	    ///  - ESP_OK   - ip address was changed sucefully
-	    ///  - ESP_ERR_NOT_FINISHED - ip adress was not changed by new ip is rq the old ip
-	    ///  - ESP_FAIL - ip address was not changed by the error in the new ip
-	    template <typename iptype>
-	    esp_err_t set(const iptype& ipaddr) { return base::set(ipaddr); };
+	    ///  - ESP_OK
+	    ///  - ESP_ERR_INVALID_ARG - the first address is above the last one
+	    ///  - ESP_ERR_NO_MEM	  - the range exceeds the storage, the pool is not changed
+	    esp_err_t range(uint32_t first, uint32_t last);
 
-	    template <typename iptype>
-	    const addrref& operator =(const iptype& ip) noexcept
-				{ set(ip); return *this;};
+	    /// @brief the free address (network order) is taken; 0 - the pool is exhausted
+	    uint32_t alloc();
+
+	    /// @brief the address (network order) is taken: reserved or assigned by the other
+	    /// @return ESP_OK, ESP_ERR_NOT_FOUND - out of the range, ESP_ERR_INVALID_STATE - used already
+	    esp_err_t take(uint32_t ipaddr);
 
+	    /// @brief the address (network order) is free
+	    /// @return ESP_OK, ESP_ERR_NOT_FOUND - out of the range, ESP_ERR_INVALID_STATE - free already
+	    esp_err_t release(uint32_t ipaddr);
+
+	    /// @brief the all addresses are free
+	    void clear();
+
+	    bool contains(uint32_t ipaddr) const noexcept {
+		return count && ntoh(ipaddr) - base < count; };
+	    bool used(uint32_t ipaddr) const noexcept {
+		    uint32_t index = ntoh(ipaddr) - base;
+		return index < count && words[index / 32] >> (index % 32) & 1; };
+
+	    uint32_t first() const { return count? hton(base): 0; };		///< network order, 0 - no range
+	    uint32_t last() const { return count? hton(base + count - 1): 0; };	///< network order, 0 - no range
+	    size_t size() const { return count; };	///< the addresses of the range
+	    size_t available() const { return nfree; };	///< the free addresses
+	    size_t capacity() const { return maxwords * 32; };
 
 	protected:
+	    pool_t(uint32_t* storage, size_t nwords) noexcept: words(storage), maxwords(nwords) {};
+	    pool_t(const pool_t&) = delete;
 
-	    esp_ip4_addr_t& ipref;
+	    uint32_t* const words;
+	    const size_t    maxwords;
+	    uint32_t	    base = 0;	///< the first address, host order
+	    size_t	    count = 0;
+	    size_t	    nfree = 0;
+	    size_t	    cursor = 0;	///< the word of the last allocation
 
-	    virtual esp_ip4_addr_t& instance() override { return ipref; };
-	    virtual const esp_ip4_addr_t& instance() const override {  return ipref;  };
+	}; /* class esp::ip4::pool_t */
 
-	}; /* class esp::ip4::adrref */
 
-	inline addrref::addrref(esp_ip4_addr_t& ref, const std::string& ipstr): addrref(ref) {
-	    ipref.addr = base::value(ipstr); };
+	///@brief allocator of the addresses with the inline storage: up to 'naddrs' addresses
+	template <size_t naddrs>
+	class pool_table: public pool_t
+	{
+	public:
+	    pool_table() noexcept: pool_t(wordbuf, (naddrs + 31) / 32) {};
+	    pool_table(const pool_table&) = delete;
+
+	private:
+	    uint32_t wordbuf[(naddrs + 31) / 32] = {};
+
+	}; /* class esp::ip4::pool_table */
 
 
 
@@ -242,11 +524,11 @@ namespace esp
 	class info: public esp_netif_ip_info_t
 	{
 	public:
-	    info(): info(0x0,0x0,0x0) {};
-	    info(uint32_t ip, uint32_t gate = 0xc0a80001, uint32_t mask = 0xffffff00 /*255.255.255.0*/):
-		esp_netif_ip_info_t{ip,mask,gate} {};
-	    info(const esp_netif_ip_info_t& src): esp_netif_ip_info_t(src) {};
-	    info(const info& src): esp_netif_ip_info_t(src) {};
+	    constexpr info(): info(0x0,0x0,0x0) {};
+	    constexpr info(uint32_t ip, uint32_t gate = 0xc0a80001, uint32_t mask = 0xffffff00 /*255.255.255.0*/):
+		esp_netif_ip_info_t{{ip},{mask},{gate}} {};
+	    constexpr info(const esp_netif_ip_info_t& src): esp_netif_ip_info_t(src) {};
+	    constexpr info(const info& src): esp_netif_ip_info_t(src) {};
 	    info(const net::configuration_t& src);
 
 	    const info& operator =(const info& src) {
@@ -268,11 +550,14 @@ namespace esp
 	    operator const esp_netif_ip_info_t*() const { return this;  };
 	    operator	  esp_netif_ip_info_t*()	{ return this;  };
 
+	    ///@brief the network of the interface
+	    constexpr network subnet() const { return network(*this); };
+
 	    ///@brief check, if the mask is correct ip4 network mask
-	    bool chkmask();
+	    constexpr bool chkmask() const { return ip4::chkmask(netmask.addr); };
 
 	    ///@brief check, if the address set is internally consistent
-	    bool consistent() { return (ip.addr & netmask.addr) == (gw.addr & netmask.addr);};
+	    constexpr bool consistent() const { return subnet().contains(gw.addr); };
 
 	}; /* class esp::ip4::info */
 
@@ -285,6 +570,10 @@ namespace esp
     class netif_t;
 
     ///@brief DHCP client control class
+    ///@detail The state of the client is mirrored: the status & the enable flag are read from the netif
+    ///	    once by the sync(), then followed by the results of the start()/stop() & by the events of the netif,
+    ///	    reported by the owner of the netif to the link(), bound() & lost(); the state queries
+    ///	    are the plain loads, the esp_netif API is called only for the change of the state.
     class dhcp_client_t
     {
     public:
@@ -293,11 +582,11 @@ namespace esp
 	/// Get/set DHCP option of the DHCP client
 	esp_err_t option(esp_netif_dhcp_option_mode_t opt_op, esp_netif_dhcp_option_id_t opt_id, void *opt_val, uint32_t opt_len);
 
-	///@brief DHCP client is enabled (directly by the netif flags)
-	bool enabled();
+	///@brief DHCP client is enabled (by the netif flags, mirrored)
+	bool enabled() const { return enable.load(std::memory_order_relaxed); };
 
 	///@brief DHCP client is initialized
-	bool initialized() { return (status() == ESP_NETIF_DHCP_INIT); };
+	bool initialized() const { return (status() == ESP_NETIF_DHCP_INIT); };
 	///@brief DHCP client is started
 	bool started() const { return (status() == ESP_NETIF_DHCP_STARTED); };
 	///@brief DHCP client is stoped
@@ -306,27 +595,131 @@ namespace esp
 	bool ackuired() const {return ack;};	///<@brief get the 'ack' value (deferred request to start DHCP client)
 	esp_err_t start();	///< start DHCP client
 	esp_err_t stop(); 	///< stop DHCP client
+	/// @brief the address, requested by the INIT-REBOOT on the next start of the client: written to the entry
+	///	   of the netif, that the lwIP restores at the start (CONFIG_LWIP_DHCP_RESTORE_LAST_IP), network order;
+	///	   0 - the DISCOVER, no address is requested
+	esp_err_t restore(uint32_t ip);
 	esp_netif_dhcp_status_t
-		 status() const;///< status of the DHCP client
+		 status() const;///< status of the DHCP client, mirrored
 	esp_err_t error() const;///< error status of the DHCP client
 	bool ack = true;	///< flag, that indicied deferred request to start DHCP-client
 
+	/// @brief the lease of the client; the each value is consistent alone, the times are ms since the boot
+	bool	 leased() const { return lease_addr.load(std::memory_order_acquire) != 0; };	///< the address is obtained
+	uint32_t address() const { return lease_addr.load(std::memory_order_acquire); };	///< the leased address, 0 - none
+	uint32_t lease_time() const { return lease_s.load(std::memory_order_relaxed); };	///< s, 0 - unknown
+	uint32_t obtained() const { return since.load(std::memory_order_relaxed); };	///< time of the lease obtained
+	uint32_t renew() const { return deadline(1, 2); };	///< T1, the renewing deadline, 0 - unknown
+	uint32_t rebind() const { return deadline(7, 8); };	///< T2, the rebinding deadline, 0 - unknown
+	uint32_t expire() const { return deadline(1, 1); };	///< end of the lease, 0 - unknown
+
+	/// @brief read the status & the flags from the netif to the mirror: at the creation of the netif
+	esp_err_t sync();
+	/// @brief the link of the netif is up/down: the netif starts the initialized client itself
+	///	   on the link up & returns the started one to the init state on the link down
+	void link(bool up);
+	/// @brief the address is obtained (IP_EVENT_xxx_GOT_IP of the netif): the lease time is read once
+	void bound(const esp_netif_ip_info_t& info);
+	/// @brief the address is lost (IP_EVENT_xxx_LOST_IP of the netif)
+	void lost();
+
     private:
+	uint32_t deadline(uint32_t num, uint32_t den) const;
+
 	netif_t *netif;
 	mutable esp_err_t err;
+	std::atomic<uint8_t>	stat{ESP_NETIF_DHCP_INIT};	///< esp_netif_dhcp_status_t of the client
+	std::atomic<bool>	enable{false};
+	std::atomic<uint32_t>	lease_addr{0};
+	std::atomic<uint32_t>	lease_s{0};
+	std::atomic<uint32_t>	since{0};
     }; /* class esp::dhcp_client_t */
 
-    /// DHCP server control class
+    ///@brief DHCP server control class
+    ///@detail The status is mirrored as by the client: read by the sync(), followed by the start()/stop().
+    ///	    The pool range & the lease time are set to the esp_netif server, the started server is restarted for it.
+    ///	    The address book of the component: the static MAC -> IP reservations are the flat table, sorted
+    ///	    by the MAC (binary search); the addresses of the pool are allocated by the bitmap allocator,
+    ///	    the reserved ones are taken from it. The esp_netif server gets the range & the lease time only:
+    ///	    it never sees the table & hands out the addresses itself - the reserve() warns of it.
+    ///	    The server of the soft-AP netif mirrors the real leases: the esp::net::wifi::stations bind()
+    ///	    the assigned address of the station & release() it on the disconnection, the address
+    ///	    of the reservation, handed out to the other station, is warned. The changes are serialized by the caller.
     class dhcp_server_t
     {
     public:
+	static constexpr size_t reservations = CONFIG_NET_DHCPS_RESERVATIONS;
+
+	/// @brief the static reservation of the address book: the assign() of the MAC gives the address (network order);
+	///	   the esp_netif server is not aware of it
+	struct reservation_t
+	{
+	    uint8_t  mac[6];
+	    uint32_t ip;
+	}; /* struct reservation_t */
+
 	dhcp_server_t(netif_t* net_if): netif(net_if), err(ESP_OK) {};
 
-	///@brief DHCP server is enabled (directly by the netif flags)
-	bool enabled();
+	/// Get/set DHCP option of the DHCP server
+	esp_err_t option(esp_netif_dhcp_option_mode_t opt_op, esp_netif_dhcp_option_id_t opt_id, void *opt_val, uint32_t opt_len);
+
+	///@brief DHCP server is enabled (by the netif flags, mirrored)
+	bool enabled() const { return enable; };
+	bool started() const { return (status() == ESP_NETIF_DHCP_STARTED); };
+	bool stopped() const { return (status() == ESP_NETIF_DHCP_STOPPED); };
+	esp_netif_dhcp_status_t status() const { return stat; };	///< status of the DHCP server, mirrored
+	esp_err_t error() const { return err; };
+
+	esp_err_t start();	///< start DHCP server
+	esp_err_t stop();	///< stop DHCP server
+	/// @brief read the status & the flags from the netif to the mirror: at the creation of the netif
+	esp_err_t sync();
+
+	/** @brief set the pool of the server: the all addresses of the pool are free, except the reserved ones
+	 *  @param[in] first, last - the range of the pool, network order
+	 *  @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_NO_MEM - the range exceeds CONFIG_NET_DHCPS_POOL_MAX,
+	 *	    or error of the esp_netif */
+	esp_err_t pool(uint32_t first, uint32_t last);
+	const ip4::pool_t& pool() const { return addrs; };
+
+	/** @brief set the lease time of the server; the esp_netif server counts it in the minutes, it's rounded up
+	 *  @param[in] seconds - the lease time, s */
+	esp_err_t lease_time(uint32_t seconds);
+	uint32_t lease_time() const { return lease_s; };	///< s, 0 - the default of the server
+
+	/** @brief reserve the address for the MAC in the address book; the reservation of the MAC is replaced.
+	 *	    It is not passed to the esp_netif server: the client gets it by the caller of the assign() only,
+	 *	    the reservation of the enabled server is warned
+	 *  @return ESP_OK, ESP_ERR_NO_MEM - the table is full, ESP_ERR_INVALID_STATE - the address of the pool
+	 *	    is used by the other client or the other reservation */
+	esp_err_t reserve(const uint8_t mac[6], uint32_t ip);
+	/// @brief drop the reservation of the MAC, it's address of the pool is free
+	esp_err_t unreserve(const uint8_t mac[6]);
+	/// @brief the reserved address of the MAC, 0 - none
+	uint32_t reserved(const uint8_t mac[6]) const;
+	size_t reserved() const { return nreserved; };	///< count of the reservations
+
+	/// @brief the address for the client: the reserved one, else the free address of the pool; 0 - exhausted
+	uint32_t assign(const uint8_t mac[6]);
+	/// @brief the address of the client is free; the reserved address is kept for it's MAC
+	esp_err_t release(const uint8_t mac[6], uint32_t ip);
+	/// @brief the address, assigned by the esp_netif server itself (IP_EVENT_AP_STAIPASSIGNED), is used
+	esp_err_t bind(const uint8_t mac[6], uint32_t ip);
+
     private:
+	/// the first reservation with the MAC not less, than the 'mac'
+	size_t lower(const uint8_t mac[6]) const;
+	/// the address is reserved by any MAC
+	bool reserved_ip(uint32_t ip) const;
+
 	netif_t* netif;
 	esp_err_t err;
+	esp_netif_dhcp_status_t stat = ESP_NETIF_DHCP_INIT;
+	bool enable = false;
+	uint32_t lease_s = 0;
+	ip4::pool_table<CONFIG_NET_DHCPS_POOL_MAX> addrs;
+	reservation_t table[reservations];
+	size_t nreserved = 0;
     }; /* class esp::dhcp_server_t */
 
     /// DHCP client/server control class
@@ -427,26 +820,33 @@ namespace esp
 
 
 
-///@brief DHCP client is enabled (directly by the netif flags)
-inline bool esp::dhcp_client_t::enabled() {
-    return netif->flags() & ESP_NETIF_DHCP_CLIENT; };
 
-///@brief DHCP server is enabled (directly by the netif flags)
-inline bool esp::dhcp_server_t::enabled() {
-    return netif->flags() & ESP_NETIF_DHCP_SERVER; };
+namespace net
+{
+    namespace cfg
+    {
+	struct fields_t;
+    }; /* namespace net::cfg */
+}; /* namespace net */
 
 
-// @brief class for managing the changing state
+// @brief class for managing the changing state w/o any state in the field: the setter of the field
+//	  sets it's compile-time 'bit' in the dirty mask of the owner (net::cfg::fields_t of the configuration),
+//	  found by the offset of the field in the owner. The field exists as the member of the owner only.
+template <class field, uint32_t bit>
 class chg_mgr
 {
 public:
-    chg_mgr(bool st = false): chgst(st) {};
-    bool changed() {return chgst;};
-    bool is_changed() {return changed();};
-    void clr_chgstat() {chgst = false;};
+    bool changed() const noexcept;
+    bool is_changed() const noexcept {return changed();};
+    void clr_chgstat() noexcept;
+
 protected:
-    void set_chgstat() {chgst = true;};
-    bool chgst = false;	///< field is changed?
+    void set_chgstat() noexcept;
+
+private:
+    net::cfg::fields_t& owner() noexcept;
+    const net::cfg::fields_t& owner() const noexcept;
 }; /* class chg_mgr */
 
 
@@ -457,54 +857,50 @@ namespace net
     namespace cfg
     {
 
-	class ip4_addr_field: public esp::ip4::address, public chg_mgr
+	template <uint32_t bit>
+	class ip4_addr_field: public esp::ip4::address, public chg_mgr<ip4_addr_field<bit>, bit>
 	{
 	public:
-	    ip4_addr_field(uint32_t ipval = 0x0): address(ipval) {};
-
-	    template <typename iptype>
-	    ip4_addr_field(const iptype& ipaddr): address(ipaddr) {};
-
 	    template <typename iptype>
 	    const ip4_addr_field& operator =(const iptype& ip) noexcept
 					{set(ip); return *this;};
+	    const ip4_addr_field& operator =(const ip4_addr_field& ip) noexcept
+					{set(ip); return *this;};
 	    template <typename iptype>
 	    esp_err_t set(const iptype& ipaddr) noexcept;
 
-	    template <typename iptype>
-	    friend bool operator == (const ip4_addr_field& left, const iptype& right) {
-		return operator == (static_cast<const esp::ip4::base&>(left), right); };
-
-	    template <typename iptype>
-	    friend bool operator == (const iptype& left, const ip4_addr_field& right) {
-		return operator ==(right, left); }
+	protected:
+	    friend struct fields_t;
 
-	    template <typename iptype>
-	    friend bool operator != (const ip4_addr_field& left, const iptype& right) {
-		return !(operator==(left, right)); };
+	    ip4_addr_field(uint32_t ipval = 0x0): address(ipval) {};
+	    ip4_addr_field(const ip4_addr_field&) = default;
 
 	    template <typename iptype>
-	    friend bool operator != (const iptype& left, const ip4_addr_field& right) {
-		return !(operator ==(left, right)); }
-
+	    ip4_addr_field(const iptype& ipaddr): address(ipaddr) {};
 	}; /* class net::cfg::ip4_addr_field */
 
+	template <uint32_t bit>
 	template <typename iptype>
-	esp_err_t inline ip4_addr_field::set(const iptype& ipaddr) noexcept {
-	    if (instance().addr != esp::ip4::/*address*/base::value(ipaddr))
-		set_chgstat();
-	    return esp::ip4::base::set(ipaddr);
+	esp_err_t inline ip4_addr_field<bit>::set(const iptype& ipaddr) noexcept {
+	    if (instance().addr != esp::ip4::value(ipaddr))
+		this->set_chgstat();
+	    return address::set(ipaddr);
 	}; /* net::cfg::ip4_addr_field::set() */
 
 
+	/// @brief the flag of the string: 1 - confirmed, 0 - declined, -1 - neither
+	int flag_value(const std::string& str);
+
 	/// @brief class for boolean flag fields
-	class flag_field: public chg_mgr
+	template <uint32_t bit>
+	class flag_field: public chg_mgr<flag_field<bit>, bit>
 	{
 	public:
-	    flag_field(bool st): state(st) {};
-
-	    const flag_field& operator =(const bool st) { if (st != state) { set_chgstat(); state = st;}; return *this; };
-	    const flag_field& operator =(const std::string& str);
+	    const flag_field& operator =(const bool st) { if (st != state) { this->set_chgstat(); state = st;}; return *this; };
+	    const flag_field& operator =(const flag_field& fld) { return operator =(fld.state); };
+	    const flag_field& operator =(const std::string& str) {
+		int st = flag_value(str);
+		if (st >= 0) { this->set_chgstat(); state = st; }; return *this; };
 
 	    operator bool() const { return state; };
 	    operator bool&() { return state; };	///< acess to inner data value, may be modified through lvalue
@@ -512,26 +908,30 @@ namespace net
 	    operator const std::string () const { return  state? "1": "0"; };
 
 	protected:
+	    friend struct fields_t;
+
+	    flag_field(bool st): state(st) {};
+	    flag_field(const flag_field&) = default;
+
 	    bool state;	// Status of the boolean field
 	}; /* class net::cfg::info::flag_field */
 
-	class string_field: public chg_mgr
-	{
-	public:
 
-	    string_field(): val("") {};
-	    template <typename strt>
-	    string_field(strt&& str = ""): val(std::forward<strt>(str)) {};
-	    string_field(const string_field& stf): chg_mgr(false), val(stf.val) {};
+	/// @brief the copy of the string in the static buffer, valid up to the next call
+	const char* string_buffer(const std::string& str);
 
-	    const string_field& operator =(const string_field& strf) { if (strf.val != val) { set_chgstat(); val = strf.val;}; return *this; };
+	template <uint32_t bit>
+	class string_field: public chg_mgr<string_field<bit>, bit>
+	{
+	public:
+	    const string_field& operator =(const string_field& strf) { if (strf.val != val) { this->set_chgstat(); val = strf.val;}; return *this; };
 	    operator std::string&() { return val; };
 	    operator const std::string&() const { return val; };
 	    std::string& str() { return val; };
 	    const std::string& str() const { return val; };
 	    const std::string& conststr() const { return val; };
-	    const char* c_str() { return val.c_str(); };
-	    operator const char*();
+	    const char* c_str() const { return val.c_str(); };
+	    operator const char*() { return string_buffer(val); };
 
 	    bool operator ==(const std::string& str) const {return val == str;};
 	    bool operator ==(const char str[]) const {return val == str;};
@@ -539,50 +939,185 @@ namespace net
 	    bool operator !=(const char str[]) const {return !(operator ==(str));};
 
 	protected:
+	    friend struct fields_t;
+
+	    string_field(): val("") {};
+	    template <typename strt>
+	    string_field(strt&& str = ""): val(std::forward<strt>(str)) {};
+	    string_field(const string_field&) = default;
+
 	    std::string val;
 	}; /* class net::cfg::string_field */
 
+
+	/// @brief string field with the inline storage of the fixed capacity (including the terminating zero);
+	///	   the longer value is truncated. Copy & move are noexcept & never allocate.
+	template <size_t capacity, uint32_t bit>
+	class inline_string_field: public chg_mgr<inline_string_field<capacity, bit>, bit>
+	{
+	public:
+	    const inline_string_field& operator =(const inline_string_field& strf) noexcept { return operator =(strf.val); };
+	    const inline_string_field& operator =(const char str[]) noexcept {
+		if (strncmp(val, str, capacity - 1) != 0) { this->set_chgstat(); assign(str); }; return *this; };
+	    const inline_string_field& operator =(const std::string& str) noexcept { return operator =(str.c_str()); };
+
+	    const char* c_str() const noexcept { return val; };
+	    operator const char*() const noexcept { return val; };
+	    std::string str() const { return val; };
+	    size_t length() const noexcept { return strlen(val); };
+	    bool empty() const noexcept { return !*val; };
+
+	    bool operator ==(const char str[]) const noexcept { return strncmp(val, str, capacity) == 0; };
+	    bool operator ==(const std::string& str) const noexcept { return operator ==(str.c_str()); };
+	    bool operator !=(const char str[]) const noexcept { return !(operator ==(str)); };
+	    bool operator !=(const std::string& str) const noexcept { return !(operator ==(str)); };
+
+	protected:
+	    friend struct fields_t;
+
+	    inline_string_field() noexcept { val[0] = '\0'; };
+	    inline_string_field(const char str[]) noexcept { assign(str); };
+	    inline_string_field(const std::string& str) noexcept { assign(str.c_str()); };
+	    inline_string_field(const inline_string_field& stf) noexcept { memcpy(val, stf.val, capacity); };
+
+	    void assign(const char str[]) noexcept {
+		size_t len = strnlen(str, capacity - 1);
+		memcpy(val, str, len);
+		val[len] = '\0'; };
+
+	    char val[capacity];
+	}; /* class net::cfg::inline_string_field */
+
+#if CONFIG_NET_CFG_INLINE_STRINGS
+	template <uint32_t bit>
+	using login_field = inline_string_field<33, bit>;	///< SSID, as the wifi_sta_config_t::ssid & the terminating zero
+	template <uint32_t bit>
+	using passwd_field = inline_string_field<65, bit>;	///< passphrase or PSK, as the wifi_sta_config_t::password & the terminating zero
+#else
+	template <uint32_t bit>
+	using login_field = string_field<bit>;
+	template <uint32_t bit>
+	using passwd_field = string_field<bit>;
+#endif
+
+
+	/// @brief the fields of the configuration & the one dirty mask of their changes:
+	///	   the standard layout - the field finds the mask by it's offset in the fields_t
+	struct fields_t
+	{
+	    /// @brief change bits of the fields in the dirty mask
+	    enum chgbit_t: uint32_t
+	    {
+		CHG_IP		= 1 << 0,
+		CHG_MASK	= 1 << 1,
+		CHG_GATE	= 1 << 2,
+		CHG_DHCP	= 1 << 3,
+		CHG_USE_PWD	= 1 << 4,
+		CHG_LOGIN	= 1 << 5,
+		CHG_PASSWD	= 1 << 6,
+
+		CHG_LOGIN_MASK = CHG_LOGIN | CHG_PASSWD | CHG_USE_PWD,	///< wifi station cfg
+		CHG_IP_MASK	   = CHG_DHCP | CHG_IP | CHG_MASK | CHG_GATE,	///< netif ip cfg
+	    }; /* enum net::cfg::fields_t::chgbit_t */
+
+	    fields_t() {};
+	    fields_t(const fields_t&) = default;	///< the change state is copied with the values
+	    fields_t& operator =(const fields_t&) = delete;	///< see the configuration_t::operator =()
+	    template <class iptype, class masktype, class gatetype, class logintype, class passwdtype>
+	    fields_t(bool dhcp_req, iptype&& ipin, masktype&& maskin, gatetype&& gatin, bool usepwd_in,
+		    logintype&& loginin, passwdtype&& passwdin):
+			ip(std::forward<iptype>(ipin)), mask(std::forward<masktype>(maskin)), gate(std::forward<gatetype>(gatin)),
+			dhcp(dhcp_req), use_pwd(usepwd_in),
+			login(std::forward<logintype>(loginin)), passwd(std::forward<passwdtype>(passwdin)) {};
+
+	    uint32_t dirty = 0;	///< dirty mask of the changed fields, chgbit_t; the first - the fields are not at 0
+
+	    ip4_addr_field<CHG_IP> ip;	///< ip address storage
+	    ip4_addr_field<CHG_MASK> mask;	///< mask storage
+	    ip4_addr_field<CHG_GATE> gate;	///< gateway ip storage
+	    flag_field<CHG_DHCP> dhcp    = true;	///< dhcp enabled?
+
+	    flag_field<CHG_USE_PWD> use_pwd = false;	///< used/desired login/password for the connection
+	    login_field<CHG_LOGIN> login;		///< login string field
+	    passwd_field<CHG_PASSWD> passwd;	///< password string field
+
+	    /// @brief offset of the field of the change bit
+	    static constexpr size_t offset(uint32_t bit) {
+		return bit == CHG_IP? offsetof(fields_t, ip): bit == CHG_MASK? offsetof(fields_t, mask):
+			bit == CHG_GATE? offsetof(fields_t, gate): bit == CHG_DHCP? offsetof(fields_t, dhcp):
+			bit == CHG_USE_PWD? offsetof(fields_t, use_pwd): bit == CHG_LOGIN? offsetof(fields_t, login):
+			offsetof(fields_t, passwd); };
+	}; /* struct net::cfg::fields_t */
+
     }; /* namespace net::cfg */
+}; /* namespace net */
+
+
+template <class field, uint32_t bit>
+inline net::cfg::fields_t& chg_mgr<field, bit>::owner() noexcept {
+    static_assert(std::is_standard_layout<net::cfg::fields_t>::value, "the field doesn't find the dirty mask of the owner");
+    return *reinterpret_cast<net::cfg::fields_t*>(reinterpret_cast<char*>(static_cast<field*>(this))
+	    - net::cfg::fields_t::offset(bit)); };
+
+template <class field, uint32_t bit>
+inline const net::cfg::fields_t& chg_mgr<field, bit>::owner() const noexcept {
+    return const_cast<chg_mgr*>(this)->owner(); };
+
+template <class field, uint32_t bit>
+inline bool chg_mgr<field, bit>::changed() const noexcept { return owner().dirty & bit; };
 
+template <class field, uint32_t bit>
+inline void chg_mgr<field, bit>::clr_chgstat() noexcept { owner().dirty &= ~bit; };
 
+template <class field, uint32_t bit>
+inline void chg_mgr<field, bit>::set_chgstat() noexcept { owner().dirty |= bit; };
+
+
+
+namespace net
+{
     /**
      * @brief information block of the specified network configuration -
      *  ethernet, wifi ap, wifi sta
      */
-    class configuration_t
+    class configuration_t: public cfg::fields_t
     {
     public:
 	configuration_t();
-	configuration_t(const configuration_t&);
+	configuration_t(const configuration_t&) noexcept;	///< the change state is copied with the values
 	configuration_t(bool dhcp_req, const esp::ip4::info& ipinfo,
 		const std::string& login = "", const std::string& passwd = "");
+	configuration_t(bool dhcp_req, const esp::ip4::info& ipinfo, const char login[], const char passwd[]);
 	template <class iptype, class masktype, class gatetype, class logintype, class passwdtype>
 	configuration_t(bool dhcp_req, iptype&& ip, masktype&& mask, gatetype&& gate, bool use_pwd,
 		logintype&& login, passwdtype&& passwd);
 	virtual ~configuration_t();	///< stub for virtual destructor
+	/// assignment: the fields with the different values are marked as changed, the other change marks are kept
+	configuration_t& operator =(const configuration_t&) noexcept;
 	virtual esp_err_t factory_reload();	///< @brief stub for reset/restore factory default configuration
 	const esp_netif_ip_info_t *ipdata() const;
 	operator esp::ip4::info ()const { return esp::ip4::info(ip, mask, gate); };
 
-	cfg::ip4_addr_field ip;	///< ip address storage
-	cfg::ip4_addr_field mask;	///< mask storage
-	cfg::ip4_addr_field gate;	///< gateway ip storage
-	cfg::flag_field dhcp    = true;	///< dhcp enabled?
-
-	cfg::flag_field use_pwd = false;	///< used/desired login/password for the connection
-	cfg::string_field login;	///< login string field
-	cfg::string_field passwd;	///< password string field
-
 	/// @brief requested wifi station cfg (SSID or password) is changed
 //	bool wifi_changed();
-	bool login_changed();
+	bool login_changed() const;
 
 	/// @brief requested wifi station netif ip cfg (ip, mask and gate) is changed
 //	bool netif_changed();
-	bool ip_changed();
+	bool ip_changed() const;
+
+	/// @brief dirty mask of the changed fields, chgbit_t
+	uint32_t changes() const { return dirty; };
 
 	/// Clear status of the changing the all data fields: ip4 adr/mask/gate & login/pwd
-	void clr_chgst();
+	void clr_chgst() { dirty = 0; };
+
+	/// @brief 32-bit fingerprint (FNV-1a) of the configuration values, never 0: the configurations
+	///	   with the different fingerprints are different, the equal ones may collide - see the same()
+	uint32_t fingerprint() const;
+
+	/// @brief the values of the configurations are equal; the change state is not compared
+	bool same(const configuration_t& other) const;
 
 	static constexpr char pwd_stub[] = "< WiFi password is never shown >";	// stub for password string
 
@@ -593,9 +1128,8 @@ namespace net
     template <class iptype, class masktype, class gatetype, class logintype, class passwdtype>
     inline configuration_t::configuration_t(bool dhcp_req, iptype&& ipin, masktype&& maskin, gatetype&& gatin, bool usepwd_in,
 			logintype&& login, passwdtype&& passwd):
-			ip(std::forward<iptype>(ipin)), mask(std::forward<masktype>(maskin)), gate(std::forward<gatetype>(gatin)),
-			dhcp(dhcp_req), use_pwd(usepwd_in),
-			login(std::forward<logintype>(login)), passwd(std::forward<passwdtype>(passwd))
+			fields_t(dhcp_req, std::forward<iptype>(ipin), std::forward<masktype>(maskin), std::forward<gatetype>(gatin),
+				usepwd_in, std::forward<logintype>(login), std::forward<passwdtype>(passwd))
     {}; /* net::confifuration_t::configuration_t() */
 
 
@@ -607,12 +1141,12 @@ namespace net
     inline esp_err_t configuration_t::factory_reload() { return ESP_OK; };
 
     /// @brief requested wifi station cfg (SSID or password) is changed
-    inline bool configuration_t::login_changed() {
-        return (login.changed() || passwd.changed() || use_pwd.changed()); }; /* net::configuration::wifi_changed() */
+    inline bool configuration_t::login_changed() const {
+        return dirty & CHG_LOGIN_MASK; }; /* net::configuration::wifi_changed() */
 
     /// @brief requested wifi station netif ip cfg (ip, mask and gate) is changed
-    inline bool configuration_t::ip_changed() {
-        return (dhcp.changed() || ip.changed() || mask.changed() || gate.changed()); }; /* net::configuration::netif_changed() */
+    inline bool configuration_t::ip_changed() const {
+        return dirty & CHG_IP_MASK; }; /* net::configuration::netif_changed() */
 
 
 
@@ -0,0 +1,269 @@
+/*
+ * @file netlog.cpp
+ *
+ * @brief Deferred-format logging of the 'net' component: the ring of the records
+ *	  (the bounded multi-producer queue) & the formatting of the records by the consumer
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "netlog.h"
+
+
+using namespace std;
+
+
+namespace
+{
+
+    /// sequence numbers of the slots of the ring, minus the index of the slot -
+    /// the zero initialized ring is valid before the static constructors;
+    /// seq == pos - the slot is free for the record 'pos', seq == pos + 1 - the record 'pos' is published
+    atomic<uint32_t> seqs[esp::net::log::capacity];
+    esp::net::log::record_t ring[esp::net::log::capacity];
+    atomic<uint32_t> enqueued;	///< position of the next record
+    atomic<uint32_t> dequeued;	///< position of the next record of the consumer
+    atomic<uint32_t> lost;
+    atomic<uint8_t> threshold{CONFIG_NET_LOG_LEVEL};
+
+    mutex consumer;		///< the flush() of the task & the explicit one
+    atomic<bool> started;
+
+    static_assert((esp::net::log::capacity & (esp::net::log::capacity - 1)) == 0, "CONFIG_NET_LOG_RECORDS must be the power of 2");
+
+    uint32_t seq(size_t idx) { return seqs[idx].load(memory_order_acquire) + idx; };
+
+    void seq(size_t idx, uint32_t val) { seqs[idx].store(val - idx, memory_order_release); };
+
+    /// the flushing task
+    void flusher(void* arg)
+    {
+	    TickType_t period = pdMS_TO_TICKS(reinterpret_cast<uintptr_t>(arg));
+
+	for (;;)
+	{
+	    esp::net::log::flush();
+	    vTaskDelay(period? period: 1);
+	}; /* for (;;) */
+    }; /* flusher() */
+
+    /// the printf conversion of the one argument: the flags, the width & the precision of the spec
+    /// are kept, the length modifiers are replaced according the kind of the argument
+    int convert(char* buf, size_t size, const char* spec, size_t len, char conv, const esp::net::log::record_t& rec, unsigned arg)
+    {
+	    char fmt[24];
+	    size_t n = 0;
+
+	for (size_t i = 0; i < len && n < sizeof(fmt) - 4; i++)
+	    if (!strchr("hlLqjzt", spec[i]))
+		fmt[n++] = spec[i];
+	if (arg >= rec.nargs)
+	    return snprintf(buf, size, "<?>");
+
+	switch (conv)
+	{
+	case 'd': case 'i': case 'o': case 'u': case 'x': case 'X': case 'c':
+	    if (rec.kinds[arg] != esp::net::log::SIGNED && rec.kinds[arg] != esp::net::log::UNSIGNED)
+		break;
+	    if (conv == 'c')
+		return fmt[n++] = 'c', fmt[n] = '\0', snprintf(buf, size, fmt, static_cast<int>(rec.args[arg].i));
+	    fmt[n++] = 'l', fmt[n++] = 'l', fmt[n++] = conv, fmt[n] = '\0';
+	    return snprintf(buf, size, fmt, rec.args[arg].i);
+	case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+	    if (rec.kinds[arg] != esp::net::log::REAL)
+		break;
+	    fmt[n++] = conv, fmt[n] = '\0';
+	    return snprintf(buf, size, fmt, rec.args[arg].d);
+	case 's':
+	    if (rec.kinds[arg] != esp::net::log::TEXT)
+		break;
+	    fmt[n++] = 's', fmt[n] = '\0';
+	    return snprintf(buf, size, fmt, rec.text + rec.args[arg].u);
+	case 'p':
+	    fmt[n++] = 'p', fmt[n] = '\0';
+	    return snprintf(buf, size, fmt, rec.args[arg].p);
+	}; /* switch conv */
+	return snprintf(buf, size, "<?>");
+    }; /* convert() */
+
+}; /* namespace <anonymous> */
+
+
+
+//--[ namespace esp::net::log ]----------------------------------------------------------------------------------------
+
+
+/// @brief the string is copied into the text buffer of the record, truncated to the rest of it
+void esp::net::log::record_t::put(const char* str)
+{
+	size_t len = str? strnlen(str, textsize - 1 - used): 0;
+
+    kinds[nargs] = TEXT;
+    args[nargs++].u = used;
+    if (len)
+	memcpy(text + used, str, len);
+    text[used + len] = '\0';
+    used += len + 1 < textsize - used? len + 1: textsize - used - 1;
+}; /* esp::net::log::record_t::put() */
+
+
+esp_log_level_t esp::net::log::level()
+{
+    return static_cast<esp_log_level_t>(threshold.load(memory_order_relaxed));
+}; /* esp::net::log::level() */
+
+void esp::net::log::level(esp_log_level_t lvl)
+{
+    threshold.store(lvl, memory_order_relaxed);
+}; /* esp::net::log::level() */
+
+
+/// @brief free slot of the ring: the position is taken by the CAS, the slot is owned up to the publish()
+esp::net::log::record_t* esp::net::log::reserve()
+{
+	uint32_t pos = enqueued.load(memory_order_relaxed);
+
+    for (;;)
+    {
+	    size_t idx = pos & (capacity - 1);
+	    int32_t diff = static_cast<int32_t>(seq(idx) - pos);
+
+	if (diff < 0)
+	{   // the record of the previous round is not consumed: the ring is full
+	    lost.fetch_add(1, memory_order_relaxed);
+	    return nullptr;
+	}; /* if diff < 0 */
+	if (diff == 0 && enqueued.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+	{
+		record_t& rec = ring[idx];
+
+	    rec.time = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+	    rec.nargs = 0;
+	    rec.used = 0;
+	    return &rec;
+	}; /* if diff == 0 && compare_exchange_weak() */
+	if (diff > 0)
+	    pos = enqueued.load(memory_order_relaxed);
+    }; /* for (;;) */
+}; /* esp::net::log::reserve() */
+
+
+/// @brief the slot is filled, pass it to the consumer
+void esp::net::log::publish(record_t* rec)
+{
+	size_t idx = rec - ring;
+
+    seq(idx, seq(idx) + 1);
+}; /* esp::net::log::publish() */
+
+
+/// @brief format the record: the literal text of the format is copied, the conversions - one by one
+size_t esp::net::log::format(const record_t& rec, char* buf, size_t size)
+{
+	size_t len = 0;
+	unsigned arg = 0;
+
+    auto out = [&](const char* str, size_t n) {
+	    if (len < size)
+		memcpy(buf + len, str, n < size - len? n: size - len);
+	    len += n; };
+
+    for (const char* p = rec.format; *p;)
+    {
+	    const char* spec = strchr(p, '%');
+
+	if (!spec)
+	    spec = p + strlen(p);
+	out(p, spec - p);
+	if (!*spec)
+	    break;
+	if (spec[1] == '%')
+	{
+	    out("%", 1);
+	    p = spec + 2;
+	    continue;
+	}; /* if spec[1] == '%' */
+
+	    const char* conv = spec + 1 + strspn(spec + 1, "-+ #0123456789.hlLqjzt");
+	    char tmp[64];
+
+	if (!*conv)
+	    break;
+	    int n = convert(tmp, sizeof(tmp), spec, conv - spec, *conv, rec, arg++);
+
+	out(tmp, n < 0? 0: n < int(sizeof(tmp))? n: sizeof(tmp) - 1);
+	p = conv + 1;
+    }; /* for p */
+    if (size)
+	buf[len < size? len: size - 1] = '\0';
+    return len;
+}; /* esp::net::log::format() */
+
+
+/// @brief format & write the all pending records, in the order of the recording;
+///	   the slot is released after the formatting
+size_t esp::net::log::flush()
+{
+	lock_guard<mutex> lock(consumer);
+	size_t count = 0;
+	char text[160];
+
+    for (uint32_t pos = dequeued.load(memory_order_relaxed);; pos++, count++)
+    {
+	    size_t idx = pos & (capacity - 1);
+
+	if (seq(idx) != pos + 1)
+	    break;	// not published yet
+
+	    const record_t& rec = ring[idx];
+
+	format(rec, text, sizeof(text));
+	ESP_LOG_LEVEL(static_cast<esp_log_level_t>(rec.level), rec.tag, "(%u) %s", static_cast<unsigned>(rec.time), text);
+	seq(idx, pos + capacity);
+	dequeued.store(pos + 1, memory_order_relaxed);
+    }; /* for pos */
+    return count;
+}; /* esp::net::log::flush() */
+
+
+/// @brief records are waiting the flush(), published or in the filling
+uint32_t esp::net::log::pending()
+{
+    return enqueued.load(memory_order_relaxed) - dequeued.load(memory_order_relaxed);
+}; /* esp::net::log::pending() */
+
+
+/// @brief records are dropped since the start: the ring was full
+uint32_t esp::net::log::dropped()
+{
+    return lost.load(memory_order_relaxed);
+}; /* esp::net::log::dropped() */
+
+
+/// @brief start the low-priority task, flushing the ring periodically
+esp_err_t esp::net::log::start(uint32_t period, UBaseType_t priority)
+{
+    if (started.exchange(true))
+	return ESP_ERR_INVALID_STATE;
+    if (xTaskCreate(flusher, "net_log", 3072, reinterpret_cast<void*>(static_cast<uintptr_t>(period)), priority, nullptr) != pdPASS)
+    {
+	started = false;
+	return ESP_ERR_NO_MEM;
+    }; /* if xTaskCreate() != pdPASS */
+    return ESP_OK;
+}; /* esp::net::log::start() */
+
+
+//--[ netlog.cpp ]-----------------------------------------------------------------------------------------------------
@@ -0,0 +1,188 @@
+/*
+ * @file
+ * netlog.h
+ *
+ * @brief Deferred-format logging of the 'net' component: the hot paths record the format
+ *	  & the raw arguments into the ring, the text is formatted later - by the low-priority task
+ *	  or by the explicit flush(). The levels above CONFIG_NET_LOG_LEVEL are compiled out.
+ *
+ * Usage, as the ESP_LOGx:	NET_LOGW(__func__, "Connection failed with error %i", err);
+ *
+ * @warning May be only inner definitions of the 'net' component
+ *
+ * This code is in the Public Domain (or CC0 licensed, at your option.)
+ *
+ * Unless required by applicable law or agreed to in writing, this
+ *  software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ *  CONDITIONS OF ANY KIND, either express or implied.
+ *
+ * @date    Created on: 16 окт. 2026 г.
+ * @author  aso
+ */
+
+#ifndef _NETLOG_H_
+#define _NETLOG_H_
+
+
+/// Maximum level of the NET_LOGx, compiled in: the calls of the higher levels are discarded
+/// at the compile time, w/o the evaluation of the arguments.
+#ifndef CONFIG_NET_LOG_LEVEL
+#ifdef CONFIG_LOG_MAXIMUM_LEVEL
+#define CONFIG_NET_LOG_LEVEL CONFIG_LOG_MAXIMUM_LEVEL
+#else
+#define CONFIG_NET_LOG_LEVEL 3	// ESP_LOG_INFO
+#endif
+#endif
+
+/// 1 - the NET_LOGx are recorded to the ring & formatted later: the application calls
+///     the esp::net::log::start() or the flush(), else the records are never written;
+/// 0 - the NET_LOGx are the ESP_LOGx, formatted & written at once.
+#ifndef CONFIG_NET_LOG_DEFERRED
+#define CONFIG_NET_LOG_DEFERRED 0
+#endif
+
+/// Capacity of the ring of the deferred log records, the power of 2
+#ifndef CONFIG_NET_LOG_RECORDS
+#define CONFIG_NET_LOG_RECORDS 32
+#endif
+
+
+/// the errors & the not deferred records are written at once, by the ESP_LOG_LEVEL
+#define NET_LOG_LEVEL(level, tag, format, ...) do {				\
+	if constexpr ((level) <= CONFIG_NET_LOG_LEVEL) {			\
+	    if constexpr (!CONFIG_NET_LOG_DEFERRED || (level) == ESP_LOG_ERROR)	\
+		ESP_LOG_LEVEL((level), (tag), format, ##__VA_ARGS__);		\
+	    else								\
+		::esp::net::log::write((level), (tag), (format), ##__VA_ARGS__);	\
+	}									\
+    } while (0)
+
+#define NET_LOGE(tag, format, ...) NET_LOG_LEVEL(ESP_LOG_ERROR,   tag, format, ##__VA_ARGS__)
+#define NET_LOGW(tag, format, ...) NET_LOG_LEVEL(ESP_LOG_WARN,    tag, format, ##__VA_ARGS__)
+#define NET_LOGI(tag, format, ...) NET_LOG_LEVEL(ESP_LOG_INFO,    tag, format, ##__VA_ARGS__)
+#define NET_LOGD(tag, format, ...) NET_LOG_LEVEL(ESP_LOG_DEBUG,   tag, format, ##__VA_ARGS__)
+#define NET_LOGV(tag, format, ...) NET_LOG_LEVEL(ESP_LOG_VERBOSE, tag, format, ##__VA_ARGS__)
+
+
+namespace esp
+{
+    namespace net
+    {
+	/// @brief deferred-format logging: the record keeps the pointers of the tag & of the format
+	///	   (the literals, the format is the id of the message) and the raw arguments;
+	///	   the string arguments are copied into the record, truncated to it's text buffer.
+	///	   The ring is the bounded multi-producer queue: the full ring drops the new records
+	///	   & counts them, the producer is never blocked.
+	namespace log
+	{
+	    constexpr size_t capacity = CONFIG_NET_LOG_RECORDS;	///< records in the ring
+	    constexpr size_t maxargs = 6;	///< arguments of the one record
+	    constexpr size_t textsize = 48;	///< text buffer of the string arguments of the one record
+
+	    /// @brief kind of the argument in the record
+	    enum kind_t: uint8_t
+	    {
+		SIGNED,		///< integer, int64_t
+		UNSIGNED,	///< unsigned integer, uint64_t
+		REAL,		///< floating point, double
+		TEXT,		///< string, copied: offset in the text buffer
+		POINTER,	///< pointer, printed by %p only
+	    }; /* enum kind_t */
+
+	    /// @brief the log record: format, tag & the raw arguments
+	    struct record_t
+	    {
+		const char*	tag;
+		const char*	format;
+		uint32_t	time;		///< esp_timer_get_time() of the record, ms
+		uint8_t		level;		///< esp_log_level_t
+		uint8_t		nargs;
+		uint8_t		used;		///< bytes of the text buffer used
+		kind_t		kinds[maxargs];
+		union
+		{
+		    int64_t	 i;
+		    uint64_t	 u;
+		    double	 d;
+		    const void*	 p;
+		}		args[maxargs];
+		char		text[textsize];
+
+		void put(int64_t val)	    { kinds[nargs] = SIGNED;   args[nargs++].i = val; };
+		void put(uint64_t val)	    { kinds[nargs] = UNSIGNED; args[nargs++].u = val; };
+		void put(double val)	    { kinds[nargs] = REAL;     args[nargs++].d = val; };
+		void put(const void* val)   { kinds[nargs] = POINTER;  args[nargs++].p = val; };
+		void put(const char* str);	///< the string is copied into the text buffer
+
+		/// @brief any argument: by the kind of the it's type
+		template <typename arg_t>
+		void add(const arg_t& arg)
+		{
+		    if constexpr (std::is_same_v<std::decay_t<arg_t>, char*> || std::is_same_v<std::decay_t<arg_t>, const char*>)
+			put(static_cast<const char*>(arg));
+		    else if constexpr (std::is_enum_v<arg_t>)
+			add(static_cast<std::underlying_type_t<arg_t>>(arg));
+		    else if constexpr (std::is_floating_point_v<arg_t>)
+			put(static_cast<double>(arg));
+		    else if constexpr (std::is_integral_v<arg_t> && std::is_signed_v<arg_t>)
+			put(static_cast<int64_t>(arg));
+		    else if constexpr (std::is_integral_v<arg_t>)
+			put(static_cast<uint64_t>(arg));
+		    else
+			put(static_cast<const void*>(arg));
+		}; /* add() */
+	    }; /* struct record_t */
+
+	    /// @brief runtime level of the records: the records above it are not taken
+	    esp_log_level_t level();
+	    void level(esp_log_level_t lvl);
+
+	    record_t* reserve();		///< free slot of the ring, nullptr - the ring is full, the record is dropped
+	    void publish(record_t* rec);	///< the slot is filled, pass it to the consumer
+
+	    /// @brief format the record to the buffer, as the printf() with the arguments of the record
+	    /// @return length of the text, w/o the truncation
+	    size_t format(const record_t& rec, char* buf, size_t size);
+
+	    /// @brief format & write the all pending records by the esp_log_write(), in the order of the recording
+	    /// @return count of the records written
+	    size_t flush();
+
+	    uint32_t pending();	///< records are waiting the flush()
+	    uint32_t dropped();	///< records are dropped since the start: the ring was full
+
+	    /** @brief start the low-priority task, flushing the ring periodically
+	     *  @param[in]   period   - flush period, ms
+	     *  @param[in]   priority - priority of the task
+	     *  @return ESP_OK, ESP_ERR_INVALID_STATE - the task is started already, ESP_ERR_NO_MEM */
+	    esp_err_t start(uint32_t period = 100, UBaseType_t priority = 1);
+
+
+	    /// @brief record the message to the ring, see the NET_LOGx
+	    template <typename... args_t>
+	    inline void write(esp_log_level_t lvl, const char* tag, const char* fmt, const args_t&... args)
+	    {
+		static_assert(sizeof...(args) <= maxargs, "too many arguments of the NET_LOGx");
+
+		if (lvl > level())
+		    return;
+
+		    record_t* rec = reserve();
+
+		if (!rec)
+		    return;
+		rec->tag = tag;
+		rec->format = fmt;
+		rec->level = lvl;
+		(rec->add(args), ...);
+		publish(rec);
+	    }; /* esp::net::log::write() */
+
+	}; /* namespace esp::net::log */
+
+    }; /* namespace esp::net */
+
+}; /* namespace esp */
+
+
+#endif /* _NETLOG_H_ */
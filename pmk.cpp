@@ -0,0 +1,236 @@
+/*
+ * @file pmk.cpp
+ *
+ * @brief Cache of the WPA PSK, derived from the passphrase: skip PBKDF2-SHA1 on the reconnection
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_wifi_types.h>
+#include <esp_wifi.h>
+
+#include <esp_log.h>
+
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+
+#include <nvs.h>
+#include <mbedtls/md.h>
+#include <mbedtls/pkcs5.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "netlog.h"
+#include "sdkconfig.h"
+
+
+using namespace std;
+
+
+/// PSK cache entry; the table of the entries is stored to the NVS as the blob
+struct pmk_entry_t
+{
+    uint32_t stamp;	///< last use, for the LRU replacement
+    uint8_t  pmk[32];
+    uint8_t  check[20];	///< HMAC-SHA1 of the passphrase, keyed by the PMK
+    char     ssid[33];	///< SSID of the AP, "" - entry is free
+}; /* struct pmk_entry_t */
+
+static constexpr char pmk_nvs_space[] = "net_pmk";
+static constexpr char pmk_nvs_key[] = "psk";
+static constexpr unsigned pmk_iterations = 4096;	///< WPA/WPA2 PSK derivation, IEEE 802.11i
+
+static mutex pmk_lock;
+static pmk_entry_t pmk_table[esp::net::wifi::pmk_cache::size];
+static bool pmk_loaded = false;
+static uint32_t pmk_clock = 0;
+static atomic<unsigned> pmk_hits{0}, pmk_misses{0};
+static bool pmk_deferred = false;	///< the storing to the NVS is postponed
+static bool pmk_dirty = false;		///< the table is changed, but not stored
+
+
+/// digest of the passphrase, keyed by the PMK of the entry: the passphrase is not stored,
+/// and w/o the PMK the digest doesn't help to guess it
+static bool pmk_check(const pmk_entry_t& entry, const char passphrase[], size_t plen, uint8_t check[20])
+{
+    return mbedtls_md_hmac(mbedtls_md_info_from_type(MBEDTLS_MD_SHA1), entry.pmk, sizeof(entry.pmk),
+	    reinterpret_cast<const unsigned char*>(passphrase), plen, check) == 0;
+}; /* pmk_check() */
+
+
+/// load the table from the NVS, once
+static void pmk_load()
+{
+	nvs_handle_t nvs;
+	size_t len = sizeof(pmk_table);
+
+    if (pmk_loaded)
+	return;
+    pmk_loaded = true;
+    if (nvs_open(pmk_nvs_space, NVS_READONLY, &nvs) != ESP_OK)
+	return;
+    if (nvs_get_blob(nvs, pmk_nvs_key, pmk_table, &len) != ESP_OK || len != sizeof(pmk_table))
+	memset(pmk_table, 0, sizeof(pmk_table));
+    nvs_close(nvs);
+
+    for (auto& entry: pmk_table)
+	pmk_clock = max(pmk_clock, entry.stamp);
+}; /* pmk_load() */
+
+
+/// store the table to the NVS
+static esp_err_t pmk_save()
+{
+	nvs_handle_t nvs;
+	esp_err_t err = nvs_open(pmk_nvs_space, NVS_READWRITE, &nvs);
+
+    if (err != ESP_OK)
+	return err;
+#ifndef CONFIG_NVS_ENCRYPTION
+	static bool warned = false;
+
+    if (!warned)
+	NET_LOGW(__func__, "PSK are stored to the NVS w/o the encryption, enable CONFIG_NVS_ENCRYPTION");
+    warned = true;
+#endif
+    err = nvs_set_blob(nvs, pmk_nvs_key, pmk_table, sizeof(pmk_table));
+    if (err == ESP_OK)
+	err = nvs_commit(nvs);
+    nvs_close(nvs);
+    if (err == ESP_OK)
+	pmk_dirty = false;
+    return err;
+}; /* pmk_save() */
+
+
+
+//--[ class esp::net::wifi::pmk_cache ]--------------------------------------------------------------------------------
+
+
+/** @brief PSK for the SSID & passphrase: from the cache, or derived & stored to the cache
+ *  @param[in]  ssid       - SSID of the AP
+ *  @param[in]  passphrase - WPA passphrase, 8..63 chars
+ *  @param[out] hex        - PSK, 64 hex digits & the terminating zero
+ *  @param[in]  derive     - derive the absent PSK
+ *  @return ESP_OK - the PSK is found or derived
+ *	ESP_ERR_NOT_FOUND - the PSK is absent & it is not derived
+ *	ESP_ERR_INVALID_ARG - the passphrase is absent or it is the PSK already
+ *	ESP_FAIL - error of the derivation */
+esp_err_t esp::net::wifi::pmk_cache::psk(const char ssid[], const char passphrase[], char hex[65], bool derive)
+{
+	size_t slen = strlen(ssid), plen = strlen(passphrase);
+
+    if (slen == 0 || slen > sizeof(wifi_sta_config_t::ssid) || plen < 8 || plen > 63)
+	return ESP_ERR_INVALID_ARG;
+
+	lock_guard<mutex> lock(pmk_lock);
+	pmk_entry_t* entry = nullptr;
+	uint8_t check[20];
+
+    pmk_load();
+    for (auto& item: pmk_table)
+	if (strncmp(item.ssid, ssid, sizeof(item.ssid)) == 0
+		&& pmk_check(item, passphrase, plen, check) && memcmp(item.check, check, sizeof(check)) == 0)
+	{
+	    entry = &item;
+	    break;
+	}; /* if strncmp(item.ssid, ssid) == 0 && memcmp(item.check, check) == 0 */
+
+    if (entry)
+	pmk_hits.fetch_add(1, memory_order_relaxed);
+    else if (!derive)
+	return ESP_ERR_NOT_FOUND;
+    else
+    {
+	// replace the free or the least recently used entry
+	entry = &pmk_table[0];
+	for (auto& item: pmk_table)
+	    if (!item.ssid[0] || item.stamp < entry->stamp)
+	    {
+		entry = &item;
+		if (!item.ssid[0])
+		    break;
+	    }; /* if !item.ssid[0] || item.stamp < entry->stamp */
+
+	if (mbedtls_pkcs5_pbkdf2_hmac_ext(MBEDTLS_MD_SHA1, reinterpret_cast<const unsigned char*>(passphrase), plen,
+		reinterpret_cast<const unsigned char*>(ssid), slen, pmk_iterations, sizeof(entry->pmk), entry->pmk) != 0)
+	{
+	    NET_LOGE(__PRETTY_FUNCTION__, "PBKDF2 derivation of the PSK is failed");
+	    memset(entry, 0, sizeof(*entry));
+	    return ESP_FAIL;
+	}; /* if mbedtls_pkcs5_pbkdf2_hmac_ext() != 0 */
+	if (!pmk_check(*entry, passphrase, plen, entry->check))
+	{
+	    NET_LOGE(__PRETTY_FUNCTION__, "digest of the passphrase is failed");
+	    memset(entry, 0, sizeof(*entry));
+	    return ESP_FAIL;
+	}; /* if !pmk_check() */
+	memset(entry->ssid, 0, sizeof(entry->ssid));
+	memcpy(entry->ssid, ssid, slen);
+	entry->stamp = ++pmk_clock;
+	pmk_misses.fetch_add(1, memory_order_relaxed);
+	pmk_dirty = true;
+	if (!pmk_deferred && pmk_save() != ESP_OK)
+	    NET_LOGW(__PRETTY_FUNCTION__, "PSK cache is not stored to the NVS, it's valid up to the reboot only");
+    }; /* else if entry */
+
+    entry->stamp = ++pmk_clock;	// the LRU order is kept in the RAM only, don't wear the flash on each hit
+    for (size_t i = 0; i < sizeof(entry->pmk); i++)
+	snprintf(hex + i * 2, 3, "%02x", entry->pmk[i]);
+    return ESP_OK;
+}; /* esp::net::wifi::pmk_cache::psk() */
+
+
+/// @brief drop the all cached PSK in the RAM & in the NVS
+esp_err_t esp::net::wifi::pmk_cache::clear()
+{
+	lock_guard<mutex> lock(pmk_lock);
+
+    memset(pmk_table, 0, sizeof(pmk_table));
+    pmk_loaded = true;
+    pmk_clock = 0;
+    return pmk_save();
+}; /* esp::net::wifi::pmk_cache::clear() */
+
+
+/// @brief postpone the storing of the new PSK to the NVS up to the commit()
+void esp::net::wifi::pmk_cache::defer()
+{
+	lock_guard<mutex> lock(pmk_lock);
+
+    pmk_deferred = true;
+}; /* esp::net::wifi::pmk_cache::defer() */
+
+
+/** @brief end of the postponing
+ *  @param[in] store - store the changed table to the NVS now; else the changes
+ *		       are kept in the RAM and stored with the next change
+ *  @return ESP_OK, or error of the NVS */
+esp_err_t esp::net::wifi::pmk_cache::commit(bool store)
+{
+	lock_guard<mutex> lock(pmk_lock);
+
+    pmk_deferred = false;
+    return (store && pmk_dirty)? pmk_save(): ESP_OK;
+}; /* esp::net::wifi::pmk_cache::commit() */
+
+
+unsigned esp::net::wifi::pmk_cache::hits() { return pmk_hits.load(memory_order_relaxed); };
+
+unsigned esp::net::wifi::pmk_cache::misses() { return pmk_misses.load(memory_order_relaxed); };
+
+
+//--[ pmk.cpp ]--------------------------------------------------------------------------------------------------------
@@ -0,0 +1,264 @@
+/*
+ * @file state.cpp
+ *
+ * @brief Snapshot of the WiFi station status: ip info, DHCP, link, RSSI & BSSID,
+ *	  updated by the WIFI_EVENT & IP_EVENT handler & published to the readers by the seqlock
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_wifi_types.h>
+#include <esp_wifi.h>
+
+#include <esp_log.h>
+
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+
+#include "net.h"
+#include "wifi.h"
+
+
+using namespace std;
+using esp::net::wifi::state;
+
+
+namespace
+{
+
+    /// words of the published status; the 64-bit atomics are not lock-free on the 32-bit targets
+    enum word_t
+    {
+	W_IP, W_MASK, W_GW,
+	W_FLAGS,	///< dhcp | link << 8 | got_ip << 9 | rssi << 16 | channel << 24
+	W_BSSID_LO,	///< bssid[0..3]
+	W_BSSID_HI,	///< bssid[4..5]
+	W_STAMP,
+	WORDS
+    }; /* enum word_t */
+
+    /// the seqlock: 'seq' is odd while the words are written, the version is seq / 2
+    atomic<uint32_t> seq{0};
+    atomic<uint32_t> words[WORDS];
+    atomic<uint32_t> retried{0};
+
+    mutex write_lock;		///< serializes the writers, never taken by the readers
+    state::snapshot_t current;	///< the status of the writers, under the write_lock
+
+    mutex enroll_lock;
+    esp_event_handler_instance_t on_wifi = nullptr;
+    esp_event_handler_instance_t on_ip = nullptr;
+    bool seeded = false;	///< the status is read from the netif & the driver, under the enroll_lock
+
+    static_assert(atomic<uint32_t>::is_always_lock_free, "the station status is not lock-free");
+
+    /// publish the 'current' to the readers; call under the write_lock
+    void publish()
+    {
+	    uint32_t s = seq.load(memory_order_relaxed);
+	    uint32_t lo, hi = 0;
+
+	current.stamp = esp_timer_get_time() / 1000;
+	current.version = s / 2 + 1;
+	memcpy(&lo, current.bssid, 4);
+	memcpy(&hi, current.bssid + 4, 2);
+
+	seq.store(s + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	words[W_IP].store(current.ip.ip.addr, memory_order_relaxed);
+	words[W_MASK].store(current.ip.netmask.addr, memory_order_relaxed);
+	words[W_GW].store(current.ip.gw.addr, memory_order_relaxed);
+	words[W_FLAGS].store(current.dhcp | current.link << 8 | current.got_ip << 9
+		| static_cast<uint8_t>(current.rssi) << 16 | current.channel << 24, memory_order_relaxed);
+	words[W_BSSID_LO].store(lo, memory_order_relaxed);
+	words[W_BSSID_HI].store(hi, memory_order_relaxed);
+	words[W_STAMP].store(current.stamp, memory_order_relaxed);
+	seq.store(s + 2, memory_order_release);
+    }; /* publish() */
+
+    /// the status at the enroll: the events of the connection, passed before it, are not posted again
+    void seed(esp_netif_t* netif)
+    {
+	    wifi_ap_record_t ap;
+	    esp_netif_ip_info_t ip{};
+	    esp_netif_dhcp_status_t dhcp;
+
+	lock_guard<mutex> lock(write_lock);
+	current.link = esp_wifi_sta_get_ap_info(&ap) == ESP_OK;
+	if (current.link)
+	{
+	    current.rssi = ap.rssi;
+	    current.channel = ap.primary;
+	    memcpy(current.bssid, ap.bssid, sizeof(ap.bssid));
+	}; /* if current.link */
+	if (esp_netif_get_ip_info(netif, &ip) == ESP_OK)
+	    current.ip = ip;
+	current.got_ip = current.link && current.ip.ip.addr != 0;
+	if (esp_netif_dhcpc_get_status(netif, &dhcp) == ESP_OK)
+	    current.dhcp = dhcp;
+	publish();
+    }; /* seed() */
+
+}; /* namespace <anonymous> */
+
+
+
+//--[ class esp::net::wifi::state ]------------------------------------------------------------------------------------
+
+
+/// @brief register the WIFI_EVENT & IP_EVENT handlers, once; seed the status by the netif, once:
+///	   the handlers are registered before, the events of the seeding aren't lost
+esp_err_t state::enroll(esp_netif_t* netif)
+{
+	lock_guard<mutex> lock(enroll_lock);
+	esp_err_t err = ESP_OK;
+
+    if (!on_wifi)
+	err = evloop::listen(WIFI_EVENT, ESP_EVENT_ANY_ID, on_event, nullptr, &on_wifi);
+    if (err == ESP_OK && !on_ip)
+	err = evloop::listen(IP_EVENT, ESP_EVENT_ANY_ID, on_event, nullptr, &on_ip);
+    if (err == ESP_OK && netif && !seeded)
+    {
+	seed(netif);
+	seeded = true;
+    }; /* if netif && !seeded */
+    return err;
+}; /* esp::net::wifi::state::enroll() */
+
+
+/// @brief the copy is retried while the writer is inside or has passed over it
+void state::get(snapshot_t& snap)
+{
+	uint32_t w[WORDS];
+	uint32_t s;
+
+    for (;;)
+    {
+	s = seq.load(memory_order_acquire);
+	if (!(s & 1))
+	{
+	    for (int i = 0; i < WORDS; i++)
+		w[i] = words[i].load(memory_order_relaxed);
+	    atomic_thread_fence(memory_order_acquire);
+	    if (seq.load(memory_order_relaxed) == s)
+		break;
+	}; /* if !(s & 1) */
+	retried.fetch_add(1, memory_order_relaxed);
+    }; /* for (;;) */
+
+    snap.ip.ip.addr = w[W_IP];
+    snap.ip.netmask.addr = w[W_MASK];
+    snap.ip.gw.addr = w[W_GW];
+    snap.dhcp = static_cast<esp_netif_dhcp_status_t>(w[W_FLAGS] & 0xff);
+    snap.link = w[W_FLAGS] >> 8 & 1;
+    snap.got_ip = w[W_FLAGS] >> 9 & 1;
+    snap.rssi = static_cast<int8_t>(w[W_FLAGS] >> 16);
+    snap.channel = w[W_FLAGS] >> 24;
+    memcpy(snap.bssid, &w[W_BSSID_LO], 4);
+    memcpy(snap.bssid + 4, &w[W_BSSID_HI], 2);
+    snap.version = s / 2;
+    snap.stamp = w[W_STAMP];
+}; /* esp::net::wifi::state::get() */
+
+
+esp::ip4::info state::info()
+{
+	snapshot_t snap;
+
+    get(snap);
+    return snap.ip;
+}; /* esp::net::wifi::state::info() */
+
+
+uint32_t state::version()
+{
+    return seq.load(memory_order_acquire) / 2;
+}; /* esp::net::wifi::state::version() */
+
+
+/// @brief publish only the changed status: the readers, polling the version(), aren't woken for nothing
+void state::dhcp(esp_netif_dhcp_status_t status)
+{
+	lock_guard<mutex> lock(write_lock);
+
+    if (current.dhcp == status && current.version)
+	return;
+    current.dhcp = status;
+    publish();
+}; /* esp::net::wifi::state::dhcp() */
+
+
+esp_err_t state::poll()
+{
+	wifi_ap_record_t ap;
+	esp_err_t err = esp_wifi_sta_get_ap_info(&ap);
+
+    if (err != ESP_OK)
+	return err;
+
+	lock_guard<mutex> lock(write_lock);
+
+    if (current.rssi == ap.rssi && current.channel == ap.primary && memcmp(current.bssid, ap.bssid, sizeof(ap.bssid)) == 0)
+	return ESP_OK;
+    current.rssi = ap.rssi;
+    current.channel = ap.primary;
+    memcpy(current.bssid, ap.bssid, sizeof(ap.bssid));
+    publish();
+    return ESP_OK;
+}; /* esp::net::wifi::state::poll() */
+
+
+uint32_t state::retries()
+{
+    return retried.load(memory_order_relaxed);
+}; /* esp::net::wifi::state::retries() */
+
+
+/// @brief the address is kept on the disconnection up to the IP_EVENT_STA_LOST_IP, as by the netif itself
+void state::on_event(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+	lock_guard<mutex> lock(write_lock);
+
+    if (base == WIFI_EVENT && id == WIFI_EVENT_STA_CONNECTED)
+    {
+	    const wifi_event_sta_connected_t& ev = *static_cast<wifi_event_sta_connected_t*>(data);
+
+	current.link = true;
+	current.channel = ev.channel;
+	memcpy(current.bssid, ev.bssid, sizeof(ev.bssid));
+    } /* if WIFI_EVENT_STA_CONNECTED */
+    else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED)
+    {
+	current.link = current.got_ip = false;
+	current.rssi = static_cast<wifi_event_sta_disconnected_t*>(data)->rssi;
+    } /* else if WIFI_EVENT_STA_DISCONNECTED */
+    else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_STOP)
+	current.link = current.got_ip = false;
+    else if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP)
+    {
+	current.ip = static_cast<ip_event_got_ip_t*>(data)->ip_info;
+	current.got_ip = true;
+    } /* else if IP_EVENT_STA_GOT_IP */
+    else if (base == IP_EVENT && id == IP_EVENT_STA_LOST_IP)
+    {
+	current.ip = esp_netif_ip_info_t{};
+	current.got_ip = false;
+    } /* else if IP_EVENT_STA_LOST_IP */
+    else
+	return;
+    publish();
+}; /* esp::net::wifi::state::on_event() */
+
+
+//--[ state.cpp ]------------------------------------------------------------------------------------------------------
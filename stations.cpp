@@ -0,0 +1,382 @@
+/*
+ * @file stations.cpp
+ *
+ * @brief Registry of the stations of the soft-AP: the open-addressing hash by the MAC,
+ *	  fed by the WIFI_EVENT & IP_EVENT of the soft-AP & the poll() of the station list
+ *
+ * @date Created on: 16 окт. 2026 г.
+ * @Author: aso
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <esp_wifi_types.h>
+#include <esp_wifi.h>
+
+#include <esp_log.h>
+
+#include <esp_netif.h>
+#include <esp_event.h>
+#include <esp_timer.h>
+
+#include "net.h"
+#include "wifi.h"
+#include "netlog.h"
+
+
+using namespace std;
+using esp::net::wifi::stations;
+
+
+namespace
+{
+    /// the slot of the hash
+    struct slot_t
+    {
+	stations::station_t st;
+	int16_t		    rssi;	///< EWMA of the RSSI, 1/16 dBm
+	uint16_t	    seen;	///< the sweep of the poll(), that listed the station
+	bool		    used;
+    }; /* struct slot_t */
+
+    constexpr unsigned shift = 32 - __builtin_ctz(stations::slots);
+
+    mutex table_lock;
+    slot_t table[stations::slots];
+    size_t nused = 0;		///< used slots
+    size_t online = 0;		///< connected stations
+    uint16_t sweep = 0;
+    uint32_t nevicted = 0;
+    uint32_t ndropped = 0;
+
+    esp::dhcp_server_t* server = nullptr;	///< the server of the soft-AP, the leases are mirrored to; by the table_lock
+
+    mutex enroll_lock;
+    esp_event_handler_instance_t on_wifi = nullptr;
+    esp_event_handler_instance_t on_ip = nullptr;
+
+    uint32_t now_ms()
+    {
+	return esp_timer_get_time() / 1000;
+    }; /* now_ms() */
+
+    /// the home slot of the MAC: the multiplicative hash of the NIC specific part & the OUI
+    size_t home(const uint8_t mac[6])
+    {
+	    uint32_t h = (uint32_t(mac[2]) << 24 | mac[3] << 16 | mac[4] << 8 | mac[5]) ^ (mac[0] << 8 | mac[1]) * 0x9e3779b9u;
+
+	return (h * 0x9e3779b9u) >> shift;
+    }; /* home() */
+
+    /// the slot of the MAC, else the empty slot, where it is to be inserted; call under the table_lock
+    size_t probe(const uint8_t mac[6])
+    {
+	    size_t i = home(mac);
+
+	while (table[i].used && memcmp(table[i].st.mac, mac, sizeof(table[i].st.mac)) != 0)
+	    i = (i + 1) & (stations::slots - 1);
+	return i;
+    }; /* probe() */
+
+    /// remove the slot: the following slots of the probe chain are shifted back, no tombstones; call under the table_lock
+    void erase(size_t i)
+    {
+	    size_t j = i;
+
+	online -= table[i].st.connected;
+	table[i].used = false;
+	nused--;
+	for (;;)
+	{
+	    j = (j + 1) & (stations::slots - 1);
+	    if (!table[j].used)
+		return;
+
+		size_t h = home(table[j].st.mac);
+
+	    // the slot j stays, if it's home is cyclically in (i, j]
+	    if (i <= j? (i < h && h <= j): (i < h || h <= j))
+		continue;
+	    table[i] = table[j];
+	    table[j].used = false;
+	    i = j;
+	}; /* for (;;) */
+    }; /* erase() */
+
+    /// the slot of the connected station: the known one is reconnected, the new one replaces
+    /// the oldest disconnected station of the full registry; -1 - the registry is full of the connected; call under the table_lock
+    int connect(const uint8_t mac[6])
+    {
+	    size_t i = probe(mac);
+
+	if (!table[i].used)
+	{
+	    if (nused >= stations::capacity)
+	    {
+		    int oldest = -1;
+
+		for (size_t j = 0; j < stations::slots; j++)
+		    if (table[j].used && !table[j].st.connected && (oldest < 0 || table[j].st.left < table[oldest].st.left))
+			oldest = j;
+		if (oldest < 0)
+		{
+		    ndropped++;
+		    return -1;
+		}; /* if oldest < 0 */
+		erase(oldest);
+		nevicted++;
+		i = probe(mac);
+	    }; /* if nused >= stations::capacity */
+	    table[i] = slot_t{};
+	    memcpy(table[i].st.mac, mac, sizeof(table[i].st.mac));
+	    table[i].used = true;
+	    nused++;
+	}; /* if !table[i].used */
+
+	    stations::station_t& st = table[i].st;
+
+	if (!st.connected)
+	{
+	    st.connected = true;
+	    st.since = now_ms();
+	    st.left = 0;
+	    st.reason = 0;
+	    st.ip = 0;
+	    online++;
+	}; /* if !st.connected */
+	return i;
+    }; /* connect() */
+
+    /// the address of the station is booked by the mirrored server; call under the table_lock
+    void take_lease(const stations::station_t& st)
+    {
+	if (!server || !st.ip)
+	    return;
+
+	    esp_err_t err = server->bind(st.mac, st.ip);
+	    uint32_t reserved = server->reserved(st.mac);
+
+	if (err == ESP_ERR_INVALID_STATE)
+	    NET_LOGW("stations", "The DHCP server assigned to %02x:%02x:%02x:%02x:%02x:%02x the address %s, reserved or used by the other",
+		    st.mac[0], st.mac[1], st.mac[2], st.mac[3], st.mac[4], st.mac[5], esp::ip4::format(esp_ip4_addr_t{st.ip}).c_str());
+	else if (reserved && reserved != st.ip)
+	    NET_LOGW("stations", "The DHCP server doesn't honour the reservation %s of %02x:%02x:%02x:%02x:%02x:%02x",
+		    esp::ip4::format(esp_ip4_addr_t{reserved}).c_str(), st.mac[0], st.mac[1], st.mac[2], st.mac[3], st.mac[4], st.mac[5]);
+    }; /* take_lease() */
+
+    /// the address of the station is free in the mirrored server; call under the table_lock
+    void free_lease(const stations::station_t& st)
+    {
+	if (server && st.ip)
+	    server->release(st.mac, st.ip);
+    }; /* free_lease() */
+
+    /// the station is disconnected, it is kept with the reason; call under the table_lock
+    void disconnect(size_t i, uint8_t reason)
+    {
+	    stations::station_t& st = table[i].st;
+
+	if (!st.connected)
+	    return;
+	free_lease(st);
+	st.connected = false;
+	st.reason = reason;
+	st.left = max<uint32_t>(now_ms(), 1);
+	online--;
+    }; /* disconnect() */
+
+}; /* namespace <anonymous> */
+
+
+
+//--[ class esp::net::wifi::stations ]---------------------------------------------------------------------------------
+
+
+/// @brief register the WIFI_EVENT & IP_EVENT handlers, once
+esp_err_t stations::enroll()
+{
+	lock_guard<mutex> lock(enroll_lock);
+	esp_err_t err = ESP_OK;
+
+    if (!on_wifi)
+	err = evloop::listen(WIFI_EVENT, ESP_EVENT_ANY_ID, on_event, nullptr, &on_wifi);
+    if (err == ESP_OK && !on_ip)
+	err = evloop::listen(IP_EVENT, IP_EVENT_AP_STAIPASSIGNED, on_event, nullptr, &on_ip);
+    return err;
+}; /* esp::net::wifi::stations::enroll() */
+
+
+void stations::mirror(esp::dhcp_server_t* dhcps)
+{
+	lock_guard<mutex> lock(table_lock);
+
+    server = dhcps;
+    for (auto& slot: table)
+	if (slot.used && slot.st.connected)
+	    take_lease(slot.st);
+}; /* esp::net::wifi::stations::mirror() */
+
+
+void stations::unmirror(const esp::dhcp_server_t* dhcps)
+{
+	lock_guard<mutex> lock(table_lock);
+
+    if (server == dhcps)
+	server = nullptr;
+}; /* esp::net::wifi::stations::unmirror() */
+
+
+bool stations::find(const uint8_t mac[6], station_t& station)
+{
+	lock_guard<mutex> lock(table_lock);
+	size_t i = probe(mac);
+
+    if (!table[i].used)
+	return false;
+    station = table[i].st;
+    return true;
+}; /* esp::net::wifi::stations::find() */
+
+
+size_t stations::connected()
+{
+	lock_guard<mutex> lock(table_lock);
+
+    return online;
+}; /* esp::net::wifi::stations::connected() */
+
+
+size_t stations::list(station_t out[], size_t size, bool all)
+{
+	lock_guard<mutex> lock(table_lock);
+	size_t n = 0;
+
+    for (size_t i = 0; i < slots && n < size; i++)
+	if (table[i].used && (all || table[i].st.connected))
+	    out[n++] = table[i].st;
+    return n;
+}; /* esp::net::wifi::stations::list() */
+
+
+/// @brief the RSSI is averaged by the EWMA of 1/4 in the 1/16 dBm; the list is copied before the lock is taken:
+///	   the esp_wifi_ap_get_sta_list() is not called under it
+esp_err_t stations::poll()
+{
+	wifi_sta_list_t list;
+	esp_err_t err = esp_wifi_ap_get_sta_list(&list);
+
+    if (err != ESP_OK)
+	return err;
+
+	lock_guard<mutex> lock(table_lock);
+
+    sweep++;
+    for (int n = 0; n < list.num; n++)
+    {
+	    int i = connect(list.sta[n].mac);
+
+	if (i < 0)
+	    continue;
+
+	    slot_t& slot = table[i];
+
+	slot.seen = sweep;
+	if (!slot.st.rssi)
+	    slot.rssi = list.sta[n].rssi * 16;
+	else
+	    slot.rssi += (list.sta[n].rssi * 16 - slot.rssi) / 4;
+	slot.st.rssi = (slot.rssi - 8) / 16;	// rounded to the nearest
+	if (!slot.st.rssi)
+	    slot.st.rssi = -1;
+    }; /* for n */
+    for (auto& slot: table)
+	if (slot.used && slot.st.connected && slot.seen != sweep)
+	    disconnect(&slot - table, 0);
+    return ESP_OK;
+}; /* esp::net::wifi::stations::poll() */
+
+
+uint32_t stations::evicted()
+{
+	lock_guard<mutex> lock(table_lock);
+
+    return nevicted;
+}; /* esp::net::wifi::stations::evicted() */
+
+
+uint32_t stations::dropped()
+{
+	lock_guard<mutex> lock(table_lock);
+
+    return ndropped;
+}; /* esp::net::wifi::stations::dropped() */
+
+
+void stations::clear()
+{
+	lock_guard<mutex> lock(table_lock);
+
+    for (auto& slot: table)
+    {
+	if (slot.used && slot.st.connected)
+	    free_lease(slot.st);
+	slot.used = false;
+    }; /* for slot */
+    nused = online = 0;
+    nevicted = ndropped = 0;
+}; /* esp::net::wifi::stations::clear() */
+
+
+/// @brief the station, connected after the list of the running poll() is taken, is not disconnected by it:
+///	   it is marked seen by the next sweep
+void stations::on_event(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+	lock_guard<mutex> lock(table_lock);
+
+    if (base == WIFI_EVENT && id == WIFI_EVENT_AP_STACONNECTED)
+    {
+	    const wifi_event_ap_staconnected_t& ev = *static_cast<wifi_event_ap_staconnected_t*>(data);
+	    int i = connect(ev.mac);
+
+	if (i < 0)
+	    return;
+	table[i].st.aid = ev.aid;
+	table[i].seen = sweep + 1;
+    } /* if WIFI_EVENT_AP_STACONNECTED */
+    else if (base == WIFI_EVENT && id == WIFI_EVENT_AP_STADISCONNECTED)
+    {
+	    const wifi_event_ap_stadisconnected_t& ev = *static_cast<wifi_event_ap_stadisconnected_t*>(data);
+	    size_t i = probe(ev.mac);
+
+	if (table[i].used)
+	    disconnect(i, ev.reason);
+    } /* else if WIFI_EVENT_AP_STADISCONNECTED */
+    else if (base == WIFI_EVENT && id == WIFI_EVENT_AP_STOP)
+    {
+	for (auto& slot: table)
+	    if (slot.used)
+		disconnect(&slot - table, 0);
+    } /* else if WIFI_EVENT_AP_STOP */
+    else if (base == IP_EVENT && id == IP_EVENT_AP_STAIPASSIGNED)
+    {
+	    const ip_event_ap_staipassigned_t& ev = *static_cast<ip_event_ap_staipassigned_t*>(data);
+	    size_t i = probe(ev.mac);
+
+	if (!table[i].used || !table[i].st.connected || table[i].st.ip == ev.ip.addr)
+	    return;
+	free_lease(table[i].st);
+	table[i].st.ip = ev.ip.addr;
+	take_lease(table[i].st);
+    }; /* else if IP_EVENT_AP_STAIPASSIGNED */
+}; /* esp::net::wifi::stations::on_event() */
+
+
+//--[ stations.cpp ]---------------------------------------------------------------------------------------------------
@@ -9,8 +9,15 @@
 
 //#include <algorithm>
 //#include <cstdint>
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <cctype>
 #include <utility>
 
@@ -24,6 +31,9 @@
 #include <esp_system.h>
 #include <esp_types.h>
 #include <esp_event.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 #include <asemaphore>
 #include <event_ctrl.hpp>
@@ -31,6 +41,7 @@
 
 #include "net.h"
 #include "wifi.h"
+#include "netlog.h"
 #include "sdkconfig.h"
 //#include "net_cfg.h"
 
@@ -39,6 +50,14 @@
 using namespace std;
 
 
+/// own events of the asynchronous Updater
+ESP_EVENT_DEFINE_BASE(WIFI_UPDATER_EVENT);
+
+enum {
+    WIFI_UPDATER_EVENT_START,	///< new request, event data - pointer to the heap copy of the request shared_ptr
+    WIFI_UPDATER_EVENT_TIMEOUT,	///< timeout of the stage, event data - generation of the stage
+};
+
 
 /// @brief Create exemplar of the wifi esp::netif
 esp::wifi::netif_t::netif_t(wifi_interface_t wifi_if, esp_netif_inherent_config_t &config): netif_t()
@@ -52,10 +71,74 @@ esp_netif_t* esp::wifi::netif_t::create(wifi_interface_t wifi_if, esp_netif_inhe
 {
     type = wifi_if;
     instance = esp_netif_create_wifi(wifi_if, &config);
+    if (instance)
+    {
+	dhcp.client.sync();
+	dhcp.server.sync();
+	if (wifi_if == WIFI_IF_STA)
+	{
+	    track();
+	    esp::net::wifi::state::enroll(instance);	// the status snapshot follows the station from it's creation
+	} /* if wifi_if == WIFI_IF_STA */
+	else if (wifi_if == WIFI_IF_AP && esp::net::wifi::stations::enroll() == ESP_OK)
+	    esp::net::wifi::stations::mirror(&dhcp.server);	// the table of the server follows the real leases
+    }; /* if instance */
     return instance;
 }; /* esp::netif::create */
 
 
+esp::wifi::netif_t::~netif_t()
+{
+    untrack();
+    esp::net::wifi::stations::unmirror(&dhcp.server);
+}; /* esp::wifi::netif_t::~netif_t() */
+
+
+esp_err_t esp::wifi::netif_t::track()
+{
+	esp_err_t err = ESP_OK;
+
+    if (!on_wifi)
+	err = esp::net::wifi::evloop::listen(WIFI_EVENT, ESP_EVENT_ANY_ID, on_event, this, &on_wifi);
+    if (err == ESP_OK && !on_ip)
+	err = esp::net::wifi::evloop::listen(IP_EVENT, ESP_EVENT_ANY_ID, on_event, this, &on_ip);
+    if (err != ESP_OK)
+	NET_LOGE(__func__, "Fail register the handlers of the station events with error code %i", err);
+    return err;
+}; /* esp::wifi::netif_t::track() */
+
+
+void esp::wifi::netif_t::untrack()
+{
+    if (on_wifi)
+	esp::net::wifi::evloop::unlisten(WIFI_EVENT, ESP_EVENT_ANY_ID, on_wifi);
+    if (on_ip)
+	esp::net::wifi::evloop::unlisten(IP_EVENT, ESP_EVENT_ANY_ID, on_ip);
+    on_wifi = on_ip = nullptr;
+}; /* esp::wifi::netif_t::untrack() */
+
+
+/// @brief the events of the station are mirrored into the state of the DHCP client w/o the esp_netif calls
+void esp::wifi::netif_t::on_event(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+	netif_t& netif = *static_cast<netif_t*>(arg);
+
+    if (base == WIFI_EVENT && id == WIFI_EVENT_STA_CONNECTED)
+	netif.dhcp.client.link(true);
+    else if (base == WIFI_EVENT && (id == WIFI_EVENT_STA_DISCONNECTED || id == WIFI_EVENT_STA_STOP))
+	netif.dhcp.client.link(false);
+    else if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP && data
+	    && static_cast<ip_event_got_ip_t*>(data)->esp_netif == netif.instance)
+    {
+	netif.dhcp.client.bound(static_cast<ip_event_got_ip_t*>(data)->ip_info);
+	if (netif.dhcp.client.started())	// not the static address
+	    esp::net::wifi::known_ap::bound(static_cast<ip_event_got_ip_t*>(data)->ip_info.ip.addr);
+    } /* if base == IP_EVENT && id == IP_EVENT_STA_GOT_IP */
+    else if (base == IP_EVENT && id == IP_EVENT_STA_LOST_IP)
+	netif.dhcp.client.lost();
+}; /* esp::wifi::netif_t::on_event() */
+
+
 
 //--[ class esp::wifi::stack ]-----------------------------------------------------------------------------------------
 
@@ -219,8 +302,8 @@ const esp::net::wifi::config_t& esp::net::wifi::config_t::set(const wifi_sta_con
 const char* xssid_cstr(const uint8_t buf[], size_t maxlen)
 {
 	static char strbuf[65];
-    memcpy(strbuf, buf, min(maxlen, 64U));
-    strbuf[min(maxlen, 64U)] = '\0';	///< terminate the output string, for safety
+    memcpy(strbuf, buf, min<size_t>(maxlen, 64U));
+    strbuf[min<size_t>(maxlen, 64U)] = '\0';	///< terminate the output string, for safety
     return strbuf;
 }; /* xssid_cstr() */
 
@@ -284,6 +367,35 @@ const char* esp::net::wifi::config_t::passwd_cstr() const
 	return xssid_cstr(data.ap.password, sizeof(data.ap.password));
 }; /* esp::net::wifi::config_t::ssid_csctr() */
 
+/// Replace the passphrase by the PSK (64 hex digits) from the pmk_cache
+/// @return ESP_OK - the passphrase is replaced
+///	ESP_ERR_WIFI_MODE - not the STA configuration
+///	ESP_ERR_INVALID_ARG - the password is not the passphrase (empty or the PSK already)
+esp_err_t esp::net::wifi::config_t::psk(bool derive)
+{
+	char ssid[sizeof(data.sta.ssid) + 1] = {}, pwd[sizeof(data.sta.password) + 1] = {};
+	char hex[65];
+
+    if (type != WIFI_IF_STA)
+	return ESP_ERR_WIFI_MODE;
+    if (sae())
+	return ESP_ERR_NOT_SUPPORTED;
+    memcpy(ssid, data.sta.ssid, sizeof(data.sta.ssid));
+    memcpy(pwd, data.sta.password, sizeof(data.sta.password));
+
+	esp_err_t err = pmk_cache::psk(ssid, pwd, hex, derive);
+
+    if (err == ESP_OK)
+	memcpy(data.sta.password, hex, sizeof(data.sta.password));	// 64 hex digits without the terminating zero
+    return err;
+}; /* esp::net::wifi::config_t::psk() */
+
+/// the SAE commit is computed from the passphrase: the PSK instead of it fails the WPA3 connection
+bool esp::net::wifi::config_t::sae() const
+{
+    return type == WIFI_IF_STA && (data.sta.threshold.authmode >= WIFI_AUTH_WPA3_PSK || data.sta.pmf_cfg.required);
+}; /* esp::net::wifi::config_t::sae() */
+
 /// Set the BSSID
 /// @return
 ///	ESP_OK	- operation comleted successfully
@@ -313,6 +425,49 @@ const char* esp::net::wifi::config_t::bssid_cstr() const
 }; /* esp::net::wifi::config_t::bssid_csctr() */
 
 
+// Get the target of the STA connection
+esp::net::wifi::target_t esp::net::wifi::config_t::target() const
+{
+	target_t tgt = {};
+
+    if (type != WIFI_IF_STA)
+	return tgt;
+    tgt.bssid_set = data.sta.bssid_set;
+    memcpy(tgt.bssid, data.sta.bssid, sizeof(tgt.bssid));
+    tgt.channel = data.sta.channel;
+    tgt.scan_method = data.sta.scan_method;
+    return tgt;
+}; /* esp::net::wifi::config_t::target() */
+
+
+// Set the target of the STA connection
+esp_err_t esp::net::wifi::config_t::target(const target_t& tgt)
+{
+    if (type != WIFI_IF_STA)
+	return ESP_ERR_WIFI_MODE;
+    data.sta.bssid_set = tgt.bssid_set;
+    memcpy(data.sta.bssid, tgt.bssid, sizeof(data.sta.bssid));
+    data.sta.channel = tgt.channel;
+    data.sta.scan_method = tgt.scan_method;
+    return ESP_OK;
+}; /* esp::net::wifi::config_t::target() */
+
+
+// Target the connection to the AP with the BSSID on the channel
+esp_err_t esp::net::wifi::config_t::pin(const uint8_t bssid[6], uint8_t channel)
+{
+    if (!bssid)
+	return ESP_ERR_INVALID_ARG;
+    if (type != WIFI_IF_STA)
+	return ESP_ERR_WIFI_MODE;
+    data.sta.bssid_set = true;
+    memcpy(data.sta.bssid, bssid, sizeof(data.sta.bssid));
+    data.sta.channel = channel;
+    data.sta.scan_method = WIFI_FAST_SCAN;
+    return ESP_OK;
+}; /* esp::net::wifi::config_t::pin() */
+
+
 #if 0
 /// assigment operators
 //template <typename T>
@@ -459,272 +614,385 @@ const char* wifi_err_reason(wifi_err_reason_t reason)
 //
 //*********************************************************************************************************************
 
-///@brief  reason-codes, defined in ESP-IDF SDK
-///@detail Decoding the WiFi error reason enum, return text message describe of it,
-///        C++ implementation of this function
-///@param [in] reason reason of the WiFi error
-///@return ASCIIZ C-string with text name of error reason
-const char* esp::wifi::err::reason(wifi_err_reason_t reasonner)
+namespace
 {
-#define Rea_pfx(reason) WIFI_REASON_##reason
-#define Rea_msg(reason) "WiFi Err Reason: " #reason
-#define case_reason(reason) case Rea_pfx(reason):	return  #reason //Rea_msg(reason)
 
-    switch (reasonner)
+    /// the entry of the reason-codes table
+    struct reason_info_t
     {
-    // Внутренняя ошибка,  например закончилась память, сбой внутреннего TX,
-    // или reason принята от противоположной стороны.
-    case_reason(UNSPECIFIED); /* 1 (1) */
-
-    // Предыдущая аутентификация не является более допустимой.
-    // Для станции ESP эта reason сообщается в случаях:
-    //  - таймаут аутентификации.
-    //  - причина получена от AP.
-    // Для ESP AP, эта reason сообщается в случаях:
-    //  - AP не приняла какие-либо пакеты от станции за последующие 5 минут.
-    //  - AP остановлена вызовом esp_wifi_stop().
-    //  - станция переведена в состояние de-authed (не аутентифицирована) вызовом esp_wifi_deauth_sta().
-    case_reason(AUTH_EXPIRE); /* 2 (2) */
-
-    // De-authenticated (не аутентифицирована),  потому что отправляющая станция отключается (или отключилась).
-    // Для станции ESP эта reason сообщается в случае: она получена от AP.
-    case_reason(AUTH_LEAVE); /* 3 (3) */
-
-    // Отключено из-за неактивности.
-    // Для станции ESP эта reason сообщается в случае: она получена от AP.
-    // Для ESP AP эта причина сообщается в случаях:
-    //  - AP не приняла какие-либо пакеты от станции в течение 5 минут.
-    //  - AP остановлена вызовом esp_wifi_stop().
-    //  - станция переведена в состояние de-authed вызовом esp_wifi_deauth_sta().
-    case_reason(ASSOC_EXPIRE); /* 4 (4) */
-
-    // Отключено, потому что AP не может обработать все текущие ассоциированные STA одновременно.
-    // Для станции ESP эта reason сообщается в случае: она получена от AP.
-    // Для ESP AP эта reason сообщается в случае: станции, ассоциированные с AP, достигли максимального количества,
-    //  которое может поддержать AP.
-    case_reason(ASSOC_TOOMANY); /* 5 (5) */
-
-    // От не аутентифицированной станции принят кадр Class-2.
-    // Для станции ESP эта reason сообщается в случае: она получена от AP.
-    // Для ESP AP эта reason сообщается в случае: AP получила пакет с данными от не аутентифицированной станции.
-    case_reason(NOT_AUTHED); /* 6 (6) */
-
-    // От не ассоциированной станции принят кадр Class-3.
-    // Для станции ESP эта reason сообщается в случае: она получена от AP.
-    // Для ESP AP эта reason сообщается в случае: AP получила пакет с данными от не ассоциированной станции.
-    case_reason(NOT_ASSOCED); /* 7 (7) */
-
-    // Отключено, потому что отправляющая станция оставляет (или оставила) BSS.
-    // Для станции ESP, эта reason сообщается в случае:
-    //  - она принята от AP.
-    //  - станция отключена через esp_wifi_disconnect() и другое API.
-    case_reason(ASSOC_LEAVE); /* 8 (8) */
-
-    // Станция, запрашивающая (повторную) ассоциацию не аутентифицирована отвечающей STA.
-    // Для станции ESP, эта reason сообщается в случае:
-    //  - она принята от AP.
-    // Для ESP AP эта reason сообщается в случае:
-    //  - AP приняла пакеты с данными от ассоциированной, но не аутентифицированной станции.
-    case_reason(ASSOC_NOT_AUTHED); /* 9 (9) */
-
-    // Отключено, потому что недопустима информация в элементе Power Capability.
-    // Для станции ESP эта reason сообщается в случае: она получена от AP.
-    case_reason(DISASSOC_PWRCAP_BAD); /* 10 (10) */
-
-    // Отключено, потому что недопустима информация в элементе Supported Channels.
-    // Для станции ESP, эта reason сообщается в случае: она принята от AP.
-    case_reason(DISASSOC_SUPCHAN_BAD); /* 11 (11) */
-
-    // Any Reason code
-    case_reason(BSS_TRANSITION_DISASSOC); /* 12 */;
-
-    // Недопустимый элемент, например элемент, содержимое которого не удовлетворяет спецификациями стандарта
-    //   в пункте формата кадра.
-    // Для станции ESP, эта reason сообщается в случае: она принята от AP.
-    // Для ESP AP, эта reason сообщается в случае: AP обработано неправильный WPA или RSN IE.
-    case_reason(IE_INVALID); /* 13 (13) */
-
-    // Ошибка кода целостности сообщения (MIC).
-    // Для станции ESP эта reason сообщается, в случае: она принята от AP.
-    case_reason(MIC_FAILURE); /* 14 (14) */
-
-    // Таймаут процесса four-way handshake.
-    // По соображениям совместимости в ESP код reason заменен на WIFI_REASON_HANDSHAKE_TIMEOUT.
-    // Для станции ESP эта reason сообщается в случае:
-    //  - таймаут handshake.
-    //  - она принята от AP.
-    case_reason(4WAY_HANDSHAKE_TIMEOUT); /* 15 (15) */
-
-    // Таймаут Group-Key Handshake.
-    // Для станции ESP эта reason сообщается в случае: она принята от AP.
-    case_reason(GROUP_KEY_UPDATE_TIMEOUT); /* 16 (16) */
-
-    // Элемент в four-way handshake отличается от кадра (Re-)Association Request/Probe и Response/Beacon frame.
-    // Для станции ESP эта reason сообщается в случае:
-    //  - она принята от AP.
-    //  - станция обнаружила, что four-way handshake IE отличается от IE в кадре (Re-)Association Request/Probe и Response/Beacon.
-    case_reason(IE_IN_4WAY_DIFFERS); /* 17 (17) */
-
-    // Invalid group cipher.
-    // Для станции ESP эта reason сообщается в случае: она принята от AP.
-    case_reason(GROUP_CIPHER_INVALID); /* 18 (18) */
-
-    // Недопустимый pairwise cipher.
-    // Для станции ESP эта reason сообщается в случае: она принята от AP.
-    case_reason(PAIRWISE_CIPHER_INVALID); /* 19 (19) */
-
-    // Недопустимый AKMP.
-    // Для станции ESP эта reason сообщается в случае: - она принята от AP.
-    case_reason(AKMP_INVALID); /* 20 (20) */
+	uint8_t			code;
+	esp::wifi::err::kind_t	kind;	///< is the retry of the connection worthwhile
+	esp_err_t		status;	///< error status of the failed connection
+	const char*		name;
+    }; /* struct reason_info_t */
+
+#define reason_entry(reason, kind, status) {WIFI_REASON_##reason, esp::wifi::err::kind, ESP_ERR_WIFI_##status, #reason}
+#define reserved_entry(code) {code, esp::wifi::err::UNKNOWN, ESP_ERR_WIFI_NOT_CONNECT, "Unknown_code"}
+
+    ///@brief  reason-codes, defined in ESP-IDF SDK: dense table over 1..68 & 200..210,
+    ///	       the codes, absent in the SDK, are the reserved entries
+    constexpr reason_info_t reasons[] = {
+	// Внутренняя ошибка,  например закончилась память, сбой внутреннего TX,
+	// или reason принята от противоположной стороны.
+	reason_entry(UNSPECIFIED, TRANSIENT, NOT_CONNECT),	/* 1 */
+
+	// Предыдущая аутентификация не является более допустимой.
+	// Для станции ESP эта reason сообщается в случаях:
+	//  - таймаут аутентификации.
+	//  - причина получена от AP.
+	// Для ESP AP, эта reason сообщается в случаях:
+	//  - AP не приняла какие-либо пакеты от станции за последующие 5 минут.
+	//  - AP остановлена вызовом esp_wifi_stop().
+	//  - станция переведена в состояние de-authed (не аутентифицирована) вызовом esp_wifi_deauth_sta().
+	reason_entry(AUTH_EXPIRE, TRANSIENT, PASSWORD),	/* 2 */
+
+	// De-authenticated (не аутентифицирована),  потому что отправляющая станция отключается (или отключилась).
+	// Для станции ESP эта reason сообщается в случае: она получена от AP.
+	reason_entry(AUTH_LEAVE, TRANSIENT, NOT_CONNECT),	/* 3 */
+
+	// Отключено из-за неактивности.
+	// Для станции ESP эта reason сообщается в случае: она получена от AP.
+	// Для ESP AP эта причина сообщается в случаях:
+	//  - AP не приняла какие-либо пакеты от станции в течение 5 минут.
+	//  - AP остановлена вызовом esp_wifi_stop().
+	//  - станция переведена в состояние de-authed вызовом esp_wifi_deauth_sta().
+	reason_entry(ASSOC_EXPIRE, TRANSIENT, NOT_CONNECT),	/* 4 */
+
+	// Отключено, потому что AP не может обработать все текущие ассоциированные STA одновременно.
+	// Для станции ESP эта reason сообщается в случае: она получена от AP.
+	// Для ESP AP эта reason сообщается в случае: станции, ассоциированные с AP, достигли максимального количества,
+	//  которое может поддержать AP.
+	reason_entry(ASSOC_TOOMANY, CAPACITY, CONN),	/* 5 */
+
+	// От не аутентифицированной станции принят кадр Class-2.
+	// Для станции ESP эта reason сообщается в случае: она получена от AP.
+	// Для ESP AP эта reason сообщается в случае: AP получила пакет с данными от не аутентифицированной станции.
+	reason_entry(NOT_AUTHED, TRANSIENT, CONN),	/* 6 */
+
+	// От не ассоциированной станции принят кадр Class-3.
+	// Для станции ESP эта reason сообщается в случае: она получена от AP.
+	// Для ESP AP эта reason сообщается в случае: AP получила пакет с данными от не ассоциированной станции.
+	reason_entry(NOT_ASSOCED, TRANSIENT, CONN),	/* 7 */
+
+	// Отключено, потому что отправляющая станция оставляет (или оставила) BSS.
+	// Для станции ESP, эта reason сообщается в случае:
+	//  - она принята от AP.
+	//  - станция отключена через esp_wifi_disconnect() и другое API.
+	reason_entry(ASSOC_LEAVE, TRANSIENT, NOT_CONNECT),	/* 8 */
+
+	// Станция, запрашивающая (повторную) ассоциацию не аутентифицирована отвечающей STA.
+	// Для станции ESP, эта reason сообщается в случае:
+	//  - она принята от AP.
+	// Для ESP AP эта reason сообщается в случае:
+	//  - AP приняла пакеты с данными от ассоциированной, но не аутентифицированной станции.
+	reason_entry(ASSOC_NOT_AUTHED, TRANSIENT, CONN),	/* 9 */
+
+	// Отключено, потому что недопустима информация в элементе Power Capability.
+	// Для станции ESP эта reason сообщается в случае: она получена от AP.
+	reason_entry(DISASSOC_PWRCAP_BAD, CONFIG, NOT_CONNECT),	/* 10 */
+
+	// Отключено, потому что недопустима информация в элементе Supported Channels.
+	// Для станции ESP, эта reason сообщается в случае: она принята от AP.
+	reason_entry(DISASSOC_SUPCHAN_BAD, CONFIG, NOT_CONNECT),	/* 11 */
+
+	// Any Reason code
+	reason_entry(BSS_TRANSITION_DISASSOC, TRANSIENT, NOT_CONNECT),	/* 12 */
+
+	// Недопустимый элемент, например элемент, содержимое которого не удовлетворяет спецификациями стандарта
+	//   в пункте формата кадра.
+	// Для станции ESP, эта reason сообщается в случае: она принята от AP.
+	// Для ESP AP, эта reason сообщается в случае: AP обработано неправильный WPA или RSN IE.
+	reason_entry(IE_INVALID, CONFIG, NOT_CONNECT),	/* 13 */
+
+	// Ошибка кода целостности сообщения (MIC).
+	// Для станции ESP эта reason сообщается, в случае: она принята от AP.
+	reason_entry(MIC_FAILURE, CREDENTIAL, PASSWORD),	/* 14 */
+
+	// Таймаут процесса four-way handshake.
+	// По соображениям совместимости в ESP код reason заменен на WIFI_REASON_HANDSHAKE_TIMEOUT.
+	// Для станции ESP эта reason сообщается в случае:
+	//  - таймаут handshake.
+	//  - она принята от AP.
+	reason_entry(4WAY_HANDSHAKE_TIMEOUT, CREDENTIAL, PASSWORD),	/* 15 */
+
+	// Таймаут Group-Key Handshake.
+	// Для станции ESP эта reason сообщается в случае: она принята от AP.
+	reason_entry(GROUP_KEY_UPDATE_TIMEOUT, TRANSIENT, NOT_CONNECT),	/* 16 */
+
+	// Элемент в four-way handshake отличается от кадра (Re-)Association Request/Probe и Response/Beacon frame.
+	// Для станции ESP эта reason сообщается в случае:
+	//  - она принята от AP.
+	//  - станция обнаружила, что four-way handshake IE отличается от IE в кадре (Re-)Association Request/Probe и Response/Beacon.
+	reason_entry(IE_IN_4WAY_DIFFERS, CONFIG, PASSWORD),	/* 17 */
+
+	// Invalid group cipher.
+	// Для станции ESP эта reason сообщается в случае: она принята от AP.
+	reason_entry(GROUP_CIPHER_INVALID, CONFIG, CONN),	/* 18 */
+
+	// Недопустимый pairwise cipher.
+	// Для станции ESP эта reason сообщается в случае: она принята от AP.
+	reason_entry(PAIRWISE_CIPHER_INVALID, CONFIG, CONN),	/* 19 */
+
+	// Недопустимый AKMP.
+	// Для станции ESP эта reason сообщается в случае: - она принята от AP.
+	reason_entry(AKMP_INVALID, CONFIG, CONN),	/* 20 */
+
+	// Не поддерживаемая версия RSNE.
+	// Для станции ESP эта reason сообщается в случае: она принята от AP.
+	reason_entry(UNSUPP_RSN_IE_VERSION, CONFIG, CONN),	/* 21 */
 
-    // Не поддерживаемая версия RSNE.
-    // Для станции ESP эта reason сообщается в случае: она принята от AP.
-    case_reason(UNSUPP_RSN_IE_VERSION); /* 21 (21) */
+	// Недопустимые возможности RSNE.
+	// Для станции ESP эта reason сообщается в случае: она принята от AP.
+	reason_entry(INVALID_RSN_IE_CAP, CONFIG, CONN),	/* 22 */
 
-    // Недопустимые возможности RSNE.
-    // Для станции ESP эта reason сообщается в случае: она принята от AP.
-    case_reason(INVALID_RSN_IE_CAP); /* 22 (22) */
+	// Ошибка аутентификации IEEE 802.1X.
+	// Для станции ESP эта reason сообщается в случае: она принята от AP.
+	// Для ESP AP эта reason сообщается в случае: ошибка аутентификации IEEE 802.1X.
+	reason_entry(802_1X_AUTH_FAILED, CREDENTIAL, PASSWORD),	/* 23 */
 
-    // Ошибка аутентификации IEEE 802.1X.
-    // Для станции ESP эта reason сообщается в случае: она принята от AP.
-    // Для ESP AP эта reason сообщается в случае: ошибка аутентификации IEEE 802.1X.
-    case_reason(802_1X_AUTH_FAILED); /* 23 (23) */
+	// Подсистема шифра отклонена политиками безопасности.
+	// Для станции ESP эта reason сообщается в случае: она принята от AP.
+	reason_entry(CIPHER_SUITE_REJECTED, CONFIG, CONN),	/* 24 */
 
-    // Подсистема шифра отклонена политиками безопасности.
-    // Для станции ESP эта reason сообщается в случае: она принята от AP.
-    case_reason(CIPHER_SUITE_REJECTED); /* 24 (24) */
+	// Разрушение TDLS direct-link из-за того, что недоступен TDLS peer STA через прямое соединение TDLS.
+	reason_entry(TDLS_PEER_UNREACHABLE, TRANSIENT, NOT_CONNECT),	/* 25 */
 
-    // Разрушение TDLS direct-link из-за того, что недоступен TDLS peer STA через прямое соединение TDLS.
-    case_reason(TDLS_PEER_UNREACHABLE); /* 25 (25) */
+	// Разрушение TDLS direct-link по неуказанной причине.
+	reason_entry(TDLS_UNSPECIFIED, TRANSIENT, NOT_CONNECT),	/* 26 */
 
-    // Разрушение TDLS direct-link по неуказанной причине.
-    case_reason(TDLS_UNSPECIFIED); /* 26 (26) */
+	// Отключено, потому что сессия прервана запросом SSP.
+	reason_entry(SSP_REQUESTED_DISASSOC, CONFIG, NOT_CONNECT),	/* 27 */
 
-    // Отключено, потому что сессия прервана запросом SSP.
-    case_reason(SSP_REQUESTED_DISASSOC); /* 27 (27) */
+	// Отключено из-за отсутствия соглашения SSP roaming.
+	reason_entry(NO_SSP_ROAMING_AGREEMENT, CONFIG, NOT_CONNECT),	/* 28 */
 
-    // Отключено из-за отсутствия соглашения SSP roaming.
-    case_reason(NO_SSP_ROAMING_AGREEMENT); /* 28 (28) */
+	// Запрошенная служба отклонена из-за требований подсистемы чипера SSP или AKM requirement.
+	reason_entry(BAD_CIPHER_OR_AKM, CONFIG, NOT_CONNECT),	/* 29 */
 
-    // Запрошенная служба отклонена из-за требований подсистемы чипера SSP или AKM requirement.
-    case_reason(BAD_CIPHER_OR_AKM); /* 29 (29) */
+	// Запрошенная служба не авторизована в этом месте.
+	reason_entry(NOT_AUTHORIZED_THIS_LOCATION, CONFIG, NOT_CONNECT),	/* 30 */
 
-    // Запрошенная служба не авторизована в этом месте.
-    case_reason(NOT_AUTHORIZED_THIS_LOCATION); /* 30 (30) */
+	// TS удалено, потому что у QoS AP отсутствует достаточная полоса для этой QoS STA из-за изменений характеристик
+	//	службы BSS или рабочего режима (например HT BSS поменялось от канала 40 МГц на канал 20 МГц).
+	reason_entry(SERVICE_CHANGE_PERCLUDES_TS, CAPACITY, NOT_CONNECT),	/* 31 */
 
-    // TS удалено, потому что у QoS AP отсутствует достаточная полоса для этой QoS STA из-за изменений характеристик
-    //	службы BSS или рабочего режима (например HT BSS поменялось от канала 40 МГц на канал 20 МГц).
-    case_reason(SERVICE_CHANGE_PERCLUDES_TS); /* 31 (31) */
+	// Отключение по не указанной, связанной с QoS причиной.
+	reason_entry(UNSPECIFIED_QOS, TRANSIENT, NOT_CONNECT),	/* 32 */
 
-    // Отключение по не указанной, связанной с QoS причиной.
-    case_reason(UNSPECIFIED_QOS); /* 32 (32) */
+	// Отключено, потому что у QoS AP отсутствует достаточная полоса для этого QoS STA.
+	reason_entry(NOT_ENOUGH_BANDWIDTH, CAPACITY, NOT_CONNECT),	/* 33 */
 
-    // Отключено, потому что у QoS AP отсутствует достаточная полоса для этого QoS STA.
-    case_reason(NOT_ENOUGH_BANDWIDTH); /* 33 (33) */
+	// Отключено, потому что должно быть подтверждено слишком большое количество кадров, они не подтверждены
+	//	из-за передач AP и/или плохих условий канала.
+	reason_entry(MISSING_ACKS, TRANSIENT, NOT_CONNECT),	/* 34 */
 
-    // Отключено, потому что должно быть подтверждено слишком большое количество кадров, они не подтверждены
-    //	из-за передач AP и/или плохих условий канала.
-    case_reason(MISSING_ACKS); /* 34 (34) */
+	// Отключено, потому что STA передает вне предела её TXOP.
+	reason_entry(EXCEEDED_TXOP, TRANSIENT, NOT_CONNECT),	/* 35 */
 
-    // Отключено, потому что STA передает вне предела её TXOP.
-    case_reason(EXCEEDED_TXOP); /* 35 (35) */
+	// Запрашивающая STA покинула BSS (или сброшена).
+	reason_entry(STA_LEAVING, TRANSIENT, NOT_CONNECT),	/* 36 */
 
-    // Запрашивающая STA покинула BSS (или сброшена).
-    case_reason(STA_LEAVING); /* 36 (36) */
+	// Запрашивающая STA не использует больше поток или сессию.
+	reason_entry(END_BA, TRANSIENT, NOT_CONNECT),	/* 37 */
 
-    // Запрашивающая STA не использует больше поток или сессию.
-    case_reason(END_BA); /* 37 (37) */
+	// Запрашивающая STA приняла кадры с использованием механизма, для которого не была завершена настройка.
+	reason_entry(UNKNOWN_BA, TRANSIENT, NOT_CONNECT),	/* 38 */
 
-    // Запрашивающая STA приняла кадры с использованием механизма, для которого не была завершена настройка.
-    case_reason(UNKNOWN_BA); /* 38 (38) */
+	// Таймаут запроса пира STA.
+	reason_entry(TIMEOUT, TRANSIENT, NOT_CONNECT),	/* 39 */
 
-    // Таймаут запроса пира STA.
-    case_reason(TIMEOUT); /* 39 (39) */
+	reserved_entry(40), reserved_entry(41), reserved_entry(42), reserved_entry(43), reserved_entry(44), reserved_entry(45),
 
-    //    Reserved		40..45	40..45	----
+	// В отключенном кадре: отключено, потому что достигнут предел авторизованного доступа.
+	reason_entry(PEER_INITIATED, TRANSIENT, NOT_CONNECT),	/* 46 */
 
-    // В отключенном кадре: отключено, потому что достигнут предел авторизованного доступа.
-    case_reason(PEER_INITIATED); /* 46 (46) */
+	// В отключенном кадре: отключена из-за требований внешней службы.
+	reason_entry(AP_INITIATED, TRANSIENT, NOT_CONNECT),	/* 47 */
 
-    // В отключенном кадре: отключена из-за требований внешней службы.
-    case_reason(AP_INITIATED); /* 47 (47) */
+	// Недопустимый счетчик кадров FT Action.
+	reason_entry(INVALID_FT_ACTION_FRAME_COUNT, CONFIG, NOT_CONNECT),	/* 48 */
 
-    // Недопустимый счетчик кадров FT Action.
-    case_reason(INVALID_FT_ACTION_FRAME_COUNT); /* 48 (48) */
+	// Недопустимый идентификатор парного мастер-ключа (PMKID).
+	reason_entry(INVALID_PMKID, TRANSIENT, NOT_CONNECT),	/* 49 */
 
-    // Недопустимый идентификатор парного мастер-ключа (PMKID).
-    case_reason(INVALID_PMKID); /* 49 (49) */
+	// Недопустимый MDE.
+	reason_entry(INVALID_MDE, CONFIG, NOT_CONNECT),	/* 50 */
 
-    // Недопустимый MDE.
-    case_reason(INVALID_MDE); /* 50 (50) */
+	// Недопустимый FTE.
+	reason_entry(INVALID_FTE, CONFIG, NOT_CONNECT),	/* 51 */
 
-    // Недопустимый FTE.
-    case_reason(INVALID_FTE); /* 51 (51) */
+	reserved_entry(52), reserved_entry(53), reserved_entry(54), reserved_entry(55), reserved_entry(56), reserved_entry(57), reserved_entry(58),
+	reserved_entry(59), reserved_entry(60), reserved_entry(61), reserved_entry(62), reserved_entry(63), reserved_entry(64), reserved_entry(65),
+	reserved_entry(66),
 
-    // Неудача установки линка передачи на альтернативном канале.
-    case_reason(TRANSMISSION_LINK_ESTABLISH_FAILED); /* 67 (67) */
+	// Неудача установки линка передачи на альтернативном канале.
+	reason_entry(TRANSMISSION_LINK_ESTABLISH_FAILED, TRANSIENT, NOT_CONNECT),	/* 67 */
 
-    // Альтернативный канал занят.
-    case_reason(ALTERATIVE_CHANNEL_OCCUPIED); /* 68 (68) */
+	// Альтернативный канал занят.
+	reason_entry(ALTERATIVE_CHANNEL_OCCUPIED, TRANSIENT, NOT_CONNECT),	/* 68 */
 
-    // Код reason Wi-Fi, специфичный для Espressif: когда станция потеряла N непрерывных beacon-ов,
-    // она разрушает соединение и сообщает эту reason.
-    case_reason(BEACON_TIMEOUT); /* 200 (reserved) */
+	// Код reason Wi-Fi, специфичный для Espressif: когда станция потеряла N непрерывных beacon-ов,
+	// она разрушает соединение и сообщает эту reason.
+	reason_entry(BEACON_TIMEOUT, TRANSIENT, SSID),	/* 200 */
 
-    // Код reason Wi-Fi, специфичный для Espressif: когда станция не смогла просканировать целевую AP.
-    case_reason(NO_AP_FOUND); /* 201 (reserved) */
+	// Код reason Wi-Fi, специфичный для Espressif: когда станция не смогла просканировать целевую AP.
+	reason_entry(NO_AP_FOUND, ABSENT, SSID),	/* 201 */
 
-    // Код reason Wi-Fi, специфичный для Espressif: неудачная аутентификация, но не из-за таймаута.
-    case_reason(AUTH_FAIL); /* 202 (reserved) */
+	// Код reason Wi-Fi, специфичный для Espressif: неудачная аутентификация, но не из-за таймаута.
+	reason_entry(AUTH_FAIL, CREDENTIAL, PASSWORD),	/* 202 */
 
-    // Код reason Wi-Fi, специфичный для Espressif: ассоциация была неудачной, но не по причине ASSOC_EXPIRE или ASSOC_TOOMANY.
-    case_reason(ASSOC_FAIL); /* 203 (reserved) */
+	// Код reason Wi-Fi, специфичный для Espressif: ассоциация была неудачной, но не по причине ASSOC_EXPIRE или ASSOC_TOOMANY.
+	reason_entry(ASSOC_FAIL, TRANSIENT, CONN),	/* 203 */
 
-    // Код reason Wi-Fi, специфичный для Espressif: неудача handshake для той же reason, как в случае WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT.
-    case_reason(HANDSHAKE_TIMEOUT); /* 204 (reserved) */
+	// Код reason Wi-Fi, специфичный для Espressif: неудача handshake для той же reason, как в случае WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT.
+	reason_entry(HANDSHAKE_TIMEOUT, CREDENTIAL, PASSWORD),	/* 204 */
 
-    // Код reason Wi-Fi, специфичный для Espressif: неудачное соединение с AP.
-    case_reason(CONNECTION_FAIL); /* 205 (reserved) */
+	// Код reason Wi-Fi, специфичный для Espressif: неудачное соединение с AP.
+	reason_entry(CONNECTION_FAIL, TRANSIENT, CONN),	/* 205 */
 
-    // Код reason Wi-Fi, специфичный для Espressif: ???
-    case_reason(AP_TSF_RESET); /* 206 */;
-    // Код reason Wi-Fi, специфичный для Espressif: ???
-    case_reason(ROAMING); /* 207 */;
-    // Код reason Wi-Fi, специфичный для Espressif: ???
-    case_reason(ASSOC_COMEBACK_TIME_TOO_LONG); /* 208 */
-    // Код reason Wi-Fi, специфичный для Espressif: ???
-    case_reason(SA_QUERY_TIMEOUT); /* 209 */
+	// Код reason Wi-Fi, специфичный для Espressif: ???
+	reason_entry(AP_TSF_RESET, TRANSIENT, NOT_CONNECT),	/* 206 */
+
+	// Код reason Wi-Fi, специфичный для Espressif: ???
+	reason_entry(ROAMING, TRANSIENT, NOT_CONNECT),	/* 207 */
+
+	// Код reason Wi-Fi, специфичный для Espressif: ???
+	reason_entry(ASSOC_COMEBACK_TIME_TOO_LONG, CAPACITY, NOT_CONNECT),	/* 208 */
+
+	// Код reason Wi-Fi, специфичный для Espressif: ???
+	reason_entry(SA_QUERY_TIMEOUT, TRANSIENT, NOT_CONNECT),	/* 209 */
+
+	reserved_entry(210)
+    }; /* reasons[] */
+
+    constexpr reason_info_t unknown_reason = reserved_entry(0);
+
+#undef reason_entry
+#undef reserved_entry
+
+    constexpr unsigned table_size = sizeof(reasons) / sizeof(reasons[0]);
+
+    ///@brief the entry of the reason-code, O(1)
+    constexpr const reason_info_t& reason_info(unsigned code)
+    {
+	return esp::wifi::err::index(code) < table_size? reasons[esp::wifi::err::index(code)]: unknown_reason;
+    }; /* reason_info() */
+
+    /// the each code is at the own place of the table
+    constexpr bool reasons_dense()
+    {
+	for (unsigned i = 0; i < table_size; i++)
+	    if (reasons[i].code != esp::wifi::err::code(i) || esp::wifi::err::index(reasons[i].code) != i)
+		return false;
+	return true;
+    }; /* reasons_dense() */
+
+    static_assert(reasons_dense(), "the reason-codes table is not dense");
+    static_assert(table_size == esp::wifi::err::codes, "the reason-codes table is not 1..68 & 200..210");
+    static_assert(reason_info(WIFI_REASON_NO_AP_FOUND).status == ESP_ERR_WIFI_SSID
+		  && reason_info(WIFI_REASON_AUTH_FAIL).kind == esp::wifi::err::CREDENTIAL
+		  && reason_info(100).kind == esp::wifi::err::UNKNOWN, "the reason-codes table lookup");
+
+}; /* namespace <anonymous> */
 
-    default:
-	return "Unknown_code";
 
-    }; /* switch reason */
-    return "";
+///@brief  reason-codes, defined in ESP-IDF SDK
+///@detail Decoding the WiFi error reason enum, return text message describe of it,
+///        C++ implementation of this function
+///@param [in] reason reason of the WiFi error
+///@return ASCIIZ C-string with text name of error reason
+const char* esp::wifi::err::reason(wifi_err_reason_t areason) {
+    return reason_info(areason).name;
 }; /* esp::wifi::err::reason() */
 
 ///@brief  reason-codes, defined in ESP-IDF SDK with uint8_t argument
 ///@param [in] reason reason of the WiFi error
 ///@return ASCIIZ C-string with text name of error reason
 const char* esp::wifi::err::reason(uint8_t areason) {
-    return reason(static_cast<wifi_err_reason_t>(areason));
+    return reason_info(areason).name;
 }; /* esp::wifi::err::reason(uint8_t) */
 
 
+///@brief  error status of the failed connection according the reason of the WiFi disconnection
+///@param [in] areason   reason of the WIFI_EVENT_STA_DISCONNECTED
+///@return ESP_ERR_WIFI_SSID	 - the AP is not found
+///	ESP_ERR_WIFI_PASSWORD	 - authentication or 4-way handshake is failed, wrong password
+///	ESP_ERR_WIFI_CONN	 - association is rejected or broken by the AP
+///	ESP_ERR_WIFI_NOT_CONNECT - any other reason
+esp_err_t esp::wifi::err::status(wifi_err_reason_t areason) {
+    return reason_info(areason).status;
+}; /* esp::wifi::err::status() */
+
+///@brief  error status of the failed connection with uint8_t argument
+esp_err_t esp::wifi::err::status(uint8_t areason) {
+    return reason_info(areason).status;
+}; /* esp::wifi::err::status(uint8_t) */
+
+///@brief  class of the disconnection reason
+esp::wifi::err::kind_t esp::wifi::err::kind(uint8_t areason) {
+    return reason_info(areason).kind;
+}; /* esp::wifi::err::kind() */
+
+
 
 
 
 //--[ class net::wifi::sta::netif_t::Updater ]-----------------------------------------------------
 
+/// guard of the rings of the phase spans: the spans are recorded by the updating task
+/// and are read by any other one
+static std::mutex spans_lock;
+/// sorting scratch of the Updater::summary(), under the 'spans_lock': not on the stack of the caller
+static uint32_t span_durations[CONFIG_WIFI_UPDATER_SPANS];
+/// guard of the lazy setup of the asynchronous update: the apply() is called by any task
+static std::mutex async_lock;
+static_assert(esp::net::wifi::Updater::PHASES <= 16, "the mask of the open spans is uint16_t");
+
 
 /// @brief Constructor for the class net::wifi::sta::netif_t::Updater
 //net::wifi::sta::netif_t::Updater::Updater(netif_t *netif):
 esp::net::wifi::Updater::Updater(esp::wifi::netif_t *netif):
 	its_netif(*netif)
 {
-    ESP_LOGW(__FUNCTION__, "    ####  Entering ti the Updater construction  ####");
+    NET_LOGW(__FUNCTION__, "    ####  Entering ti the Updater construction  ####");
 
 }; /* esp::net::wifi::Updater::Updater() */
 
+/// @brief Destructor: release the handlers & the timer of the asynchronous update
+esp::net::wifi::Updater::~Updater()
+{
+    if (wifi_evt)
+	evloop::unlisten(WIFI_EVENT, ESP_EVENT_ANY_ID, wifi_evt);
+    if (ip_evt)
+	evloop::unlisten(IP_EVENT, IP_EVENT_STA_GOT_IP, ip_evt);
+    if (own_evt)
+	evloop::unlisten(WIFI_UPDATER_EVENT, ESP_EVENT_ANY_ID, own_evt);
+    if (timer)
+    {
+	esp_timer_stop(timer);
+	esp_timer_delete(timer);
+    }; /* if timer */
+}; /* esp::net::wifi::Updater::~Updater() */
+
+
+/// @brief subscribe to the connection & the address events of the persistent dispatcher, once:
+///	   the handlers are registered on the first update, not on the every one
+esp_err_t esp::net::wifi::Updater::listen()
+{
+    if (linking && addressing)
+	return ESP_OK;
+    if ((err = events.enroll()) != ESP_OK)
+    {
+	NET_LOGE(__FUNCTION__, "Fail register the event dispatcher with error code %i", err);
+	return err;
+    }; /* if events.enroll() != ESP_OK */
+    if (!linking)
+	linking = events.subscribe(WIFI_EVENT, 1u << WIFI_EVENT_STA_CONNECTED | 1u << WIFI_EVENT_STA_DISCONNECTED);
+    if (!addressing)
+	addressing = events.subscribe(IP_EVENT, 1u << IP_EVENT_STA_GOT_IP);
+    return (err = linking && addressing? ESP_OK: ESP_ERR_NO_MEM);
+}; /* esp::net::wifi::Updater::listen() */
+
 
 /** @brief Preliliminary Set status of request to the dhcp-client - request start/stop after the connection
  *  @param[in]   dhcp_st  - needed DHCP client run status
@@ -732,15 +1000,15 @@ esp::net::wifi::Updater::Updater(esp::wifi::netif_t *netif):
 //esp_err_t net::wifi::sta::netif_t::Updater::dhcp(bool dhcp_st)
 esp_err_t esp::net::wifi::Updater::dhcp_adv(bool dhcp_st)
 {
-    ESP_LOGI("NAMI Demo", "Preliminary request to Updating DHCP state...");
+    NET_LOGI("NAMI Demo", "Preliminary request to Updating DHCP state...");
 
     its_netif.dhcp.client.ackuire(dhcp_st);	//< set flag deferred DHCP client start/stop accoding the dhcp_st value
 
     if (dhcp_st)
-	ESP_LOGI("NAMI Tester Demo", "DHCP Enabled, obtain the network ip-parameters from DHCP-server");
+	NET_LOGI("NAMI Tester Demo", "DHCP Enabled, obtain the network ip-parameters from DHCP-server");
 
     if (!dhcp_st)
-	ESP_LOGI("NAMI Tester Demo", "DHCP Disabled, direct setup network ip-configuration");
+	NET_LOGI("NAMI Tester Demo", "DHCP Disabled, direct setup network ip-configuration");
 
     return (err = ESP_OK);
 }; /* esp::net::wifi::Updater::dhcp() */
@@ -751,72 +1019,74 @@ esp_err_t esp::net::wifi::Updater::dhcp_adv(bool dhcp_st)
 esp_err_t esp::net::wifi::Updater::dhcp_do()
 {
 
-    ESP_LOGI("NAMI Demo", "====== Update DHCP requested state...");
+    NET_LOGI("NAMI Demo", "====== Update DHCP requested state...");
 
     //XXX Remove after needed expired
-    ESP_LOGI(__func__, "Requested dhcp status is .......... : [ %s ]", its_netif.dhcp.client.ackuired()? "Yes": "No");
-    ESP_LOGI(__func__, "Netif DHCP client is started? ..... : [ %s ]", its_netif.dhcp.client.started()? "Yes": "No");
-    ESP_LOGI(__func__, "Netif DHCP client is enabled? ..... : [ %s ]\n", its_netif.dhcp.client.enabled()? "Yes": "No");
+    NET_LOGI(__func__, "Requested dhcp status is .......... : [ %s ]", its_netif.dhcp.client.ackuired()? "Yes": "No");
+    NET_LOGI(__func__, "Netif DHCP client is started? ..... : [ %s ]", its_netif.dhcp.client.started()? "Yes": "No");
+    NET_LOGI(__func__, "Netif DHCP client is enabled? ..... : [ %s ]\n", its_netif.dhcp.client.enabled()? "Yes": "No");
 
     if (its_netif.dhcp.client.ackuired())
     {
-	ESP_LOGI("NAMI Tester Demo", "DHCP Enabled, obtain the network ip-parameters from DHCP-server");
+	NET_LOGI("NAMI Tester Demo", "DHCP Enabled, obtain the network ip-parameters from DHCP-server");
 	if (!its_netif.dhcp.client.started())
-	{	ESP_LOGI("DHCP Client stopped", "Start the DHCP Client");
+	{	NET_LOGI("DHCP Client stopped", "Start the DHCP Client");
 	    err = its_netif.dhcp.client.start();
-	    ESP_LOGI("Starting of the DHCP Client", "*** returned code: %i", err);
+	    NET_LOGI("Starting of the DHCP Client", "*** returned code: %i", err);
 	}; /* if !its_netif.dhcp.client.started() */
     }; /* its_netif.dhcp.client.ackuired() */
 
     if (!its_netif.dhcp.client.ackuired())
     {
-	ESP_LOGI("NAMI Tester Demo", "DHCP Disabled, direct setup network ip-configuration");
+	NET_LOGI("NAMI Tester Demo", "DHCP Disabled, direct setup network ip-configuration");
 	if (its_netif.dhcp.client.started())
-	{	ESP_LOGI("DHCP Client started", "Stop the DHCP Client");
+	{	NET_LOGI("DHCP Client started", "Stop the DHCP Client");
 	    err = its_netif.dhcp.client.stop();
-	    ESP_LOGI("Stopping of the DHCP Client", "*** returned code: %i", err);
+	    NET_LOGI("Stopping of the DHCP Client", "*** returned code: %i", err);
 	}; /* if its_netif.dhcp.client.started() */
     }; /* if !its_netif.dhcp.client.ackuired() */
 
     //XXX Remove after needed expired
-    ESP_LOGI("NAMI Tester Demo", "###### Statuses after actual updating ip configuration ######\n");
+    NET_LOGI("NAMI Tester Demo", "###### Statuses after actual updating ip configuration ######\n");
 
-    ESP_LOGI(__func__, "Requested DHCP status is ......... : [ %s ]", its_netif.dhcp.client.ackuired()? "Yes": "No");
-    ESP_LOGI(__func__, "Netif DHCP client is started? .... : [ %s ]", its_netif.dhcp.client.started()? "Yes": "No");
-    ESP_LOGI(__func__, "Netif DHCP client is enabled? .... : [ %s ]\n", its_netif.dhcp.client.enabled()? "Yes": "No");
+    NET_LOGI(__func__, "Requested DHCP status is ......... : [ %s ]", its_netif.dhcp.client.ackuired()? "Yes": "No");
+    NET_LOGI(__func__, "Netif DHCP client is started? .... : [ %s ]", its_netif.dhcp.client.started()? "Yes": "No");
+    NET_LOGI(__func__, "Netif DHCP client is enabled? .... : [ %s ]\n", its_netif.dhcp.client.enabled()? "Yes": "No");
 
+    if (its_netif.type == WIFI_IF_STA)
+	state::dhcp(its_netif.dhcp.client.status());
     return err;
 }; /* esp::net::wifi::Updater::dhcp_do() */
 
+/// current login (SSID) of the config to the buffer
 static inline
-std::string curr_login(const esp::net::wifi::config_t& cfg/*, esp::wifi::netif_t& netif*/)
+const char* curr_login(const esp::net::wifi::config_t& cfg, char buf[sizeof(wifi_sta_config_t::ssid) + 1])
 {
-    //esp::net::wifi::stack::configuration(netif.type);
-//    netif.type;
     switch (cfg.getype())
     {
     case WIFI_IF_AP:
-	return reinterpret_cast<const char*>(cfg.get().ap.ssid);
+	return strncpy(buf, xssid_cstr(cfg.get().ap.ssid, sizeof(cfg.get().ap.ssid)), sizeof(wifi_sta_config_t::ssid) + 1);
 
     case WIFI_IF_STA:
     default:
-	return reinterpret_cast<const char*>(cfg.get().sta.ssid);
+	return strncpy(buf, xssid_cstr(cfg.get().sta.ssid, sizeof(cfg.get().sta.ssid)), sizeof(wifi_sta_config_t::ssid) + 1);
     }; /* switch cfg.getype() */
 }; /* curr_login() */
 
+/// current password (passphrase or PSK) of the config to the buffer
 static inline
-std::string curr_passwd(const esp::net::wifi::config_t& cfg)
+const char* curr_passwd(const esp::net::wifi::config_t& cfg, char buf[sizeof(wifi_sta_config_t::password) + 1])
 {
     switch (cfg.getype())
     {
     case WIFI_IF_AP:
-	return reinterpret_cast<const char*>(cfg.get().ap.password);
+	return strncpy(buf, xssid_cstr(cfg.get().ap.password, sizeof(cfg.get().ap.password)), sizeof(wifi_sta_config_t::password) + 1);
 
     case WIFI_IF_STA:
     default:
-	return reinterpret_cast<const char*>(cfg.get().sta.password);
+	return strncpy(buf, xssid_cstr(cfg.get().sta.password, sizeof(cfg.get().sta.password)), sizeof(wifi_sta_config_t::password) + 1);
     }; /* switch cfg.getype() */
-}; /* curr_login() */
+}; /* curr_passwd() */
 
 
 /** @brief Save current network configuration for bacup
@@ -827,34 +1097,32 @@ esp_err_t esp::net::wifi::Updater::backup()
 {
     if (wifibkp == nullptr)
     {
-	wifibkp = new ::net::configuration_t(its_netif.dhcp.client.ackuired(), its_netif.cfg.get(),
-		curr_login(stack::configuration(its_netif.type)), curr_passwd(stack::configuration(its_netif.type)));
-	if (wifibkp)
-	    err = ESP_OK;
-	else
-	{
-	    ESP_LOGE(__PRETTY_FUNCTION__, "Insufficient memory for backup network configuration");
-	    err = ESP_ERR_NO_MEM;
-	    return err;
-	}; /* else if wifibackup == nullptr */
+	    config_t curr = stack::configuration(its_netif.type);
+	    char login[sizeof(wifi_sta_config_t::ssid) + 1], passwd[sizeof(wifi_sta_config_t::password) + 1];
+
+	bkpbuf = ::net::configuration_t(its_netif.dhcp.client.ackuired(), its_netif.cfg.get(),
+		curr_login(curr, login), curr_passwd(curr, passwd));
+	bkpbuf.clr_chgst();
+	wifibkp = &bkpbuf;
+	err = ESP_OK;
     }; /* if wifibackup == nullptr */
 
     //XXX: Remove after debug
-    ESP_LOGW(__PRETTY_FUNCTION__, "##### Bacuped WiFi IP cfg is:");
-        ESP_LOGW(__FUNCTION__, "~~~~~~~~~~~");
+    NET_LOGW(__PRETTY_FUNCTION__, "##### Bacuped WiFi IP cfg is:");
+        NET_LOGW(__FUNCTION__, "~~~~~~~~~~~");
 //        ESP_LOGW(__func__, "IP     : " IPSTR, IP2STR(&ipbackup.ip) );
 //        ESP_LOGW(__func__, "IP     : " IPSTR, IP2STR(&(static_cast<const esp_ip4_addr_t&>(wifibkp->ip))) );
-        ESP_LOGW(__func__, "IP      : %s", static_cast<const char*>(wifibkp->ip));
+        NET_LOGW(__func__, "IP      : %s", wifibkp->ip.text().c_str());
 //        ESP_LOGI(__func__, "Mask   : " IPSTR, IP2STR(&ipbackup.netmask));
-        ESP_LOGI(__func__, "Mask    : %s", static_cast<const char*>(wifibkp->mask));
+        NET_LOGI(__func__, "Mask    : %s", wifibkp->mask.text().c_str());
 //        ESP_LOGI(__func__, "Gateway: " IPSTR, IP2STR(&ipbackup.gw));
-        ESP_LOGI(__func__, "Gateway : %s", static_cast<const char*>(wifibkp->gate));
+        NET_LOGI(__func__, "Gateway : %s", wifibkp->gate.text().c_str());
 //        ESP_LOGI(__func__, "DHCP is: %s", ipbackup? "Enabled": "Disabled");
-        ESP_LOGI(__func__, "DHCP is : %s", wifibkp->dhcp? "Enabled": "Disabled");
-        ESP_LOGI(__func__, "Password  %s", wifibkp->passwd? "Used": "Unused");
-        ESP_LOGI(__func__, "Login is: %s", wifibkp->login.c_str());
-        ESP_LOGI(__func__, "Password: %s", wifibkp->passwd.c_str());
-        ESP_LOGW(__FUNCTION__, "~~~~~~~~~~~");
+        NET_LOGI(__func__, "DHCP is : %s", wifibkp->dhcp? "Enabled": "Disabled");
+        NET_LOGI(__func__, "Password  %s", wifibkp->passwd? "Used": "Unused");
+        NET_LOGI(__func__, "Login is: %s", wifibkp->login.c_str());
+        NET_LOGI(__func__, "Password: %s", ::net::configuration_t::pwd_stub);
+        NET_LOGW(__FUNCTION__, "~~~~~~~~~~~");
 
     return ESP_OK;
 }; /* esp::net::wifi::Updater::backup() */
@@ -866,15 +1134,14 @@ esp_err_t esp::net::wifi::Updater::backup()
  *	ESP_ERR_NO_MEM	  - backup buffer is absent, it's not found */
 esp_err_t esp::net::wifi::Updater::revert()
 {
-    ESP_LOGW(__PRETTY_FUNCTION__, "###-- Error updating new network parameters, restore it's from backup --###");
+    NET_LOGW(__PRETTY_FUNCTION__, "###-- Error updating new network parameters, restore it's from backup --###");
     return invoke(*wifibkp, true);
 }; /* esp::net::wifi::Updater::revert() */
 
 /** @brief Finalize updating procedure - clearing the backup buffer */
 void esp::net::wifi::Updater::finalize()
 {
-    ESP_LOGI(__PRETTY_FUNCTION__, "##### Clear the Backup buffer #####");
-    delete wifibkp;
+    NET_LOGI(__PRETTY_FUNCTION__, "##### Clear the Backup buffer #####");
     wifibkp = nullptr;
 }; /* esp::net::wifi::Updater::finalize() */
 
@@ -895,7 +1162,7 @@ esp_err_t esp::net::wifi::Updater::ip(const ::net::configuration_t& cfg)
  *  @return ESP_OK        - success updating configuration */
 esp_err_t esp::net::wifi::Updater::ip(const esp::ip4::info& info)
 {
-    ESP_LOGI("NAMI Demo", "Update IP configuration...");
+    NET_LOGI("NAMI Demo", "Update IP configuration...");
 
     if (!its_netif.dhcp.client.ackuired())
 	its_netif.set_ip(info);
@@ -908,35 +1175,68 @@ esp_err_t esp::net::wifi::Updater::ip(const esp::ip4::info& info)
 /** @brief Apply the login cfg: wifi cfg - ssid, password - to the netif
  *  @param[in]   cfg      - new parameters network configuration buffer
  *  @return ESP_OK        - success updating configuration */
-esp_err_t esp::net::wifi::Updater::login(const ::net::configuration_t& cfg)
+esp_err_t esp::net::wifi::Updater::login(const ::net::configuration_t& cfg, bool derive)
 {
-	ESP_LOGW(__FUNCTION__, "##### WiFi Login Updater with (const net::configuration& cfg) parameter #####");
-    return login(config_t(its_netif.type, cfg));
+	NET_LOGW(__FUNCTION__, "##### WiFi Login Updater with (const net::configuration& cfg) parameter #####");
+    return login(config_t(its_netif.type, cfg), derive);
 }; /* esp::net::wifi::Updater::login(const net::configuration&) */
 
 
 /** @brief Apply the login cfg: wifi cfg - ssid, password - to the netif
  *  @param[in]   cfg      - new parameters network configuration buffer
  *  @return ESP_OK        - success updating configuration */
-esp_err_t esp::net::wifi::Updater::login(const esp::net::wifi::config_t& cfg)
+esp_err_t esp::net::wifi::Updater::login(const esp::net::wifi::config_t& cfg, bool derive)
 {
-	ESP_LOGW(__FUNCTION__, "##### WiFi Login Updater with (const esp::net::wifi::config_t& cfg) parameter #####");
+	NET_LOGW(__FUNCTION__, "##### WiFi Login Updater with (const esp::net::wifi::config_t& cfg) parameter #####");
 
 	esp::net::wifi::config_t conf;
 
     conf = stack::configuration(its_netif.type);
+    /// the caller's target, not the pin of the previous login()
+    if (held)
+	conf.target(own);
+    own = conf.target();
     /// set ssid & passd
-    conf.ssid(cfg.ssid());
-    conf.passwd(cfg.passwd());
+    conf.ssid(cfg.ssid_cstr());
+    conf.passwd(cfg.passwd_cstr());
+    /// the cached PSK instead of the passphrase - skip PBKDF2 in the supplicant, but not the SAE
+    if (conf.psk(derive) == ESP_OK)
+	NET_LOGI(__func__, "The passphrase is replaced by the cached PSK");
 
     /// set failure retry counter to
     uint8_t tmp = conf.retry(CONFIG_WIFI_STA_MAXIMUM_RETRY);
-    ESP_LOGW(__func__, "======= New value of data.sta.failure_retry_cnt is %u, prev value is %u, real current value is %u", CONFIG_WIFI_STA_MAXIMUM_RETRY, tmp, conf.retry());
+    NET_LOGW(__func__, "======= New value of data.sta.failure_retry_cnt is %u, prev value is %u, real current value is %u", CONFIG_WIFI_STA_MAXIMUM_RETRY, tmp, conf.retry());
 
-    ESP_LOGW(__PRETTY_FUNCTION__, "====>> New  SSID  for connecting to AP is: %s", conf.ssid_cstr());
-    ESP_LOGW(__PRETTY_FUNCTION__, "====>> New Passwd for connecting to AP is: %s", conf.passwd_cstr());
+    NET_LOGW(__PRETTY_FUNCTION__, "====>> New  SSID  for connecting to AP is: %s", conf.ssid_cstr());
+    NET_LOGW(__PRETTY_FUNCTION__, "====>> New Passwd for connecting to AP is: %s", ::net::configuration_t::pwd_stub);
 
-    /*esp::net::wifi::*/stack::configure(conf);
+	known_ap::entry_t ap = {};
+
+    /// the known AP - connect to it's BSSID on it's channel, skip the full scan
+    known_ap::enroll();
+    pinned = known_ap::find(conf.ssid_cstr(), ap);
+    held = false;
+    if (!pinned)
+	/*esp::net::wifi::*/stack::configure(conf);
+    else
+    {
+	NET_LOGI(__func__, "Known AP on the channel %u, the full scan is skipped", ap.channel);
+	if (!deferred)
+	{   // the flash gets the caller's target, the pin is set in the RAM only
+	    stack::configure(conf);
+	    storage::set(WIFI_STORAGE_RAM);
+	}; /* if !deferred */
+	conf.pin(ap.bssid, ap.channel);
+	stack::configure(conf);
+	if (!deferred)
+	    storage::set(WIFI_STORAGE_FLASH);
+	held = true;
+    }; /* else pinned */
+    /// the address, obtained on the network last time, is requested by the INIT-REBOOT; not the other one's
+    if (its_netif.type == WIFI_IF_STA && its_netif.dhcp.client.ackuired())
+	its_netif.dhcp.client.restore(pinned? ap.ip: 0);
+    if (deferred)
+	pending++;	// set in the RAM only, the flash is written on the commit()
 
     return (err = ESP_OK);
 }; /* esp::net::wifi::Updater::login() */
@@ -944,48 +1244,73 @@ esp_err_t esp::net::wifi::Updater::login(const esp::net::wifi::config_t& cfg)
 
 
 
-/** @brief simply execute connection to the selected WiFi AP
+/// @brief the connection result from the queue of the persistent subscription: WIFI_EVENT_STA_CONNECTED
+///	   or WIFI_EVENT_STA_DISCONNECTED with the reason, whichever comes first, up to the timeout
+/// @return ESP_OK - connected, ESP_ERR_WIFI_TIMEOUT - no events,
+///	    other - esp::wifi::err::status() of the disconnection reason
+static esp_err_t connection_result(esp::net::wifi::dispatcher::queue_t& queue, TickType_t ticks)
+{
+	esp::net::wifi::dispatcher::event_t ev;
+	TickType_t start = xTaskGetTickCount();
+
+    while (esp::net::wifi::dispatcher::wait(queue, ev, ticks - std::min<TickType_t>(xTaskGetTickCount() - start, ticks)))
+    {
+	if (ev.id == WIFI_EVENT_STA_CONNECTED)
+	    return ESP_OK;
+	// the disconnection from the previous AP by the Updater itself, not the result of the connection
+	if (ev.reason == WIFI_REASON_ASSOC_LEAVE)
+	    continue;
+	NET_LOGW("connection_result", "WiFi station disconnected, reason: %s (%u)", esp::wifi::err::reason(ev.reason), ev.reason);
+	return esp::wifi::err::status(ev.reason);
+    }; /* while dispatcher::wait() */
+    return ESP_ERR_WIFI_TIMEOUT;
+}; /* connection_result() */
+
+
+/** @brief simply execute connection to the selected WiFi AP;
+ *	    wait the WIFI_EVENT_STA_CONNECTED or the WIFI_EVENT_STA_DISCONNECTED, whichever comes first
  *  @param[in]   cfg      - new network configuration buffer
  *  @return               - passed the 'err' value */
 esp_err_t esp::net::wifi::Updater::connect(const ::net::configuration_t& cfg)
 {
 
-	static event::sync::stat reconnect(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED);
-	event::ctrl<reconnect>::automatic autorecon;
-
-    ESP_LOGW(__FUNCTION__, ">> wifi disconnect ");
-    /// wifi disconnect
-    esp::net::wifi::stack::disconnect();
+    if (listen() != ESP_OK)
+	return err;
 
-    ESP_LOGW(__FUNCTION__, ">> update wifi login configuration ");
-    login(cfg);
-    ESP_LOGW(__func__, "==>>> sta::cfg::login::update() return the %d error code", err);
+    do {
+	NET_LOGW(__FUNCTION__, ">> wifi disconnect ");
+	/// wifi disconnect
+	begin(PH_DISCONNECT);
+	esp::net::wifi::stack::disconnect();
+	end(PH_DISCONNECT);
 
-    //ESP_ERROR_CHECK(event::ctrl<reconnect>::enroll());
-    ESP_ERROR_CHECK(autorecon.enroll());
+	NET_LOGW(__FUNCTION__, ">> update wifi login configuration ");
+	begin(PH_LOGIN);
+	login(cfg);
+	end(PH_LOGIN);
+	NET_LOGW(__func__, "==>>> sta::cfg::login::update() return the %d error code", err);
 
-    ESP_LOGW(__FUNCTION__, ">> connect to the new WiFi AP...");
-    err = stack::connect();
+	dispatcher::drain(*linking);	// the stale results & the disconnection from the previous AP
 
+	NET_LOGW(__FUNCTION__, ">> connect to the new WiFi AP...");
+	begin(PH_CONNECT);
+	err = stack::connect();
 
-    if(reconnect.wait.Take(secticks(CONFIG_WIFI_STA_WAITING_CONNECT)) != pdTRUE)
-    {   // Semaphore broken by timeout expired
+	if (err == ESP_OK)
+	    err = connection_result(*linking, secticks(CONFIG_WIFI_STA_WAITING_CONNECT));
+	end(PH_CONNECT);
+    } while (err != ESP_OK && rescan(err));
+    unpin();
 
-	ESP_LOGW(__FUNCTION__, "Wrong new WiFi SSID or Password.");
-	ESP_LOGW(__FUNCTION__, "Need Rollback to old config.");
-	// Rollback WiFi configuration
-	// Rolback network WiFi ip config
-	// Reconnect
-//	    ESP_LOGW(__func__, "=== UnRegister WiFi connection handler, WiFi Station configuration reverted ===");
-//	    ESP_ERROR_CHECK(reconnect.ctrl.unreg());
-	//ESP_ERROR_CHECK(event::ctrl<reconnect>::unreg());
-	return (err = ESP_ERR_WIFI_PASSWORD);
-    }; /* if xSemaphoreTake( s_semph_wait_wifi_connect, <timeout> ) != pdTRUE */
-    ESP_LOGI("Updating connection", "Wi-Fi Station connected, release waiting WiFi connection semaphore & restart DHCP client, if needed...");
+    if (err != ESP_OK)
+    {   // connection failed or timeout expired
+	NET_LOGW(__FUNCTION__, "Connection to the new WiFi AP failed with error %i", err);
+	NET_LOGW(__FUNCTION__, "Need Rollback to old config.");
+	return err;
+    }; /* if err != ESP_OK */
+    NET_LOGI("Updating connection", "Wi-Fi Station connected, release waiting WiFi connection semaphore & restart DHCP client, if needed...");
 
-    ESP_LOGW(__func__, "=== UnRegister WiFi connection handler, sucсess WiFi connection ===");
-    //ESP_ERROR_CHECK(event::ctrl<reconnect>::unreg());
-    ESP_LOGI(__func__, "Exit from esp::net::wifi::stack::connect() with return code: %i", err);
+    NET_LOGI(__func__, "Exit from esp::net::wifi::stack::connect() with return code: %i", err);
 
     return err;
 }; /* esp::net::wifi::Updater::connect() */
@@ -1002,14 +1327,11 @@ esp_err_t esp::net::wifi::Updater::connect(const ::net::configuration_t& cfg)
  */
 esp_err_t esp::net::wifi::Updater::invoke(::net::configuration_t& cfg, bool forcecon)
 {
-	static event::sync::stat on_got_ip(IP_EVENT, IP_EVENT_STA_GOT_IP);
-	event::ctrl<on_got_ip>::automatic auto_ip;
-
+    NET_LOGW(__PRETTY_FUNCTION__, "> !!! Perform updating WiFi station configuration");
 
-    ESP_LOGW(__PRETTY_FUNCTION__, "> !!! Perform updating WiFi station configuration");
-
-    ESP_LOGI(__FUNCTION__, "Register event handler for: IP_EVENT, IP_EVENT_STA_GOT_IP");
-    ESP_ERROR_CHECK(auto_ip.enroll());
+    if (listen() != ESP_OK)
+	return err;
+    dispatcher::drain(*addressing);	// IP_EVENT_STA_GOT_IP of the previous configuration
 
     dhcp_adv(cfg.dhcp);
 
@@ -1018,38 +1340,47 @@ esp_err_t esp::net::wifi::Updater::invoke(::net::configuration_t& cfg, bool forc
 	connect(cfg);
 	if (err != ESP_OK)
 	{
-	    ESP_LOGE(__FUNCTION__, "New connection failed with error status %i", err);
+	    NET_LOGE(__FUNCTION__, "New connection failed with error status %i", err);
 	    return err;
 	}; /* if err != ESP_OK */
 
     }; /* if forcecon cfg.login_changed() */
 
 
-    ESP_LOGI("NAMI C++ Demo", "###### DHCP Statuses during update procedure ######");
+    NET_LOGI("NAMI C++ Demo", "###### DHCP Statuses during update procedure ######");
 
 
     //XXX Remove after needed expired
-    ESP_LOGI(__func__, "Shadow configuration DHCP status is: [ %s ]", cfg.dhcp? "Yes": "No");
-    ESP_LOGI(__func__, "Netif DHCP client is started? .... : [ %s ]", its_netif.dhcp.client.started()? "Yes": "No");
-    ESP_LOGI(__func__, "Netif DHCP client is enabled? .... : [ %s ]", its_netif.dhcp.client.enabled()? "Yes": "No");
+    NET_LOGI(__func__, "Shadow configuration DHCP status is: [ %s ]", cfg.dhcp? "Yes": "No");
+    NET_LOGI(__func__, "Netif DHCP client is started? .... : [ %s ]", its_netif.dhcp.client.started()? "Yes": "No");
+    NET_LOGI(__func__, "Netif DHCP client is enabled? .... : [ %s ]", its_netif.dhcp.client.enabled()? "Yes": "No");
 
+    begin(PH_DHCP);
     dhcp_do();
+    end(PH_DHCP);
+    begin(PH_IP);
     ip(cfg);
+    end(PH_IP);
+
+    begin(PH_GOT_IP);
+	dispatcher::event_t got_ip;
+	bool addressed = dispatcher::wait(*addressing, got_ip, secticks(CONFIG_WIFI_STA_WAITING_IP));
+    end(PH_GOT_IP);
 
-    if (on_got_ip.wait.Take(secticks(CONFIG_WIFI_STA_WAITING_IP)) != pdTRUE)
+    if (!addressed)
     {   // Semaphore broken by timeout expired
-	ESP_LOGW(__FUNCTION__, "Wrong IP-configuration, but the new WiFi SSID & Password are correct.");
-	ESP_LOGW(__FUNCTION__, "Rollback to old config.");
+	NET_LOGW(__FUNCTION__, "Wrong IP-configuration, but the new WiFi SSID & Password are correct.");
+	NET_LOGW(__FUNCTION__, "Rollback to old config.");
 	// Rollback WiFi configuration
 	// Rolback network WiFi ip config
 	// Reconnect
-	ESP_LOGW(__func__, "=== UnRegister WiFi Station ip given handler, WiFi Station configuration reverted ===");
-
 	return (err = ESP_ERR_WIFI_PASSWORD);
 //	return (err = ESP_ERR_WIFI_IF);
     }; /* if xSemaphoreTake( s_semph_wait_wifi_connect, <timeout> ) != pdTRUE */
 
-    ESP_LOGW(__func__, "=== UnRegister WiFi Station ip given handler, WiFi station ip cfg sucessfully changed ===");
+	esp_ip4_addr_t addr = {got_ip.aux};
+
+    NET_LOGI(__func__, "WiFi station got ip " IPSTR ", ip cfg sucessfully changed", IP2STR(&addr));
     return (err = ESP_OK);
 
 }; /* esp::net::wifi::Updater::invoke() */
@@ -1074,45 +1405,65 @@ esp_err_t esp::net::wifi::Updater::invoke(::net::configuration_t& cfg, bool forc
  */
 esp_err_t esp::net::wifi::Updater::operator()(::net::configuration_t& cfg)
 {
-
-	static event::sync::stat on_got_ip(IP_EVENT, IP_EVENT_STA_GOT_IP);
-	event::ctrl<on_got_ip>::automatic auto_ip;
-
-    ESP_LOGW(__PRETTY_FUNCTION__, "> Setup new WiFi station configuration");
+    NET_LOGW(__PRETTY_FUNCTION__, "> Setup new WiFi station configuration");
 
     err = ESP_OK;
 
     if (!cfg.ip_changed())
     {
-	ESP_LOGW(__func__, "# WiFi station netif configuration was not changed");
+	NET_LOGW(__func__, "# WiFi station netif configuration was not changed");
 	if (!cfg.login_changed())
 	{
-	    ESP_LOGW(__func__, "# WiFi config of station was not changed - nothong to do");
+	    NET_LOGW(__func__, "# WiFi config of station was not changed - nothong to do");
 	    err = ESP_ERR_NOT_FOUND;
 	    return err;
 	}; /* if !cfg.wifi_changed() */
     }; /* if !cfg.netif_changed() */
 
-    ESP_LOGW(__func__, ">> Configuration of WiFi station or it's netif is changed");
+    if (cfg.fingerprint() == applied && cfg.same(lastcfg))
+    {
+	NET_LOGW(__func__, "# WiFi config of station is changed back to the applied one - nothong to do");
+	return (err = ESP_ERR_NOT_FOUND);
+    }; /* if cfg.fingerprint() == applied && cfg.same(lastcfg) */
+
+    NET_LOGW(__func__, ">> Configuration of WiFi station or it's netif is changed");
 
+    begin(PH_APPLY);
+    begin(PH_BACKUP);
     backup();
 
     if (err != ESP_OK)
     {
-	ESP_LOGW(__FUNCTION__, "Fail backup network configuration with error code %i", err);
+	NET_LOGW(__FUNCTION__, "Fail backup network configuration with error code %i", err);
+	close();
 	return err;
     }; /* if backup() != ESP_OK */
 
+    defer();
+    end(PH_BACKUP);
     invoke(cfg);
     if (err != ESP_OK)
     {
 	    esp_err_t savederr = err;
-	ESP_LOGW(__FUNCTION__, "Fail updating network configuration with error code %i, reverted it", err);
+	NET_LOGW(__FUNCTION__, "Fail updating network configuration with error code %i, reverted it", err);
+	begin(PH_REVERT);
+	rollback = true;
 	revert();
-	ESP_LOGW(__FUNCTION__, "Revert network configuration with error code %i", err);
+	rollback = false;
+	end(PH_REVERT);
+	NET_LOGW(__FUNCTION__, "Revert network configuration with error code %i", err);
+	if (err != ESP_OK)
+	    applied = 0;	// the current configuration is unknown
 	err = savederr;
 
-    }; /* if err != ESP_OK */
+    } /* if err != ESP_OK */
+    else
+    {
+	applied = cfg.fingerprint();
+	lastcfg = cfg;
+    }; /* else if err != ESP_OK */
+    commit(err == ESP_OK);
+    end(PH_APPLY);
     /*
     sta::save();
     sta::config.clr_chgst();
@@ -1124,4 +1475,524 @@ esp_err_t esp::net::wifi::Updater::operator()(::net::configuration_t& cfg)
 
 
 
+//--[ asynchronous update ]-------------------------------------------------------------------------------------------
+
+
+/// @brief request of the asynchronous update
+struct esp::net::wifi::Updater::job_t
+{
+    job_t(const ::net::configuration_t& acfg, bool relogin, callback_t cb):
+	cfg(acfg), login(relogin), done(cb), result(ESP_ERR_NOT_FINISHED) {};
+
+    /// set the result, wake the waiters & call the completion callback
+    void finish(esp_err_t res)
+    {
+	result = res;
+	ready.Give();
+	if (done)
+	    done(res);
+    }; /* finish() */
+
+    ::net::configuration_t cfg;	///< copy of the requested configuration
+    bool	login;		///< the WiFi login (ssid/password) is changed, reconnect is needed
+    callback_t	done;		///< completion callback
+    std::atomic<esp_err_t> result;	///< ESP_ERR_NOT_FINISHED while in flight
+    Semaphore	ready;		///< given on the completion
+    bool	connecting = false;	///< waiting WIFI_EVENT_STA_CONNECTED/DISCONNECTED
+    bool	addressing = false;	///< waiting IP_EVENT_STA_GOT_IP
+    bool	got_ip = false;		///< IP_EVENT_STA_GOT_IP is received before the ip stage
+    bool	reverting = false;	///< the request is failed, restore the backup
+    esp_err_t	failure = ESP_OK;	///< error of the failed request, returned after the revert
+}; /* struct esp::net::wifi::Updater::job_t */
+
+
+bool esp::net::wifi::Updater::handle_t::done() const
+{
+    return !job || job->result != ESP_ERR_NOT_FINISHED;
+}; /* esp::net::wifi::Updater::handle_t::done() */
+
+esp_err_t esp::net::wifi::Updater::handle_t::status() const
+{
+    return job? job->result.load(): ESP_ERR_INVALID_STATE;
+}; /* esp::net::wifi::Updater::handle_t::status() */
+
+esp_err_t esp::net::wifi::Updater::handle_t::wait(TickType_t ticks)
+{
+    if (job && job->ready.Take(ticks) == pdTRUE)
+	job->ready.Give();	// for the next waiters
+    return status();
+}; /* esp::net::wifi::Updater::handle_t::wait() */
+
+
+/** @brief Asynchronous update procedure of the WiFi configuration
+ *  @param[in]   cfg      - new network configuration, copied into the request
+ *  @param[in]   done     - completion callback, may be empty
+ *  @return handle of the request for the waiting/polling of it's status */
+esp::net::wifi::Updater::handle_t esp::net::wifi::Updater::apply(::net::configuration_t& cfg, callback_t done)
+{
+	std::shared_ptr<job_t> job = std::make_shared<job_t>(cfg, cfg.login_changed(), done);
+
+    NET_LOGW(__PRETTY_FUNCTION__, "> Request the asynchronous update of WiFi station configuration");
+
+    if (!cfg.ip_changed() && !cfg.login_changed())
+    {
+	NET_LOGW(__func__, "# WiFi config of station was not changed - nothong to do");
+	job->finish(ESP_ERR_NOT_FOUND);
+	return handle_t(job);
+    }; /* if !cfg.ip_changed() && !cfg.login_changed() */
+
+    if (cfg.login_changed())
+    {	// PBKDF2 of the new login here, off the event loop: the login() of the request gets the PSK from the cache
+	    config_t conf = stack::configuration(its_netif.type);
+	    config_t login(its_netif.type, cfg);
+
+	conf.ssid(login.ssid_cstr());
+	conf.passwd(login.passwd_cstr());
+	conf.psk();
+    }; /* if cfg.login_changed() */
+
+	esp_err_t error = ESP_OK;	// the 'err' is of the event loop task, while the request is in flight
+
+    {
+	std::lock_guard<std::mutex> lock(async_lock);
+	if (!timer)
+	{
+		esp_timer_create_args_t args = {};
+		esp_timer_handle_t created = nullptr;
+
+	    args.callback = on_timeout;
+	    args.arg = this;
+	    args.dispatch_method = ESP_TIMER_TASK;
+	    args.name = "wifi_updater";
+	    error = esp_timer_create(&args, &created);
+	    if (error == ESP_OK && !wifi_evt)
+		error = evloop::listen(WIFI_EVENT, ESP_EVENT_ANY_ID, on_event, this, &wifi_evt);
+	    if (error == ESP_OK && !ip_evt)
+		error = evloop::listen(IP_EVENT, IP_EVENT_STA_GOT_IP, on_event, this, &ip_evt);
+	    if (error == ESP_OK && !own_evt)
+		error = evloop::listen(WIFI_UPDATER_EVENT, ESP_EVENT_ANY_ID, on_event, this, &own_evt);
+	    if (error == ESP_OK)
+		timer = created;	// the setup is complete: the next apply() skips it
+	    else if (created)
+		esp_timer_delete(created);
+	}; /* if !timer */
+    }
+    if (error != ESP_OK)
+    {
+	NET_LOGE(__FUNCTION__, "Fail initialize the asynchronous update with error code %i", error);
+	job->finish(error);
+	return handle_t(job);
+    }; /* if error != ESP_OK */
+
+	auto request = new std::shared_ptr<job_t>(job);
+
+    error = evloop::post(WIFI_UPDATER_EVENT, WIFI_UPDATER_EVENT_START, &request, sizeof(request), portMAX_DELAY);
+    if (error != ESP_OK)
+    {
+	delete request;
+	job->finish(error);
+    }; /* if error != ESP_OK */
+    return handle_t(job);
+}; /* esp::net::wifi::Updater::apply() */
+
+
+/// @brief event handler of the asynchronous update state machine
+void esp::net::wifi::Updater::on_event(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+	Updater& self = *static_cast<Updater*>(arg);
+
+    if (base == WIFI_UPDATER_EVENT && id == WIFI_UPDATER_EVENT_START)
+    {
+	    std::shared_ptr<job_t>* request = *static_cast<std::shared_ptr<job_t>**>(data);
+
+	self.start(*request);
+	delete request;
+	return;
+    }; /* if WIFI_UPDATER_EVENT_START */
+
+    if (!self.current)
+	return;
+	job_t& job = *self.current;
+
+    if (base == WIFI_UPDATER_EVENT && id == WIFI_UPDATER_EVENT_TIMEOUT)
+    {
+	// stale timeout of the completed stage: the callback, running while the stage was changed & the timer
+	// was rearmed (esp_timer_stop() doesn't wait for it), posts the new generation with the timer still active
+	if (*static_cast<uint32_t*>(data) != self.stage || esp_timer_is_active(self.timer))
+	    return;
+	NET_LOGW(__FUNCTION__, "Timeout of the %s stage", job.connecting? "connection": "ip");
+	self.fail(job.connecting? ESP_ERR_WIFI_TIMEOUT: ESP_ERR_TIMEOUT);	// the credentials are accepted by the ip stage
+    } /* if WIFI_UPDATER_EVENT_TIMEOUT */
+    else if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP)
+    {
+	if (job.addressing)
+	    self.complete(job.reverting? job.failure: ESP_OK);
+	else
+	    job.got_ip = true;
+    } /* else if IP_EVENT_STA_GOT_IP */
+    else if (base == WIFI_EVENT && job.connecting)
+    {
+	if (id == WIFI_EVENT_STA_CONNECTED)
+	{
+	    job.connecting = false;
+	    self.address();
+	} /* if WIFI_EVENT_STA_CONNECTED */
+	else if (id == WIFI_EVENT_STA_DISCONNECTED)
+	{
+		uint8_t reason = static_cast<wifi_event_sta_disconnected_t*>(data)->reason;
+
+	    // the disconnection from the previous AP by the Updater itself, not the result of the connection
+	    if (reason == WIFI_REASON_ASSOC_LEAVE)
+		return;
+	    NET_LOGW(__FUNCTION__, "WiFi station disconnected, reason: %s (%u)", esp::wifi::err::reason(reason), reason);
+	    self.fail(esp::wifi::err::status(reason));
+	}; /* else if WIFI_EVENT_STA_DISCONNECTED */
+    } /* else if WIFI_EVENT */
+    else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED && job.addressing)
+    {	// the link is lost while the address is waited: no address is coming up to the timeout
+	    uint8_t reason = static_cast<wifi_event_sta_disconnected_t*>(data)->reason;
+
+	NET_LOGW(__FUNCTION__, "WiFi station disconnected in the ip stage, reason: %s (%u)", esp::wifi::err::reason(reason), reason);
+	self.fail(esp::wifi::err::status(reason));
+    }; /* else if WIFI_EVENT_STA_DISCONNECTED */
+}; /* esp::net::wifi::Updater::on_event() */
+
+
+/// @brief stage timeout of the asynchronous update, post it to the event loop with the generation,
+///	   the timer is armed for
+void esp::net::wifi::Updater::on_timeout(void* arg)
+{
+	uint32_t stage = static_cast<Updater*>(arg)->armed.load(std::memory_order_acquire);
+
+    evloop::post(WIFI_UPDATER_EVENT, WIFI_UPDATER_EVENT_TIMEOUT, &stage, sizeof(stage), portMAX_DELAY);
+}; /* esp::net::wifi::Updater::on_timeout() */
+
+
+/// @brief start the new asynchronous request, supersede the current
+void esp::net::wifi::Updater::start(std::shared_ptr<job_t>& job)
+{
+    if (!current && job->cfg.fingerprint() == applied && job->cfg.same(lastcfg))	// with the request in flight it's the return to the applied one
+    {
+	NET_LOGW(__func__, "# WiFi config of station is changed back to the applied one - nothong to do");
+	job->finish(ESP_ERR_NOT_FOUND);
+	return;
+    }; /* if !current && job->cfg.same(lastcfg) */
+    if (current)
+    {
+	NET_LOGW(__FUNCTION__, "# Previous update request is superseded by the new one");
+	esp_timer_stop(timer);
+	stage++;
+	close();
+	current->finish(ESP_ERR_INVALID_STATE);
+    }; /* if current */
+    current = job;
+
+    begin(PH_APPLY);
+    begin(PH_BACKUP);
+    backup();	// the backup of the superseded request is kept - it's the last consistent configuration
+    if (err != ESP_OK)
+    {
+	NET_LOGW(__FUNCTION__, "Fail backup network configuration with error code %i", err);
+	current->finish(err);
+	current.reset();
+	commit(false);	// the superseded request may be deferred
+	close();
+	return;
+    }; /* if err != ESP_OK */
+
+    defer();
+    end(PH_BACKUP);
+    run(current->cfg, current->login);
+}; /* esp::net::wifi::Updater::start() */
+
+
+/// @brief connect stage of the request; the dhcp & ip stages follow without the connection
+void esp::net::wifi::Updater::run(const ::net::configuration_t& cfg, bool reconnect)
+{
+    dhcp_adv(cfg.dhcp);
+    current->got_ip = false;
+
+    if (!reconnect)
+	return address();
+
+    NET_LOGW(__FUNCTION__, ">> wifi disconnect ");
+    begin(PH_DISCONNECT);
+    stack::disconnect();
+    end(PH_DISCONNECT);
+    begin(PH_LOGIN);
+    login(cfg, false);	// the PSK is derived by the apply(), in the task of the caller
+    end(PH_LOGIN);
+    NET_LOGW(__FUNCTION__, ">> connect to the new WiFi AP...");
+    begin(PH_CONNECT);
+    err = stack::connect();
+    if (err != ESP_OK)
+	return fail(err);
+    current->connecting = true;
+    arm(CONFIG_WIFI_STA_WAITING_CONNECT);
+}; /* esp::net::wifi::Updater::run() */
+
+
+/// @brief dhcp & ip stages of the request
+void esp::net::wifi::Updater::address()
+{
+    esp_timer_stop(timer);
+    stage++;
+    end(PH_CONNECT);
+    unpin();
+    begin(PH_DHCP);
+    dhcp_do();
+    end(PH_DHCP);
+    begin(PH_IP);
+    ip(target());
+    end(PH_IP);
+    begin(PH_GOT_IP);
+    if (current->got_ip)
+	return complete(current->reverting? current->failure: ESP_OK);
+    current->addressing = true;
+    arm(CONFIG_WIFI_STA_WAITING_IP);
+}; /* esp::net::wifi::Updater::address() */
+
+
+/// @brief set the timeout of the current stage
+void esp::net::wifi::Updater::arm(unsigned seconds)
+{
+    esp_timer_stop(timer);
+    armed.store(++stage, std::memory_order_release);
+    esp_timer_start_once(timer, seconds * 1000000ULL);
+}; /* esp::net::wifi::Updater::arm() */
+
+
+/// @brief stage failed: revert to the backup or complete the request
+void esp::net::wifi::Updater::fail(esp_err_t error)
+{
+	job_t& job = *current;
+
+    esp_timer_stop(timer);
+    stage++;
+    end(PH_CONNECT);
+    end(PH_GOT_IP);
+    if (job.connecting && rescan(error))
+	return run(target(), true);
+    unpin();
+    job.connecting = job.addressing = false;
+    if (job.reverting || !wifibkp)
+    {
+	applied = 0;	// the current configuration is unknown
+	return complete(job.reverting? job.failure: error);
+    }; /* if job.reverting || !wifibkp */
+
+    NET_LOGW(__FUNCTION__, "Fail updating network configuration with error code %i, revert it", error);
+    job.failure = error;
+    job.reverting = true;
+    begin(PH_REVERT);
+    rollback = true;
+    run(*wifibkp, true);
+}; /* esp::net::wifi::Updater::fail() */
+
+
+/// @brief complete the current request
+void esp::net::wifi::Updater::complete(esp_err_t result)
+{
+	std::shared_ptr<job_t> job;
+
+    esp_timer_stop(timer);
+    stage++;
+    if (result == ESP_OK && !current->reverting)
+    {
+	applied = current->cfg.fingerprint();
+	lastcfg = current->cfg;
+    }; /* if result == ESP_OK && !current->reverting */
+    job.swap(current);
+    commit(result == ESP_OK);
+    finalize();
+    close();
+    err = result;
+    NET_LOGW(__FUNCTION__, "Asynchronous update is completed with code %i", result);
+    job->finish(result);
+}; /* esp::net::wifi::Updater::complete() */
+
+
+/// @brief open the span of the phase; the update number is assigned at the PH_APPLY begin
+void esp::net::wifi::Updater::begin(phase_t phase)
+{
+    if (phase == PH_APPLY)
+	applies++;
+    opened[phase] = esp_timer_get_time();
+    open |= 1u << phase;
+}; /* esp::net::wifi::Updater::begin() */
+
+
+/// @brief close the span of the phase & record it to the ring, if the span is open
+void esp::net::wifi::Updater::end(phase_t phase)
+{
+	int64_t now = esp_timer_get_time();
+
+    if (!(open & (1u << phase)))
+	return;
+    open &= ~(1u << phase);
+
+	std::lock_guard<std::mutex> lock(spans_lock);
+
+    ring[recorded++ % CONFIG_WIFI_UPDATER_SPANS] =
+	    {opened[phase], static_cast<uint32_t>(now - opened[phase]), applies, phase, rollback};
+}; /* esp::net::wifi::Updater::end() */
+
+
+/// @brief close the all open spans of the update: the PH_REVERT & PH_APPLY are the last, out of the rollback
+void esp::net::wifi::Updater::close()
+{
+    for (unsigned ph = PH_BACKUP; ph < PH_REVERT; ph++)
+	end(static_cast<phase_t>(ph));
+    rollback = false;
+    end(PH_REVERT);
+    end(PH_APPLY);
+}; /* esp::net::wifi::Updater::close() */
+
+
+/// @brief name of the phase
+const char* esp::net::wifi::Updater::phase_name(phase_t phase)
+{
+	static const char* const names[PHASES] = {
+	    "backup", "disconnect", "login", "connect", "dhcp", "ip", "got_ip", "revert", "apply" };
+
+    return phase < PHASES? names[phase]: "unknown";
+}; /* esp::net::wifi::Updater::phase_name() */
+
+
+/// @brief copy of the recorded spans, the oldest first
+size_t esp::net::wifi::Updater::spans(span_t out[], size_t size) const
+{
+	std::lock_guard<std::mutex> lock(spans_lock);
+	size_t count = std::min<size_t>(recorded, CONFIG_WIFI_UPDATER_SPANS);
+	size_t first = recorded - count;
+
+    count = std::min(count, size);
+    for (size_t i = 0; i < count; i++)
+	out[i] = ring[(first + i) % CONFIG_WIFI_UPDATER_SPANS];
+    return count;
+}; /* esp::net::wifi::Updater::spans() */
+
+
+/// @brief min/avg/max/p95 of the each phase over the recorded spans, read in place under the lock;
+///	   the durations are sorted in the static scratch of the ring size, p95 - the nearest rank
+void esp::net::wifi::Updater::summary(timing_t out[PHASES], bool rollback) const
+{
+	std::lock_guard<std::mutex> lock(spans_lock);
+	size_t count = std::min<size_t>(recorded, CONFIG_WIFI_UPDATER_SPANS);
+	uint32_t* durations = span_durations;
+
+    for (unsigned ph = 0; ph < PHASES; ph++)
+    {
+	    size_t n = 0;
+	    uint64_t sum = 0;
+
+	for (size_t i = 0; i < count; i++)	// the order of the spans is not used: the ring is read as is
+	    if (ring[i].phase == ph && ring[i].rollback == rollback)
+		sum += durations[n++] = ring[i].duration;
+	out[ph] = {};
+	if (!n)
+	    continue;
+	std::sort(durations, durations + n);
+	out[ph].count = n;
+	out[ph].min = durations[0];
+	out[ph].avg = sum / n;
+	out[ph].max = durations[n - 1];
+	out[ph].p95 = durations[(n * 95 + 99) / 100 - 1];
+    }; /* for ph */
+}; /* esp::net::wifi::Updater::summary() */
+
+
+/// @brief drop the recorded spans
+void esp::net::wifi::Updater::clear_spans()
+{
+	std::lock_guard<std::mutex> lock(spans_lock);
+
+    recorded = 0;
+}; /* esp::net::wifi::Updater::clear_spans() */
+
+
+
+/// @brief configuration, applied by the current request
+const ::net::configuration_t& esp::net::wifi::Updater::target() const
+{
+    return current->reverting? *wifibkp: current->cfg;
+}; /* esp::net::wifi::Updater::target() */
+
+
+
+/// @brief the targeted connection to the known AP is failed: the AP is not found on it's channel
+///	   or it's BSSID is changed - forget it, the next login() scans the all channels
+bool esp::net::wifi::Updater::rescan(esp_err_t error)
+{
+    if (!pinned || (error != ESP_ERR_WIFI_SSID && error != ESP_ERR_WIFI_TIMEOUT))
+	return false;
+    NET_LOGW(__FUNCTION__, "Targeted connection to the known AP failed with error %i, retry with the full scan", error);
+    known_ap::forget(stack::configuration(its_netif.type).ssid().c_str());
+    pinned = false;
+    return true;
+}; /* esp::net::wifi::Updater::rescan() */
+
+
+
+/// @brief the connection of the pinned login() is ended: restore the caller's target in the driver
+///	   configuration, the own reconnection of the driver & the next boot are not locked to the pinned BSSID
+void esp::net::wifi::Updater::unpin()
+{
+	config_t conf;
+
+    if (!held)
+	return;
+    held = false;
+    conf = stack::configuration(its_netif.type);
+    conf.target(own);
+    if (!deferred)
+	storage::set(WIFI_STORAGE_RAM);	// the flash keeps the caller's target already
+    stack::configure(conf);
+    if (!deferred)
+	storage::set(WIFI_STORAGE_FLASH);
+}; /* esp::net::wifi::Updater::unpin() */
+
+
+
+/// @brief keep the WiFi configuration & the PSK cache in the RAM while the apply is in flight:
+///	   the attempts & the rollback don't write the flash
+void esp::net::wifi::Updater::defer()
+{
+    if (deferred)
+	return;	// the superseded request is deferred already
+    if (storage::set(WIFI_STORAGE_RAM) != ESP_OK)
+	return;
+    pmk_cache::defer();
+    deferred = true;
+    pending = 0;
+}; /* esp::net::wifi::Updater::defer() */
+
+
+/// @brief end of the apply: on the success store the configuration to the flash once;
+///	   on the failure the flash keeps the configuration before the apply, it's restored in the RAM by the rollback
+void esp::net::wifi::Updater::commit(bool success)
+{
+	bool store = success && pending;
+
+    if (!deferred)
+	return;
+    deferred = false;
+    storage::set(WIFI_STORAGE_FLASH);
+    pmk_cache::commit(success);
+    if (store)
+    {
+	    config_t conf = stack::configuration(its_netif.type);
+
+	if (held)
+	    conf.target(own);	// the pin is never stored
+	stack::configure(conf);
+	pending--;
+    }; /* if store */
+    avoided += pending;
+    pending = 0;
+    NET_LOGI(__func__, "WiFi configuration is %s, %u flash writes avoided", store? "stored": "kept", avoided);
+}; /* esp::net::wifi::Updater::commit() */
+
+
+
 //--[ wifi.cpp ]-------------------------------------------------------------------------------------------------------
@@ -152,6 +152,54 @@ extern "C" {
 }
 
 
+/// Capacity of the ring of the phase timing spans of the esp::net::wifi::Updater,
+/// the oldest spans are overwritten.
+#ifndef CONFIG_WIFI_UPDATER_SPANS
+#define CONFIG_WIFI_UPDATER_SPANS 64
+#endif
+
+/// Capacity of the ring of the esp::net::wifi::trace records, the power of 2
+#ifndef CONFIG_WIFI_TRACE_RECORDS
+#define CONFIG_WIFI_TRACE_RECORDS 64
+#endif
+
+/// Capacity of the event queue of the one subscriber of the esp::net::wifi::dispatcher, the power of 2
+#ifndef CONFIG_WIFI_DISPATCH_EVENTS
+#define CONFIG_WIFI_DISPATCH_EVENTS 16
+#endif
+
+/// Maximum count of the subscribers of the one esp::net::wifi::dispatcher
+#ifndef CONFIG_WIFI_DISPATCH_SUBSCRIBERS
+#define CONFIG_WIFI_DISPATCH_SUBSCRIBERS 4
+#endif
+
+/// Capacity of the event queue of the own event loop of the component, esp::net::wifi::evloop
+#ifndef CONFIG_WIFI_EVLOOP_QUEUE
+#define CONFIG_WIFI_EVLOOP_QUEUE 32
+#endif
+
+/// Priority of the task of the own event loop: above the default event loop task (ESP_TASKD_EVENT_PRIO)
+#ifndef CONFIG_WIFI_EVLOOP_PRIORITY
+#define CONFIG_WIFI_EVLOOP_PRIORITY 21
+#endif
+
+/// Stack size of the task of the own event loop, bytes
+#ifndef CONFIG_WIFI_EVLOOP_STACK
+#define CONFIG_WIFI_EVLOOP_STACK 4096
+#endif
+
+/// Handlers of the component, registered in the own event loop at once: the loop of each one is kept up to the unlisten()
+#ifndef CONFIG_WIFI_EVLOOP_HANDLERS
+#define CONFIG_WIFI_EVLOOP_HANDLERS 32
+#endif
+
+/// Capacity of the registry of the soft-AP stations, esp::net::wifi::stations: the connected stations
+/// & the recently disconnected ones, the oldest disconnected are replaced
+#ifndef CONFIG_WIFI_AP_STATIONS
+#define CONFIG_WIFI_AP_STATIONS 32
+#endif
+
+
 // namesopace for encapsulating of the esp system functions
 namespace esp
 {
@@ -169,14 +217,240 @@ namespace esp
 
 	    class config_t;
 
+	    /// @brief the target of the STA connection: the BSSID lock, the channel & the scan method
+	    struct target_t
+	    {
+		bool		    bssid_set;
+		uint8_t		    bssid[6];
+		uint8_t		    channel;
+		wifi_scan_method_t  scan_method;
+	    }; /* struct esp::net::wifi::target_t */
+
+	    /// @brief Own esp_event loop of the component, with the own task, priority & core affinity:
+	    ///	   the slow handlers of the application in the default event loop don't delay the handlers
+	    ///	   of the component. The WIFI_EVENT & IP_EVENT are forwarded to it by the handlers,
+	    ///	   registered in the default loop by the start(); start it before the application registers
+	    ///	   it's own handlers - the forwarders are called first. The handlers of the component
+	    ///	   (dispatcher, Updater, trace, known_ap, disconnects) are registered by the listen():
+	    ///	   in the own loop, when it is started, else in the default one.
+	    class evloop
+	    {
+	    public:
+		/// @brief parameters of the loop & of it's task
+		struct config_t
+		{
+		    const char*	name = "net_evt";			///< name of the task
+		    uint32_t	stack = CONFIG_WIFI_EVLOOP_STACK;
+		    UBaseType_t	priority = CONFIG_WIFI_EVLOOP_PRIORITY;
+		    BaseType_t	core = tskNO_AFFINITY;			///< core of the task, tskNO_AFFINITY - any
+		    int32_t	queue = CONFIG_WIFI_EVLOOP_QUEUE;	///< events in the queue of the loop
+		}; /* struct config_t */
+
+		/** @brief create the loop & it's task, register the forwarders of the WIFI_EVENT & IP_EVENT
+		 *	    in the default loop
+		 *  @return ESP_OK, ESP_ERR_INVALID_STATE - the loop is started already, or error of the esp_event */
+		static esp_err_t start(const config_t& cfg);
+		static esp_err_t start() { return start(config_t()); };
+
+		/** @brief unregister the forwarders & delete the loop
+		 *  @return ESP_OK, ESP_ERR_INVALID_STATE - the loop is not started, or the handlers of the component
+		 *	    are registered in it: the loop is kept, unlisten() them before the stop */
+		static esp_err_t stop();
+
+		/// @brief handle of the loop, nullptr - the loop is not started
+		static esp_event_loop_handle_t handle();
+
+		/** @brief register the handler of the component: in the own loop, if it is started, else in the default one;
+		 *	    the loop of the instance is kept for the unlisten()
+		 *  @return ESP_OK, ESP_ERR_NO_MEM - CONFIG_WIFI_EVLOOP_HANDLERS are registered in the own loop already,
+		 *	    ESP_ERR_INVALID_ARG - no 'instance' for the own loop: the handler could not be unlisten()'ed,
+		 *	    or error of the esp_event */
+		static esp_err_t listen(esp_event_base_t base, int32_t id, esp_event_handler_t fn, void* arg,
+			esp_event_handler_instance_t* instance);
+
+		/// @brief unregister the handler, registered by the listen(), in the loop, it is registered in
+		static esp_err_t unlisten(esp_event_base_t base, int32_t id, esp_event_handler_instance_t instance);
+
+		/// @brief post the event of the component: to the own loop, if it is started, else to the default one
+		static esp_err_t post(esp_event_base_t base, int32_t id, const void* data, size_t size, TickType_t ticks);
+
+		/// @brief size of the data of the forwarded event, 0 - the event w/o the data
+		static size_t data_size(esp_event_base_t base, int32_t id);
+
+		static uint32_t forwarded();	///< events, forwarded to the own loop
+		static uint32_t dropped();	///< events, dropped by the full queue of the own loop
+
+	    private:
+		/// @brief WIFI_EVENT & IP_EVENT handler of the default loop: repost the event to the own loop
+		static void forward(void* arg, esp_event_base_t base, int32_t id, void* data);
+	    }; /* class esp::net::wifi::evloop */
+
+
+	    /// @brief Long-lived dispatcher of the WIFI_EVENT & IP_EVENT of the netif: the handlers are registered
+	    ///	   once, on the first enroll(), and stay up to the destruction; the events are fanned out
+	    ///	   to the subscribers, each one has the own lock-free single-producer/single-consumer queue
+	    ///	   (the producer - the event loop task, the consumer - the task of the subscriber).
+	    ///	   The events, arrived between the waitings of the subscriber, are kept in it's queue;
+	    ///	   the full queue drops the new events & counts them, the event loop is never blocked.
+	    class dispatcher
+	    {
+	    public:
+		static constexpr size_t capacity = CONFIG_WIFI_DISPATCH_EVENTS;		///< events in the queue of the subscriber
+		static constexpr size_t subscribers = CONFIG_WIFI_DISPATCH_SUBSCRIBERS;	///< subscribers of the dispatcher
+
+		/// @brief the event, copied into the queue of the subscriber
+		struct event_t
+		{
+		    esp_event_base_t	base;	///< WIFI_EVENT or IP_EVENT
+		    int32_t		id;
+		    uint32_t		aux;	///< WIFI_EVENT_STA_CONNECTED - the channel, IP_EVENT_STA_GOT_IP - the address, else 0
+		    uint8_t		reason;	///< reason-code of the disconnection, else 0
+		    int8_t		rssi;	///< rssi of the WIFI_EVENT_STA_DISCONNECTED, else 0
+		}; /* struct event_t */
+
+		/// @brief queue of the subscriber, defined in the dispatch.cpp
+		struct queue_t;
+
+		dispatcher() {};
+		~dispatcher();	///< unregister the handlers, release the queues
+		dispatcher(const dispatcher&) = delete;
+		dispatcher& operator =(const dispatcher&) = delete;
+
+		/// @brief register the WIFI_EVENT & IP_EVENT handlers, once for the dispatcher
+		esp_err_t enroll();
+
+		/** @brief subscribe to the events: the queue is allocated on the first subscription only,
+		 *	    the queue of the unsubscribed one is reused
+		 *  @param[in]   base     - WIFI_EVENT or IP_EVENT
+		 *  @param[in]   ids      - mask of the event ids: bit 1 << id, the ids 0..31
+		 *  @return the queue of the subscriber, nullptr - all the subscribers are busy or no memory */
+		queue_t* subscribe(esp_event_base_t base, uint32_t ids);
+
+		/// @brief stop the delivery of the events to the queue, the queue is kept for the reuse
+		void unsubscribe(queue_t* queue);
+
+		/** @brief take the next event of the queue, wait it up to the timeout
+		 *  @param[in]   queue    - queue of the subscriber, the consumer side - the one task only
+		 *  @param[out]  ev       - the event taken
+		 *  @param[in]   ticks    - timeout
+		 *  @return true - the event is taken, false - timeout expired */
+		static bool wait(queue_t& queue, event_t& ev, TickType_t ticks);
+
+		/// @brief drop the stale events of the queue
+		/// @return count of the events dropped
+		static size_t drain(queue_t& queue);
+
+		/// @brief events, dropped by the full queue of the subscriber
+		static uint32_t dropped(const queue_t& queue);
+
+		uint32_t delivered() const { return posted.load(std::memory_order_relaxed); };	///< events, queued to the subscribers
+		uint32_t dropped() const { return lost.load(std::memory_order_relaxed); };	///< events, dropped by the full queues
+
+	    private:
+		/// @brief WIFI_EVENT & IP_EVENT handler: fan out the event to the subscribers
+		static void on_event(void* arg, esp_event_base_t base, int32_t id, void* data);
+
+		std::atomic<queue_t*> subs[subscribers] = {};	///< queues of the subscribers, allocated ones are never released
+		std::atomic<uint32_t> posted{0}, lost{0};
+		esp_event_handler_instance_t wifi_evt = nullptr, ip_evt = nullptr;
+	    }; /* class esp::net::wifi::dispatcher */
+
+
 	    /// @brief Class for updating configuration parameters of the netif
 	    class Updater
 	    {
+		struct job_t;
+
 	    public:
 		Updater(esp::wifi::netif_t *netif);	///< @brief Constructor for the class net::wifi::sta::netif_t::Updater
+		~Updater();
+
+		/// @brief Completion callback of the asynchronous update, called from the event loop task
+		///	   with the status of the update, see the operator()
+		typedef std::function<void(esp_err_t)> callback_t;
+
+		/// @brief Handle of the asynchronous update request, returned by the apply()
+		class handle_t
+		{
+		public:
+		    handle_t() {};
+
+		    /// @brief the update request is completed, failed or superseded
+		    bool done() const;
+
+		    /** @brief status of the update request
+		     * @return
+		     *	ESP_ERR_NOT_FINISHED  - the request is in flight
+		     *	ESP_ERR_INVALID_STATE - the request is superseded by the next one
+		     *	other		      - as the operator() */
+		    esp_err_t status() const;
+
+		    /// @brief wait the completion of the update request
+		    /// @return status() of the request
+		    esp_err_t wait(TickType_t ticks = portMAX_DELAY);
+
+		    explicit operator bool() const { return job != nullptr; };
+
+		private:
+		    friend class Updater;
+		    handle_t(const std::shared_ptr<job_t>& ajob): job(ajob) {};
+		    std::shared_ptr<job_t> job;
+		}; /* class esp::net::wifi::Updater::handle_t */
 
 		esp_err_t status() { return err; };
 
+		/// @brief phases of the update, timed by the spans
+		enum phase_t: uint8_t
+		{
+		    PH_BACKUP,		///< backup of the current configuration
+		    PH_DISCONNECT,	///< disconnection from the current AP
+		    PH_LOGIN,		///< PSK derivation & setting of the WiFi configuration
+		    PH_CONNECT,		///< connection to the AP up to the WIFI_EVENT_STA_CONNECTED/DISCONNECTED
+		    PH_DHCP,		///< DHCP client start/stop
+		    PH_IP,		///< setting of the ip info
+		    PH_GOT_IP,		///< waiting of the IP_EVENT_STA_GOT_IP
+		    PH_REVERT,		///< rollback to the backup after the failure
+		    PH_APPLY,		///< the whole update, from the request up to the result
+		    PHASES
+		}; /* enum phase_t */
+
+		/// @brief name of the phase
+		static const char* phase_name(phase_t phase);
+
+		/// @brief timestamped span of the one phase of the update
+		struct span_t
+		{
+		    int64_t	start;		///< esp_timer_get_time() of the phase begin, us
+		    uint32_t	duration;	///< us
+		    uint16_t	apply;		///< number of the update: the spans of the one update have the same number
+		    phase_t	phase;
+		    bool	rollback;	///< the phase is the part of the PH_REVERT
+		}; /* struct span_t */
+
+		/// @brief durations of the phase over the recorded spans, us
+		struct timing_t
+		{
+		    uint32_t count, min, avg, max, p95;
+		}; /* struct timing_t */
+
+		/** @brief copy of the recorded spans, the oldest first
+		 *  @param[out]  out      - buffer for the spans
+		 *  @param[in]   size     - capacity of the buffer
+		 *  @return count of the spans copied */
+		size_t spans(span_t out[], size_t size) const;
+
+		/** @brief min/avg/max/p95 of the each phase over the recorded spans, w/o the heap allocation
+		 *  @param[out]  out      - timing of the each phase, count 0 - the phase is not recorded
+		 *  @param[in]   rollback - timing of the phases of the rollback, not of the update itself */
+		void summary(timing_t out[PHASES], bool rollback = false) const;
+
+		/// @brief drop the recorded spans
+		void clear_spans();
+
+		/// @brief count of the flash writes of the WiFi configuration, avoided by the deferred storage:
+		///	   the configuration is stored once on the success, never on the attempts & the rollback
+		unsigned writes_avoided() const { return avoided; };
+
 		/** @brief Save current network configuration for bacup
 		 *  @return ESP_OK	  - success updating configuration
 		 *	ESP_ERR		  - any error
@@ -206,10 +480,13 @@ namespace esp
 		 * @return
 		 *	ESP_OK - Setup configuration successfully
 		 *	ESP_ERR_NOT_FOUND     - network cfg is not changed, nothing to do
+		 *				or it is changed back to the last applied configuration
 		 *	ESP_ERR_INVALID_RESPONSE
-		 *	ESP_ERR_WIFI_SSID     - invalid SSID (not connected?)
+		 *	ESP_ERR_WIFI_SSID     - invalid SSID, the AP is not found
 		 *	ESP_ERR_WIFI_PASSWORD - invalid the WiFi password
-		 *	ESP_ERR_WIFI_TIMEOUT  - timeout(???)
+		 *	ESP_ERR_WIFI_CONN     - association is rejected by the AP
+		 *	ESP_ERR_WIFI_NOT_CONNECT - connection is failed by other reason
+		 *	ESP_ERR_WIFI_TIMEOUT  - no answer from the WiFi driver during CONFIG_WIFI_STA_WAITING_CONNECT
 		 *	ESP_ERR_WIFI_IF	      - invalid ip cfg netif params
 		 * events:
 		 *	WIFI_EVENT_WIFI_READY - ESP32 station ready
@@ -221,6 +498,18 @@ namespace esp
 		 */
 		esp_err_t operator()(::net::configuration_t& cfg);
 
+		/** @brief Asynchronous update procedure of the WiFi configuration, the same as the operator(),
+		 *	    but executed as the state machine in the default event loop task:
+		 *	    backup -> disconnect -> login -> connect -> dhcp -> ip -> got ip -> finalize, or revert on failure.
+		 *	    The request, passed during the previous one is in flight, supersedes it.
+		 *	    Called by any task: the state of the update is read & changed by the event loop task only.
+		 *	    The request is failed by the ESP_ERR_TIMEOUT, if no address during CONFIG_WIFI_STA_WAITING_IP,
+		 *	    or at once by the status of the WIFI_EVENT_STA_DISCONNECTED, received while the address is waited.
+		 *  @param[in]   cfg      - new network configuration, copied into the request
+		 *  @param[in]   done     - completion callback, may be empty
+		 *  @return handle of the request for the waiting/polling of it's status */
+		handle_t apply(::net::configuration_t& cfg, callback_t done = nullptr);
+
 	    protected:
 
 		/** @brief Preliliminary Set status of request to the dhcp-client - request start/stop after the connection
@@ -244,30 +533,84 @@ namespace esp
 
 		/** @brief Apply the login cfg: wifi cfg - ssid, password - to the netif
 		 *  @param[in]   cfg      - new parameters network configuration buffer
+		 *  @param[in]   derive   - derive the PSK, absent in the pmk_cache; false - in the event loop task
 		 *  @return ESP_OK        - success updating configuration */
-		esp_err_t login(const ::net::configuration_t& cfg);
+		esp_err_t login(const ::net::configuration_t& cfg, bool derive = true);
 		/** @brief Apply the login cfg: wifi cfg - ssid, password - to the netif
 		 *  @param[in]   cfg      - new parameters network configuration buffer
+		 *  @param[in]   derive   - derive the PSK, absent in the pmk_cache; false - in the event loop task
 		 *  @return ESP_OK        - success updating configuration */
-		esp_err_t login(const config_t& cfg);
+		esp_err_t login(const config_t& cfg, bool derive = true);
 //		/** @brief Apply the login cfg: wifi cfg - ssid, password - to the netif
 //		 *  @param[in]   ssid     - SSID (login) for setup
 //		 *  @param[in]   passwd   - password for setup
 //		 *  @return ESP_OK        - success updating configuration */
 //		esp_err_t login(const std::string& ssid, const std::string& passwd);
 
-		/** @brief simply execute connection to the selected WiFi AP
+		/** @brief simply execute connection to the selected WiFi AP;
+		 *	    wait the WIFI_EVENT_STA_CONNECTED or the WIFI_EVENT_STA_DISCONNECTED, whichever comes first;
+		 *	    the failed targeted connection to the known AP is repeated with the full channel scan
 		 *  @param[in]   cfg      - new network configuration buffer
-		 *  @return               - passed the 'err' value */
+		 *  @return               - passed the 'err' value:
+		 *	ESP_OK		      - connected
+		 *	other		      - esp::wifi::err::status() of the disconnection reason,
+		 *				or ESP_ERR_WIFI_TIMEOUT */
 		esp_err_t connect(const ::net::configuration_t& cfg);
 
 
 	    private:
 
+		/// @brief event handler of the asynchronous update state machine
+		static void on_event(void* arg, esp_event_base_t base, int32_t id, void* data);
+		/// @brief stage timeout of the asynchronous update, post it to the event loop
+		static void on_timeout(void* arg);
+
+		void start(std::shared_ptr<job_t>& job);	///< start the new asynchronous request, supersede the current
+		void run(const ::net::configuration_t& cfg, bool reconnect);	///< connect stage of the request
+		void address();			///< dhcp & ip stages of the request
+		void arm(unsigned seconds);	///< set the timeout of the current stage
+		void fail(esp_err_t error);	///< stage failed: revert to the backup or complete the request
+		void complete(esp_err_t result);	///< complete the current request
+		const ::net::configuration_t& target() const;	///< configuration, applied by the current request
+		bool rescan(esp_err_t error);	///< the targeted connection is failed: forget the AP, retry with the full scan?
+		void unpin();			///< restore the caller's target in the driver configuration, in the RAM only
+		void defer();			///< keep the WiFi configuration & the PSK cache in the RAM while the apply is in flight
+		void commit(bool success);	///< end of the apply: store the configuration to the flash once, on the success only
+		void begin(phase_t phase);	///< open the span of the phase
+		void end(phase_t phase);	///< close the span of the phase & record it, if it is open
+		void close();			///< close the all open spans of the update
+		esp_err_t listen();		///< subscribe to the connection & the address events, once
+
 		esp::wifi::netif_t &its_netif;
 
-		::net::configuration_t *wifibkp = nullptr; ///<@brief storage for wifi cfg - login/password etc
+		::net::configuration_t *wifibkp = nullptr; ///<@brief backup of wifi cfg - login/password etc, points to the 'bkpbuf'
+		::net::configuration_t bkpbuf;	///< storage of the backup, inline - the backup does not allocate
 		esp_err_t err = ESP_OK;
+		bool pinned = false;	///< the last login() is targeted to the known AP
+		bool held = false;	///< the pin of the login() is in the driver configuration, in the RAM only
+		target_t own = {};		///< the caller's target of the STA connection, restored by the unpin()
+		bool deferred = false;	///< the WiFi configuration storage is WIFI_STORAGE_RAM for the apply in flight
+		unsigned pending = 0;	///< configurations, set in the RAM during the apply in flight
+		unsigned avoided = 0;	///< flash writes, avoided by the deferred storage
+		uint32_t applied = 0;	///< fingerprint of the applied configuration, 0 - unknown
+		::net::configuration_t lastcfg;	///< the applied configuration, compared on the equal fingerprints
+
+		std::shared_ptr<job_t> current;	///< asynchronous request in flight
+		uint32_t stage = 0;		///< generation of the current stage, for drop the stale timeouts; by the event loop task only
+		std::atomic<uint32_t> armed{0};	///< generation of the stage, the timer is armed for; read by the esp_timer task
+		esp_timer_handle_t timer = nullptr;
+		esp_event_handler_instance_t wifi_evt = nullptr, ip_evt = nullptr, own_evt = nullptr;
+
+		dispatcher events;			///< persistent subscriptions of the synchronous update
+		dispatcher::queue_t* linking = nullptr;	///< WIFI_EVENT_STA_CONNECTED & WIFI_EVENT_STA_DISCONNECTED
+		dispatcher::queue_t* addressing = nullptr;	///< IP_EVENT_STA_GOT_IP
+
+		span_t ring[CONFIG_WIFI_UPDATER_SPANS];	///< recorded spans, 'recorded' - count of the all spans ever recorded
+		size_t recorded = 0;
+		int64_t opened[PHASES] = {};	///< begin of the open spans
+		uint16_t open = 0;		///< mask of the open spans
+		uint16_t applies = 0;		///< number of the current update
+		bool rollback = false;		///< the rollback is in progress
 
 	    }; /* class esp::net::wifi::Updater */
 
@@ -293,6 +636,49 @@ namespace esp
 	    ///@return ASCIIZ C-string with text name of error reason
 	    const char* reason(uint8_t areason);
 
+	    ///@brief  error status of the failed connection according the reason of the WiFi disconnection
+	    ///@param [in] areason   reason of the WIFI_EVENT_STA_DISCONNECTED
+	    ///@return ESP_ERR_WIFI_SSID	 - the AP is not found
+	    ///	ESP_ERR_WIFI_PASSWORD	 - authentication or 4-way handshake is failed, wrong password
+	    ///	ESP_ERR_WIFI_CONN	 - association is rejected or broken by the AP
+	    ///	ESP_ERR_WIFI_NOT_CONNECT - any other reason
+	    esp_err_t status(wifi_err_reason_t areason);
+
+	    ///@brief  error status of the failed connection with uint8_t argument
+	    ///@param [in] areason   reason of the WIFI_EVENT_STA_DISCONNECTED
+	    ///@return as esp::wifi::err::status(wifi_err_reason_t)
+	    esp_err_t status(uint8_t areason);
+
+	    constexpr unsigned codes = 68 + 11;	///< size of the dense reason-codes table: 1..68 & 200..210
+
+	    ///@brief  dense index of the reason-code in the table, 0..codes-1; 'codes' - the code is out of the table
+	    constexpr unsigned index(unsigned areason) {
+		return (areason >= 1 && areason <= 68)? areason - 1:
+		       (areason >= 200 && areason < 200 + codes - 68)? areason - 200 + 68: codes; };
+
+	    ///@brief  reason-code of the dense index of the table
+	    constexpr uint8_t code(unsigned idx) { return idx < 68? idx + 1: idx - 68 + 200; };
+
+	    ///@brief  class of the disconnection reason: is the retry of the connection worthwhile
+	    enum kind_t: uint8_t
+	    {
+		UNKNOWN,	///< reserved or unknown code
+		TRANSIENT,	///< link or protocol event: the retry is worthwhile at once
+		CREDENTIAL,	///< wrong password or PSK: no retry w/o the new credentials
+		CAPACITY,	///< the AP is overloaded: retry after the backoff or with the other AP
+		ABSENT,		///< the AP is not found: retry after the rescan
+		CONFIG		///< incompatible security or capabilities: no retry w/o the reconfiguration
+	    }; /* enum esp::wifi::err::kind_t */
+
+	    ///@brief  class of the disconnection reason
+	    ///@param [in] areason   reason of the WIFI_EVENT_STA_DISCONNECTED
+	    kind_t kind(uint8_t areason);
+
+	    ///@brief  the retry of the connection may succeed w/o the change of the configuration
+	    inline bool retryable(uint8_t areason) {
+		kind_t k = kind(areason);
+		return k == TRANSIENT || k == CAPACITY || k == ABSENT; };
+
 	}; /* namespace esp::wifi::err */
 
 	/// NetIf for WiFi Specialization
@@ -303,6 +689,9 @@ namespace esp
 	    netif_t(): esp::netif_t(), update(this) {};
 	    /// @brief Create the exemplar of esp::netif and create the wifi esp_netif_t object
 	    netif_t(wifi_interface_t wifi_if, esp_netif_inherent_config_t &config);
+	    /// @brief the handlers of the station events & the mirror of the leases of the soft-AP
+	    ///	   are dropped before the netif is destroyed
+	    ~netif_t();
 	    /// Main procedure for creation the WiFi Netif
 	    esp_netif_t* create(wifi_interface_t wifi_if, esp_netif_inherent_config_t &config);
 
@@ -312,6 +701,13 @@ namespace esp
 	    friend class esp::net::wifi::Updater;
 	    wifi_interface_t type = WIFI_IF_STA;
 
+	    /// @brief the DHCP client of the station follows the link & the address by the events
+	    esp_err_t track();
+	    void untrack();
+	    static void on_event(void* arg, esp_event_base_t base, int32_t id, void* data);
+	    esp_event_handler_instance_t on_wifi = nullptr;
+	    esp_event_handler_instance_t on_ip = nullptr;
+
 	}; /* class esp::wifi::netif_t */
 
     }; /* esp::wifi */
@@ -416,6 +812,19 @@ namespace esp
 		std::string passwd() const { return passwd_cstr(); };
 		const char* passwd_cstr() const;
 
+		/// Replace the passphrase by the PSK (64 hex digits) from the pmk_cache,
+		/// the supplicant skips the PBKDF2 derivation of the PMK with it
+		/// @param derive - derive the PSK, absent in the cache; else the passphrase is kept
+		/// @return ESP_OK - the passphrase is replaced
+		///	ESP_ERR_WIFI_MODE - not the STA configuration
+		///	ESP_ERR_NOT_SUPPORTED - the WPA3-SAE or the PMF is required: the SAE needs the passphrase
+		///	ESP_ERR_NOT_FOUND - the PSK is not cached & it is not derived
+		///	ESP_ERR_INVALID_ARG - the password is not the passphrase (empty or the PSK already)
+		esp_err_t psk(bool derive = true);
+
+		/// the connection may be the WPA3-SAE: the threshold is WPA3 or the PMF is required
+		bool sae() const;
+
 		// Set the BSSID
 		esp_err_t bssid(const std::string& name) {
 		    return bssid(name.c_str()); }
@@ -425,6 +834,20 @@ namespace esp
 		std::string bssid() const { return bssid_cstr(); };
 		const char* bssid_cstr() const;
 
+		/// Get the target of the STA connection
+		target_t target() const;
+
+		/// Set the target of the STA connection, as got by the target()
+		/// @return ESP_OK - the target is set
+		///	ESP_ERR_WIFI_MODE - not the STA configuration
+		esp_err_t target(const target_t& tgt);
+
+		/// Target the connection to the AP with the BSSID on the channel: scan this channel only
+		/// @return ESP_OK - the target is set
+		///	ESP_ERR_INVALID_ARG - no BSSID
+		///	ESP_ERR_WIFI_MODE - not the STA configuration
+		esp_err_t pin(const uint8_t bssid[6], uint8_t channel);
+
 		/// Get Failure Retry counter value
 		/// @return - if type == STA, return value of the sta.failure_retry_cnt
 		///	else - return 0xff
@@ -448,6 +871,321 @@ namespace esp
 		wifi_config_t data;
 	    }; /* class esp::net::wifi::config_t */
 
+	    /// @brief Cache of the PSK, derived from the WPA passphrase by PBKDF2-SHA1 (4096 iterations),
+	    ///	   for skip this derivation by the supplicant on the reconnection & the rollback.
+	    ///	   The entry is found by the SSID & the digest of the passphrase, keyed by the PMK of the entry;
+	    ///	   the least recently used entry is replaced. Stored in the NVS namespace "net_pmk", survive the reboot:
+	    ///	   the PSK is the key of the network, build with the CONFIG_NVS_ENCRYPTION for the encrypted NVS.
+	    class pmk_cache
+	    {
+	    public:
+		static constexpr size_t size = 4;	///< number of the cached PSK
+
+		/** @brief PSK for the SSID & passphrase: from the cache, or derived & stored to the cache
+		 *  @param[in]  ssid       - SSID of the AP
+		 *  @param[in]  passphrase - WPA passphrase, 8..63 chars
+		 *  @param[out] hex        - PSK, 64 hex digits & the terminating zero
+		 *  @param[in]  derive     - derive the absent PSK: PBKDF2 takes the CPU for the long time,
+		 *			     don't derive it in the event loop task
+		 *  @return ESP_OK - the PSK is found or derived
+		 *	ESP_ERR_NOT_FOUND - the PSK is absent in the cache & it is not derived
+		 *	ESP_ERR_INVALID_ARG - the passphrase is absent or it is the PSK already
+		 *	ESP_FAIL - error of the derivation */
+		static esp_err_t psk(const char ssid[], const char passphrase[], char hex[65], bool derive = true);
+
+		/// @brief drop the all cached PSK in the RAM & in the NVS
+		static esp_err_t clear();
+
+		/// @brief postpone the storing of the new PSK to the NVS up to the commit()
+		static void defer();
+
+		/** @brief end of the postponing
+		 *  @param[in] store - store the changed table to the NVS now; else the changes
+		 *		       are kept in the RAM and stored with the next change
+		 *  @return ESP_OK, or error of the NVS */
+		static esp_err_t commit(bool store);
+
+		static unsigned hits();		///< count of the PSK, found in the cache
+		static unsigned misses();	///< count of the derived PSK
+	    }; /* class esp::net::wifi::pmk_cache */
+
+
+	    /// @brief Table of the known AP: SSID -> BSSID, channel, RSSI & time of the last successful connection,
+	    ///	   filled from the WIFI_EVENT_STA_CONNECTED; the connection to the known AP
+	    ///	   is targeted to it's BSSID & channel, without the full channel scan, and the DHCP client
+	    ///	   requests the address, obtained on it last time, by the INIT-REBOOT.
+	    ///	   The least recently connected entry is replaced; kept in the RAM only.
+	    class known_ap
+	    {
+	    public:
+		static constexpr size_t size = 4;	///< number of the known AP
+
+		/// @brief entry of the table
+		struct entry_t
+		{
+		    char	ssid[33];	///< SSID, zero terminated; empty - entry is free
+		    uint8_t	bssid[6];
+		    uint8_t	channel;
+		    int8_t	rssi;		///< RSSI on the connection
+		    int64_t	stamp;		///< esp_timer_get_time() of the last successful connection, us
+		    uint32_t	ip;		///< the address, obtained by the DHCP on the network, network order; 0 - none
+		}; /* struct entry_t */
+
+		/// @brief register the WIFI_EVENT_STA_CONNECTED handler, once
+		static esp_err_t enroll();
+
+		/** @brief find the known AP with the SSID
+		 *  @param[in]  ssid  - SSID of the AP
+		 *  @param[out] entry - the found entry
+		 *  @return true - the AP is known */
+		static bool find(const char ssid[], entry_t& entry);
+
+		/// @brief drop the AP with the SSID: the targeted connection to it is failed
+		static void forget(const char ssid[]);
+
+		/// @brief drop the all known AP
+		static void clear();
+
+		/// @brief the address, obtained by the DHCP on the connected AP, network order:
+		///	   by the netif of the station on the IP_EVENT_STA_GOT_IP
+		static void bound(uint32_t ip);
+
+	    private:
+		/// @brief WIFI_EVENT_STA_CONNECTED handler: store the AP to the table
+		static void on_connected(void* arg, esp_event_base_t base, int32_t id, void* data);
+	    }; /* class esp::net::wifi::known_ap */
+
+
+	    /// @brief statistics of the disconnections of the station by the reason-code: count, time of the last one
+	    ///	   & the histogram of the connection time before the disconnection. Lock-free: the counters are updated
+	    ///	   by the WIFI_EVENT handler with the relaxed atomics, the snapshot is cheap enough for polling every second.
+	    class disconnects
+	    {
+	    public:
+		static constexpr size_t buckets = 10;			///< histogram buckets, see bucket()
+		static constexpr size_t slots = esp::wifi::err::codes + 1;	///< reason-codes of the table & the rest codes
+
+		/// @brief counters of the reason-code
+		struct counter_t
+		{
+		    uint8_t	reason;		///< reason-code; 0 - the codes out of the reason-codes table
+		    uint32_t	count;		///< count of the disconnections
+		    uint32_t	last;		///< esp_timer_get_time() of the last disconnection, ms (wraps in 49 days)
+		    uint32_t	hist[buckets];	///< count by the connection time before the disconnection
+		}; /* struct counter_t */
+
+		/// @brief copy of the statistics
+		struct snapshot_t
+		{
+		    uint32_t	total;		///< count of the all disconnections
+		    counter_t	reasons[slots];	///< by the dense index of the esp::wifi::err::index(), the last - the rest codes
+		}; /* struct snapshot_t */
+
+		/// @brief histogram bucket of the connection time (ms):
+		///	   0 - the disconnection w/o the connection (failed attempt),
+		///	   1..buckets-1 - the connection time < 4^(n-1) s: <1s, <4s, <16s ... <4.5h, the last - longer
+		static constexpr unsigned bucket(bool connected, uint32_t ms) {
+		    return !connected? 0: ms < 1000? 1: 2 + unsigned(31 - __builtin_clz(ms / 1000)) / 2 < buckets?
+			    2 + unsigned(31 - __builtin_clz(ms / 1000)) / 2: unsigned(buckets - 1); };
+
+		/// @brief register the WIFI_EVENT_STA_CONNECTED & WIFI_EVENT_STA_DISCONNECTED handlers, once
+		static esp_err_t enroll();
+
+		/// @brief count of the all disconnections: poll it, take the snapshot, when changed
+		static uint32_t total();
+
+		/// @brief copy of the statistics; the fields are read one by one, w/o the lock:
+		///	   the disconnection in progress may be counted partially
+		static void snapshot(snapshot_t& snap);
+
+		/// @brief counters of the one reason-code
+		static void get(uint8_t reason, counter_t& cnt);
+
+		/// @brief clear of the statistics
+		static void reset();
+
+	    private:
+		/// @brief WIFI_EVENT handler: the start of the connection & the disconnection
+		static void on_event(void* arg, esp_event_base_t base, int32_t id, void* data);
+	    }; /* class esp::net::wifi::disconnects */
+
+
+	    /// @brief trace of the WIFI_EVENT & IP_EVENT: compact binary records in the lock-free ring,
+	    ///	   filled by the own handler in the event loop task (the single producer) & read by any task.
+	    ///	   The records are not decoded on the recording: the reason names are resolved by the reader only.
+	    class trace
+	    {
+	    public:
+		static constexpr size_t capacity = CONFIG_WIFI_TRACE_RECORDS;	///< records in the ring, the oldest are overwritten
+
+		/// @brief event base of the record
+		enum source_t: uint8_t
+		{
+		    WIFI,	///< WIFI_EVENT
+		    IP,		///< IP_EVENT
+		}; /* enum source_t */
+
+		/// @brief the event record
+		struct record_t
+		{
+		    int64_t	time;	///< esp_timer_get_time() of the event, us
+		    uint32_t	seq;	///< number of the record: the gap - the records are overwritten before the read
+		    uint32_t	aux;	///< WIFI_EVENT_STA_CONNECTED - the channel, IP_EVENT_STA_GOT_IP - the address, else 0
+		    source_t	source;
+		    uint8_t	id;	///< event id
+		    uint8_t	reason;	///< reason-code of the disconnection, else 0
+		    int8_t	rssi;	///< rssi of the WIFI_EVENT_STA_DISCONNECTED, else 0
+		}; /* struct record_t */
+
+		/// @brief register the WIFI_EVENT & IP_EVENT handlers, once
+		static esp_err_t enroll();
+
+		/// @brief record the event; the producer side - the event loop task only, no lock, no allocation
+		static void record(source_t source, uint8_t id, uint8_t reason = 0, int8_t rssi = 0, uint32_t aux = 0);
+
+		/// @brief count of the all records, the next record number
+		static uint32_t recorded();
+
+		/** @brief copy of the records, the oldest first; the records, overwritten during the copy, are skipped
+		 *  @param[out]  out      - buffer for the records
+		 *  @param[in]   size     - capacity of the buffer
+		 *  @param[in]   from     - number of the first record wanted: the last seq + 1 of the previous read
+		 *  @return count of the records copied */
+		static size_t read(record_t out[], size_t size, uint32_t from = 0);
+
+		/// @brief name of the event of the record
+		static const char* name(const record_t& rec);
+
+		/// @brief log the records with the decoded event names & reasons, ESP_LOGI with the tag
+		static void dump(const char* tag = "wifi::trace", uint32_t from = 0);
+
+		/// @brief drop the records
+		static void clear();
+
+	    private:
+		/// @brief WIFI_EVENT & IP_EVENT handler
+		static void on_event(void* arg, esp_event_base_t base, int32_t id, void* data);
+	    }; /* class esp::net::wifi::trace */
+
+
+	    /// @brief snapshot of the station status: ip info, DHCP client status, link, RSSI, BSSID & channel,
+	    ///	   updated by the own WIFI_EVENT & IP_EVENT handlers & published by the seqlock.
+	    ///	   The readers of any task never take the lock & never call the esp_netif/esp_wifi API:
+	    ///	   the reader retries the copy, when it is overlapped by the publication. The writers
+	    ///	   (the event handler, the Updater, the poll()) are serialized by the lock between them.
+	    class state
+	    {
+	    public:
+		/// @brief the copy of the status
+		struct snapshot_t
+		{
+		    esp_netif_ip_info_t	    ip;		///< ip info of the station, zero - no address
+		    esp_netif_dhcp_status_t dhcp;	///< DHCP client status, as set by the Updater
+		    bool		    link;	///< the station is connected to the AP
+		    bool		    got_ip;	///< IP_EVENT_STA_GOT_IP after the connection, not lost yet
+		    int8_t		    rssi;	///< RSSI of the last poll() or of the disconnection, 0 - unknown
+		    uint8_t		    channel;
+		    uint8_t		    bssid[6];
+		    uint32_t		    version;	///< count of the publications: the status is changed, when it differs
+		    uint32_t		    stamp;	///< esp_timer_get_time() of the last publication, ms
+		}; /* struct snapshot_t */
+
+		/// @brief register the WIFI_EVENT & IP_EVENT handlers, once; called by the creation of the station netif
+		/// @param[in] netif - the station netif: the status is seeded once by it's ip info, DHCP client status
+		///		       & the esp_wifi_sta_get_ap_info(), the connection may be up before the enroll
+		static esp_err_t enroll(esp_netif_t* netif = nullptr);
+
+		/// @brief the consistent copy of the status, lock-free
+		static void get(snapshot_t& snap);
+
+		/// @brief ip info of the station only, lock-free
+		static esp::ip4::info info();
+
+		/// @brief count of the publications: poll it, take the snapshot, when changed
+		static uint32_t version();
+
+		/// @brief publish the DHCP client status, set by the Updater: no event is posted for it
+		static void dhcp(esp_netif_dhcp_status_t status);
+
+		/// @brief refresh the RSSI, BSSID & channel by the esp_wifi_sta_get_ap_info(): call it periodically
+		///	   from the one task, instead of the every reader
+		/// @return the esp_wifi_sta_get_ap_info() result, ESP_ERR_WIFI_NOT_CONNECT - the status is kept as is
+		static esp_err_t poll();
+
+		/// @brief count of the copies, retried by the readers: the reader overlapped the publication
+		static uint32_t retries();
+
+	    private:
+		/// @brief WIFI_EVENT & IP_EVENT handler of the station
+		static void on_event(void* arg, esp_event_base_t base, int32_t id, void* data);
+	    }; /* class esp::net::wifi::state */
+
+
+	    /// @brief registry of the stations of the soft-AP: the open-addressing hash by the MAC (linear probing,
+	    ///	   the load up to 1/2), fed by the WIFI_EVENT_AP_STACONNECTED/STADISCONNECTED,
+	    ///	   the IP_EVENT_AP_STAIPASSIGNED & the periodic poll() of the esp_wifi_ap_get_sta_list().
+	    ///	   The lookup of the station costs the probe or two, w/o the scan of the all stations.
+	    ///	   The disconnected station is kept with the reason up to it's slot is needed for the new one.
+	    class stations
+	    {
+	    public:
+		static constexpr size_t capacity = CONFIG_WIFI_AP_STATIONS;	///< stations in the registry
+		static constexpr size_t slots = 2 * capacity;			///< slots of the hash, the power of 2
+
+		static_assert((slots & (slots - 1)) == 0, "CONFIG_WIFI_AP_STATIONS is not the power of 2");
+
+		/// @brief the station of the soft-AP
+		struct station_t
+		{
+		    uint8_t	mac[6];
+		    uint8_t	aid;		///< association id, 0 - unknown (found by the poll() only)
+		    uint8_t	reason;		///< reason-code of the disconnection, 0 - connected or unknown
+		    bool	connected;
+		    int8_t	rssi;		///< EWMA (1/4) of the RSSI of the poll(), 0 - not polled yet
+		    uint32_t	ip;		///< address, assigned by the DHCP server, network byte order; 0 - none
+		    uint32_t	since;		///< esp_timer_get_time() of the connection, ms
+		    uint32_t	left;		///< esp_timer_get_time() of the disconnection, ms; 0 - connected
+		}; /* struct station_t */
+
+		/// @brief register the WIFI_EVENT & IP_EVENT handlers of the soft-AP, once
+		static esp_err_t enroll();
+
+		/// @brief mirror the leases of the stations to the table of the DHCP server of the soft-AP:
+		///	   the address of the IP_EVENT_AP_STAIPASSIGNED is bound, the address of the disconnected
+		///	   station is released, by the event loop task - the reservations of the mirrored server
+		///	   are to be changed in it too, or with the soft-AP stopped
+		static void mirror(esp::dhcp_server_t* server);
+		/// @brief stop the mirror of the leases to the server, if it is mirrored
+		static void unmirror(const esp::dhcp_server_t* server);
+
+		/// @brief the station by the MAC, connected or disconnected; false - unknown
+		static bool find(const uint8_t mac[6], station_t& station);
+
+		/// @brief count of the connected stations
+		static size_t connected();
+
+		/// @brief copy of the stations, in the hash order
+		/// @param[in] all - the disconnected stations too
+		/// @return count of the stations copied
+		static size_t list(station_t out[], size_t size, bool all = false);
+
+		/// @brief refresh the RSSI by the esp_wifi_ap_get_sta_list(): call it periodically from the one task;
+		///	   the listed station, missed by the registry, is added, the missed in the list is disconnected
+		static esp_err_t poll();
+
+		/// @brief count of the connections, replaced the disconnected station or dropped by the full registry
+		static uint32_t evicted();
+		static uint32_t dropped();
+
+		/// @brief drop the all stations
+		static void clear();
+
+	    private:
+		/// @brief WIFI_EVENT & IP_EVENT handler of the soft-AP
+		static void on_event(void* arg, esp_event_base_t base, int32_t id, void* data);
+	    }; /* class esp::net::wifi::stations */
+
+
 	    /// @brief	namespace for pretty naming of the ESP32 WiFi STA or AP network configuration getting (wrapper on official API)
 	    namespace cfg
 	    {